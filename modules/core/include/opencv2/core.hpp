@@ -2278,6 +2278,53 @@ the convolution sample in dft description.
 */
 CV_EXPORTS_W void idft(InputArray src, OutputArray dst, int flags = 0, int nonzeroRows = 0);
 
+/** @brief Precomputed plan of the Discrete Fourier Transform of fixed size and type.
+
+The plan keeps factorization, twiddle factors, permutation tables and scratch buffers of the transform,
+so repeated transforms of the same size (for example, in phase correlation or template matching of
+video frames) skip setup performed by each dft call:
+@code
+    DFTPlan plan(frame.size(), CV_32FC1, DFT_COMPLEX_OUTPUT);
+    for (...)
+        plan.apply(frame, spectrum); // the same as dft(frame, spectrum, DFT_COMPLEX_OUTPUT)
+@endcode
+The plan object is not thread-safe: use separate plans in concurrent threads.
+@note dft calls reuse a few recently used plans of the calling thread too
+(`OPENCV_DFT_PLAN_CACHE_SIZE` configuration parameter limits the number of plans, 0 disables this cache;
+`OPENCV_DFT_PLAN_CACHE_LIMIT` limits memory of cached plans per thread, 4Mb by default).
+@sa dft, idft
+*/
+class CV_EXPORTS DFTPlan
+{
+public:
+    DFTPlan();
+    /** @overload
+    @param size size of the input array.
+    @param type type of the input array (CV_32FC1, CV_32FC2, CV_64FC1 or CV_64FC2).
+    @param flags transformation flags, see dft.
+    @param nonzeroRows see dft.
+    */
+    DFTPlan(Size size, int type, int flags = 0, int nonzeroRows = 0);
+    ~DFTPlan();
+
+    /** @brief Creates the plan, see DFTPlan(Size, int, int, int).
+    */
+    void create(Size size, int type, int flags = 0, int nonzeroRows = 0);
+
+    /** @brief Performs the transform, the result is the same as dft(src, dst, flags, nonzeroRows).
+    @param src input array of the size and type specified on plan creation.
+    @param dst output array, it is reallocated if needed.
+    */
+    void apply(InputArray src, OutputArray dst);
+
+    //! returns true if the plan has not been created
+    bool empty() const;
+
+    class Impl;
+protected:
+    Ptr<Impl> p;
+};
+
 /** @brief Performs a forward or inverse discrete Cosine transform of 1D or 2D array.
 
 The function cv::dct performs a forward or inverse discrete Cosine transform (DCT) of a 1D or 2D
@@ -0,0 +1,107 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_MAT_STORAGE_HPP
+#define OPENCV_CORE_MAT_STORAGE_HPP
+
+#include "opencv2/core.hpp"
+
+namespace cv {
+
+//! @addtogroup core_xml
+//! @{
+
+/** @brief Writer of binary matrix containers.
+
+The container is a flat binary file with named dense matrices. Data of each matrix is stored
+continuously in the native byte order and aligned to MatStorageWriter::ALIGNMENT bytes, so
+MatStorageReader can return matrices that point directly into the memory-mapped file.
+The index of matrices is stored in the end of the file, it is written by release().
+
+@code
+    MatStorageWriter writer("descriptors.cvmat");
+    writer.write("descriptors", descriptors);
+    writer.write("lut", lut);
+    writer.release();
+@endcode
+ */
+class CV_EXPORTS MatStorageWriter
+{
+public:
+    enum { ALIGNMENT = 64 };  //!< alignment of matrix data in the file
+
+    MatStorageWriter();
+    //! @copydoc open()
+    explicit MatStorageWriter(const String& filename);
+    //! the destructor calls release(), errors are logged instead of throwing exceptions
+    ~MatStorageWriter();
+
+    /** @brief Creates the container file (an existing file is overwritten).
+     @returns true if the file has been created.
+     */
+    bool open(const String& filename);
+
+    bool isOpened() const;
+
+    /** @brief Writes dense matrix of any type.
+     @param name Name of the matrix, it must be unique within the container.
+     @param mat The matrix (non-continuous matrices are supported, empty matrices are stored as empty).
+     */
+    void write(const String& name, InputArray mat);
+
+    //! Writes the index of matrices and closes the file.
+    void release();
+
+    class Impl;
+protected:
+    Ptr<Impl> p;
+};
+
+/** @brief Zero-copy reader of binary matrix containers written by MatStorageWriter.
+
+The file is memory-mapped by open() and matrices returned by get() point directly into the mapping
+without any parsing or copying, so processes that read the same file share its data through the
+page cache. The mapping is private: modifications of the returned matrices are not written to the
+file and are not visible to other processes (modified pages are copied on write).
+The mapping is kept while any returned matrix exists, even after release() of the reader.
+ */
+class CV_EXPORTS MatStorageReader
+{
+public:
+    MatStorageReader();
+    //! @copydoc open()
+    explicit MatStorageReader(const String& filename);
+    ~MatStorageReader();
+
+    /** @brief Maps the container file into memory and reads its index.
+     @returns false if the file can't be opened. Throws exception if the file is not a valid container.
+     */
+    bool open(const String& filename);
+
+    bool isOpened() const;
+
+    //! Releases the reader. Matrices returned by get() remain valid.
+    void release();
+
+    //! Returns names of the stored matrices in the order of writing.
+    std::vector<String> names() const;
+
+    //! Checks if the matrix with specified name is stored in the container.
+    bool contains(const String& name) const;
+
+    /** @brief Returns the stored matrix that points into the mapped file.
+     @returns empty matrix if there is no matrix with the specified name.
+     */
+    Mat get(const String& name) const;
+
+    class Impl;
+protected:
+    Ptr<Impl> p;
+};
+
+//! @} core_xml
+
+} // namespace
+
+#endif // OPENCV_CORE_MAT_STORAGE_HPP
@@ -39,6 +39,14 @@ namespace cv { namespace parallel {
  *   @snippet parallel_backend/example-openmp.cpp openmp_backend
  * - Configuration of compiler/linker options is responsibility of Application's scripts
  *
+ * #### Work-stealing (builtin)
+ *
+ * OpenCV provides optional builtin thread pool with per-thread task queues and work stealing.
+ * It balances loops with uneven per-stripe cost and executes nested `parallel_for_()` regions in parallel
+ * (other backends serialize nested calls). This backend is not selected automatically:
+ * - `OPENCV_PARALLEL_BACKEND=WORKSTEALING` environment variable
+ * - or `cv::parallel::setParallelForBackend("WORKSTEALING")` call
+ *
  *
  * ### Plugins support
  *
@@ -253,6 +253,7 @@ Check @ref tutorial_file_input_output_with_xml_yml "the corresponding tutorial"
 
 class CV_EXPORTS FileNode;
 class CV_EXPORTS FileNodeIterator;
+class CV_EXPORTS FileNodeVisitor;
 
 /** @brief XML/YAML/JSON file storage class that encapsulates all the information necessary for writing or
 reading data to/from a file.
@@ -418,6 +419,21 @@ public:
      */
     CV_WRAP int getFormat() const;
 
+    /** @brief Reads the file in streaming (SAX-like) mode.
+
+     Nodes are reported to the visitor in document order while the file is being parsed, so only
+     the current path of collections (and the collections requested by
+     FileNodeVisitor::startCollection() as a whole) is kept in memory. The function is useful for
+     multi-gigabyte files, where the regular FileStorage::open() would keep the whole parsed
+     document in memory.
+     @param filename Name of the file to read or the text string to read the data from
+     (with FileStorage::MEMORY flag).
+     @param visitor Callbacks that receive the nodes.
+     @param flags FileStorage::READ, optionally combined with FileStorage::MEMORY.
+     @returns true if the document has been parsed successfully.
+     */
+    static bool readStream(const String& filename, FileNodeVisitor& visitor, int flags = READ);
+
     int state;
     std::string elname;
 
@@ -653,6 +669,54 @@ protected:
     size_t idx;
 };
 
+/** @brief Callbacks of the streaming FileStorage reader.
+
+ See FileStorage::readStream(). Top-level nodes of the document have depth 0. All the nodes passed
+ to the callbacks are valid only until the callback returns.
+ */
+class CV_EXPORTS FileNodeVisitor
+{
+public:
+    //! processing of collection content, returned by startCollection()
+    enum Action
+    {
+        ENTER = 0,        //!< report elements of the collection one by one
+        SKIP = 1,         //!< parse the collection without storing and reporting its content
+        MATERIALIZE = 2   //!< store the whole collection and report it by visit() as a single node
+    };
+
+    virtual ~FileNodeVisitor();
+
+    /** @brief Called when a map or a sequence starts.
+     @param name Name of the collection (empty for sequence elements).
+     @param type FileNode::MAP or FileNode::SEQ.
+     @param depth Nesting level of the collection.
+     @returns one of FileNodeVisitor::Action. The default implementation returns ENTER.
+     */
+    virtual int startCollection(const std::string& name, int type, int depth);
+
+    /** @brief Called for the completely parsed scalar nodes and materialized collections.
+     @param name Name of the node (empty for sequence elements).
+     @param node The node. It can be read with the regular FileNode API, e.g. `node >> mat`.
+     @param depth Nesting level of the node.
+     */
+    virtual void visit(const std::string& name, const FileNode& node, int depth);
+
+    //! Called after all elements of the entered collection have been reported.
+    virtual void endCollection(const std::string& name, int type, int depth);
+
+    /** @brief Provides destination for the base64-encoded data of sequence (e.g. `data` of `opencv-matrix`
+     written with FileStorage::BASE64).
+     @param name Name of the sequence.
+     @param dt Format of the sequence elements, see @ref format_spec "format specification".
+     @param depth Nesting level of the sequence.
+     @returns Continuous matrix of the same depth as the elements, the data is decoded directly into it
+     and its size must match the number of elements. If the returned matrix is empty (the default
+     implementation), the data is processed as a regular sequence.
+     */
+    virtual Mat rawDataBuffer(const std::string& name, const std::string& dt, int depth);
+};
+
 //! @} core_xml
 
 /////////////////// XML & YAML I/O implementation //////////////////
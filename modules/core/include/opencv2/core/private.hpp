@@ -109,6 +109,10 @@ namespace cv
     // Returns a static string if there is a parallel framework,
     // NULL otherwise.
     CV_EXPORTS const char* currentParallelFramework();
+
+    // Returns true if the current thread executes a parallel_for_() call (or its body)
+    // and the backend doesn't support nesting, so the nested calls run sequentially.
+    CV_EXPORTS bool isNestedParallelForSequential();
 } //namespace cv
 
 /****************************************************************************************\
@@ -24,6 +24,13 @@ public:
     virtual void resetPeakUsage() = 0;
 };
 
+/** @brief Returns statistics of Mat::getPoolAllocator()
+
+Counters track memory requested from the system, including buffers which are cached by the pool.
+Number of allocations is the number of pool misses.
+*/
+CV_EXPORTS AllocatorStatisticsInterface& getPoolAllocatorStatistics();
+
 }} // namespace
 
 #endif // OPENCV_CORE_ALLOCATOR_STATS_HPP
@@ -0,0 +1,46 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_UTILS_HUGE_PAGES_PRIVATE_HPP
+#define OPENCV_CORE_UTILS_HUGE_PAGES_PRIVATE_HPP
+
+#include "opencv2/core/cvdef.h"
+
+namespace cv { namespace utils {
+
+//! @addtogroup core_utils
+//! @{
+
+/** Huge pages mode of fastMalloc() for large buffers (Linux only)
+ *
+ * Default mode is configured through `OPENCV_ALLOC_HUGE_PAGES` (`THP` or `HUGETLB`),
+ * size threshold is configured through `OPENCV_ALLOC_HUGE_PAGES_THRESHOLD` (32Mb by default).
+ */
+enum HugePagesMode
+{
+    HUGE_PAGES_NONE = 0,     //!< regular heap allocations
+    HUGE_PAGES_THP = 1,      //!< 2Mb aligned mappings with madvise(MADV_HUGEPAGE) (transparent huge pages)
+    HUGE_PAGES_HUGETLB = 2,  //!< MAP_HUGETLB mappings (requires reserved huge pages), fallback on HUGE_PAGES_THP
+};
+
+/** @brief Overrides huge pages configuration of fastMalloc() (used by tests and benchmarks)
+ *
+ * @note The function is not thread-safe. Buffers allocated before the call are released properly.
+ */
+CV_EXPORTS void setHugePagesAllocationMode(HugePagesMode mode, size_t threshold);
+
+/** @brief Returns true if huge pages modes are supported by this build of fastMalloc()
+ *
+ * Not supported on non-Linux platforms, without MADV_HUGEPAGE, with OPENCV_ENABLE_MEMORY_SANITIZER
+ * or OPENCV_ALLOC_DISABLE_HUGE_PAGES. Other modes are silently ignored in this case.
+ */
+CV_EXPORTS bool isHugePagesAllocationSupported();
+CV_EXPORTS HugePagesMode getHugePagesAllocationMode();
+CV_EXPORTS size_t getHugePagesAllocationThreshold();
+
+//! @}
+
+}} // namespace
+
+#endif // OPENCV_CORE_UTILS_HUGE_PAGES_PRIVATE_HPP
@@ -0,0 +1,53 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_UTILS_NUMA_HPP
+#define OPENCV_CORE_UTILS_NUMA_HPP
+
+#include "../cvdef.h"
+
+namespace cv { namespace utils {
+
+//! @addtogroup core_utils
+//! @{
+
+/** NUMA placement policy of OpenCV thread pool and Mat buffers
+ *
+ * @sa setNumaPolicy
+ */
+enum NumaPolicy
+{
+    NUMA_POLICY_NONE = 0,   //!< don't manage placement (OS defaults)
+    NUMA_POLICY_LOCAL = 1,  //!< pin worker threads of OpenCV thread pool to NUMA nodes and first-touch large Mat buffers in parallel row stripes
+};
+
+/** @brief Sets NUMA placement policy.
+ *
+ * With NUMA_POLICY_LOCAL worker threads of builtin thread pools (pthreads, work-stealing) are pinned to NUMA nodes:
+ * consecutive thread indexes are grouped on the same node (like consecutive row stripes of parallel_for_()).
+ * Buffers of new Mat objects with default allocator larger than `OPENCV_NUMA_FIRST_TOUCH_THRESHOLD` bytes (4Mb by default)
+ * are touched by parallel row stripes, so their pages are placed near threads which process them later.
+ *
+ * Policy is applied to existing worker threads on their next parallel job and it follows thread pool reconfiguration by setNumThreads().
+ * There is no effect on systems with single NUMA node or on platforms without NUMA support (only Linux is supported).
+ *
+ * Default value is configured through `OPENCV_NUMA_POLICY` environment variable (`NONE` or `LOCAL`).
+ *
+ * @note The function is not thread-safe. It must not be called in parallel region or concurrent threads.
+ */
+CV_EXPORTS void setNumaPolicy(NumaPolicy policy);
+
+/** @brief Returns current NUMA placement policy
+ */
+CV_EXPORTS NumaPolicy getNumaPolicy();
+
+/** @brief Returns number of NUMA nodes with CPUs available for the current process (1 if NUMA topology is not available)
+ */
+CV_EXPORTS int getNumaNodesCount();
+
+//! @}
+
+}} // namespace
+
+#endif // OPENCV_CORE_UTILS_NUMA_HPP
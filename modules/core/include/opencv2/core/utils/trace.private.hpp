@@ -15,8 +15,10 @@
 
 //! @cond IGNORED
 
+#include <atomic>
 #include <deque>
 #include <ostream>
+#include <vector>
 
 #define INTEL_ITTNOTIFY_API_PRIVATE 1
 #ifdef OPENCV_WITH_ITT
@@ -231,6 +233,48 @@ std::ostream& operator<<(std::ostream& out, const RegionStatisticsStatus& s)
     return out;
 }
 
+//! Completed region recorded by profiler
+struct ProfilerEvent
+{
+    const Region::LocationStaticStorage* location;
+    int64 beginTimestamp;
+    int64 duration;
+    int rangeStart;                    // parallel_for_ stripe range (rangeStart == rangeEnd if not available)
+    int rangeEnd;
+
+    ProfilerEvent() : location(NULL), beginTimestamp(0), duration(0), rangeStart(0), rangeEnd(0) {}
+    ProfilerEvent(const Region::LocationStaticStorage* location_, int64 beginTimestamp_, int64 duration_,
+                  int rangeStart_ = 0, int rangeEnd_ = 0) :
+        location(location_), beginTimestamp(beginTimestamp_), duration(duration_),
+        rangeStart(rangeStart_), rangeEnd(rangeEnd_)
+    {}
+};
+
+/** Ring buffer of profiler events (without locks)
+ *
+ * Events are written by owner thread only and read by profiler API calls from other threads.
+ * Readers drop events which are overwritten while they are being copied.
+ */
+class ProfilerBuffer
+{
+public:
+    ProfilerBuffer() : events(NULL), capacity(0), total(0), cleared(0) {}
+    ~ProfilerBuffer() { delete[] events.load(); }
+
+    void put(const ProfilerEvent& event);  // owner thread only
+    void copyTo(std::vector<ProfilerEvent>& dst) const;
+    void clear();
+
+private:
+    std::atomic<ProfilerEvent*> events;  // allocated on the first put()
+    size_t capacity;                     // written before 'events' is published
+    std::atomic<uint64> total;           // number of events written by owner thread
+    std::atomic<uint64> cleared;         // events before this index are dropped by clear()
+
+    ProfilerBuffer(const ProfilerBuffer&); // disabled
+    ProfilerBuffer& operator=(const ProfilerBuffer&); // disabled
+};
+
 //! TraceManager for local thread
 struct TraceManagerThreadLocal
 {
@@ -267,13 +311,19 @@ struct TraceManagerThreadLocal
 
     mutable cv::Ptr<TraceStorage> storage;
 
+    ProfilerBuffer profiler;
+    unsigned profilerRootCounter;      // number of entered root regions (sampling)
+    bool profilerSampled;              // regions of the current root region are recorded by profiler
+
     TraceManagerThreadLocal() :
         threadID(cv::utils::getThreadID()),
         region_counter(0), totalSkippedEvents(0),
         currentActiveRegion(NULL),
         regionDepth(0),
         regionDepthOpenCV(0),
-        parallel_for_stack_size(0)
+        parallel_for_stack_size(0),
+        profilerRootCounter(0),
+        profilerSampled(true)
     {
     }
 
@@ -351,6 +401,10 @@ void parallelForSetRootRegion(const Region& rootRegion, const TraceManagerThread
 void parallelForAttachNestedRegion(const Region& rootRegion);
 void parallelForFinalize(const Region& rootRegion);
 
+bool isProfilerActivated();
+//! records parallel_for_ stripe which is not traced as active region
+void profilerRecordStripe(int64 beginTimestamp, int rangeStart, int rangeEnd);
+
 
 
 
@@ -0,0 +1,97 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_UTILS_TRACE_PROFILER_HPP
+#define OPENCV_CORE_UTILS_TRACE_PROFILER_HPP
+
+#include "../cvdef.h"
+
+#include <string>
+#include <vector>
+
+namespace cv {
+namespace utils {
+namespace trace {
+
+//! @addtogroup core_logging
+//! @{
+
+/** Timing summary of trace region collected by profiler
+ *
+ * @sa getProfilerSummary
+ */
+struct CV_EXPORTS RegionProfile
+{
+    std::string name;       //!< region name (function name or name passed to CV_TRACE_REGION)
+    std::string filename;   //!< source code filename
+    int line;               //!< source code line
+    int64 count;            //!< number of recorded calls
+    double total;           //!< total time (milliseconds)
+    double mean;            //!< mean time (milliseconds)
+    double p50;             //!< median time (milliseconds)
+    double p90;             //!< 90th percentile of time (milliseconds)
+    double p99;             //!< 99th percentile of time (milliseconds)
+    double max;             //!< maximal time (milliseconds)
+};
+
+/** @brief Enables or disables runtime profiler.
+ *
+ * Profiler records completed trace regions (CV_TRACE_FUNCTION, CV_TRACE_REGION and instrumented OpenCV functions)
+ * into per-thread ring buffers. Each thread keeps the last `OPENCV_TRACE_PROFILER_BUFFER_SIZE` regions (65536 by default),
+ * so memory usage is bounded and the profiler can be kept enabled in long-running processes.
+ * Row stripes of parallel_for_() are recorded as "parallel_for_body" regions of worker threads.
+ *
+ * Nesting of recorded OpenCV functions is limited by `OPENCV_TRACE_DEPTH_OPENCV` (1 by default: only functions called from application code).
+ *
+ * Default value is configured through `OPENCV_TRACE_PROFILER` environment variable.
+ * If `OPENCV_TRACE_PROFILER_OUTPUT` is set, Chrome trace of recorded regions is written into this file by dumpProfiler()
+ * and on process exit (unreliable: it depends on the order of static objects destruction).
+ *
+ * There is no effect if OpenCV is built without trace support.
+ */
+CV_EXPORTS void setProfilerEnabled(bool enabled);
+
+/** @brief Returns true if runtime profiler is enabled
+ */
+CV_EXPORTS bool isProfilerEnabled();
+
+/** @brief Sets profiler sampling period
+ *
+ * Only each `period`-th root (outermost) region of each thread is recorded with all nested regions,
+ * so overhead of the profiler is reduced while nesting of recorded regions is preserved.
+ * Default value is configured through `OPENCV_TRACE_PROFILER_SAMPLING_PERIOD` environment variable (1: record all regions).
+ */
+CV_EXPORTS void setProfilerSamplingPeriod(int period);
+CV_EXPORTS int getProfilerSamplingPeriod();
+
+/** @brief Writes Chrome trace of recorded regions into the file specified by `OPENCV_TRACE_PROFILER_OUTPUT`
+ *
+ * @returns false if the output file is not configured or it can't be written
+ * @sa writeProfilerChromeTrace
+ */
+CV_EXPORTS bool dumpProfiler();
+
+/** @brief Drops regions recorded by profiler in all threads
+ */
+CV_EXPORTS void resetProfiler();
+
+/** @brief Returns timing statistics of regions recorded by profiler
+ *
+ * Regions are grouped by their code location. Result is sorted by total time (descending).
+ * Only regions which are still kept in ring buffers are taken into account.
+ */
+CV_EXPORTS std::vector<RegionProfile> getProfilerSummary();
+
+/** @brief Writes regions recorded by profiler in Chrome trace event format (JSON)
+ *
+ * The file can be opened by chrome://tracing or Perfetto UI (https://ui.perfetto.dev).
+ * @returns false if the file can't be written
+ */
+CV_EXPORTS bool writeProfilerChromeTrace(const std::string& filename);
+
+//! @}
+
+}}} // namespace
+
+#endif // OPENCV_CORE_UTILS_TRACE_PROFILER_HPP
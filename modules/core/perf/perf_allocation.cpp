@@ -3,8 +3,14 @@
 // of this distribution and at http://opencv.org/license.html.
 
 #include "perf_precomp.hpp"
+#include "opencv2/core/utils/huge_pages.private.hpp"
 #include <array>
 
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#define HAVE_GETRUSAGE 1
+#endif
+
 using namespace perf;
 
 #define ALLOC_MAT_SIZES ::perf::szSmall24, ::perf::szSmall32, ::perf::szSmall64, \
@@ -45,4 +51,110 @@ PERF_TEST_P(MatDepth_tb, DISABLED_Allocation_Aligned,
     SANITY_CHECK_NOTHING();
 }
 
+typedef perf::TestBaseWithParam<bool> MatAllocator_Pool;
+
+PERF_TEST_P(MatAllocator_Pool, Allocation_Mat_frames, testing::Bool())
+{
+    const bool usePool = GetParam();
+    cv::MatAllocator* allocator = usePool ? cv::Mat::getPoolAllocator() : cv::Mat::getStdAllocator();
+    const std::array<cv::Size, 3> sizes{{::perf::sz1080p, ::perf::szVGA, ::perf::szQVGA}};
+
+    TEST_CYCLE()
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            cv::Mat m;
+            m.allocator = allocator;
+            m.create(sizes[i % sizes.size()], CV_8UC3);
+        }
+    }
+    if (usePool)
+        allocator->getBufferPoolController()->freeAllReservedBuffers();
+    SANITY_CHECK_NOTHING();
+}
+
+static int64 getPageFaults()
+{
+#ifdef HAVE_GETRUSAGE
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        return (int64)usage.ru_minflt + usage.ru_majflt;
+#endif
+    return 0;
+}
+
+class HugePagesModeScope
+{
+public:
+    HugePagesModeScope(cv::utils::HugePagesMode mode)
+        : prevMode(cv::utils::getHugePagesAllocationMode())
+        , prevThreshold(cv::utils::getHugePagesAllocationThreshold())
+    {
+        cv::utils::setHugePagesAllocationMode(mode, (size_t)4 << 20);
+    }
+    ~HugePagesModeScope()
+    {
+        cv::utils::setHugePagesAllocationMode(prevMode, prevThreshold);
+    }
+protected:
+    cv::utils::HugePagesMode prevMode;
+    size_t prevThreshold;
+};
+
+CV_ENUM(HugePagesMode, cv::utils::HUGE_PAGES_NONE, cv::utils::HUGE_PAGES_THP)
+
+typedef tuple<HugePagesMode, cv::Size> HugePages_Size_t;
+typedef perf::TestBaseWithParam<HugePages_Size_t> HugePages_Size;
+
+// allocation + first touch of the whole buffer (page faults are dominant)
+PERF_TEST_P(HugePages_Size, Allocation_HugePages_touch,
+    testing::Combine(HugePagesMode::all(), testing::Values(::perf::sz2160p, ::perf::sz4320p)))
+{
+    const HugePagesModeScope scope((cv::utils::HugePagesMode)(int)get<0>(GetParam()));
+    const cv::Size sz = get<1>(GetParam());
+
+    const int64 faults0 = getPageFaults();
+    int iterations = 0;
+    TEST_CYCLE()
+    {
+        cv::Mat m(sz, CV_8UC4);
+        m.setTo(cv::Scalar::all(1));
+        iterations++;
+    }
+    const int64 faults = getPageFaults() - faults0;
+    RecordProperty("page_faults_per_iteration", cv::format("%.1f", (double)faults / std::max(1, iterations)));
+
+    SANITY_CHECK_NOTHING();
+}
+
+// random row access over a large buffer (TLB misses are dominant)
+PERF_TEST_P(HugePages_Size, HugePages_random_access,
+    testing::Combine(HugePagesMode::all(), testing::Values(::perf::sz4320p)))
+{
+    const HugePagesModeScope scope((cv::utils::HugePagesMode)(int)get<0>(GetParam()));
+    const cv::Size sz = get<1>(GetParam());
+
+    // 7680x4320x16 bytes = ~506Mb: far beyond TLB reach of 4Kb pages (a few Mb), ~250 of 2Mb pages
+    cv::Mat m(sz, CV_32FC4, cv::Scalar::all(1));
+    std::vector<int> rows(1 << 16);
+    cv::RNG& rng = cv::theRNG();
+    for (size_t i = 0; i < rows.size(); i++)
+        rows[i] = rng.uniform(0, m.rows);
+
+    const int64 faults0 = getPageFaults();
+    float sum = 0;
+    TEST_CYCLE()
+    {
+        for (size_t i = 0; i < rows.size(); i++)
+        {
+            const float* ptr = m.ptr<float>(rows[i]);
+            sum += ptr[(i * 64) % (size_t)(m.cols * 4)];
+        }
+    }
+    RecordProperty("page_faults", cv::format("%lld", (long long)(getPageFaults() - faults0)));
+    EXPECT_GT(sum, 0);
+
+    SANITY_CHECK_NOTHING();
+}
+
 }
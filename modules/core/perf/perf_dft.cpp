@@ -36,6 +36,49 @@ PERF_TEST_P(Size_MatType_FlagsType_NzeroRows, dft, TEST_MATS_DFT)
     SANITY_CHECK(dst, 1e-5, ERROR_RELATIVE);
 }
 
+//////////////////////////////////////////////////dft (same size)///////////////////////////////////////////////////
+
+// phase correlation / template matching pattern: many transforms of the same size
+typedef tuple<Size, MatType, bool> Size_MatType_UsePlan_t;
+typedef perf::TestBaseWithParam<Size_MatType_UsePlan_t> Size_MatType_UsePlan;
+
+PERF_TEST_P(Size_MatType_UsePlan, dft_repeated, testing::Combine(
+                                    testing::Values(cv::Size(64, 64), cv::Size(128, 128), cv::Size(256, 256),
+                                                    cv::Size(512, 512), cv::Size(1024, 1024)),
+                                    testing::Values(CV_32FC1, CV_32FC2, CV_64FC1), testing::Bool()))
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    bool usePlan = get<2>(GetParam());
+    const int flags = CV_MAT_CN(type) == 1 ? DFT_COMPLEX_OUTPUT : 0;
+    const int N = 16;
+
+    Mat src(sz, type);
+    Mat dst;
+
+    declare.in(src, WARMUP_RNG);
+
+    DFTPlan plan(sz, type, flags);
+    if (usePlan)
+    {
+        TEST_CYCLE()
+        {
+            for (int i = 0; i < N; i++)
+                plan.apply(src, dst);
+        }
+    }
+    else
+    {
+        TEST_CYCLE()
+        {
+            for (int i = 0; i < N; i++)
+                dft(src, dst, flags);
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 ///////////////////////////////////////////////////////dct//////////////////////////////////////////////////////
 
 CV_ENUM(DCT_FlagsType, 0, DCT_INVERSE , DCT_ROWS, DCT_INVERSE|DCT_ROWS)
@@ -0,0 +1,77 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "perf_precomp.hpp"
+
+namespace opencv_test
+{
+using namespace perf;
+
+typedef Size_MatType MatExpr_Chain;
+
+PERF_TEST_P_(MatExpr_Chain, weightedDiff_expr)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat a(sz, type), b(sz, type), c(sz, type), dst(sz, type);
+    declare.in(a, b, c, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() dst = a*0.5 + b*0.5 - c;
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(MatExpr_Chain, weightedDiff_calls)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat a(sz, type), b(sz, type), c(sz, type), dst(sz, type), t(sz, type);
+    declare.in(a, b, c, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE()
+    {
+        cv::addWeighted(a, 0.5, b, 0.5, 0, t);
+        cv::subtract(t, c, dst);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(MatExpr_Chain, absDiffThreshold_expr)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat a(sz, type), b(sz, type), dst;
+    declare.in(a, b, WARMUP_RNG);
+
+    TEST_CYCLE() dst = abs(a - b)*2 > 50;
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(MatExpr_Chain, absDiffThreshold_calls)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat a(sz, type), b(sz, type), t(sz, type), dst;
+    declare.in(a, b, WARMUP_RNG);
+
+    TEST_CYCLE()
+    {
+        cv::absdiff(a, b, t);
+        t.convertTo(t, -1, 2);
+        cv::compare(t, 50, dst, CMP_GT);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/ , MatExpr_Chain,
+    testing::Combine(
+        testing::Values(szVGA, sz1080p, sz2160p),
+        testing::Values(CV_8UC1, CV_32FC1, CV_32FC3, CV_64FC1)  // integer chains use temporary matrices
+    )
+);
+
+} // namespace
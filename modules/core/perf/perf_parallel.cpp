@@ -0,0 +1,116 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "perf_precomp.hpp"
+#include "opencv2/core/private.hpp"
+#include <opencv2/core/parallel/parallel_backend.hpp>
+
+namespace opencv_test
+{
+using namespace perf;
+
+namespace {
+
+// Row cost grows with the row index: the last rows are ~64x more expensive than the first ones
+// (like contours or warps over sparse masks)
+static void processImbalancedRows(const Mat& src, Mat& dst, const Range& r)
+{
+    for (int y = r.start; y < r.end; y++)
+    {
+        const float* s = src.ptr<float>(y);
+        float* d = dst.ptr<float>(y);
+        const int iterations = 1 + (64 * y) / src.rows;
+        for (int x = 0; x < src.cols; x++)
+        {
+            float v = s[x];
+            for (int k = 0; k < iterations; k++)
+                v = v * 0.999f + 0.001f;
+            d[x] = v;
+        }
+    }
+}
+
+class ParallelBackendScope
+{
+public:
+    ParallelBackendScope(const std::string& name)
+    {
+        const char* framework = cv::currentParallelFramework();
+        prev = framework && std::string(framework) == "workstealing" ? "WORKSTEALING" : "";
+        isAvailable = cv::parallel::setParallelForBackend(name);  // empty name: default backend
+    }
+    ~ParallelBackendScope()
+    {
+        cv::parallel::setParallelForBackend(prev);
+    }
+    bool isAvailable;
+protected:
+    std::string prev;
+};
+
+} // namespace
+
+typedef tuple<std::string, Size> ParallelBackend_Size_t;
+typedef TestBaseWithParam<ParallelBackend_Size_t> ParallelBackend_Size;
+
+PERF_TEST_P(ParallelBackend_Size, parallel_for_imbalanced,
+    testing::Combine(
+        testing::Values(std::string(), std::string("WORKSTEALING")),
+        testing::Values(szVGA, sz1080p)
+    ))
+{
+    const std::string backend = get<0>(GetParam());
+    const Size sz = get<1>(GetParam());
+    ParallelBackendScope scope(backend);
+    if (!scope.isAvailable)
+        throw SkipTestException("Parallel backend is not available: " + backend);
+
+    Mat src(sz, CV_32FC1), dst(sz, CV_32FC1);
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE()
+    {
+        parallel_for_(Range(0, sz.height), [&](const Range& r) { processImbalancedRows(src, dst, r); });
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(ParallelBackend_Size, parallel_for_nested,
+    testing::Combine(
+        testing::Values(std::string(), std::string("WORKSTEALING")),
+        testing::Values(szVGA, sz1080p)
+    ))
+{
+    const std::string backend = get<0>(GetParam());
+    const Size sz = get<1>(GetParam());
+    ParallelBackendScope scope(backend);
+    if (!scope.isAvailable)
+        throw SkipTestException("Parallel backend is not available: " + backend);
+
+    const int nImages = 4;  // outer loop doesn't have enough parallelism on many-core systems
+    std::vector<Mat> src(nImages), dst(nImages);
+    for (int i = 0; i < nImages; i++)
+    {
+        src[i].create(sz, CV_32FC1);
+        dst[i].create(sz, CV_32FC1);
+        declare.in(src[i], WARMUP_RNG);
+    }
+
+    TEST_CYCLE()
+    {
+        parallel_for_(Range(0, nImages), [&](const Range& images) {
+            for (int i = images.start; i < images.end; i++)
+            {
+                const Mat& s = src[i];
+                Mat& d = dst[i];
+                parallel_for_(Range(0, sz.height), [&](const Range& r) { processImbalancedRows(s, d, r); });
+            }
+        });
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+} // namespace
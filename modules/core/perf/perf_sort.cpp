@@ -47,4 +47,42 @@ PERF_TEST_P(sortIdxFixture, sorIdx, TYPICAL_MATS_SORT)
     SANITY_CHECK_NOTHING();
 }
 
+typedef tuple<Size, MatType, int> sortLargeParams;
+typedef TestBaseWithParam<sortLargeParams> sortLargeFixture;
+
+#define SORT_LARGE_MATS testing::Combine( \
+    testing::Values(sz1080p, Size(100000, 16)), \
+    testing::Values(CV_8UC1, CV_16SC1, CV_32SC1, CV_32FC1, CV_64FC1), \
+    testing::Values(SORT_EVERY_ROW | SORT_ASCENDING, SORT_EVERY_COLUMN | SORT_DESCENDING) )
+
+PERF_TEST_P(sortLargeFixture, sort, SORT_LARGE_MATS)
+{
+    const Size sz = get<0>(GetParam());
+    const int type = get<1>(GetParam()), flags = get<2>(GetParam());
+
+    cv::Mat a(sz, type), b(sz, type);
+
+    declare.in(a, WARMUP_RNG).out(b);
+
+    TEST_CYCLE() cv::sort(a, b, flags);
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef sortLargeFixture sortIdxLargeFixture;
+
+PERF_TEST_P(sortIdxLargeFixture, sortIdx, SORT_LARGE_MATS)
+{
+    const Size sz = get<0>(GetParam());
+    const int type = get<1>(GetParam()), flags = get<2>(GetParam());
+
+    cv::Mat a(sz, type), b(sz, CV_32SC1);
+
+    declare.in(a, WARMUP_RNG).out(b);
+
+    TEST_CYCLE() cv::sortIdx(a, b, flags);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
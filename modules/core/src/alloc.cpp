@@ -66,6 +66,19 @@
 #include <map>
 #endif
 
+#if defined(__linux__) && !defined(__ANDROID__) \
+    && !defined(OPENCV_ENABLE_MEMORY_SANITIZER) \
+    && !defined(OPENCV_ALLOC_DISABLE_HUGE_PAGES)
+#include <sys/mman.h>
+#if defined(MADV_HUGEPAGE)
+#define OPENCV_ALLOC_HUGE_PAGES_SUPPORT 1
+#include <unistd.h>
+#include <atomic>
+#endif
+#endif
+
+#include "opencv2/core/utils/huge_pages.private.hpp"
+
 namespace cv {
 
 static void* OutOfMemoryError(size_t size)
@@ -123,6 +136,166 @@ static const bool g_force_initialization_memalign_flag
     = isAlignedAllocationEnabled();
 #endif
 
+namespace utils {
+
+static HugePagesMode readHugePagesModeParameter()
+{
+    std::string mode = toUpperCase(cv::utils::getConfigurationParameterString("OPENCV_ALLOC_HUGE_PAGES", ""));  // should not call fastMalloc() internally
+    if (mode == "THP" || mode == "MADVISE")
+        return HUGE_PAGES_THP;
+    if (mode == "HUGETLB")
+        return HUGE_PAGES_HUGETLB;
+    return HUGE_PAGES_NONE;
+}
+
+static HugePagesMode& getHugePagesModeRef()
+{
+    static HugePagesMode mode = readHugePagesModeParameter();
+    return mode;
+}
+
+static size_t& getHugePagesThresholdRef()
+{
+    static size_t threshold = cv::utils::getConfigurationParameterSizeT("OPENCV_ALLOC_HUGE_PAGES_THRESHOLD", (size_t)32 << 20);
+    return threshold;
+}
+
+void setHugePagesAllocationMode(HugePagesMode mode, size_t threshold)
+{
+    getHugePagesModeRef() = mode;
+    getHugePagesThresholdRef() = threshold;
+}
+
+bool isHugePagesAllocationSupported()
+{
+#ifdef OPENCV_ALLOC_HUGE_PAGES_SUPPORT
+    return true;
+#else
+    return false;
+#endif
+}
+
+HugePagesMode getHugePagesAllocationMode()
+{
+    return getHugePagesModeRef();
+}
+
+size_t getHugePagesAllocationThreshold()
+{
+    return getHugePagesThresholdRef();
+}
+
+} // namespace utils
+
+#ifdef OPENCV_ALLOC_HUGE_PAGES_SUPPORT
+// Large buffers are mapped directly with 2Mb alignment, so they can be backed by huge pages
+// (transparent huge pages through madvise() or explicitly reserved pages through MAP_HUGETLB).
+// Mapping is preceded by one regular page with HugePagesHeader, so fastFree() recognizes such buffers
+// without lookups in a global registry.
+static const size_t HUGE_PAGE_SIZE = (size_t)2 << 20;
+static const size_t HUGE_PAGES_TAG = (size_t)0x4855474550414745ull;  // "HUGEPAGE"
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)  // request 2Mb pages explicitly instead of the system default huge page size
+#endif
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE 0x100000  // Linux 4.17+, older kernels treat the address as a hint
+#endif
+
+struct HugePagesHeader
+{
+    size_t map_size;
+    size_t tag;  // HUGE_PAGES_TAG ^ (size_t)ptr
+};
+
+static std::atomic<int> huge_pages_buffers(0);  // fast check for fastFree() calls
+
+static size_t getSystemPageSize()
+{
+    static size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    return page_size;
+}
+
+// explicitly reserved huge pages, the header page is mapped separately right before them
+static uchar* hugeTlbMalloc(size_t map_size, size_t page_size)
+{
+    // the kernel aligns MAP_HUGETLB mappings on the huge page size
+    uchar* aligned = (uchar*)mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+                                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_2MB, -1, 0);
+    if ((void*)aligned == MAP_FAILED)
+        return NULL;
+    if (((size_t)aligned & (HUGE_PAGE_SIZE - 1)) == 0)
+    {
+        // mappings of other threads are never replaced (no MAP_FIXED)
+        void* header_page = mmap(aligned - page_size, page_size, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        if (header_page == (void*)(aligned - page_size))
+            return aligned;
+        if (header_page != MAP_FAILED)
+            munmap(header_page, page_size);
+    }
+    munmap(aligned, map_size);
+    return NULL;
+}
+
+static void* hugePagesMalloc(size_t size)
+{
+    const utils::HugePagesMode mode = utils::getHugePagesModeRef();
+    if (mode == utils::HUGE_PAGES_NONE || size < utils::getHugePagesThresholdRef())
+        return NULL;
+    const size_t page_size = getSystemPageSize();
+    const size_t map_size = alignSize(size, HUGE_PAGE_SIZE);
+    uchar* aligned = NULL;
+    if (mode == utils::HUGE_PAGES_HUGETLB)
+    {
+        aligned = hugeTlbMalloc(map_size, page_size);
+        if (!aligned)
+            CV_LOG_VERBOSE(NULL, 0, "alloc.cpp: MAP_HUGETLB allocation failed (no reserved 2Mb huge pages?), fallback on transparent huge pages");
+    }
+    if (!aligned)
+    {
+        // reserve address range and trim it to [aligned - page_size; aligned + map_size)
+        const size_t reserved_size = map_size + HUGE_PAGE_SIZE + page_size;
+        uchar* base = (uchar*)mmap(NULL, reserved_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if ((void*)base == MAP_FAILED)
+            return NULL;  // fallback on regular allocation
+        aligned = alignPtr(base + page_size, (int)HUGE_PAGE_SIZE);
+        uchar* header_page = aligned - page_size;
+        if (header_page > base)
+            munmap(base, header_page - base);
+        size_t tail = (base + reserved_size) - (aligned + map_size);
+        if (tail > 0)
+            munmap(aligned + map_size, tail);
+        madvise(aligned, map_size, MADV_HUGEPAGE);
+    }
+    HugePagesHeader* header = (HugePagesHeader*)aligned - 1;
+    header->map_size = map_size;
+    header->tag = HUGE_PAGES_TAG ^ (size_t)aligned;
+    huge_pages_buffers++;
+    return aligned;
+}
+
+static bool hugePagesFree(void* ptr)
+{
+    // memory before other 2Mb aligned buffers is readable too: it belongs to the heap block (or its header)
+    if (huge_pages_buffers.load(std::memory_order_relaxed) == 0 || ((size_t)ptr & (HUGE_PAGE_SIZE - 1)) != 0 || !ptr)
+        return false;
+    HugePagesHeader* header = (HugePagesHeader*)ptr - 1;
+    if (header->tag != (HUGE_PAGES_TAG ^ (size_t)ptr))
+        return false;
+    const size_t map_size = header->map_size;
+    header->tag = 0;
+    huge_pages_buffers--;
+    munmap(ptr, map_size);  // may be MAP_HUGETLB mapping, so it is released separately from the header page
+    const size_t page_size = getSystemPageSize();
+    munmap((uchar*)ptr - page_size, page_size);
+    return true;
+}
+#endif // OPENCV_ALLOC_HUGE_PAGES_SUPPORT
+
 #ifdef OPENCV_ALLOC_ENABLE_STATISTICS
 static inline
 void* fastMalloc_(size_t size)
@@ -130,6 +303,14 @@ void* fastMalloc_(size_t size)
 void* fastMalloc(size_t size)
 #endif
 {
+#ifdef OPENCV_ALLOC_HUGE_PAGES_SUPPORT
+    if (size >= utils::getHugePagesThresholdRef())
+    {
+        void* ptr = hugePagesMalloc(size);
+        if (ptr)
+            return ptr;
+    }
+#endif
 #ifdef HAVE_POSIX_MEMALIGN
     if (isAlignedAllocationEnabled())
     {
@@ -172,6 +353,10 @@ void fastFree_(void* ptr)
 void fastFree(void* ptr)
 #endif
 {
+#ifdef OPENCV_ALLOC_HUGE_PAGES_SUPPORT
+    if (hugePagesFree(ptr))
+        return;
+#endif
 #if defined HAVE_POSIX_MEMALIGN || defined HAVE_MEMALIGN
     if (isAlignedAllocationEnabled())
     {
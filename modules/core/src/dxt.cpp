@@ -43,8 +43,13 @@
 #include "opencv2/core/opencl/runtime/opencl_clfft.hpp"
 #include "opencv2/core/opencl/runtime/opencl_core.hpp"
 #include "opencl_kernels_core.hpp"
+#include "opencv2/core/utils/configuration.private.hpp"
+#include "opencv2/core/utils/tls.hpp"
 #include <map>
 
+#include "dxt.simd.hpp"
+#include "dxt.simd_declarations.hpp" // defines CV_CPU_DISPATCH_MODES_ALL=AVX2,...,BASELINE based on CMakeLists.txt content
+
 namespace cv
 {
 
@@ -779,6 +784,39 @@ static IppStatus ippsDFTInv_PackToR( const double* src, double* dst,
 }
 #endif
 
+// radix-4 passes of power-of-2 part of the transform (see dxt.simd.hpp)
+static int DFT_R4(Complexf* dst, int N, int n0, int& dw0, const float* twiddles)
+{
+    CV_CPU_DISPATCH(DFT_R4_32f, (dst, N, n0, dw0, twiddles),
+        CV_CPU_DISPATCH_MODES_ALL);
+}
+
+static int DFT_R4(Complexd* dst, int N, int n0, int& dw0, const double* twiddles)
+{
+    CV_CPU_DISPATCH(DFT_R4_64f, (dst, N, n0, dw0, twiddles),
+        CV_CPU_DISPATCH_MODES_ALL);
+}
+
+// gathers twiddle factors of radix-4 passes from the table of DFTInit() into the layout of DFT_R4()
+template<typename T> static void
+DFTInitR4( int n0, int N, const Complex<T>* wave, T* twiddles )
+{
+    for( int nx = 1; nx*4 <= N; nx *= 4 )
+    {
+        T* tw = twiddles + 2*(nx - 1);
+        int dw0 = n0/(nx*4);
+        for( int k = 0; k < 3; k++, tw += nx*2 )
+        {
+            for( int j = 0; j < nx; j++ )
+            {
+                const Complex<T>& w = wave[(k + 1)*j*dw0];
+                tw[j] = w.re;
+                tw[nx + j] = w.im;
+            }
+        }
+    }
+}
+
 struct OcvDftOptions;
 
 typedef void (*DFTFunc)(const OcvDftOptions & c, const void* src, void* dst);
@@ -790,6 +828,7 @@ struct OcvDftOptions {
 
     int* itab;
     void* wave;
+    void* r4twiddles;
     int tab_size;
     int n;
 
@@ -814,6 +853,7 @@ struct OcvDftOptions {
         scale = 0;
         itab = 0;
         wave = 0;
+        r4twiddles = 0;
         tab_size = 0;
         n = 0;
         isInverse = false;
@@ -829,6 +869,26 @@ struct OcvDftOptions {
     }
 };
 
+// enables vectorized radix-4 passes, the tables (c.wave) should be initialized
+static void initR4Twiddles( OcvDftOptions & c, int depth, AutoBuffer<uchar>& buf )
+{
+    int N = c.factors[0];
+    c.r4twiddles = 0;
+    if( (N & 1) != 0 || N < 16 )
+        return;
+    if( depth == CV_32F )
+    {
+        buf.allocate(N*2*sizeof(float));
+        DFTInitR4(c.n, N, (const Complexf*)c.wave, (float*)buf.data());
+    }
+    else
+    {
+        buf.allocate(N*2*sizeof(double));
+        DFTInitR4(c.n, N, (const Complexd*)c.wave, (double*)buf.data());
+    }
+    c.r4twiddles = buf.data();
+}
+
 // mixed-radix complex discrete Fourier transform: double-precision version
 template<typename T> static void
 DFT(const OcvDftOptions & c, const Complex<T>* src, Complex<T>* dst)
@@ -961,7 +1021,9 @@ DFT(const OcvDftOptions & c, const Complex<T>* src, Complex<T>* dst)
     // 1. power-2 transforms
     if( (c.factors[0] & 1) == 0 )
     {
-        if( c.factors[0] >= 4 && c.haveSSE3)
+        if( c.r4twiddles )
+            n = DFT_R4(dst, c.factors[0], c.n, dw0, (const T*)c.r4twiddles);
+        else if( c.factors[0] >= 4 && c.haveSSE3)
         {
             DFT_VecR4<T> vr4;
             n = vr4(dst, c.factors[0], c.n, dw0, wave);
@@ -3217,6 +3279,7 @@ public:
     int _factors[34];
     AutoBuffer<uchar> wave_buf;
     AutoBuffer<int> itab_buf;
+    AutoBuffer<uchar> r4tw_buf;
 #ifdef USE_IPP_DFT
     AutoBuffer<uchar> ippbuf;
     AutoBuffer<uchar> ippworkbuf;
@@ -3310,6 +3373,7 @@ public:
                 opt.itab = itab_buf.data();
                 DFTInit( opt.n, opt.nf, opt.factors, opt.itab, complex_elem_size,
                          opt.wave, stage == 0 && opt.isInverse && real_transform );
+                initR4Twiddles(opt, depth, r4tw_buf);
             }
             // otherwise reuse the tables calculated on the previous stage
             if (needBuffer)
@@ -3483,6 +3547,120 @@ Ptr<DFT2D> DFT2D::create(int width, int height, int depth,
 } // cv::
 
 
+namespace cv {
+
+// returns type of dft() destination
+static int getDFTDstType( int type, int flags )
+{
+    bool inv = (flags & DFT_INVERSE) != 0;
+    int depth = CV_MAT_DEPTH(type), cn = CV_MAT_CN(type);
+
+    CV_Assert( type == CV_32FC1 || type == CV_32FC2 || type == CV_64FC1 || type == CV_64FC2 );
+
+    // Fail if DFT_COMPLEX_INPUT is specified, but src is not 2 channels.
+    CV_Assert( !((flags & DFT_COMPLEX_INPUT) && cn != 2) );
+
+    if( !inv && cn == 1 && (flags & DFT_COMPLEX_OUTPUT) )
+        return CV_MAKETYPE(depth, 2);
+    if( inv && cn == 2 && (flags & DFT_REAL_OUTPUT) )
+        return depth;
+    return type;
+}
+
+// converts dft() flags into flags of hal::DFT2D
+static int getHalDFTFlags( int flags, bool isContinuous, bool isInplace )
+{
+    int f = 0;
+    if (isContinuous)
+        f |= CV_HAL_DFT_IS_CONTINUOUS;
+    if (flags & DFT_INVERSE)
+        f |= CV_HAL_DFT_INVERSE;
+    if (flags & DFT_ROWS)
+        f |= CV_HAL_DFT_ROWS;
+    if (flags & DFT_SCALE)
+        f |= CV_HAL_DFT_SCALE;
+    if (isInplace)
+        f |= CV_HAL_DFT_IS_INPLACE;
+    return f;
+}
+
+// allocates the destination of dft(), returns flags of hal::DFT2D
+static int prepareDFT( const Mat& src, OutputArray _dst, int flags, Mat& dst )
+{
+    _dst.create( src.size(), getDFTDstType(src.type(), flags) );
+    dst = _dst.getMat();
+    return getHalDFTFlags(flags, src.isContinuous() && dst.isContinuous(), src.data == dst.data);
+}
+
+static size_t getDFTPlanCacheSize()
+{
+    static size_t cacheSize = utils::getConfigurationParameterSizeT("OPENCV_DFT_PLAN_CACHE_SIZE", 8);
+    return cacheSize;
+}
+
+static size_t getDFTPlanCacheLimit()
+{
+    static size_t cacheLimit = utils::getConfigurationParameterSizeT("OPENCV_DFT_PLAN_CACHE_LIMIT", (size_t)4 << 20);
+    return cacheLimit;
+}
+
+// approximate memory usage of hal::DFT2D context: tables (wave, itab, radix-4 twiddles) and row/column buffers
+static size_t estimateDFTContextSize( int width, int height, int depth )
+{
+    const size_t complexElemSize = (depth == CV_64F ? sizeof(double) : sizeof(float)) * 2;
+    return ((size_t)width + height) * (complexElemSize * 6 + sizeof(int));
+}
+
+// recently used hal::DFT2D contexts of the thread (dft() calls with the same size reuse tables and buffers)
+struct DFTPlanCache
+{
+    struct Entry
+    {
+        int width, height, depth, src_channels, dst_channels, flags, nonzero_rows;
+        Ptr<hal::DFT2D> context;
+        size_t bytes;
+    };
+    std::vector<Entry> entries;  // the most recently used entry is the last one
+    size_t totalBytes;
+
+    DFTPlanCache() : totalBytes(0) {}
+
+    Ptr<hal::DFT2D> get(int width, int height, int depth, int src_channels, int dst_channels,
+                        int flags, int nonzero_rows, size_t maxSize, size_t maxBytes)
+    {
+        for (size_t i = entries.size(); i > 0; i--)
+        {
+            Entry& e = entries[i - 1];
+            if (e.width == width && e.height == height && e.depth == depth && e.src_channels == src_channels &&
+                e.dst_channels == dst_channels && e.flags == flags && e.nonzero_rows == nonzero_rows)
+            {
+                if (i < entries.size())
+                    std::rotate(entries.begin() + (i - 1), entries.begin() + i, entries.end());
+                return entries.back().context;
+            }
+        }
+        Entry e = { width, height, depth, src_channels, dst_channels, flags, nonzero_rows,
+                    hal::DFT2D::create(width, height, depth, src_channels, dst_channels, flags, nonzero_rows),
+                    estimateDFTContextSize(width, height, depth) };
+        if (e.bytes > maxBytes)
+            return e.context;  // too large to be kept
+        size_t evict = 0;
+        while (evict < entries.size() && (entries.size() - evict >= maxSize || totalBytes + e.bytes > maxBytes))
+            totalBytes -= entries[evict++].bytes;
+        entries.erase(entries.begin(), entries.begin() + evict);
+        entries.push_back(e);
+        totalBytes += e.bytes;
+        return e.context;
+    }
+};
+
+static TLSData<DFTPlanCache>& getDFTPlanCacheTLS()
+{
+    CV_SINGLETON_LAZY_INIT_REF(TLSData<DFTPlanCache>, new TLSData<DFTPlanCache>())
+}
+
+} // cv::
+
 void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
 {
     CV_INSTRUMENT_REGION();
@@ -3498,37 +3676,17 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
                ocl_dft(_src0, _dst, flags, nonzero_rows))
 #endif
 
-    Mat src0 = _src0.getMat(), src = src0;
-    bool inv = (flags & DFT_INVERSE) != 0;
-    int type = src.type();
+    Mat src0 = _src0.getMat(), src = src0, dst;
+    int f = prepareDFT(src, _dst, flags, dst);
     int depth = src.depth();
 
-    CV_Assert( type == CV_32FC1 || type == CV_32FC2 || type == CV_64FC1 || type == CV_64FC2 );
-
-    // Fail if DFT_COMPLEX_INPUT is specified, but src is not 2 channels.
-    CV_Assert( !((flags & DFT_COMPLEX_INPUT) && src.channels() != 2) );
-
-    if( !inv && src.channels() == 1 && (flags & DFT_COMPLEX_OUTPUT) )
-        _dst.create( src.size(), CV_MAKETYPE(depth, 2) );
-    else if( inv && src.channels() == 2 && (flags & DFT_REAL_OUTPUT) )
-        _dst.create( src.size(), depth );
+    Ptr<hal::DFT2D> c;
+    size_t cacheSize = getDFTPlanCacheSize();
+    if (cacheSize > 0)
+        c = getDFTPlanCacheTLS().getRef().get(src.cols, src.rows, depth, src.channels(), dst.channels(), f, nonzero_rows,
+                                              cacheSize, getDFTPlanCacheLimit());
     else
-        _dst.create( src.size(), type );
-
-    Mat dst = _dst.getMat();
-
-    int f = 0;
-    if (src.isContinuous() && dst.isContinuous())
-        f |= CV_HAL_DFT_IS_CONTINUOUS;
-    if (inv)
-        f |= CV_HAL_DFT_INVERSE;
-    if (flags & DFT_ROWS)
-        f |= CV_HAL_DFT_ROWS;
-    if (flags & DFT_SCALE)
-        f |= CV_HAL_DFT_SCALE;
-    if (src.data == dst.data)
-        f |= CV_HAL_DFT_IS_INPLACE;
-    Ptr<hal::DFT2D> c = hal::DFT2D::create(src.cols, src.rows, depth, src.channels(), dst.channels(), f, nonzero_rows);
+        c = hal::DFT2D::create(src.cols, src.rows, depth, src.channels(), dst.channels(), f, nonzero_rows);
     c->apply(src.data, src.step, dst.data, dst.step);
 }
 
@@ -3540,6 +3698,68 @@ void cv::idft( InputArray src, OutputArray dst, int flags, int nonzero_rows )
     dft( src, dst, flags | DFT_INVERSE, nonzero_rows );
 }
 
+class cv::DFTPlan::Impl
+{
+public:
+    Impl(Size size_, int type_, int flags_, int nonzeroRows_)
+        : size(size_), type(type_), flags(flags_), nonzeroRows(nonzeroRows_) {}
+
+    Ptr<hal::DFT2D>& context(int f)
+    {
+        // contexts depend on the layout of matrices passed to apply()
+        return contexts[((f & CV_HAL_DFT_IS_CONTINUOUS) ? 1 : 0) + ((f & CV_HAL_DFT_IS_INPLACE) ? 2 : 0)];
+    }
+
+    Size size;
+    int type;
+    int flags;
+    int nonzeroRows;
+    Ptr<hal::DFT2D> contexts[4];
+};
+
+cv::DFTPlan::DFTPlan() {}
+
+cv::DFTPlan::DFTPlan(Size size, int type, int flags, int nonzeroRows)
+{
+    create(size, type, flags, nonzeroRows);
+}
+
+cv::DFTPlan::~DFTPlan() {}
+
+void cv::DFTPlan::create(Size size, int type, int flags, int nonzeroRows)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( size.width > 0 && size.height > 0 );
+    p = makePtr<Impl>(size, type, flags, nonzeroRows);
+
+    // tables and buffers for continuous non-inplace transform are prepared in advance
+    int dstType = getDFTDstType(type, flags);
+    int f = getHalDFTFlags(flags, true, false);
+    p->context(f) = hal::DFT2D::create(size.width, size.height, CV_MAT_DEPTH(type), CV_MAT_CN(type),
+                                       CV_MAT_CN(dstType), f, nonzeroRows);
+}
+
+void cv::DFTPlan::apply(InputArray _src, OutputArray _dst)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( !empty() );
+    Mat src = _src.getMat(), dst;
+    CV_Assert( src.size() == p->size && src.type() == p->type );
+
+    int f = prepareDFT(src, _dst, p->flags, dst);
+    Ptr<hal::DFT2D>& c = p->context(f);
+    if (!c)
+        c = hal::DFT2D::create(src.cols, src.rows, src.depth(), src.channels(), dst.channels(), f, p->nonzeroRows);
+    c->apply(src.data, src.step, dst.data, dst.step);
+}
+
+bool cv::DFTPlan::empty() const
+{
+    return !p;
+}
+
 #ifdef HAVE_OPENCL
 
 namespace cv {
@@ -4227,6 +4447,7 @@ public:
     int _factors[34];
     AutoBuffer<uint> wave_buf;
     AutoBuffer<int> itab_buf;
+    AutoBuffer<uchar> r4tw_buf;
 
     DCTFunc dct_func;
     bool isRowTransform;
@@ -4327,6 +4548,7 @@ public:
                 itab_buf.allocate(len);
                 opt.itab = itab_buf.data();
                 DFTInit( len, opt.nf, opt.factors, opt.itab, complex_elem_size, opt.wave, isInverse );
+                initR4Twiddles(opt, depth, r4tw_buf);
 
                 dct_wave.allocate((len/2 + 1)*complex_elem_size);
                 src_buf.allocate(len*elem_size);
@@ -0,0 +1,145 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "precomp.hpp"
+
+namespace cv {
+
+CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
+
+// Radix-4 passes of the mixed-radix complex DFT (see DFT() in dxt.cpp).
+// Twiddle factors of the pass with nx butterflies per block start at offset 2*(nx-1):
+// re(w^j), im(w^j), re(w^2j), im(w^2j), re(w^3j), im(w^3j), j = 0..nx-1 (each of them is nx values).
+// Returns the transform length processed by radix-4 passes, dw0 is updated like in the generic code.
+int DFT_R4_32f(Complexf* dst, int N, int n0, int& dw0, const float* twiddles);
+int DFT_R4_64f(Complexd* dst, int N, int n0, int& dw0, const double* twiddles);
+
+#ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+template<typename T> static inline
+void DFT_R4_butterfly(Complex<T>* v0, int nx, const T* tw, int j)
+{
+    Complex<T>* v1 = v0 + nx*2;
+    const T w1r = tw[j], w1i = tw[nx + j];
+    const T w2r = tw[nx*2 + j], w2i = tw[nx*3 + j];
+    const T w3r = tw[nx*4 + j], w3i = tw[nx*5 + j];
+
+    T r2 = v0[nx].re*w2r - v0[nx].im*w2i;
+    T i2 = v0[nx].re*w2i + v0[nx].im*w2r;
+    T r0 = v1[0].re*w1i + v1[0].im*w1r;
+    T i0 = v1[0].re*w1r - v1[0].im*w1i;
+    T r3 = v1[nx].re*w3i + v1[nx].im*w3r;
+    T i3 = v1[nx].re*w3r - v1[nx].im*w3i;
+
+    T r1 = i0 + i3, i1 = r0 + r3;
+    r3 = r0 - r3; i3 = i3 - i0;
+    T r4 = v0[0].re, i4 = v0[0].im;
+
+    r0 = r4 + r2; i0 = i4 + i2;
+    r2 = r4 - r2; i2 = i4 - i2;
+
+    v0[0].re = r0 + r1; v0[0].im = i0 + i1;
+    v1[0].re = r0 - r1; v1[0].im = i0 - i1;
+    v0[nx].re = r2 + r3; v0[nx].im = i2 + i3;
+    v1[nx].re = r2 - r3; v1[nx].im = i2 - i3;
+}
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+// the same as DFT_R4_butterfly() for VTraits<V>::vlanes() consecutive butterflies
+template<typename T, typename V> static inline
+void DFT_R4_butterfly_simd(T* v0, int nx, const T* tw, int j)
+{
+    V ar, ai, br, bi, cr, ci, dr, di;
+    v_load_deinterleave(v0, ar, ai);
+    v_load_deinterleave(v0 + nx*2, br, bi);
+    v_load_deinterleave(v0 + nx*4, cr, ci);
+    v_load_deinterleave(v0 + nx*6, dr, di);
+    V w1r = vx_load(tw + j), w1i = vx_load(tw + nx + j);
+    V w2r = vx_load(tw + nx*2 + j), w2i = vx_load(tw + nx*3 + j);
+    V w3r = vx_load(tw + nx*4 + j), w3i = vx_load(tw + nx*5 + j);
+
+    V r2 = v_sub(v_mul(br, w2r), v_mul(bi, w2i));
+    V i2 = v_add(v_mul(br, w2i), v_mul(bi, w2r));
+    V r0 = v_add(v_mul(cr, w1i), v_mul(ci, w1r));
+    V i0 = v_sub(v_mul(cr, w1r), v_mul(ci, w1i));
+    V r3 = v_add(v_mul(dr, w3i), v_mul(di, w3r));
+    V i3 = v_sub(v_mul(dr, w3r), v_mul(di, w3i));
+
+    V r1 = v_add(i0, i3), i1 = v_add(r0, r3);
+    r3 = v_sub(r0, r3); i3 = v_sub(i3, i0);
+
+    r0 = v_add(ar, r2); i0 = v_add(ai, i2);
+    r2 = v_sub(ar, r2); i2 = v_sub(ai, i2);
+
+    v_store_interleave(v0, v_add(r0, r1), v_add(i0, i1));
+    v_store_interleave(v0 + nx*4, v_sub(r0, r1), v_sub(i0, i1));
+    v_store_interleave(v0 + nx*2, v_add(r2, r3), v_add(i2, i3));
+    v_store_interleave(v0 + nx*6, v_sub(r2, r3), v_sub(i2, i3));
+}
+#endif
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+// processes the leading butterflies of the block with SIMD, returns the number of processed butterflies
+template<typename T, typename V> static inline
+int DFT_R4_block_simd(Complex<T>* v0, int nx, const T* tw)
+{
+    const int vlanes = VTraits<V>::vlanes();
+    int j = 0;
+    for( ; j <= nx - vlanes; j += vlanes )
+        DFT_R4_butterfly_simd<T, V>((T*)(v0 + j), nx, tw, j);
+    return j;
+}
+#endif
+
+template<typename T> static inline
+int DFT_R4_block_scalar(Complex<T>*, int, const T*)
+{
+    return 0;
+}
+
+template<typename T, int (*processBlockSIMD)(Complex<T>*, int, const T*)> static
+int DFT_R4_(Complex<T>* dst, int N, int n0, int& _dw0, const T* twiddles)
+{
+    int n = 1, dw0 = _dw0;
+    for( ; n*4 <= N; )
+    {
+        const int nx = n;
+        n *= 4;
+        dw0 /= 4;
+        const T* tw = twiddles + 2*(nx - 1);
+
+        for( int i = 0; i < n0; i += n )
+        {
+            int j = processBlockSIMD(dst + i, nx, tw);
+            for( ; j < nx; j++ )
+                DFT_R4_butterfly(dst + i + j, nx, tw, j);
+        }
+    }
+    _dw0 = dw0;
+    return n;
+}
+
+int DFT_R4_32f(Complexf* dst, int N, int n0, int& dw0, const float* twiddles)
+{
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    return DFT_R4_<float, DFT_R4_block_simd<float, v_float32> >(dst, N, n0, dw0, twiddles);
+#else
+    return DFT_R4_<float, DFT_R4_block_scalar<float> >(dst, N, n0, dw0, twiddles);
+#endif
+}
+
+int DFT_R4_64f(Complexd* dst, int N, int n0, int& dw0, const double* twiddles)
+{
+#if (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+    return DFT_R4_<double, DFT_R4_block_simd<double, v_float64> >(dst, N, n0, dw0, twiddles);
+#else
+    // no SIMD for doubles, v_float64 is not available
+    return DFT_R4_<double, DFT_R4_block_scalar<double> >(dst, N, n0, dw0, twiddles);
+#endif
+}
+
+#endif // CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+CV_CPU_OPTIMIZATION_NAMESPACE_END
+} // namespace
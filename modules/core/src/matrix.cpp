@@ -4,6 +4,7 @@
 
 #include "precomp.hpp"
 #include "bufferpool.impl.hpp"
+#include "numa.hpp"
 
 namespace cv {
 
@@ -145,6 +146,8 @@ public:
             total *= sizes[i];
         }
         uchar* data = data0 ? (uchar*)data0 : (uchar*)fastMalloc(total);
+        if (!data0 && numa::isFirstTouchRequired(total))
+            numa::firstTouch(data, total, dims > 0 ? sizes[0] : 1, dims > 0 && sizes[0] > 0 ? total / sizes[0] : total);
         UMatData* u = new UMatData(this);
         u->data = u->origdata = data;
         u->size = total;
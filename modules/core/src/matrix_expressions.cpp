@@ -10,7 +10,11 @@
 // */
 
 #include "precomp.hpp"
+#include <opencv2/core/utils/configuration.private.hpp>
 #include <opencv2/core/utils/logger.hpp>
+#include "matrix_expressions_fused.hpp"
+
+#include <map>
 
 namespace cv
 {
@@ -200,6 +204,40 @@ static MatOp_Initializer* getGlobalMatOpInitializer()
     CV_SINGLETON_LAZY_INIT(MatOp_Initializer, new MatOp_Initializer())
 }
 
+/** Chain of element-wise operations evaluated in a single pass (see matrix_expressions_fused.hpp)
+ *
+ * Generic MatOp implementations evaluate element-wise sub-expressions into temporary matrices.
+ * Instead, large enough AddEx, Bin (arithmetic) and Fused sub-expressions are merged into a program,
+ * which emulates the temporary matrices (including saturation of intermediate values).
+ * MatOp_Fused objects are shared between expressions with the same program,
+ * operands are stored in MatExpr::a, b, c and constants in MatExpr::alpha, beta, s.
+ */
+class MatOp_Fused CV_FINAL : public MatOp
+{
+public:
+    MatOp_Fused(const std::vector<fused::Instr>& code);
+    virtual ~MatOp_Fused() {}
+
+    bool elementWise(const MatExpr& /*expr*/) const CV_OVERRIDE { return true; }
+    void assign(const MatExpr& expr, Mat& m, int type=-1) const CV_OVERRIDE;
+    void multiply(const MatExpr& e1, double s, MatExpr& res) const CV_OVERRIDE;
+    int type(const MatExpr& expr) const CV_OVERRIDE;
+
+    static void makeAddEx(MatExpr& res, const Mat& a, const MatExpr* ea, const Mat& b, const MatExpr* eb,
+                          double alpha, double beta, const Scalar& s=Scalar());
+    static void makeBin(MatExpr& res, char op, const Mat& a, const MatExpr* ea, const Mat& b, const MatExpr* eb,
+                        double scale=1);
+    static void makeBin(MatExpr& res, char op, const Mat& a, const MatExpr* ea, const Scalar& s);
+    static void makeCmp(MatExpr& res, int cmpop, const Mat& a, const MatExpr* ea, const Mat& b, const MatExpr* eb);
+    static void makeCmp(MatExpr& res, int cmpop, const Mat& a, const MatExpr* ea, double alpha);
+
+    static const MatOp_Fused* getOp(const std::vector<fused::Instr>& code);
+
+    std::vector<fused::Instr> code;
+    int stackSize;
+    bool mask;  //!< result of comparison
+};
+
 static inline bool isIdentity(const MatExpr& e) { return e.op == &g_MatOp_Identity; }
 static inline bool isAddEx(const MatExpr& e) { return e.op == &g_MatOp_AddEx; }
 static inline bool isScaled(const MatExpr& e) { return isAddEx(e) && (!e.b.data || e.beta == 0) && e.s == Scalar(); }
@@ -212,6 +250,320 @@ static inline bool isSolve(const MatExpr& e) { return e.op == &g_MatOp_Solve; }
 //static inline bool isGEMM(const MatExpr& e) { return e.op == &g_MatOp_GEMM; }
 static inline bool isMatProd(const MatExpr& e) { return e.op == &g_MatOp_GEMM && (!e.c.data || e.beta == 0); }
 static inline bool isInitializer(const MatExpr& e) { return e.op == getGlobalMatOpInitializer(); }
+static inline bool isFused(const MatExpr& e) { return dynamic_cast<const MatOp_Fused*>(e.op) != NULL; }
+static inline bool isArithmBin(const MatExpr& e)
+{
+    return e.op == &g_MatOp_Bin && (e.flags == '*' || e.flags == '/' || e.flags == 'm' || e.flags == 'M' ||
+                                    e.flags == 'n' || e.flags == 'N' || e.flags == 'a');
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static size_t getFusionThreshold()
+{
+    static size_t threshold = utils::getConfigurationParameterSizeT("OPENCV_MATEXPR_FUSION_THRESHOLD", 4096);
+    return threshold;
+}
+
+// element-wise sub-expression, which can be merged into MatOp_Fused program instead of evaluation into temporary matrix
+static bool isFusable(const MatExpr& e)
+{
+    if( !isAddEx(e) && !isArithmBin(e) && !(isFused(e) && !static_cast<const MatOp_Fused*>(e.op)->mask) )
+        return false;
+    return e.a.dims <= 2 && e.a.channels() <= 4 && fused::isSupportedDepth(e.a.depth()) &&
+           e.a.total() >= getFusionThreshold();
+}
+
+// replacement of `e.op->assign(e, m)` in generic MatOp implementations
+static void deferAssign(const MatExpr& e, Mat& m, const MatExpr*& deferred)
+{
+    if( isFusable(e) )
+        deferred = &e;
+    else
+        e.op->assign(e, m);
+}
+
+/** Builds MatOp_Fused program from operands and semantic of AddEx, Bin and Cmp expressions
+ *
+ * Methods return false if the expression can't be fused (types or sizes of operands are different
+ * or not floating-point, limits of MatExpr fields are exceeded).
+ */
+class FusedExprBuilder
+{
+public:
+    FusedExprBuilder() : nsrc(0), nconsts(0), sp(0), mask(false)
+    {
+        for( int i = 0; i < fused::MAX_CONSTS; i++ )
+            consts[i] = 0;
+    }
+
+    bool push(const Mat& m, const MatExpr* e)
+    {
+        if( e )
+            return pushExpr(*e);
+        return !m.data || pushMat(m);
+    }
+
+    bool pushMat(const Mat& m)
+    {
+        if( m.dims > 2 || m.channels() > 4 || !fused::isSupportedDepth(m.depth()) )
+            return false;
+        int i = 0;
+        for( ; i < nsrc; i++ )
+        {
+            if( src[i].data == m.data && src[i].step[0] == m.step[0] && src[i].size == m.size && src[i].type() == m.type() )
+                break;
+        }
+        if( i == nsrc )
+        {
+            if( nsrc == fused::MAX_OPERANDS || (nsrc > 0 && (src[0].type() != m.type() || src[0].size != m.size)) )
+                return false;
+            src[nsrc++] = m;
+        }
+        return emit(fused::OP_LOAD, i);
+    }
+
+    bool pushExpr(const MatExpr& e)
+    {
+        if( isIdentity(e) )
+            return pushMat(e.a);
+        if( isAddEx(e) )
+            return pushMat(e.a) && push(e.b, 0) && addEx(e.b.data != 0, e.alpha, e.beta, e.s);
+        if( isArithmBin(e) )
+            return pushMat(e.a) && push(e.b, 0) && bin((char)e.flags, e.b.data != 0, e.alpha, e.s);
+        if( !isFused(e) )
+            return false;
+
+        const std::vector<fused::Instr>& code_ = static_cast<const MatOp_Fused*>(e.op)->code;
+        const Mat* esrc[] = { &e.a, &e.b, &e.c };
+        const double econsts[] = { e.alpha, e.beta, e.s[0], e.s[1], e.s[2], e.s[3] };
+        for( size_t i = 0; i < code_.size(); i++ )
+        {
+            const fused::Instr& instr = code_[i];
+            int k = 0;
+            if( instr.opcode == fused::OP_LOAD )
+            {
+                if( !pushMat(*esrc[instr.arg]) )
+                    return false;
+            }
+            else if( (instr.nk > 0 && !addConsts(econsts + instr.k, instr.nk, k)) ||
+                     !emit(instr.opcode, instr.arg, k, instr.nk) )
+                return false;
+        }
+        return true;
+    }
+
+    // MatOp_AddEx::assign()
+    bool addEx(bool hasB, double alpha, double beta, const Scalar& s)
+    {
+        bool ok = true;
+        if( hasB )
+        {
+            if( alpha == 1 && beta == 1 )
+                ok = emit(fused::OP_ADD);
+            else if( alpha == 1 && beta == -1 )
+                ok = emit(fused::OP_SUB);
+            else if( alpha == -1 && beta == 1 )
+                ok = emit(fused::OP_RSUB);
+            else
+            {
+                const double w[] = { alpha, beta };
+                int k = 0;
+                ok = addConsts(w, 2, k) && emit(fused::OP_ADDW, 0, k, 2);
+            }
+            if( s.isReal() )  // addWeighted()
+                return ok && (s[0] == 0 || emitC(fused::OP_ADDC, s[0]));
+        }
+        else if( s.isReal() && (fabs(alpha) != 1 || (!code.empty() && code.back().opcode == fused::OP_MULC)) )
+        {
+            // convertTo(), the scaled operand is MatOp_AddEx expression in the non-fused evaluation,
+            // so the added scalar is merged into it
+            ok = alpha == 1 || (alpha == -1 ? emit(fused::OP_NEG) : emitC(fused::OP_MULC, alpha));
+            return ok && (s[0] == 0 || emitC(fused::OP_ADDC, s[0]));
+        }
+        else if( alpha == -1 )
+            ok = emit(fused::OP_NEG);
+        else if( alpha != 1 )
+            ok = emitC(fused::OP_MULC, alpha);
+        return ok && addPerChannel(s);
+    }
+
+    // MatOp_Bin::assign()
+    bool bin(char op, bool hasB, double alpha, const Scalar& s)
+    {
+        bool ok = false;
+        switch( op )
+        {
+        case '*': ok = hasB && (alpha == 1 ? emit(fused::OP_MUL) : emitC(fused::OP_MUL, alpha)); break;
+        case '/':
+            if( hasB )
+                ok = alpha == 1 ? emit(fused::OP_DIV) : emitC(fused::OP_DIV, alpha);
+            else
+                ok = emitC(fused::OP_RDIVC, alpha);
+            break;
+        case 'm': ok = hasB && emit(fused::OP_MIN); break;
+        case 'M': ok = hasB && emit(fused::OP_MAX); break;
+        case 'n': ok = !hasB && emitC(fused::OP_MINC, scalarToDepth(s[0])); break;
+        case 'N': ok = !hasB && emitC(fused::OP_MAXC, scalarToDepth(s[0])); break;
+        case 'a': ok = hasB ? emit(fused::OP_ABSDIFF) : addPerChannel(-s) && emit(fused::OP_ABS); break;
+        default: break;
+        }
+        return ok;
+    }
+
+    // MatOp_Cmp::assign()
+    bool cmp(int cmpop, bool hasB, double alpha)
+    {
+        return hasB ? emit(fused::OP_CMP, cmpop) : emitC(fused::OP_CMPC, alpha, cmpop);
+    }
+
+    // MatOp_AddEx::multiply() and MatOp_Bin::multiply(): the scale is merged into the last expression
+    // instead of the extra instruction, returns false if the last expression can't be scaled
+    bool scale(double s)
+    {
+        size_t n = code.size();
+        fused::Instr* addc = 0;
+        if( n > 1 && code[n - 1].opcode == fused::OP_ADDC && code[n - 1].nk == 1 )
+            addc = &code[--n];
+        if( n == 0 )
+            return false;
+
+        fused::Instr& instr = code[n - 1];
+        int k = 0;
+        switch( instr.opcode )
+        {
+        case fused::OP_ADD: case fused::OP_SUB: case fused::OP_RSUB: case fused::OP_ADDW:
+        {
+            double w[] = { instr.opcode == fused::OP_RSUB ? -s : s, instr.opcode == fused::OP_SUB ? -s : s };
+            if( instr.opcode == fused::OP_ADDW )
+            {
+                w[0] = consts[instr.k]*s;
+                w[1] = consts[instr.k + 1]*s;
+            }
+            if( !addConsts(w, 2, k) )
+                return false;
+            instr.opcode = fused::OP_ADDW;
+            instr.nk = 2;
+            break;
+        }
+        case fused::OP_MULC:
+        case fused::OP_MUL: case fused::OP_DIV: case fused::OP_RDIVC:
+        {
+            if( addc && instr.opcode != fused::OP_MULC )
+                return false;
+            const double v = (instr.nk == 1 ? consts[instr.k] : 1.)*s;
+            if( !addConsts(&v, 1, k) )
+                return false;
+            instr.nk = 1;
+            break;
+        }
+        default:
+            return false;
+        }
+        instr.k = (uchar)k;
+
+        if( addc )
+        {
+            const double v = consts[addc->k]*s;
+            if( !addConsts(&v, 1, k) )
+                return false;
+            addc->k = (uchar)k;
+        }
+        return true;
+    }
+
+    bool makeExpr(MatExpr& res) const
+    {
+        if( sp != 1 )
+            return false;
+        const MatOp_Fused* op = MatOp_Fused::getOp(code);
+        if( !op )
+            return false;
+        res = MatExpr(op, 0, src[0], src[1], src[2], consts[0], consts[1],
+                      Scalar(consts[2], consts[3], consts[4], consts[5]));
+        return true;
+    }
+
+protected:
+    bool emit(int opcode, int arg = 0, int k = 0, int nk = 0)
+    {
+        if( mask || code.size() >= 64 )
+            return false;
+        if( opcode == fused::OP_LOAD )
+        {
+            if( sp == fused::MAX_STACK )
+                return false;
+            sp++;
+        }
+        else if( opcode < fused::OP_ADDC )  // binary
+        {
+            if( sp < 2 )
+                return false;
+            sp--;
+        }
+        else if( sp < 1 )
+            return false;
+        mask = opcode == fused::OP_CMP || opcode == fused::OP_CMPC;
+        fused::Instr instr = { (uchar)opcode, (uchar)arg, (uchar)k, (uchar)nk };
+        code.push_back(instr);
+        return true;
+    }
+
+    bool emitC(int opcode, double value, int arg = 0)
+    {
+        int k = 0;
+        return addConsts(&value, 1, k) && emit(opcode, arg, k, 1);
+    }
+
+    // scalar argument of min() / max()
+    double scalarToDepth(double v) const
+    {
+        return src[0].depth() == CV_32F ? (double)saturate_cast<float>(v) : v;
+    }
+
+    // cv::add(x, s)
+    bool addPerChannel(const Scalar& s)
+    {
+        const int cn = src[0].channels();
+        double v[4];
+        bool uniform = true;
+        for( int i = 0; i < cn; i++ )
+        {
+            v[i] = s[i];
+            uniform = uniform && v[i] == v[0];
+        }
+        if( uniform )
+            return v[0] == 0 || emitC(fused::OP_ADDC, v[0]);
+        int k = 0;
+        return addConsts(v, cn, k) && emit(fused::OP_ADDC, 0, k, cn);
+    }
+
+    bool addConsts(const double* v, int n, int& k)
+    {
+        for( k = 0; k + n <= nconsts; k++ )
+        {
+            int i = 0;
+            while( i < n && consts[k + i] == v[i] )
+                i++;
+            if( i == n )
+                return true;
+        }
+        if( nconsts + n > fused::MAX_CONSTS )
+            return false;
+        k = nconsts;
+        for( int i = 0; i < n; i++ )
+            consts[nconsts++] = v[i];
+        return true;
+    }
+
+    std::vector<fused::Instr> code;
+    Mat src[fused::MAX_OPERANDS];
+    int nsrc;
+    double consts[fused::MAX_CONSTS];
+    int nconsts;
+    int sp;
+    bool mask;
+};
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -332,6 +684,7 @@ void MatOp::add(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
         double alpha = 1, beta = 1;
         Scalar s;
         Mat m1, m2;
+        const MatExpr *d1 = 0, *d2 = 0;
         if( isAddEx(e1) && (!e1.b.data || e1.beta == 0) )
         {
             m1 = e1.a;
@@ -339,7 +692,7 @@ void MatOp::add(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
             s = e1.s;
         }
         else
-            e1.op->assign(e1, m1);
+            deferAssign(e1, m1, d1);
 
         if( isAddEx(e2) && (!e2.b.data || e2.beta == 0) )
         {
@@ -348,8 +701,8 @@ void MatOp::add(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
             s += e2.s;
         }
         else
-            e2.op->assign(e2, m2);
-        MatOp_AddEx::makeExpr(res, m1, m2, alpha, beta, s);
+            deferAssign(e2, m2, d2);
+        MatOp_Fused::makeAddEx(res, m1, d1, m2, d2, alpha, beta, s);
     }
     else
         e2.op->add(e1, e2, res);
@@ -361,8 +714,9 @@ void MatOp::add(const MatExpr& expr1, const Scalar& s, MatExpr& res) const
     CV_INSTRUMENT_REGION();
 
     Mat m1;
-    expr1.op->assign(expr1, m1);
-    MatOp_AddEx::makeExpr(res, m1, Mat(), 1, 0, s);
+    const MatExpr* d1 = 0;
+    deferAssign(expr1, m1, d1);
+    MatOp_Fused::makeAddEx(res, m1, d1, Mat(), 0, 1, 0, s);
 }
 
 
@@ -375,6 +729,7 @@ void MatOp::subtract(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
         double alpha = 1, beta = -1;
         Scalar s;
         Mat m1, m2;
+        const MatExpr *d1 = 0, *d2 = 0;
         if( isAddEx(e1) && (!e1.b.data || e1.beta == 0) )
         {
             m1 = e1.a;
@@ -382,7 +737,7 @@ void MatOp::subtract(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
             s = e1.s;
         }
         else
-            e1.op->assign(e1, m1);
+            deferAssign(e1, m1, d1);
 
         if( isAddEx(e2) && (!e2.b.data || e2.beta == 0) )
         {
@@ -391,8 +746,8 @@ void MatOp::subtract(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
             s -= e2.s;
         }
         else
-            e2.op->assign(e2, m2);
-        MatOp_AddEx::makeExpr(res, m1, m2, alpha, beta, s);
+            deferAssign(e2, m2, d2);
+        MatOp_Fused::makeAddEx(res, m1, d1, m2, d2, alpha, beta, s);
     }
     else
         e2.op->subtract(e1, e2, res);
@@ -404,8 +759,9 @@ void MatOp::subtract(const Scalar& s, const MatExpr& expr, MatExpr& res) const
     CV_INSTRUMENT_REGION();
 
     Mat m;
-    expr.op->assign(expr, m);
-    MatOp_AddEx::makeExpr(res, m, Mat(), -1, 0, s);
+    const MatExpr* d = 0;
+    deferAssign(expr, m, d);
+    MatOp_Fused::makeAddEx(res, m, d, Mat(), 0, -1, 0, s);
 }
 
 
@@ -416,6 +772,7 @@ void MatOp::multiply(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double
     if( this == e2.op )
     {
         Mat m1, m2;
+        const MatExpr *d1 = 0, *d2 = 0;
 
         if( isReciprocal(e1) )
         {
@@ -425,9 +782,9 @@ void MatOp::multiply(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double
                 m2 = e2.a;
             }
             else
-                e2.op->assign(e2, m2);
+                deferAssign(e2, m2, d2);
 
-            MatOp_Bin::makeExpr(res, '/', m2, e1.a, scale/e1.alpha);
+            MatOp_Fused::makeBin(res, '/', m2, d2, e1.a, 0, scale/e1.alpha);
         }
         else
         {
@@ -438,7 +795,7 @@ void MatOp::multiply(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double
                 scale *= e1.alpha;
             }
             else
-                e1.op->assign(e1, m1);
+                deferAssign(e1, m1, d1);
 
             if( isScaled(e2) )
             {
@@ -452,9 +809,9 @@ void MatOp::multiply(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double
                 scale *= e2.alpha;
             }
             else
-                e2.op->assign(e2, m2);
+                deferAssign(e2, m2, d2);
 
-            MatOp_Bin::makeExpr(res, op, m1, m2, scale);
+            MatOp_Fused::makeBin(res, op, m1, d1, m2, d2, scale);
         }
     }
     else
@@ -467,8 +824,9 @@ void MatOp::multiply(const MatExpr& expr, double s, MatExpr& res) const
     CV_INSTRUMENT_REGION();
 
     Mat m;
-    expr.op->assign(expr, m);
-    MatOp_AddEx::makeExpr(res, m, Mat(), s, 0);
+    const MatExpr* d = 0;
+    deferAssign(expr, m, d);
+    MatOp_Fused::makeAddEx(res, m, d, Mat(), 0, s, 0);
 }
 
 
@@ -483,6 +841,7 @@ void MatOp::divide(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double sc
         else
         {
             Mat m1, m2;
+            const MatExpr *d1 = 0, *d2 = 0;
             char op = '/';
 
             if( isScaled(e1) )
@@ -491,7 +850,7 @@ void MatOp::divide(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double sc
                 scale *= e1.alpha;
             }
             else
-                e1.op->assign(e1, m1);
+                deferAssign(e1, m1, d1);
 
             if( isScaled(e2) )
             {
@@ -505,8 +864,8 @@ void MatOp::divide(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double sc
                 op = '*';
             }
             else
-                e2.op->assign(e2, m2);
-            MatOp_Bin::makeExpr(res, op, m1, m2, scale);
+                deferAssign(e2, m2, d2);
+            MatOp_Fused::makeBin(res, op, m1, d1, m2, d2, scale);
         }
     }
     else
@@ -519,8 +878,9 @@ void MatOp::divide(double s, const MatExpr& expr, MatExpr& res) const
     CV_INSTRUMENT_REGION();
 
     Mat m;
-    expr.op->assign(expr, m);
-    MatOp_Bin::makeExpr(res, '/', m, Mat(), s);
+    const MatExpr* d = 0;
+    deferAssign(expr, m, d);
+    MatOp_Fused::makeBin(res, '/', m, d, Mat(), 0, s);
 }
 
 
@@ -529,8 +889,9 @@ void MatOp::abs(const MatExpr& expr, MatExpr& res) const
     CV_INSTRUMENT_REGION();
 
     Mat m;
-    expr.op->assign(expr, m);
-    MatOp_Bin::makeExpr(res, 'a', m, Mat());
+    const MatExpr* d = 0;
+    deferAssign(expr, m, d);
+    MatOp_Fused::makeBin(res, 'a', m, d, Mat(), 0);
 }
 
 
@@ -1086,6 +1447,246 @@ MatExpr operator > (double s, const Mat& a)
     return e;
 }
 
+// comparison of element-wise expressions (see MatOp_Fused)
+static void makeCmpExpr(MatExpr& res, int cmpop, const MatExpr& e1, const MatExpr& e2)
+{
+    Mat m1, m2;
+    const MatExpr *d1 = 0, *d2 = 0;
+    deferAssign(e1, m1, d1);
+    deferAssign(e2, m2, d2);
+    MatOp_Fused::makeCmp(res, cmpop, m1, d1, m2, d2);
+}
+
+static void makeCmpExpr(MatExpr& res, int cmpop, const MatExpr& e, double s)
+{
+    Mat m;
+    const MatExpr* d = 0;
+    deferAssign(e, m, d);
+    MatOp_Fused::makeCmp(res, cmpop, m, d, s);
+}
+
+MatExpr operator < (const MatExpr& e, const Mat& m)
+{
+    checkOperandsExist(m);
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_LT, e, MatExpr(m));
+    return en;
+}
+
+MatExpr operator < (const Mat& m, const MatExpr& e)
+{
+    checkOperandsExist(m);
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_LT, MatExpr(m), e);
+    return en;
+}
+
+MatExpr operator < (const MatExpr& e, double s)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_LT, e, s);
+    return en;
+}
+
+MatExpr operator < (double s, const MatExpr& e)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_GT, e, s);
+    return en;
+}
+
+MatExpr operator < (const MatExpr& e1, const MatExpr& e2)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_LT, e1, e2);
+    return en;
+}
+
+MatExpr operator <= (const MatExpr& e, const Mat& m)
+{
+    checkOperandsExist(m);
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_LE, e, MatExpr(m));
+    return en;
+}
+
+MatExpr operator <= (const Mat& m, const MatExpr& e)
+{
+    checkOperandsExist(m);
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_LE, MatExpr(m), e);
+    return en;
+}
+
+MatExpr operator <= (const MatExpr& e, double s)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_LE, e, s);
+    return en;
+}
+
+MatExpr operator <= (double s, const MatExpr& e)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_GE, e, s);
+    return en;
+}
+
+MatExpr operator <= (const MatExpr& e1, const MatExpr& e2)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_LE, e1, e2);
+    return en;
+}
+
+MatExpr operator == (const MatExpr& e, const Mat& m)
+{
+    checkOperandsExist(m);
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_EQ, e, MatExpr(m));
+    return en;
+}
+
+MatExpr operator == (const Mat& m, const MatExpr& e)
+{
+    checkOperandsExist(m);
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_EQ, MatExpr(m), e);
+    return en;
+}
+
+MatExpr operator == (const MatExpr& e, double s)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_EQ, e, s);
+    return en;
+}
+
+MatExpr operator == (double s, const MatExpr& e)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_EQ, e, s);
+    return en;
+}
+
+MatExpr operator == (const MatExpr& e1, const MatExpr& e2)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_EQ, e1, e2);
+    return en;
+}
+
+MatExpr operator != (const MatExpr& e, const Mat& m)
+{
+    checkOperandsExist(m);
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_NE, e, MatExpr(m));
+    return en;
+}
+
+MatExpr operator != (const Mat& m, const MatExpr& e)
+{
+    checkOperandsExist(m);
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_NE, MatExpr(m), e);
+    return en;
+}
+
+MatExpr operator != (const MatExpr& e, double s)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_NE, e, s);
+    return en;
+}
+
+MatExpr operator != (double s, const MatExpr& e)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_NE, e, s);
+    return en;
+}
+
+MatExpr operator != (const MatExpr& e1, const MatExpr& e2)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_NE, e1, e2);
+    return en;
+}
+
+MatExpr operator >= (const MatExpr& e, const Mat& m)
+{
+    checkOperandsExist(m);
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_GE, e, MatExpr(m));
+    return en;
+}
+
+MatExpr operator >= (const Mat& m, const MatExpr& e)
+{
+    checkOperandsExist(m);
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_GE, MatExpr(m), e);
+    return en;
+}
+
+MatExpr operator >= (const MatExpr& e, double s)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_GE, e, s);
+    return en;
+}
+
+MatExpr operator >= (double s, const MatExpr& e)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_LE, e, s);
+    return en;
+}
+
+MatExpr operator >= (const MatExpr& e1, const MatExpr& e2)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_GE, e1, e2);
+    return en;
+}
+
+MatExpr operator > (const MatExpr& e, const Mat& m)
+{
+    checkOperandsExist(m);
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_GT, e, MatExpr(m));
+    return en;
+}
+
+MatExpr operator > (const Mat& m, const MatExpr& e)
+{
+    checkOperandsExist(m);
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_GT, MatExpr(m), e);
+    return en;
+}
+
+MatExpr operator > (const MatExpr& e, double s)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_GT, e, s);
+    return en;
+}
+
+MatExpr operator > (double s, const MatExpr& e)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_LT, e, s);
+    return en;
+}
+
+MatExpr operator > (const MatExpr& e1, const MatExpr& e2)
+{
+    MatExpr en;
+    makeCmpExpr(en, CV_CMP_GT, e1, e2);
+    return en;
+}
+
 MatExpr min(const Mat& a, const Mat& b)
 {
     CV_INSTRUMENT_REGION();
@@ -1146,6 +1747,118 @@ MatExpr max(double s, const Mat& a)
     return e;
 }
 
+// min() / max() of element-wise expressions (see MatOp_Fused)
+static void makeMinMaxExpr(MatExpr& res, char op, const MatExpr& e1, const MatExpr& e2)
+{
+    Mat m1, m2;
+    const MatExpr *d1 = 0, *d2 = 0;
+    deferAssign(e1, m1, d1);
+    deferAssign(e2, m2, d2);
+    MatOp_Fused::makeBin(res, op, m1, d1, m2, d2);
+}
+
+static void makeMinMaxExpr(MatExpr& res, char op, const MatExpr& e, double s)
+{
+    Mat m;
+    const MatExpr* d = 0;
+    deferAssign(e, m, d);
+    MatOp_Fused::makeBin(res, op, m, d, Scalar(s));
+}
+
+MatExpr min(const MatExpr& e, const Mat& m)
+{
+    CV_INSTRUMENT_REGION();
+
+    checkOperandsExist(m);
+    MatExpr en;
+    makeMinMaxExpr(en, 'm', e, MatExpr(m));
+    return en;
+}
+
+MatExpr min(const Mat& m, const MatExpr& e)
+{
+    CV_INSTRUMENT_REGION();
+
+    checkOperandsExist(m);
+    MatExpr en;
+    makeMinMaxExpr(en, 'm', MatExpr(m), e);
+    return en;
+}
+
+MatExpr min(const MatExpr& e, double s)
+{
+    CV_INSTRUMENT_REGION();
+
+    MatExpr en;
+    makeMinMaxExpr(en, 'n', e, s);
+    return en;
+}
+
+MatExpr min(double s, const MatExpr& e)
+{
+    CV_INSTRUMENT_REGION();
+
+    MatExpr en;
+    makeMinMaxExpr(en, 'n', e, s);
+    return en;
+}
+
+MatExpr min(const MatExpr& e1, const MatExpr& e2)
+{
+    CV_INSTRUMENT_REGION();
+
+    MatExpr en;
+    makeMinMaxExpr(en, 'm', e1, e2);
+    return en;
+}
+
+MatExpr max(const MatExpr& e, const Mat& m)
+{
+    CV_INSTRUMENT_REGION();
+
+    checkOperandsExist(m);
+    MatExpr en;
+    makeMinMaxExpr(en, 'M', e, MatExpr(m));
+    return en;
+}
+
+MatExpr max(const Mat& m, const MatExpr& e)
+{
+    CV_INSTRUMENT_REGION();
+
+    checkOperandsExist(m);
+    MatExpr en;
+    makeMinMaxExpr(en, 'M', MatExpr(m), e);
+    return en;
+}
+
+MatExpr max(const MatExpr& e, double s)
+{
+    CV_INSTRUMENT_REGION();
+
+    MatExpr en;
+    makeMinMaxExpr(en, 'N', e, s);
+    return en;
+}
+
+MatExpr max(double s, const MatExpr& e)
+{
+    CV_INSTRUMENT_REGION();
+
+    MatExpr en;
+    makeMinMaxExpr(en, 'N', e, s);
+    return en;
+}
+
+MatExpr max(const MatExpr& e1, const MatExpr& e2)
+{
+    CV_INSTRUMENT_REGION();
+
+    MatExpr en;
+    makeMinMaxExpr(en, 'M', e1, e2);
+    return en;
+}
+
 MatExpr operator & (const Mat& a, const Mat& b)
 {
     checkOperandsExist(a, b);
@@ -1406,7 +2119,7 @@ void MatOp_AddEx::abs(const MatExpr& e, MatExpr& res) const
 
     if( (!e.b.data || e.beta == 0) && fabs(e.alpha) == 1 )
         MatOp_Bin::makeExpr(res, 'a', e.a, -e.s*e.alpha);
-    else if( e.b.data && e.alpha + e.beta == 0 && e.alpha*e.beta == -1 )
+    else if( e.b.data && e.alpha + e.beta == 0 && e.alpha*e.beta == -1 && e.s == Scalar() )
         MatOp_Bin::makeExpr(res, 'a', e.a, e.b);
     else
         MatOp::abs(e, res);
@@ -1522,6 +2235,159 @@ inline void MatOp_Cmp::makeExpr(MatExpr& res, int cmpop, const Mat& a, double al
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+MatOp_Fused::MatOp_Fused(const std::vector<fused::Instr>& _code) : code(_code), stackSize(0), mask(false)
+{
+    int sp = 0;
+    for( size_t i = 0; i < code.size(); i++ )
+    {
+        int opcode = code[i].opcode;
+        sp += opcode == fused::OP_LOAD ? 1 : opcode < fused::OP_ADDC ? -1 : 0;
+        stackSize = std::max(stackSize, sp);
+        mask = opcode == fused::OP_CMP || opcode == fused::OP_CMPC;
+    }
+}
+
+void MatOp_Fused::assign(const MatExpr& e, Mat& m, int _type) const
+{
+    const int rtype = type(e);
+    const int dtype = _type == -1 ? rtype : CV_MAKETYPE(CV_MAT_DEPTH(_type), CV_MAT_CN(rtype));
+    const Mat src[] = { e.a, e.b, e.c };
+    const int nsrc = e.c.data ? 3 : e.b.data ? 2 : 1;
+    const double consts[] = { e.alpha, e.beta, e.s[0], e.s[1], e.s[2], e.s[3] };
+
+    m.create(e.a.dims, e.a.size.p, dtype);
+    fused::run(code, stackSize, src, nsrc, consts, m);
+}
+
+void MatOp_Fused::multiply(const MatExpr& e, double s, MatExpr& res) const
+{
+    CV_INSTRUMENT_REGION();
+
+    FusedExprBuilder builder;
+    if( builder.push(Mat(), &e) && builder.scale(s) && builder.makeExpr(res) )
+        return;
+    MatOp::multiply(e, s, res);
+}
+
+int MatOp_Fused::type(const MatExpr& e) const
+{
+    return mask ? CV_MAKETYPE(CV_8U, e.a.channels()) : e.a.type();
+}
+
+namespace {
+struct FusedOpsRegistry
+{
+    Mutex mutex;
+    std::map<std::string, MatOp_Fused*> ops;
+};
+}
+
+static FusedOpsRegistry& getFusedOpsRegistry()
+{
+    CV_SINGLETON_LAZY_INIT_REF(FusedOpsRegistry, new FusedOpsRegistry())
+}
+
+// MatOp_Fused objects are never released (the number of programs is limited by the application code)
+const MatOp_Fused* MatOp_Fused::getOp(const std::vector<fused::Instr>& code)
+{
+    const std::string key((const char*)code.data(), code.size() * sizeof(code[0]));
+    FusedOpsRegistry& registry = getFusedOpsRegistry();
+    AutoLock lock(registry.mutex);
+    std::map<std::string, MatOp_Fused*>::const_iterator it = registry.ops.find(key);
+    if( it != registry.ops.end() )
+        return it->second;
+    if( registry.ops.size() >= 1024 )
+    {
+        CV_LOG_ONCE_DEBUG(NULL, "MatExpr: too many fused programs, temporary matrices are used");
+        return NULL;
+    }
+    MatOp_Fused* op = new MatOp_Fused(code);
+    registry.ops[key] = op;
+    return op;
+}
+
+void MatOp_Fused::makeAddEx(MatExpr& res, const Mat& a, const MatExpr* ea, const Mat& b, const MatExpr* eb,
+                            double alpha, double beta, const Scalar& s)
+{
+    if( ea || eb )
+    {
+        FusedExprBuilder builder;
+        if( builder.push(a, ea) && builder.push(b, eb) &&
+            builder.addEx(eb || b.data, alpha, beta, s) && builder.makeExpr(res) )
+            return;
+    }
+    Mat ma = a, mb = b;
+    if( ea )
+        ea->op->assign(*ea, ma);
+    if( eb )
+        eb->op->assign(*eb, mb);
+    MatOp_AddEx::makeExpr(res, ma, mb, alpha, beta, s);
+}
+
+void MatOp_Fused::makeBin(MatExpr& res, char op, const Mat& a, const MatExpr* ea, const Mat& b, const MatExpr* eb,
+                          double scale)
+{
+    if( ea || eb )
+    {
+        FusedExprBuilder builder;
+        if( builder.push(a, ea) && builder.push(b, eb) &&
+            builder.bin(op, eb || b.data, scale, Scalar()) && builder.makeExpr(res) )
+            return;
+    }
+    Mat ma = a, mb = b;
+    if( ea )
+        ea->op->assign(*ea, ma);
+    if( eb )
+        eb->op->assign(*eb, mb);
+    MatOp_Bin::makeExpr(res, op, ma, mb, scale);
+}
+
+void MatOp_Fused::makeBin(MatExpr& res, char op, const Mat& a, const MatExpr* ea, const Scalar& s)
+{
+    if( ea )
+    {
+        FusedExprBuilder builder;
+        if( builder.push(a, ea) && builder.bin(op, false, 1, s) && builder.makeExpr(res) )
+            return;
+    }
+    Mat ma = a;
+    if( ea )
+        ea->op->assign(*ea, ma);
+    MatOp_Bin::makeExpr(res, op, ma, s);
+}
+
+void MatOp_Fused::makeCmp(MatExpr& res, int cmpop, const Mat& a, const MatExpr* ea, const Mat& b, const MatExpr* eb)
+{
+    if( ea || eb )
+    {
+        FusedExprBuilder builder;
+        if( builder.push(a, ea) && builder.push(b, eb) && builder.cmp(cmpop, true, 1) && builder.makeExpr(res) )
+            return;
+    }
+    Mat ma = a, mb = b;
+    if( ea )
+        ea->op->assign(*ea, ma);
+    if( eb )
+        eb->op->assign(*eb, mb);
+    MatOp_Cmp::makeExpr(res, cmpop, ma, mb);
+}
+
+void MatOp_Fused::makeCmp(MatExpr& res, int cmpop, const Mat& a, const MatExpr* ea, double alpha)
+{
+    if( ea )
+    {
+        FusedExprBuilder builder;
+        if( builder.push(a, ea) && builder.cmp(cmpop, false, alpha) && builder.makeExpr(res) )
+            return;
+    }
+    Mat ma = a;
+    if( ea )
+        ea->op->assign(*ea, ma);
+    MatOp_Cmp::makeExpr(res, cmpop, ma, alpha);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void MatOp_T::assign(const MatExpr& e, Mat& m, int _type) const
 {
     Mat temp, &dst = _type == -1 || _type == e.a.type() ? m : temp;
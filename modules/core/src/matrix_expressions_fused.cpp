@@ -0,0 +1,367 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "precomp.hpp"
+#include "matrix_expressions_fused.hpp"
+#include "opencv2/core/hal/intrin.hpp"
+
+/*
+ * Single pass evaluation of element-wise MatExpr chains.
+ *
+ * Rows are split on blocks of BLOCK_SIZE elements. Program instructions are applied to the block
+ * buffers (they stay in L1 cache) and the result is converted into the destination type.
+ * Blocks are processed by parallel_for_().
+ *
+ * Only floating-point operands are supported: rounding and saturation of integer temporary matrices
+ * depend on the implementation of each operation (working type, FMA usage) and can't be reproduced
+ * bit-exactly in one pass.
+ */
+
+namespace cv { namespace fused {
+
+static const int BLOCK_SIZE = 768;  // multiple of 12: each block starts from the first channel (1-4 channels)
+
+bool isSupportedDepth(int depth)
+{
+    return depth == CV_32F || depth == CV_64F;
+}
+
+namespace {
+
+// Operations: s() - scalar version, v() - universal intrinsics version
+
+struct op_add
+{
+    template<typename T> inline T s(T a, T b) const { return a + b; }
+    template<typename V> inline V v(const V& a, const V& b) const { return v_add(a, b); }
+};
+
+struct op_sub
+{
+    template<typename T> inline T s(T a, T b) const { return a - b; }
+    template<typename V> inline V v(const V& a, const V& b) const { return v_sub(a, b); }
+};
+
+struct op_rsub
+{
+    template<typename T> inline T s(T a, T b) const { return b - a; }
+    template<typename V> inline V v(const V& a, const V& b) const { return v_sub(b, a); }
+};
+
+struct op_addw
+{
+    op_addw(double alpha_, double beta_) : alpha(alpha_), beta(beta_) {}
+    template<typename T> inline T s(T a, T b) const { return a*(T)alpha + b*(T)beta; }
+    template<typename V> inline V v(const V& a, const V& b) const
+    {
+        typedef typename VTraits<V>::lane_type T;
+        return v_add(v_mul(a, v_setall_<V>((T)alpha)), v_mul(b, v_setall_<V>((T)beta)));
+    }
+    double alpha, beta;
+};
+
+struct op_mul
+{
+    op_mul(double scale_) : scale(scale_) {}
+    template<typename T> inline T s(T a, T b) const { return a*(T)scale*b; }
+    template<typename V> inline V v(const V& a, const V& b) const
+    {
+        typedef typename VTraits<V>::lane_type T;
+        return v_mul(v_mul(a, v_setall_<V>((T)scale)), b);
+    }
+    double scale;
+};
+
+struct op_div
+{
+    op_div(double scale_) : scale(scale_) {}
+    template<typename T> inline T s(T a, T b) const { return a*(T)scale/b; }
+    template<typename V> inline V v(const V& a, const V& b) const
+    {
+        typedef typename VTraits<V>::lane_type T;
+        return v_div(v_mul(a, v_setall_<V>((T)scale)), b);
+    }
+    double scale;
+};
+
+struct op_rdiv
+{
+    template<typename T> inline T s(T a, T b) const { return b/a; }
+    template<typename V> inline V v(const V& a, const V& b) const { return v_div(b, a); }
+};
+
+struct op_min
+{
+    template<typename T> inline T s(T a, T b) const { return std::min(a, b); }
+    template<typename V> inline V v(const V& a, const V& b) const { return v_min(a, b); }
+};
+
+struct op_max
+{
+    template<typename T> inline T s(T a, T b) const { return std::max(a, b); }
+    template<typename V> inline V v(const V& a, const V& b) const { return v_max(a, b); }
+};
+
+struct op_absdiff
+{
+    template<typename T> inline T s(T a, T b) const { return std::abs(a - b); }
+    template<typename V> inline V v(const V& a, const V& b) const { return v_absdiff(a, b); }
+};
+
+struct op_neg
+{
+    template<typename T> inline T s(T a, T) const { return -a; }
+    template<typename V> inline V v(const V& a, const V&) const { return v_sub(v_setzero_<V>(), a); }
+};
+
+struct op_abs
+{
+    template<typename T> inline T s(T a, T) const { return std::abs(a); }
+    template<typename V> inline V v(const V& a, const V&) const { return v_abs(a); }
+};
+
+template<int cmpop>
+struct op_cmp
+{
+    template<typename T> inline T s(T a, T b) const
+    {
+        bool r = cmpop == CMP_EQ ? a == b : cmpop == CMP_GT ? a > b : cmpop == CMP_GE ? a >= b :
+                 cmpop == CMP_LT ? a < b : cmpop == CMP_LE ? a <= b : a != b;
+        return r ? (T)255 : (T)0;
+    }
+    template<typename V> inline V v(const V& a, const V& b) const
+    {
+        typedef typename VTraits<V>::lane_type T;
+        V mask = cmpop == CMP_EQ ? v_eq(a, b) : cmpop == CMP_GT ? v_gt(a, b) : cmpop == CMP_GE ? v_ge(a, b) :
+                 cmpop == CMP_LT ? v_lt(a, b) : cmpop == CMP_LE ? v_le(a, b) : v_ne(a, b);
+        return v_and(mask, v_setall_<V>((T)255));
+    }
+};
+
+// SIMD part of loops, returns number of processed elements
+template<typename T>
+struct SimdLoops
+{
+    template<class Op> static inline int binary(const T*, const T*, T*, int, const Op&) { return 0; }
+    template<class Op> static inline int scalar(const T*, T, T*, int, const Op&) { return 0; }
+};
+
+template<typename T, typename V>
+struct SimdLoopsImpl
+{
+    template<class Op> static inline int binary(const T* x, const T* y, T* d, int n, const Op& op)
+    {
+        const int w = VTraits<V>::vlanes();
+        int i = 0;
+        for (; i <= n - w; i += w)
+            v_store(d + i, op.v(vx_load(x + i), vx_load(y + i)));
+        vx_cleanup();
+        return i;
+    }
+    template<class Op> static inline int scalar(const T* x, T c, T* d, int n, const Op& op)
+    {
+        const int w = VTraits<V>::vlanes();
+        const V vc = v_setall_<V>(c);
+        int i = 0;
+        for (; i <= n - w; i += w)
+            v_store(d + i, op.v(vx_load(x + i), vc));
+        vx_cleanup();
+        return i;
+    }
+};
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+template<> struct SimdLoops<float> : public SimdLoopsImpl<float, v_float32> {};
+#endif
+#if (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+template<> struct SimdLoops<double> : public SimdLoopsImpl<double, v_float64> {};
+#endif
+
+template<typename T, class Op> static inline
+void binaryLoop(const T* x, const T* y, T* d, int n, const Op& op)
+{
+    int i = SimdLoops<T>::binary(x, y, d, n, op);
+    for (; i < n; i++)
+        d[i] = op.s(x[i], y[i]);
+}
+
+template<typename T, class Op> static inline
+void scalarLoop(const T* x, T c, T* d, int n, const Op& op)
+{
+    int i = SimdLoops<T>::scalar(x, c, d, n, op);
+    for (; i < n; i++)
+        d[i] = op.s(x[i], c);
+}
+
+template<typename T>
+class FusedInvoker CV_FINAL : public ParallelLoopBody
+{
+public:
+    FusedInvoker(const std::vector<Instr>& code_, int stackSize_, const Mat* src_, int nsrc_,
+                 const double* consts_, Mat& dst_, size_t len_)
+        : code(code_), stackSize(stackSize_), src(src_), nsrc(nsrc_), consts(consts_), dst(dst_), len(len_)
+    {
+        CV_DbgAssert(src[0].depth() == DataType<T>::depth);
+        cn = src[0].channels();
+        cvtDst = dst.depth() != DataType<T>::depth ? getConvertFunc(DataType<T>::depth, dst.depth()) : 0;
+        blocksPerRow = (int)((len + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        const int ncode = (int)code.size();
+        int npatterns = 0;
+        for (int j = 0; j < ncode; j++)
+            npatterns += code[j].nk > 1;
+
+        AutoBuffer<T> _buf((size_t)(stackSize + npatterns) * BLOCK_SIZE);
+        T* stackbuf = _buf.data();
+
+        // per-channel constants
+        AutoBuffer<const T*> patterns(ncode);
+        T* pattern = stackbuf + stackSize * BLOCK_SIZE;
+        for (int j = 0; j < ncode; j++)
+        {
+            patterns[j] = 0;
+            if (code[j].nk <= 1)
+                continue;
+            for (int i = 0; i < BLOCK_SIZE; i++)
+                pattern[i] = (T)consts[code[j].k + i % cn];
+            patterns[j] = pattern;
+            pattern += BLOCK_SIZE;
+        }
+
+        const size_t desz = dst.elemSize1();
+        for (int b = range.start; b < range.end; b++)
+        {
+            const int y = b / blocksPerRow;
+            const size_t x = (size_t)(b - y * blocksPerRow) * BLOCK_SIZE;
+            const int n = (int)std::min((size_t)BLOCK_SIZE, len - x);
+
+            const T* loaded[MAX_OPERANDS];
+            for (int i = 0; i < nsrc; i++)
+                loaded[i] = src[i].ptr<T>(y) + x;
+
+            const T* stack[MAX_STACK];
+            int sp = 0;
+            for (int j = 0; j < ncode; j++)
+            {
+                const Instr& instr = code[j];
+                const T* x0 = sp > 0 ? stack[sp - 1] : 0;
+                const T* x1 = sp > 1 ? stack[sp - 2] : 0;
+                T* d1 = stackbuf + (sp - 1) * BLOCK_SIZE;  // result of unary instructions
+                T* d2 = d1 - BLOCK_SIZE;                    // result of binary instructions
+                const T c = instr.nk == 1 ? (T)consts[instr.k] : (T)1;
+                switch (instr.opcode)
+                {
+                case OP_LOAD: stack[sp++] = loaded[instr.arg]; continue;
+                case OP_ADD: binaryLoop(x1, x0, d2, n, op_add()); break;
+                case OP_SUB: binaryLoop(x1, x0, d2, n, op_sub()); break;
+                case OP_RSUB: binaryLoop(x1, x0, d2, n, op_rsub()); break;
+                case OP_ADDW: binaryLoop(x1, x0, d2, n, op_addw(consts[instr.k], consts[instr.k + 1])); break;
+                case OP_MUL: binaryLoop(x1, x0, d2, n, op_mul(c)); break;
+                case OP_DIV: binaryLoop(x1, x0, d2, n, op_div(c)); break;
+                case OP_MIN: binaryLoop(x1, x0, d2, n, op_min()); break;
+                case OP_MAX: binaryLoop(x1, x0, d2, n, op_max()); break;
+                case OP_ABSDIFF: binaryLoop(x1, x0, d2, n, op_absdiff()); break;
+                case OP_CMP: compare(x1, x0, d2, n, instr.arg); break;
+                case OP_ADDC:
+                    if (patterns[j])
+                        binaryLoop(x0, patterns[j], d1, n, op_add());
+                    else
+                        scalarLoop(x0, c, d1, n, op_add());
+                    break;
+                case OP_MULC: scalarLoop(x0, c, d1, n, op_mul(1)); break;
+                case OP_RDIVC: scalarLoop(x0, c, d1, n, op_rdiv()); break;
+                case OP_MINC: scalarLoop(x0, c, d1, n, op_min()); break;
+                case OP_MAXC: scalarLoop(x0, c, d1, n, op_max()); break;
+                case OP_CMPC: compare(x0, c, d1, n, instr.arg); break;
+                case OP_NEG: scalarLoop(x0, (T)0, d1, n, op_neg()); break;
+                case OP_ABS: scalarLoop(x0, (T)0, d1, n, op_abs()); break;
+                default:
+                    CV_Error(Error::StsInternal, "Unknown instruction");
+                }
+                if (instr.opcode < OP_ADDC)
+                    stack[--sp - 1] = d2;
+                else
+                    stack[sp - 1] = d1;
+            }
+            CV_DbgAssert(sp == 1);
+
+            uchar* dptr = dst.ptr(y) + x * desz;
+            if (cvtDst)
+                cvtDst((const uchar*)stack[0], 0, 0, 0, dptr, 0, Size(n, 1), 0);
+            else
+                memcpy(dptr, stack[0], n * sizeof(T));
+        }
+    }
+
+protected:
+    static void compare(const T* x, const T* y, T* d, int n, int cmpop)
+    {
+        switch (cmpop)
+        {
+        case CMP_EQ: binaryLoop(x, y, d, n, op_cmp<CMP_EQ>()); break;
+        case CMP_GT: binaryLoop(x, y, d, n, op_cmp<CMP_GT>()); break;
+        case CMP_GE: binaryLoop(x, y, d, n, op_cmp<CMP_GE>()); break;
+        case CMP_LT: binaryLoop(x, y, d, n, op_cmp<CMP_LT>()); break;
+        case CMP_LE: binaryLoop(x, y, d, n, op_cmp<CMP_LE>()); break;
+        default: binaryLoop(x, y, d, n, op_cmp<CMP_NE>()); break;
+        }
+    }
+
+    static void compare(const T* x, T c, T* d, int n, int cmpop)
+    {
+        switch (cmpop)
+        {
+        case CMP_EQ: scalarLoop(x, c, d, n, op_cmp<CMP_EQ>()); break;
+        case CMP_GT: scalarLoop(x, c, d, n, op_cmp<CMP_GT>()); break;
+        case CMP_GE: scalarLoop(x, c, d, n, op_cmp<CMP_GE>()); break;
+        case CMP_LT: scalarLoop(x, c, d, n, op_cmp<CMP_LT>()); break;
+        case CMP_LE: scalarLoop(x, c, d, n, op_cmp<CMP_LE>()); break;
+        default: scalarLoop(x, c, d, n, op_cmp<CMP_NE>()); break;
+        }
+    }
+
+    const std::vector<Instr>& code;
+    int stackSize;
+    const Mat* src;
+    int nsrc;
+    const double* consts;
+    Mat& dst;
+    size_t len;
+    int cn, blocksPerRow;
+    BinaryFunc cvtDst;
+};
+
+}  // namespace
+
+void run(const std::vector<Instr>& code, int stackSize, const Mat* src, int nsrc, const double* consts, Mat& dst)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert(nsrc > 0 && nsrc <= MAX_OPERANDS && stackSize > 0 && stackSize <= MAX_STACK);
+    CV_Assert(isSupportedDepth(src[0].depth()) && src[0].channels() <= 4 && src[0].dims <= 2);
+
+    bool continuous = dst.isContinuous();
+    for (int i = 0; i < nsrc; i++)
+    {
+        CV_Assert(src[i].type() == src[0].type() && src[i].size == dst.size);
+        continuous = continuous && src[i].isContinuous();
+    }
+
+    const int rows = continuous ? 1 : dst.rows;
+    const size_t len = (continuous ? dst.total() : (size_t)dst.cols) * dst.channels();
+    const size_t blocksPerRow = (len + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    CV_Assert(blocksPerRow * rows < (size_t)INT_MAX);
+
+    const Range range(0, (int)(blocksPerRow * rows));
+    const double nstripes = (double)(len * rows) / (1 << 16);
+    if (src[0].depth() == CV_64F)
+        parallel_for_(range, FusedInvoker<double>(code, stackSize, src, nsrc, consts, dst, len), nstripes);
+    else
+        parallel_for_(range, FusedInvoker<float>(code, stackSize, src, nsrc, consts, dst, len), nstripes);
+}
+
+}}  // namespace
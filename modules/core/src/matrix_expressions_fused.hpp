@@ -0,0 +1,68 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#ifndef OPENCV_CORE_SRC_MATRIX_EXPRESSIONS_FUSED_HPP
+#define OPENCV_CORE_SRC_MATRIX_EXPRESSIONS_FUSED_HPP
+
+namespace cv { namespace fused {
+
+/** Instructions of fused element-wise MatExpr programs.
+ *
+ * Programs are executed on the stack of row blocks. All values are processed in the type
+ * of operands (float or double).
+ */
+enum Opcode
+{
+    OP_LOAD = 0,    //!< push operand `arg`
+    OP_ADD,         //!< x + y
+    OP_SUB,         //!< x - y
+    OP_RSUB,        //!< y - x
+    OP_ADDW,        //!< x*c[k] + y*c[k+1]
+    OP_MUL,         //!< x*c[k]*y (or x*y if nk == 0)
+    OP_DIV,         //!< x*c[k]/y (or x/y if nk == 0)
+    OP_MIN,         //!< min(x, y)
+    OP_MAX,         //!< max(x, y)
+    OP_ABSDIFF,     //!< |x - y|
+    OP_CMP,         //!< compare(x, y, arg) ? 255 : 0
+    OP_ADDC,        //!< x + c[k] (nk == 1) or x + c[k + channel] (nk == number of channels)
+    OP_MULC,        //!< x*c[k]
+    OP_RDIVC,       //!< c[k]/x
+    OP_MINC,        //!< min(x, c[k])
+    OP_MAXC,        //!< max(x, c[k])
+    OP_CMPC,        //!< compare(x, c[k], arg) ? 255 : 0
+    OP_NEG,         //!< -x
+    OP_ABS          //!< |x|
+};
+
+enum
+{
+    MAX_OPERANDS = 3,   //!< MatExpr::a, MatExpr::b, MatExpr::c
+    MAX_CONSTS = 6,     //!< MatExpr::alpha, MatExpr::beta, MatExpr::s
+    MAX_STACK = 8
+};
+
+struct Instr
+{
+    uchar opcode;
+    uchar arg;  //!< operand index (OP_LOAD) or comparison operation (OP_CMP, OP_CMPC)
+    uchar k;    //!< index of the first constant
+    uchar nk;   //!< number of constants
+};
+
+//! depth of operands supported by fused evaluation
+bool isSupportedDepth(int depth);
+
+/** Evaluates program `code` over operands of the same size and type.
+ *
+ * @param code program
+ * @param stackSize maximal stack depth of the program
+ * @param src operands (2D, up to 4 channels)
+ * @param nsrc number of operands
+ * @param consts values of constants
+ * @param dst preallocated destination, it may be the same matrix as one of operands
+ */
+void run(const std::vector<Instr>& code, int stackSize, const Mat* src, int nsrc, const double* consts, Mat& dst);
+
+}}  // namespace
+
+#endif  // OPENCV_CORE_SRC_MATRIX_EXPRESSIONS_FUSED_HPP
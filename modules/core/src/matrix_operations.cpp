@@ -969,53 +969,310 @@ void cv::reduce(InputArray _src, OutputArray _dst, int dim, int op, int dtype)
 namespace cv
 {
 
-template<typename T> static void sort_( const Mat& src, Mat& dst, int flags )
+/* Order-preserving mapping of values to unsigned radix sort keys.
+   Signed integers get the sign bit flipped, floats additionally get all other bits inverted
+   for negative values. 64-bit values are sorted with std::sort. */
+template<typename T> struct SortKey
 {
-    AutoBuffer<T> buf;
-    int n, len;
-    bool sortRows = (flags & 1) == SORT_EVERY_ROW;
-    bool inplace = src.data == dst.data;
-    bool sortDescending = (flags & SORT_DESCENDING) != 0;
-
-    if( sortRows )
-        n = src.rows, len = src.cols;
-    else
+    enum { radix = 0 };
+    typedef uint64 key_type;
+    static inline key_type toKey(T) { return 0; }
+    static inline T fromKey(key_type) { return T(); }
+};
+
+template<> struct SortKey<uchar>
+{
+    enum { radix = 1 };
+    typedef uchar key_type;
+    static inline key_type toKey(uchar v) { return v; }
+    static inline uchar fromKey(key_type k) { return k; }
+};
+
+template<> struct SortKey<schar>
+{
+    enum { radix = 1 };
+    typedef uchar key_type;
+    static inline key_type toKey(schar v) { return (uchar)(v ^ 0x80); }
+    static inline schar fromKey(key_type k) { return (schar)(k ^ 0x80); }
+};
+
+template<> struct SortKey<ushort>
+{
+    enum { radix = 1 };
+    typedef ushort key_type;
+    static inline key_type toKey(ushort v) { return v; }
+    static inline ushort fromKey(key_type k) { return k; }
+};
+
+template<> struct SortKey<short>
+{
+    enum { radix = 1 };
+    typedef ushort key_type;
+    static inline key_type toKey(short v) { return (ushort)(v ^ 0x8000); }
+    static inline short fromKey(key_type k) { return (short)(k ^ 0x8000); }
+};
+
+template<> struct SortKey<int>
+{
+    enum { radix = 1 };
+    typedef unsigned key_type;
+    static inline key_type toKey(int v) { return (unsigned)v ^ 0x80000000u; }
+    static inline int fromKey(key_type k) { return (int)(k ^ 0x80000000u); }
+};
+
+template<> struct SortKey<float>
+{
+    enum { radix = 1 };
+    typedef unsigned key_type;
+    static inline key_type toKey(float v)
+    {
+        Cv32suf u; u.f = v;
+        return u.u ^ ((unsigned)(u.i >> 31) | 0x80000000u);
+    }
+    static inline float fromKey(key_type k)
+    {
+        Cv32suf u; u.u = k ^ ((k & 0x80000000u) ? 0x80000000u : 0xffffffffu);
+        return u.f;
+    }
+};
+
+//! minimal length of line to use radix sort instead of std::sort
+static const int RADIX_SORT_MIN_LEN = 128;
+
+/* LSD radix sort of `len` keys (and optional indices) by 8-bit digits.
+   Result is stored back to `keys` (`idx`), `ktmp` (`itmp`) are temporary buffers of the same size.
+   The sort is stable, passes with the same digit in all keys are skipped. */
+template<typename K> static void
+radixSort( K* keys, K* ktmp, int* idx, int* itmp, int len )
+{
+    const int npasses = (int)sizeof(K);
+    int hist[sizeof(K)][256];
+    memset(hist, 0, sizeof(hist));
+    for( int i = 0; i < len; i++ )
     {
-        n = src.cols, len = src.rows;
-        buf.allocate(len);
+        K k = keys[i];
+        for( int b = 0; b < npasses; b++ )
+            hist[b][(k >> (b*8)) & 255]++;
+    }
+
+    if( npasses == 1 && !idx )
+    {
+        // counting sort
+        for( int d = 0, j = 0; d < 256; d++ )
+            for( int c = hist[0][d]; c > 0; c-- )
+                keys[j++] = (K)d;
+        return;
     }
-    T* bptr = buf.data();
 
-    for( int i = 0; i < n; i++ )
+    K *ksrc = keys, *kdst = ktmp;
+    int *isrc = idx, *idst = itmp;
+    for( int b = 0; b < npasses; b++ )
     {
-        T* ptr = bptr;
-        if( sortRows )
+        int* h = hist[b];
+        const int shift = b*8;
+        if( h[(ksrc[0] >> shift) & 255] == len )
+            continue;
+        for( int d = 0, sum = 0; d < 256; d++ )
         {
-            T* dptr = dst.ptr<T>(i);
-            if( !inplace )
+            int c = h[d];
+            h[d] = sum;
+            sum += c;
+        }
+        if( isrc )
+        {
+            for( int i = 0; i < len; i++ )
             {
-                const T* sptr = src.ptr<T>(i);
-                memcpy(dptr, sptr, sizeof(T) * len);
+                K k = ksrc[i];
+                int p = h[(k >> shift) & 255]++;
+                kdst[p] = k;
+                idst[p] = isrc[i];
             }
-            ptr = dptr;
+            std::swap(isrc, idst);
         }
         else
         {
+            for( int i = 0; i < len; i++ )
+            {
+                K k = ksrc[i];
+                kdst[h[(k >> shift) & 255]++] = k;
+            }
+        }
+        std::swap(ksrc, kdst);
+    }
+    if( ksrc != keys )
+    {
+        memcpy(keys, ksrc, len*sizeof(K));
+        if( idx )
+            memcpy(idx, isrc, len*sizeof(int));
+    }
+}
+
+template<typename _Tp> class LessThanIdx
+{
+public:
+    LessThanIdx( const _Tp* _arr ) : arr(_arr) {}
+    bool operator()(int a, int b) const { return arr[a] < arr[b]; }
+    const _Tp* arr;
+};
+
+/* Sorts rows or columns of the matrix (values for cv::sort, indices for cv::sortIdx).
+   Columns are gathered into contiguous lines by groups for better cache locality. */
+template<typename T> class Sort_Invoker : public ParallelLoopBody
+{
+public:
+    typedef typename SortKey<T>::key_type K;
+    enum { COL_GROUP = 16 };
+
+    Sort_Invoker( const Mat& _src, Mat& _dst, int _flags, bool _idx )
+        : src(_src), dst(_dst), flags(_flags), needIdx(_idx)
+    {
+        sortRows = (flags & 1) == SORT_EVERY_ROW;
+        sortDescending = (flags & SORT_DESCENDING) != 0;
+        nlines = sortRows ? src.rows : src.cols;
+        len = sortRows ? src.cols : src.rows;
+        useRadix = SortKey<T>::radix && len >= RADIX_SORT_MIN_LEN;
+    }
+
+    int groupSize() const { return sortRows ? 1 : (int)COL_GROUP; }
+    int numGroups() const { return (nlines + groupSize() - 1)/groupSize(); }
+
+    //! range is measured in groups of lines
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        const int group = groupSize();
+        const int start = range.start*group, end = std::min(range.end*group, nlines);
+        AutoBuffer<T> buf;
+        AutoBuffer<int> ibuf;
+        AutoBuffer<K> kbuf;
+        AutoBuffer<int> itmp;
+        if( !sortRows )
+        {
+            buf.allocate((size_t)len*group);
+            if( needIdx )
+                ibuf.allocate((size_t)len*group);
+        }
+        if( useRadix )
+        {
+            kbuf.allocate((size_t)len*2);
+            if( needIdx )
+                itmp.allocate(len);
+        }
+
+        for( int i0 = start; i0 < end; i0 += group )
+        {
+            int g = std::min(group, end - i0);
+            if( sortRows )
+            {
+                const T* sptr = src.ptr<T>(i0);
+                if( needIdx )
+                    sortLine((T*)sptr, dst.ptr<int>(i0), kbuf.data(), itmp.data());
+                else
+                {
+                    T* dptr = dst.ptr<T>(i0);
+                    if( sptr != dptr )
+                        memcpy(dptr, sptr, sizeof(T)*len);
+                    sortLine(dptr, 0, kbuf.data(), 0);
+                }
+                continue;
+            }
+
+            T* bptr = buf.data();
             for( int j = 0; j < len; j++ )
-                ptr[j] = src.ptr<T>(j)[i];
+            {
+                const T* sptr = src.ptr<T>(j) + i0;
+                for( int c = 0; c < g; c++ )
+                    bptr[c*len + j] = sptr[c];
+            }
+            for( int c = 0; c < g; c++ )
+                sortLine(bptr + c*len, needIdx ? ibuf.data() + c*len : 0, kbuf.data(), itmp.data());
+            if( needIdx )
+            {
+                const int* iptr = ibuf.data();
+                for( int j = 0; j < len; j++ )
+                {
+                    int* dptr = dst.ptr<int>(j) + i0;
+                    for( int c = 0; c < g; c++ )
+                        dptr[c] = iptr[c*len + j];
+                }
+            }
+            else
+            {
+                for( int j = 0; j < len; j++ )
+                {
+                    T* dptr = dst.ptr<T>(j) + i0;
+                    for( int c = 0; c < g; c++ )
+                        dptr[c] = bptr[c*len + j];
+                }
+            }
         }
+    }
 
-        std::sort( ptr, ptr + len );
-        if( sortDescending )
+private:
+    // sorts `ptr` in-place (iptr == 0) or stores the sorting permutation of `ptr` into `iptr`
+    void sortLine( T* ptr, int* iptr, K* kptr, int* itmp_ ) const
+    {
+        if( useRadix )
         {
-            for( int j = 0; j < len/2; j++ )
-                std::swap(ptr[j], ptr[len-1-j]);
+            // descending order is obtained with inverted keys, so the sort stays stable
+            const K flip = sortDescending ? (K)~(K)0 : (K)0;
+            for( int j = 0; j < len; j++ )
+                kptr[j] = SortKey<T>::toKey(ptr[j]) ^ flip;
+            if( iptr )
+            {
+                for( int j = 0; j < len; j++ )
+                    iptr[j] = j;
+                radixSort(kptr, kptr + len, iptr, itmp_, len);
+            }
+            else
+            {
+                radixSort(kptr, kptr + len, (int*)0, (int*)0, len);
+                for( int j = 0; j < len; j++ )
+                    ptr[j] = SortKey<T>::fromKey((K)(kptr[j] ^ flip));
+            }
+            return;
         }
 
-        if( !sortRows )
+        if( iptr )
+        {
             for( int j = 0; j < len; j++ )
-                dst.ptr<T>(j)[i] = ptr[j];
+                iptr[j] = j;
+            std::sort( iptr, iptr + len, LessThanIdx<T>(ptr) );
+            if( sortDescending )
+                std::reverse(iptr, iptr + len);
+        }
+        else
+        {
+            std::sort( ptr, ptr + len );
+            if( sortDescending )
+                std::reverse(ptr, ptr + len);
+        }
     }
+
+    const Mat& src;
+    Mat& dst;
+    int flags;
+    bool needIdx;
+    bool sortRows;
+    bool sortDescending;
+    bool useRadix;
+    int nlines;
+    int len;
+};
+
+template<typename T> static void sortImpl_( const Mat& src, Mat& dst, int flags, bool idx )
+{
+    Sort_Invoker<T> body(src, dst, flags, idx);
+    int ngroups = body.numGroups();
+    double nstripes = std::min((double)ngroups, (double)src.total()/(1 << 16));
+    if( nstripes <= 1 )
+        body(Range(0, ngroups));
+    else
+        parallel_for_(Range(0, ngroups), body, nstripes);
+}
+
+template<typename T> static void sort_( const Mat& src, Mat& dst, int flags )
+{
+    sortImpl_<T>(src, dst, flags, false);
 }
 
 #ifdef HAVE_IPP
@@ -1106,64 +1363,10 @@ static bool ipp_sort(const Mat& src, Mat& dst, int flags)
 }
 #endif
 
-template<typename _Tp> class LessThanIdx
-{
-public:
-    LessThanIdx( const _Tp* _arr ) : arr(_arr) {}
-    bool operator()(int a, int b) const { return arr[a] < arr[b]; }
-    const _Tp* arr;
-};
-
 template<typename T> static void sortIdx_( const Mat& src, Mat& dst, int flags )
 {
-    AutoBuffer<T> buf;
-    AutoBuffer<int> ibuf;
-    bool sortRows = (flags & 1) == SORT_EVERY_ROW;
-    bool sortDescending = (flags & SORT_DESCENDING) != 0;
-
     CV_Assert( src.data != dst.data );
-
-    int n, len;
-    if( sortRows )
-        n = src.rows, len = src.cols;
-    else
-    {
-        n = src.cols, len = src.rows;
-        buf.allocate(len);
-        ibuf.allocate(len);
-    }
-    T* bptr = buf.data();
-    int* _iptr = ibuf.data();
-
-    for( int i = 0; i < n; i++ )
-    {
-        T* ptr = bptr;
-        int* iptr = _iptr;
-
-        if( sortRows )
-        {
-            ptr = (T*)(src.data + src.step*i);
-            iptr = dst.ptr<int>(i);
-        }
-        else
-        {
-            for( int j = 0; j < len; j++ )
-                ptr[j] = src.ptr<T>(j)[i];
-        }
-        for( int j = 0; j < len; j++ )
-            iptr[j] = j;
-
-        std::sort( iptr, iptr + len, LessThanIdx<T>(ptr) );
-        if( sortDescending )
-        {
-            for( int j = 0; j < len/2; j++ )
-                std::swap(iptr[j], iptr[len-1-j]);
-        }
-
-        if( !sortRows )
-            for( int j = 0; j < len; j++ )
-                dst.ptr<int>(j)[i] = iptr[j];
-    }
+    sortImpl_<T>(src, dst, flags, true);
 }
 
 #ifdef HAVE_IPP
@@ -0,0 +1,336 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "precomp.hpp"
+
+#include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/tls.hpp>
+#include "opencv2/core/utils/allocator_stats.impl.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+/*
+ * Pooling Mat allocator.
+ *
+ * Buffers are rounded up to size classes (4 classes per power of two, so the overhead is below 25%).
+ * Released buffers are kept in free lists: small per-thread caches backed by shared lists.
+ * Thread caches are guarded by own (uncontended) mutexes and registered in the allocator,
+ * so freeAllReservedBuffers() releases buffers cached by all threads, not only by the calling one.
+ * The amount of reserved (cached) memory is limited by BufferPoolController::setMaxReservedSize(),
+ * buffers over the limit are released to the system immediately.
+ */
+
+namespace cv {
+
+namespace {
+
+static const int POOL_MIN_CLASS_SHIFT = 6;  // 64 bytes
+static const int POOL_CLASSES_PER_POW2_SHIFT = 2;  // 4 classes per power of two
+static const int POOL_NUM_CLASSES = 1 + (int)(sizeof(size_t) * 8 - POOL_MIN_CLASS_SHIFT) * (1 << POOL_CLASSES_PER_POW2_SHIFT);
+
+static inline int sizeClassIndex(size_t size, size_t& classSize)
+{
+    if (size > ((size_t)1 << (sizeof(size_t) * 8 - 2)))
+    {
+        classSize = size;
+        return -1;  // not pooled
+    }
+    if (size <= ((size_t)1 << POOL_MIN_CLASS_SHIFT))
+    {
+        classSize = (size_t)1 << POOL_MIN_CLASS_SHIFT;
+        return 0;
+    }
+    size_t v = size - 1;
+    int p = 0;  // index of the highest bit of (size - 1)
+    while ((v >> p) > 1)
+        p++;
+    const int shift = p - POOL_CLASSES_PER_POW2_SHIFT;
+    const size_t k = v >> shift;  // [4; 7]
+    classSize = (k + 1) << shift;
+    return 1 + (p - POOL_MIN_CLASS_SHIFT) * (1 << POOL_CLASSES_PER_POW2_SHIFT) + (int)(k - (1 << POOL_CLASSES_PER_POW2_SHIFT));
+}
+
+class PoolMatAllocator;
+
+struct ThreadCache
+{
+    ThreadCache();
+    ~ThreadCache();
+
+    std::mutex mutex;  // taken by the owner thread and by freeAllReservedBuffers()
+    PoolMatAllocator* pool;
+    size_t bytes;
+    std::vector<void*> lists[POOL_NUM_CLASSES];
+};
+
+class PoolMatAllocator CV_FINAL : public MatAllocator, public BufferPoolController
+{
+public:
+    PoolMatAllocator()
+        : reservedSize(0)
+    {
+        maxReservedSize = utils::getConfigurationParameterSizeT("OPENCV_MAT_POOL_ALLOCATOR_LIMIT", (size_t)256 << 20);
+        maxThreadCacheSize = utils::getConfigurationParameterSizeT("OPENCV_MAT_POOL_ALLOCATOR_THREAD_CACHE_LIMIT", (size_t)16 << 20);
+        maxThreadCacheBlocks = std::max((size_t)1, utils::getConfigurationParameterSizeT("OPENCV_MAT_POOL_ALLOCATOR_THREAD_CACHE_BLOCKS", 4));
+    }
+
+    UMatData* allocate(int dims, const int* sizes, int type,
+                       void* data0, size_t* step, AccessFlag /*flags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        size_t total = CV_ELEM_SIZE(type);
+        for( int i = dims-1; i >= 0; i-- )
+        {
+            if( step )
+            {
+                if( data0 && step[i] != CV_AUTOSTEP )
+                {
+                    CV_Assert(total <= step[i]);
+                    total = step[i];
+                }
+                else
+                    step[i] = total;
+            }
+            total *= sizes[i];
+        }
+        uchar* data = data0 ? (uchar*)data0 : (uchar*)allocateBuffer(total);
+        UMatData* u = new UMatData(this);
+        u->data = u->origdata = data;
+        u->size = total;
+        if(data0)
+            u->flags |= UMatData::USER_ALLOCATED;
+
+        return u;
+    }
+
+    bool allocate(UMatData* u, AccessFlag /*accessFlags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        if(!u) return false;
+        return true;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if(!u)
+            return;
+
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        if( !(u->flags & UMatData::USER_ALLOCATED) )
+        {
+            releaseBuffer(u->origdata, u->size);
+            u->origdata = 0;
+        }
+        delete u;
+    }
+
+    BufferPoolController* getBufferPoolController(const char* /*id*/) const CV_OVERRIDE
+    {
+        return const_cast<PoolMatAllocator*>(this);
+    }
+
+    // BufferPoolController
+    size_t getReservedSize() const CV_OVERRIDE { return reservedSize.load(); }
+    size_t getMaxReservedSize() const CV_OVERRIDE { return maxReservedSize.load(); }
+    void setMaxReservedSize(size_t size) CV_OVERRIDE
+    {
+        maxReservedSize = size;
+        if (reservedSize.load() > size)
+            freeAllReservedBuffers();
+    }
+    void freeAllReservedBuffers() CV_OVERRIDE
+    {
+        std::vector<void*> released;
+        size_t releasedSize = 0;
+        {
+            AutoLock lock(cachesMutex);
+            for (size_t k = 0; k < caches.size(); k++)
+            {
+                ThreadCache& cache = *caches[k];
+                std::lock_guard<std::mutex> cacheLock(cache.mutex);
+                for (int i = 0; i < POOL_NUM_CLASSES; i++)
+                {
+                    std::vector<void*>& list = cache.lists[i];
+                    released.insert(released.end(), list.begin(), list.end());
+                    releasedSize += list.size() * classSizeOf(i);
+                    list.clear();
+                }
+                cache.bytes = 0;
+            }
+        }
+        {
+            AutoLock lock(mutex);
+            for (int i = 0; i < POOL_NUM_CLASSES; i++)
+            {
+                std::vector<void*>& list = lists[i];
+                if (list.empty())
+                    continue;
+                released.insert(released.end(), list.begin(), list.end());
+                releasedSize += list.size() * classSizeOf(i);
+                list.clear();
+            }
+        }
+        reservedSize -= releasedSize;
+        for (size_t i = 0; i < released.size(); i++)
+            fastFree(released[i]);
+        stats.onFree(releasedSize);
+    }
+
+    /// moves cached buffers of terminated thread into the shared lists
+    void releaseThreadCache(ThreadCache& cache) const
+    {
+        {
+            AutoLock lock(cachesMutex);
+            caches.erase(std::remove(caches.begin(), caches.end(), &cache), caches.end());
+        }
+        AutoLock lock(mutex);
+        for (int i = 0; i < POOL_NUM_CLASSES; i++)
+        {
+            std::vector<void*>& list = cache.lists[i];
+            lists[i].insert(lists[i].end(), list.begin(), list.end());
+            list.clear();
+        }
+        cache.bytes = 0;
+    }
+
+    utils::AllocatorStatisticsInterface& getStatistics() const { return stats; }
+
+protected:
+    static size_t classSizeOf(int index)
+    {
+        if (index == 0)
+            return (size_t)1 << POOL_MIN_CLASS_SHIFT;
+        const int p = (index - 1) / (1 << POOL_CLASSES_PER_POW2_SHIFT) + POOL_MIN_CLASS_SHIFT;
+        const size_t k = (index - 1) % (1 << POOL_CLASSES_PER_POW2_SHIFT) + (1 << POOL_CLASSES_PER_POW2_SHIFT);
+        return (k + 1) << (p - POOL_CLASSES_PER_POW2_SHIFT);
+    }
+
+    ThreadCache& getThreadCache() const
+    {
+        ThreadCache& cache = threadCache.getRef();
+        if (!cache.pool)
+        {
+            cache.pool = const_cast<PoolMatAllocator*>(this);
+            AutoLock lock(cachesMutex);
+            caches.push_back(&cache);
+        }
+        return cache;
+    }
+
+    void* allocateBuffer(size_t size) const
+    {
+        size_t classSize = 0;
+        const int idx = sizeClassIndex(size, classSize);
+        if (idx >= 0 && classSize <= maxReservedSize.load(std::memory_order_relaxed))
+        {
+            ThreadCache& cache = getThreadCache();
+            {
+                std::lock_guard<std::mutex> cacheLock(cache.mutex);
+                std::vector<void*>& local = cache.lists[idx];
+                if (!local.empty())
+                {
+                    void* ptr = local.back();
+                    local.pop_back();
+                    cache.bytes -= classSize;
+                    reservedSize -= classSize;
+                    return ptr;
+                }
+            }
+            {
+                AutoLock lock(mutex);
+                std::vector<void*>& list = lists[idx];
+                if (!list.empty())
+                {
+                    void* ptr = list.back();
+                    list.pop_back();
+                    reservedSize -= classSize;
+                    return ptr;
+                }
+            }
+        }
+        void* ptr = fastMalloc(classSize);
+        stats.onAllocate(classSize);
+        return ptr;
+    }
+
+    void releaseBuffer(void* ptr, size_t size) const
+    {
+        size_t classSize = 0;
+        const int idx = sizeClassIndex(size, classSize);
+        if (idx < 0)
+        {
+            fastFree(ptr);
+            stats.onFree(classSize);
+            return;
+        }
+        if (reservedSize.fetch_add(classSize) + classSize <= maxReservedSize.load(std::memory_order_relaxed))
+        {
+            ThreadCache& cache = getThreadCache();
+            {
+                std::lock_guard<std::mutex> cacheLock(cache.mutex);
+                std::vector<void*>& local = cache.lists[idx];
+                if (local.size() < maxThreadCacheBlocks && cache.bytes + classSize <= maxThreadCacheSize)
+                {
+                    local.push_back(ptr);
+                    cache.bytes += classSize;
+                    return;
+                }
+            }
+            AutoLock lock(mutex);
+            lists[idx].push_back(ptr);
+            return;
+        }
+        reservedSize -= classSize;
+        fastFree(ptr);
+        stats.onFree(classSize);
+    }
+
+    mutable Mutex mutex;  // guards shared lists
+    mutable std::vector<void*> lists[POOL_NUM_CLASSES];
+    mutable std::atomic<size_t> reservedSize;  // cached bytes (shared lists and thread caches)
+    std::atomic<size_t> maxReservedSize;
+    mutable Mutex cachesMutex;  // guards caches, taken before ThreadCache::mutex
+    mutable std::vector<ThreadCache*> caches;  // thread caches of running threads
+    size_t maxThreadCacheSize;
+    size_t maxThreadCacheBlocks;
+    TLSData<ThreadCache> threadCache;
+    mutable utils::AllocatorStatistics stats;  // memory allocated from the system (including cached buffers)
+};
+
+ThreadCache::ThreadCache()
+    : pool(NULL)
+    , bytes(0)
+{
+    // nothing
+}
+
+ThreadCache::~ThreadCache()
+{
+    if (pool)
+        pool->releaseThreadCache(*this);
+}
+
+static PoolMatAllocator& getPoolMatAllocator()
+{
+    CV_SINGLETON_LAZY_INIT_REF(PoolMatAllocator, new PoolMatAllocator())
+}
+
+}  // namespace
+
+MatAllocator* Mat::getPoolAllocator()
+{
+    return &getPoolMatAllocator();
+}
+
+namespace utils {
+
+AllocatorStatisticsInterface& getPoolAllocatorStatistics()
+{
+    return getPoolMatAllocator().getStatistics();
+}
+
+}  // namespace utils
+
+}  // namespace cv
@@ -0,0 +1,215 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "numa.hpp"
+
+#include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/logger.hpp>
+
+#include <atomic>
+#include <fstream>
+
+#if defined __linux__ && !defined __ANDROID__
+#define CV_HAVE_NUMA_SYSFS 1
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace cv {
+
+namespace numa {
+
+static size_t getFirstTouchThreshold()
+{
+    static size_t threshold = utils::getConfigurationParameterSizeT("OPENCV_NUMA_FIRST_TOUCH_THRESHOLD", 4 << 20);
+    return threshold;
+}
+
+static utils::NumaPolicy readPolicyParameter()
+{
+    std::string value = toUpperCase(utils::getConfigurationParameterString("OPENCV_NUMA_POLICY", "NONE"));
+    if (value == "LOCAL")
+        return utils::NUMA_POLICY_LOCAL;
+    if (!value.empty() && value != "NONE")
+        CV_LOG_WARNING(NULL, "core(numa): unknown OPENCV_NUMA_POLICY value: " << value);
+    return utils::NUMA_POLICY_NONE;
+}
+
+static utils::NumaPolicy& getPolicyRef()
+{
+    static utils::NumaPolicy g_policy = readPolicyParameter();
+    return g_policy;
+}
+
+static std::atomic<unsigned> g_policyGeneration(1);
+
+#ifdef CV_HAVE_NUMA_SYSFS
+
+// parse string of form "0-1,3,5-7,10,13-15"
+static std::vector<int> parseList(const std::string& str)
+{
+    std::vector<int> result;
+    size_t pos = 0;
+    while (pos < str.size())
+    {
+        size_t end = str.find(',', pos);
+        if (end == std::string::npos)
+            end = str.size();
+        int rstart = 0, rend = 0;
+        int n = sscanf(str.c_str() + pos, "%d-%d", &rstart, &rend);
+        if (n == 1)
+            rend = rstart;
+        if (n >= 1)
+        {
+            for (int i = rstart; i <= rend; i++)
+                result.push_back(i);
+        }
+        pos = end + 1;
+    }
+    return result;
+}
+
+static std::string readFirstLine(const std::string& filename)
+{
+    std::ifstream f(filename.c_str());
+    std::string line;
+    if (f.is_open())
+        std::getline(f, line);
+    return line;
+}
+
+struct NumaTopology
+{
+    std::vector<cpu_set_t> nodes;  // CPUs of each node available for the process (nodes without CPUs are skipped)
+    cpu_set_t processAffinity;
+
+    NumaTopology()
+    {
+        CPU_ZERO(&processAffinity);
+        if (0 != sched_getaffinity(0, sizeof(processAffinity), &processAffinity))
+        {
+            CV_LOG_DEBUG(NULL, "core(numa): can't get process affinity");
+            return;
+        }
+        const std::string root = "/sys/devices/system/node/";
+        std::vector<int> nodeIds = parseList(readFirstLine(root + "online"));
+        for (size_t i = 0; i < nodeIds.size(); i++)
+        {
+            std::vector<int> cpus = parseList(readFirstLine(cv::format("%snode%d/cpulist", root.c_str(), nodeIds[i])));
+            cpu_set_t node_cpus;
+            CPU_ZERO(&node_cpus);
+            for (size_t j = 0; j < cpus.size(); j++)
+            {
+                if (cpus[j] >= 0 && cpus[j] < CPU_SETSIZE && CPU_ISSET(cpus[j], &processAffinity))
+                    CPU_SET(cpus[j], &node_cpus);
+            }
+            if (CPU_COUNT(&node_cpus) > 0)
+                nodes.push_back(node_cpus);
+        }
+        CV_LOG_DEBUG(NULL, "core(numa): nodes with available CPUs: " << nodes.size());
+    }
+
+    static const NumaTopology& getInstance()
+    {
+        static NumaTopology g_topology;
+        return g_topology;
+    }
+};
+
+#endif  // CV_HAVE_NUMA_SYSFS
+
+static int getNodesCount()
+{
+#ifdef CV_HAVE_NUMA_SYSFS
+    static int count = std::max(1, (int)NumaTopology::getInstance().nodes.size());
+    return count;
+#else
+    return 1;
+#endif
+}
+
+unsigned getPolicyGeneration()
+{
+    return g_policyGeneration.load(std::memory_order_acquire);
+}
+
+void bindCurrentThread(unsigned index, unsigned count, bool enable)
+{
+#ifdef CV_HAVE_NUMA_SYSFS
+    const NumaTopology& topology = NumaTopology::getInstance();
+    if (topology.nodes.size() < 2)
+        return;
+    const cpu_set_t* cpus = &topology.processAffinity;
+    if (enable && count > 0)
+    {
+        size_t node = std::min((size_t)index * topology.nodes.size() / count, topology.nodes.size() - 1);
+        cpus = &topology.nodes[node];
+        CV_LOG_VERBOSE(NULL, 1, "core(numa): bind thread " << index << "/" << count << " to node " << node);
+    }
+    if (0 != sched_setaffinity(0, sizeof(cpu_set_t), cpus))
+    {
+        CV_LOG_DEBUG(NULL, "core(numa): can't set affinity of thread " << index);
+    }
+#else
+    CV_UNUSED(index); CV_UNUSED(count); CV_UNUSED(enable);
+#endif
+}
+
+bool isFirstTouchRequired(size_t size)
+{
+    return size >= getFirstTouchThreshold()
+        && getPolicyRef() == utils::NUMA_POLICY_LOCAL
+        && getNodesCount() > 1
+        && getNumThreads() > 1;
+}
+
+void firstTouch(uchar* data, size_t size, int rows, size_t rowStep)
+{
+#ifdef CV_HAVE_NUMA_SYSFS
+    static const size_t pageSize = (size_t)std::max(4096L, sysconf(_SC_PAGESIZE));
+#else
+    const size_t pageSize = 4096;
+#endif
+    if (rows <= 1 || rowStep < pageSize)
+    {
+        // use page-sized stripes
+        rowStep = pageSize;
+        rows = (int)std::min((size + pageSize - 1) / pageSize, (size_t)INT_MAX);
+    }
+    parallel_for_(Range(0, rows), [&](const Range& r)
+    {
+        uchar* begin = data + (size_t)r.start * rowStep;
+        uchar* end = data + std::min(size, (size_t)r.end * rowStep);
+        if (r.start == 0)
+            *begin = 0;  // partial first page
+        for (uchar* p = alignPtr(begin, (int)pageSize); p < end; p += pageSize)
+            *p = 0;
+    });
+}
+
+}  // namespace numa
+
+namespace utils {
+
+void setNumaPolicy(NumaPolicy policy)
+{
+    CV_Assert(policy == NUMA_POLICY_NONE || policy == NUMA_POLICY_LOCAL);
+    numa::getPolicyRef() = policy;
+    numa::g_policyGeneration.fetch_add(1, std::memory_order_acq_rel);
+}
+
+NumaPolicy getNumaPolicy()
+{
+    return numa::getPolicyRef();
+}
+
+int getNumaNodesCount()
+{
+    return numa::getNodesCount();
+}
+
+}  // namespace utils
+
+}  // namespace cv
@@ -0,0 +1,55 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#ifndef OPENCV_CORE_SRC_NUMA_HPP
+#define OPENCV_CORE_SRC_NUMA_HPP
+
+#include "opencv2/core/utils/numa.hpp"
+
+namespace cv { namespace numa {
+
+/// changed on each setNumaPolicy() call
+unsigned getPolicyGeneration();
+
+/// pin current thread to NUMA node of thread pool slot `index` (0 - main thread) or restore the process affinity
+void bindCurrentThread(unsigned index, unsigned count, bool enable);
+
+/// buffer of `size` bytes should be first-touched by parallel stripes
+bool isFirstTouchRequired(size_t size);
+
+/// touch pages of buffer by `rows` parallel stripes of `rowStep` bytes
+void firstTouch(uchar* data, size_t size, int rows, size_t rowStep);
+
+/** Tracks NUMA binding of thread pool worker thread
+ *
+ * apply() is cheap if nothing is changed, call it before processing of each job.
+ */
+class WorkerThreadBinding
+{
+public:
+    WorkerThreadBinding() : generation_(0), count_(0), isBound_(false) {}
+
+    inline void apply(unsigned index, unsigned count)
+    {
+        unsigned generation = getPolicyGeneration();
+        if (generation == generation_ && count == count_)
+            return;
+        generation_ = generation;
+        count_ = count;
+        bool enable = utils::getNumaPolicy() == utils::NUMA_POLICY_LOCAL;
+        if (enable || isBound_)
+        {
+            bindCurrentThread(index, count, enable);
+            isBound_ = enable;
+        }
+    }
+
+protected:
+    unsigned generation_;
+    unsigned count_;
+    bool isBound_;
+};
+
+}}  // namespace
+
+#endif  // OPENCV_CORE_SRC_NUMA_HPP
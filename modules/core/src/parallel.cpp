@@ -198,6 +198,28 @@ namespace {
     }
 #endif
 
+    struct ParallelForThreadState
+    {
+        ParallelForThreadState() : depth(0) {}
+        int depth;  //!< number of parallel_for_() calls and bodies executed by the thread
+    };
+
+    static cv::TLSData<ParallelForThreadState>& getParallelForThreadStateTLS()
+    {
+        CV_SINGLETON_LAZY_INIT_REF(cv::TLSData<ParallelForThreadState>, new cv::TLSData<ParallelForThreadState>())
+    }
+
+    class ParallelForDepthScope
+    {
+    public:
+        ParallelForDepthScope() : state(getParallelForThreadStateTLS().getRef()) { state.depth++; }
+        ~ParallelForDepthScope() { state.depth--; }
+    private:
+        ParallelForThreadState& state;
+        ParallelForDepthScope(const ParallelForDepthScope&); // disabled
+        ParallelForDepthScope& operator=(const ParallelForDepthScope&); // disabled
+    };
+
     class ParallelLoopBodyWrapperContext
     {
     public:
@@ -341,6 +363,7 @@ namespace {
 #if OPENCV_SUPPORTS_FP_DENORMALS_HINT && OPENCV_IMPL_FP_HINTS
             FPDenormalsIgnoreHintScope fp_denormals_scope(ctx.fp_denormals_base_state);
 #endif
+            ParallelForDepthScope depth_scope;  // worker threads
 
             cv::Range r;
             cv::Range wholeRange = ctx.wholeRange;
@@ -353,6 +376,9 @@ namespace {
 #ifdef OPENCV_TRACE
             CV_TRACE_ARG_VALUE(range_start, "range.start", (int64)r.start);
             CV_TRACE_ARG_VALUE(range_end, "range.end", (int64)r.end);
+            // stripes of nested OpenCV calls are not traced as regions (see OPENCV_TRACE_DEPTH_OPENCV)
+            const bool profileStripe = !__region_fn.isActive() && CV_TRACE_NS::details::isProfilerActivated();
+            const int64 stripeBeginTimestamp = profileStripe ? cv::getTimestampNS() : 0;
 #endif
 
             try
@@ -379,6 +405,11 @@ namespace {
             }
 #endif
 
+#ifdef OPENCV_TRACE
+            if (profileStripe)
+                CV_TRACE_NS::details::profilerRecordStripe(stripeBeginTimestamp, r.start, r.end);
+#endif
+
             if (!ctx.is_rng_used && !(cv::theRNG() == ctx.rng))
                 ctx.is_rng_used = true;
         }
@@ -504,6 +535,13 @@ static SchedPtr pplScheduler;
 
 static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes); // forward declaration
 
+static std::atomic<bool> flagNestedParallelFor(false);
+
+bool isNestedParallelForSequential()
+{
+    return getParallelForThreadStateTLS().getRef().depth > 0 && !isNestedParallelForSupported();
+}
+
 void parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes)
 {
 #ifdef OPENCV_TRACE
@@ -517,7 +555,7 @@ void parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body, dou
     if (range.empty())
         return;
 
-    static std::atomic<bool> flagNestedParallelFor(false);
+    ParallelForDepthScope depth_scope;  // calling thread
     bool isNotNestedRegion = !flagNestedParallelFor.load();
     if (isNotNestedRegion)
       isNotNestedRegion = !flagNestedParallelFor.exchange(true);
@@ -534,6 +572,10 @@ void parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body, dou
             throw;
         }
     }
+    else if (isNestedParallelForSupported())
+    {
+        parallel_for_impl(range, body, nstripes);
+    }
     else // nested parallel_for_() calls are not parallelized
     {
         CV_UNUSED(nstripes);
@@ -14,6 +14,8 @@ class IParallelBackendFactory
 public:
     virtual ~IParallelBackendFactory() {}
     virtual std::shared_ptr<cv::parallel::ParallelForAPI> create() const = 0;
+    /// backend is used only if it is requested by name (OPENCV_PARALLEL_BACKEND or setParallelForBackend())
+    virtual bool isExplicitOnly() const { return false; }
 };
 
 
@@ -21,10 +23,12 @@ class StaticBackendFactory CV_FINAL: public IParallelBackendFactory
 {
 protected:
     std::function<std::shared_ptr<cv::parallel::ParallelForAPI>(void)> create_fn_;
+    bool explicit_only_;
 
 public:
-    StaticBackendFactory(std::function<std::shared_ptr<cv::parallel::ParallelForAPI>(void)>&& create_fn)
+    StaticBackendFactory(std::function<std::shared_ptr<cv::parallel::ParallelForAPI>(void)>&& create_fn, bool explicit_only = false)
         : create_fn_(create_fn)
+        , explicit_only_(explicit_only)
     {
         // nothing
     }
@@ -35,6 +39,11 @@ public:
     {
         return create_fn_();
     }
+
+    bool isExplicitOnly() const CV_OVERRIDE
+    {
+        return explicit_only_;
+    }
 };
 
 //
@@ -60,6 +60,11 @@ std::shared_ptr<ParallelForAPI> createParallelForAPI()
             }
             isKnown = true;
         }
+        else if (info.backendFactory && info.backendFactory->isExplicitOnly())
+        {
+            CV_LOG_DEBUG(NULL, "core(parallel): skip backend (must be requested explicitly): " << info.name);
+            continue;
+        }
         try
         {
             CV_LOG_DEBUG(NULL, "core(parallel): trying backend: " << info.name << " (priority=" << info.priority << ")");
@@ -114,6 +119,12 @@ std::shared_ptr<ParallelForAPI>& getCurrentParallelForAPI()
     return g_currentParallelForAPI;
 }
 
+bool isNestedParallelForSupported()
+{
+    const std::shared_ptr<ParallelForAPI>& api = getCurrentParallelForAPI();
+    return api && dynamic_cast<const NestedParallelForAPI*>(api.get()) != NULL;
+}
+
 void setParallelForBackend(const std::shared_ptr<ParallelForAPI>& api, bool propagateNumThreads)
 {
     getCurrentParallelForAPI() = api;
@@ -12,6 +12,16 @@ extern int numThreads;
 
 std::shared_ptr<ParallelForAPI>& getCurrentParallelForAPI();
 
+/** Builtin backends which are able to execute nested parallel_for_() regions in parallel.
+ *
+ * parallel_for_() serializes nested calls for other backends.
+ */
+class NestedParallelForAPI : public ParallelForAPI
+{
+};
+
+bool isNestedParallelForSupported();
+
 #ifndef BUILD_PLUGIN
 
 #ifdef HAVE_TBB
@@ -22,6 +32,10 @@ std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendTBB();
 std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendOpenMP();
 #endif
 
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendWorkStealing();
+#endif
+
 #endif  // BUILD_PLUGIN
 
 }}  // namespace
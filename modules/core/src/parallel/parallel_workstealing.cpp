@@ -0,0 +1,418 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#include "../precomp.hpp"
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+
+#include "parallel.hpp"
+#include "../parallel_impl.hpp"  // defaultNumberOfThreads()
+#include "../numa.hpp"
+
+#include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/logger.hpp>
+#include <opencv2/core/utils/tls.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+/*
+ * Work-stealing parallel_for_ backend.
+ *
+ * Each worker owns a deque of tasks (ranges of stripes). Owner takes tasks from the back (LIFO, cache-friendly),
+ * idle threads steal from the front (FIFO, the largest pending ranges). Ranges are split lazily:
+ * executor keeps the first half and publishes the second half into its own deque until the range reaches the grain size.
+ *
+ * Thread which calls parallel_for() participates in the job and executes pending tasks (of any job) while waiting,
+ * so nested parallel_for_() regions are processed in parallel without deadlocks.
+ *
+ * setNumThreads() waits until the running jobs are completed before the workers are restarted. It is refused
+ * (with a warning) if called from a parallel region, because the job in progress would never complete.
+ *
+ * Backend is not selected automatically: use OPENCV_PARALLEL_BACKEND=WORKSTEALING or setParallelForBackend("WORKSTEALING").
+ */
+
+namespace cv { namespace parallel {
+
+namespace workstealing {
+
+// number of stripes per thread, which are used as minimal work item (grain) of lazy range splitting
+static int WS_STRIPES_PER_THREAD = (int)utils::getConfigurationParameterSizeT("OPENCV_PARALLEL_WORKSTEALING_STRIPES_PER_THREAD", 8);
+static int WS_ACTIVE_WAIT = (int)utils::getConfigurationParameterSizeT("OPENCV_PARALLEL_WORKSTEALING_ACTIVE_WAIT", 2000);  // iterations
+
+struct Job
+{
+    Job(ParallelForAPI::FN_parallel_for_body_cb_t body_callback_, void* callback_data_, int tasks, int grain_)
+        : body_callback(body_callback_)
+        , callback_data(callback_data_)
+        , grain(grain_)
+        , pending(tasks)
+        , is_completed(false)
+    {
+        // nothing
+    }
+
+    void complete(int tasks)
+    {
+        if (pending.fetch_sub(tasks, std::memory_order_acq_rel) == tasks)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            is_completed = true;
+            cond_completed.notify_all();  // under mutex: job object is owned (and destroyed) by the waiting thread
+        }
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!is_completed)
+            cond_completed.wait(lock);
+    }
+
+    const ParallelForAPI::FN_parallel_for_body_cb_t body_callback;
+    void* const callback_data;
+    const int grain;
+
+    std::atomic<int> pending;  // number of not completed stripes
+    std::mutex mutex;
+    std::condition_variable cond_completed;
+    bool is_completed;
+};
+
+struct Task
+{
+    Job* job;
+    int begin;
+    int end;
+};
+
+class TaskQueue
+{
+public:
+    void push(const Task& task)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(task);
+    }
+
+    bool pop(Task& task)  // owner side
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty())
+            return false;
+        task = tasks.back();
+        tasks.pop_back();
+        return true;
+    }
+
+    bool steal(Task& task)  // thief side
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty())
+            return false;
+        task = tasks.front();
+        tasks.pop_front();
+        return true;
+    }
+
+protected:
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    int64 dummy_[8];  // avoid cache-line sharing between queues of different threads
+};
+
+struct ThreadContext
+{
+    ThreadContext() : backend(NULL), index(0), depth(0) {}
+    const void* backend;
+    int index;  // queue index of worker thread, 0 - external threads
+    int depth;  // number of job bodies executed by the thread at the moment (nesting level)
+};
+
+class ParallelForBackend CV_FINAL : public NestedParallelForAPI
+{
+public:
+    ParallelForBackend()
+        : numThreads(0)
+        , isStarted(false)
+        , activeJobs(0)
+        , reconfiguring(false)
+        , stop(false)
+        , numSleeping(0)
+        , workEpoch(0)
+    {
+        numThreads = (int)defaultNumberOfThreads();
+    }
+
+    ~ParallelForBackend() CV_OVERRIDE
+    {
+        std::lock_guard<std::mutex> lock(mutex_config);
+        stopWorkers();
+    }
+
+    void parallel_for(int tasks, FN_parallel_for_body_cb_t body_callback, void* callback_data) CV_OVERRIDE
+    {
+        if (tasks <= 0)
+            return;
+        if (tasks == 1 || numThreads.load(std::memory_order_relaxed) <= 1)
+        {
+            body_callback(0, tasks, callback_data);
+            return;
+        }
+
+        ThreadContext& ctx = threadContext.getRef();
+        const int nThreads = beginJob(ctx);
+        if (nThreads <= 1)
+        {
+            endJob();
+            body_callback(0, tasks, callback_data);
+            return;
+        }
+
+        const int index = ctx.backend == this ? ctx.index : 0;
+        const int grain = std::max(1, tasks / (nThreads * std::max(1, WS_STRIPES_PER_THREAD)));
+        Job job(body_callback, callback_data, tasks, grain);
+        Task task = { &job, 0, tasks };
+        execute(task, index, ctx);  // publishes the most part of the range during splitting
+
+        // help others (any job) until our job is completed
+        int wait_iterations = 0;
+        while (job.pending.load(std::memory_order_acquire) > 0)
+        {
+            if (findTask(index, task))
+            {
+                execute(task, index, ctx);
+                wait_iterations = 0;
+                continue;
+            }
+            if (++wait_iterations < WS_ACTIVE_WAIT)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            break;
+        }
+        job.wait();
+        endJob();
+    }
+
+    int getThreadNum() const CV_OVERRIDE
+    {
+        return currentThreadIndex();
+    }
+
+    int getNumThreads() const CV_OVERRIDE
+    {
+        return numThreads.load(std::memory_order_relaxed);
+    }
+
+    int setNumThreads(int nThreads) CV_OVERRIDE
+    {
+        const int n = nThreads > 0 ? nThreads : 1;
+        const ThreadContext& ctx = threadContext.getRef();
+        if (ctx.depth > 0 || (ctx.backend == this && ctx.index > 0))
+        {
+            CV_LOG_ONCE_WARNING(NULL, "core(parallel): workstealing: setNumThreads() is ignored inside of parallel region");
+            return numThreads.load(std::memory_order_relaxed);
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_config);
+        const int oldNumThreads = numThreads.load(std::memory_order_relaxed);
+        if (n != oldNumThreads)
+        {
+            // drain: new jobs wait for the end of reconfiguration, running jobs are completed with the old workers
+            reconfiguring = true;
+            while (activeJobs > 0)
+                cond_config.wait(lock);
+            stopWorkers();
+            numThreads.store(n, std::memory_order_relaxed);
+            reconfiguring = false;
+            cond_config.notify_all();
+        }
+        return oldNumThreads;
+    }
+
+    const char* getName() const CV_OVERRIDE
+    {
+        return "workstealing";
+    }
+
+protected:
+    int currentThreadIndex() const
+    {
+        const ThreadContext& ctx = threadContext.getRef();
+        return ctx.backend == this ? ctx.index : 0;
+    }
+
+    /// registers the job, starts the workers if needed and returns the number of threads to use
+    int beginJob(const ThreadContext& ctx)
+    {
+        std::unique_lock<std::mutex> lock(mutex_config);
+        // nested jobs are parts of an active job, they must not wait for the reconfiguration
+        if (ctx.depth == 0)
+        {
+            while (reconfiguring)
+                cond_config.wait(lock);
+        }
+        activeJobs++;
+        startWorkers();
+        return numThreads.load(std::memory_order_relaxed);
+    }
+
+    void endJob()
+    {
+        std::lock_guard<std::mutex> lock(mutex_config);
+        if (--activeJobs == 0 && reconfiguring)
+            cond_config.notify_all();
+    }
+
+    void startWorkers()  // mutex_config must be locked
+    {
+        if (isStarted.load(std::memory_order_relaxed))
+            return;
+        stopWorkers();
+        const int n = numThreads.load(std::memory_order_relaxed);
+        CV_LOG_DEBUG(NULL, "core(parallel): workstealing: starting " << (n - 1) << " worker threads");
+        queues.resize(n);
+        for (int i = 0; i < n; i++)
+            queues[i].reset(new TaskQueue());
+        stop = false;
+        for (int i = 1; i < n; i++)
+            workers.push_back(std::thread(&ParallelForBackend::workerLoop, this, i));
+        isStarted.store(true, std::memory_order_release);
+    }
+
+    void stopWorkers()  // mutex_config must be locked
+    {
+        isStarted.store(false, std::memory_order_release);
+        if (workers.empty())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_sleep);
+            stop = true;
+            cond_sleep.notify_all();
+        }
+        for (size_t i = 0; i < workers.size(); i++)
+            workers[i].join();
+        workers.clear();
+        queues.clear();
+    }
+
+    void push(const Task& task, int index)
+    {
+        queues[index]->push(task);
+        workEpoch.fetch_add(1, std::memory_order_seq_cst);
+        if (numSleeping.load(std::memory_order_seq_cst) > 0)
+        {
+            std::lock_guard<std::mutex> lock(mutex_sleep);
+            cond_sleep.notify_one();
+        }
+    }
+
+    bool findTask(int index, Task& task)
+    {
+        if (queues[index]->pop(task))
+            return true;
+        const int n = (int)queues.size();
+        for (int i = 1; i < n; i++)
+        {
+            int victim = index + i;
+            if (victim >= n)
+                victim -= n;
+            if (queues[victim]->steal(task))
+                return true;
+        }
+        return false;
+    }
+
+    void execute(Task task, int index, ThreadContext& ctx)
+    {
+        Job& job = *task.job;
+        while (task.end - task.begin > job.grain)
+        {
+            int mid = task.begin + (task.end - task.begin) / 2;
+            Task tail = { task.job, mid, task.end };
+            push(tail, index);
+            task.end = mid;
+        }
+        ctx.depth++;
+        job.body_callback(task.begin, task.end, job.callback_data);
+        ctx.depth--;
+        job.complete(task.end - task.begin);
+    }
+
+    void workerLoop(int index)
+    {
+        (void)cv::utils::getThreadID(); // notify OpenCV about new thread
+        ThreadContext& ctx = threadContext.getRef();
+        ctx.backend = this;
+        ctx.index = index;
+        CV_LOG_VERBOSE(NULL, 5, "core(parallel): workstealing: new worker thread: " << index);
+
+        numa::WorkerThreadBinding numa_binding;
+        Task task;
+        while (!stop)
+        {
+            numa_binding.apply(index, numThreads.load(std::memory_order_relaxed));
+            unsigned epoch = workEpoch.load(std::memory_order_seq_cst);
+            bool found = false;
+            for (int i = 0; i < WS_ACTIVE_WAIT && !found && !stop; i++)
+            {
+                found = findTask(index, task);
+                if (!found)
+                    std::this_thread::yield();
+            }
+            if (found)
+            {
+                execute(task, index, ctx);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex_sleep);
+            numSleeping.fetch_add(1, std::memory_order_seq_cst);
+            while (!stop && workEpoch.load(std::memory_order_seq_cst) == epoch)
+                cond_sleep.wait(lock);
+            numSleeping.fetch_sub(1, std::memory_order_seq_cst);
+        }
+        ctx.backend = NULL;
+        ctx.index = 0;
+    }
+
+    std::atomic<int> numThreads;  // changed under mutex_config when there are no active jobs
+
+    std::mutex mutex_config;  // guards workers/queues (re)configuration and the fields below
+    std::condition_variable cond_config;
+    std::atomic<bool> isStarted;
+    int activeJobs;  // queues and workers are not changed while there are active jobs
+    bool reconfiguring;
+    std::vector<std::thread> workers;
+    std::vector< std::unique_ptr<TaskQueue> > queues;  // 0 - shared queue of external threads, 1..N-1 - worker threads
+
+    std::mutex mutex_sleep;
+    std::condition_variable cond_sleep;
+    std::atomic<bool> stop;
+    std::atomic<int> numSleeping;
+    std::atomic<unsigned> workEpoch;
+
+    TLSData<ThreadContext> threadContext;
+};
+
+}  // namespace workstealing
+
+static
+std::shared_ptr<workstealing::ParallelForBackend>& getWorkStealingInstance()
+{
+    static std::shared_ptr<workstealing::ParallelForBackend> g_instance = std::make_shared<workstealing::ParallelForBackend>();
+    return g_instance;
+}
+
+std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendWorkStealing()
+{
+    return getWorkStealingInstance();
+}
+
+}}  // namespace
+
+#endif  // OPENCV_DISABLE_THREAD_SUPPORT
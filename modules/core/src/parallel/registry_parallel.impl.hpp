@@ -24,6 +24,12 @@ ParallelBackendInfo { \
     1000, name, std::make_shared<cv::parallel::StaticBackendFactory>([=] () -> std::shared_ptr<cv::parallel::ParallelForAPI> { return createBackendAPI(); }) \
 },
 
+// builtin backends which are not selected automatically (opt-in via OPENCV_PARALLEL_BACKEND=<name> or setParallelForBackend(<name>))
+#define DECLARE_STATIC_BACKEND_EXPLICIT(name, createBackendAPI) \
+ParallelBackendInfo { \
+    1000, name, std::make_shared<cv::parallel::StaticBackendFactory>([=] () -> std::shared_ptr<cv::parallel::ParallelForAPI> { return createBackendAPI(); }, true) \
+},
+
 static
 std::vector<ParallelBackendInfo>& getBuiltinParallelBackendsInfo()
 {
@@ -41,6 +47,10 @@ std::vector<ParallelBackendInfo>& getBuiltinParallelBackendsInfo()
 #elif defined(PARALLEL_ENABLE_PLUGINS)
         DECLARE_DYNAMIC_BACKEND("OPENMP")  // TODO Intel OpenMP?
 #endif
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        DECLARE_STATIC_BACKEND_EXPLICIT("WORKSTEALING", createParallelBackendWorkStealing)
+#endif
     };
     return g_backends;
 }
@@ -5,6 +5,7 @@
 #include "precomp.hpp"
 
 #include "parallel_impl.hpp"
+#include "numa.hpp"
 
 #ifdef HAVE_PTHREADS_PF
 #include <pthread.h>
@@ -206,6 +207,8 @@ public:
 
     Ptr<ParallelJob> job;
 
+    numa::WorkerThreadBinding numa_binding;
+
     pthread_mutex_t mutex;
 #if !defined(CV_USE_GLOBAL_WORKERS_COND_VAR)
     volatile bool isActive;
@@ -429,6 +432,7 @@ void WorkerThread::thread_body()
             ParallelJob* j = j_ptr;
             if (j)
             {
+                numa_binding.apply(id + 1, thread_pool.num_threads);  // slot 0 is the main thread
                 CV_LOG_VERBOSE(NULL, 5, "Thread: job size=" << j->range.size() << " done=" << j->current_task);
                 if (j->current_task < j->range.size())
                 {
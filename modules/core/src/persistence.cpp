@@ -444,6 +444,7 @@ void FileStorage::Impl::init() {
     fs_data_ptrs.clear();
     fs_data_blksz.clear();
     freeSpaceOfs = 0;
+    stream_stack.clear();
 
     str_hash.clear();
     str_hash_data.clear();
@@ -456,6 +457,7 @@ void FileStorage::Impl::init() {
 
 FileStorage::Impl::Impl(FileStorage *_fs) {
     fs_ext = _fs;
+    visitor = 0;
     init();
 }
 
@@ -769,6 +771,12 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
             writeInt(rptr + 5, 0);
 
             roots.clear();
+            stream_stack.clear();
+            if (visitor) {
+                StreamLevel level = { root_nodes.blockIdx, root_nodes.ofs, FileNodeVisitor::ENTER, -2,
+                                      false, false, 0, 0 };
+                stream_stack.push_back(level);
+            }
 
             switch (fmt) {
                 case FileStorage::FORMAT_XML:
@@ -788,7 +796,8 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
                 ok = getParser().parse(ptr);
                 if (ok) {
                     finalizeCollection(root_nodes);
-
+                }
+                if (ok && !visitor) {
                     CV_Assert(!fs_data_ptrs.empty());
                     FileNode roots_node(fs_ext, 0, 0);
                     size_t i, nroots = roots_node.size();
@@ -1473,6 +1482,7 @@ void FileStorage::Impl::convertToCollection(int type, FileNode &node) {
             CV_Error_(Error::StsError, ("The node of type %d cannot be converted to collection", node_type));
     }
 
+    size_t oldBlockIdx = node.blockIdx, oldOfs = node.ofs;
     ptr = reserveNodeSpace(node, 1 + (named ? 4 : 0) + 4 + 4);
     *ptr++ = (uchar) (type | (named ? FileNode::NAMED : 0));
     // name has been copied automatically
@@ -1482,6 +1492,9 @@ void FileStorage::Impl::convertToCollection(int type, FileNode &node) {
     writeInt(ptr, 4);
     writeInt(ptr + 4, 0);
 
+    if (visitor)
+        streamStartCollection(node, oldBlockIdx, oldOfs);
+
     if (add_first_scalar)
         addNode(node, std::string(), node_type,
                 node_type == FileNode::INT ? (const void *) &ival :
@@ -1579,6 +1592,12 @@ FileNode FileStorage::Impl::addNode(FileNode &collection, const std::string &key
     if (noname != isseq)
         CV_PARSE_ERROR_CPP(noname ? "Map element should have a name" :
                            "Sequence element should not have name (use <_></_>)");
+
+    // the previous element of the collection is complete
+    StreamLevel* level = visitor ? streamFindLevel(collection) : 0;
+    if (level)
+        streamFlush(*level);
+
     unsigned strofs = 0;
     if (!noname) {
         strofs = getStringOfs(key);
@@ -1622,12 +1641,30 @@ FileNode FileStorage::Impl::addNode(FileNode &collection, const std::string &key
     int nelems = readInt(cp + 5);
     writeInt(cp + 5, nelems + 1);
 
+    if (level) {
+        level->hasPending = true;
+        level->pendingVisit = true;
+        level->pendingBlockIdx = node.blockIdx;
+        level->pendingOfs = node.ofs;
+        if (elem_type == FileNode::SEQ || elem_type == FileNode::MAP)
+            streamStartCollection(node, node.blockIdx, node.ofs);
+    }
+
     return node;
 }
 
+// FileNode::name() is valid for named nodes only (sequence elements have no name)
+static inline std::string streamNodeName(const FileNode &node) {
+    return node.isNamed() ? node.name() : std::string();
+}
+
 void FileStorage::Impl::finalizeCollection(FileNode &collection) {
     if (!collection.isSeq() && !collection.isMap())
         return;
+    StreamLevel* level = visitor ? streamFindLevel(collection) : 0;
+    if (level)
+        streamFlush(*level);
+
     uchar *ptr0 = collection.ptr(), *ptr = ptr0 + 1;
     if (*ptr0 & FileNode::NAMED)
         ptr += 4;
@@ -1645,6 +1682,100 @@ void FileStorage::Impl::finalizeCollection(FileNode &collection) {
     }
     rawSize += freeSpaceOfs - ofs;
     writeInt(ptr, (int) rawSize);
+
+    if (level) {
+        int action = level->action, depth = level->depth;
+        CV_DbgAssert(level == &stream_stack.back());
+        stream_stack.pop_back();
+        if (action == FileNodeVisitor::ENTER && depth >= 0)
+            visitor->endCollection(streamNodeName(collection), collection.type(), depth);
+    }
+}
+
+FileStorage::Impl::StreamLevel* FileStorage::Impl::streamFindLevel(const FileNode &collection) {
+    size_t i = stream_stack.size();
+    while (i > 0 && (stream_stack[i - 1].blockIdx != collection.blockIdx || stream_stack[i - 1].ofs != collection.ofs))
+        i--;
+    if (i == 0)
+        return 0;
+    // nested collections that have not been finalized explicitly are complete
+    while (stream_stack.size() > i) {
+        StreamLevel& top = stream_stack.back();
+        streamFlush(top);
+        int action = top.action, depth = top.depth;
+        FileNode node(fs_ext, top.blockIdx, top.ofs);
+        stream_stack.pop_back();
+        if (action == FileNodeVisitor::ENTER && depth >= 0)
+            visitor->endCollection(streamNodeName(node), node.type(), depth);
+    }
+    return &stream_stack[i - 1];
+}
+
+FileStorage::Impl::StreamLevel* FileStorage::Impl::streamFindParent(size_t blockIdx, size_t ofs) {
+    for (size_t i = stream_stack.size(); i > 0; i--) {
+        StreamLevel& level = stream_stack[i - 1];
+        if (level.hasPending && level.pendingBlockIdx == blockIdx && level.pendingOfs == ofs)
+            return &level;
+    }
+    return 0;
+}
+
+// called when `node` (the last element of some collection) becomes a collection,
+// (oldBlockIdx, oldOfs) is the node position before reallocation
+void FileStorage::Impl::streamStartCollection(FileNode &node, size_t oldBlockIdx, size_t oldOfs) {
+    StreamLevel* parent = streamFindParent(oldBlockIdx, oldOfs);
+    if (!parent)
+        return;
+    parent->pendingBlockIdx = node.blockIdx;
+    parent->pendingOfs = node.ofs;
+
+    int depth = parent->depth + 1;
+    int action = parent->action;
+    if (action == FileNodeVisitor::ENTER && depth >= 0) {
+        action = visitor->startCollection(streamNodeName(node), node.type(), depth);
+        CV_Check(action, action == FileNodeVisitor::ENTER || action == FileNodeVisitor::SKIP ||
+                         action == FileNodeVisitor::MATERIALIZE, "Unknown FileNodeVisitor action");
+    }
+    parent->pendingVisit = action == FileNodeVisitor::MATERIALIZE;
+
+    StreamLevel level = { node.blockIdx, node.ofs, action, depth, false, false, 0, 0 };
+    stream_stack.push_back(level);
+}
+
+// reports the last element of the collection and releases its storage
+void FileStorage::Impl::streamFlush(StreamLevel &level) {
+    if (!level.hasPending)
+        return;
+    level.hasPending = false;
+    if (level.action == FileNodeVisitor::MATERIALIZE)
+        return;
+
+    if (level.action == FileNodeVisitor::ENTER && level.pendingVisit && level.depth + 1 >= 0) {
+        FileNode elem(fs_ext, level.pendingBlockIdx, level.pendingOfs);
+        visitor->visit(streamNodeName(elem), elem, level.depth + 1);
+    }
+
+    // all other elements have been released already, so drop everything after the collection header
+    // (the element may have been moved to the next block by reserveNodeSpace())
+    FileNode collection(fs_ext, level.blockIdx, level.ofs);
+    size_t headerSize = 1 + (collection.isNamed() ? 4 : 0) + 8;
+    uchar* cp = collection.ptr() + headerSize - 8;
+    writeInt(cp + 4, readInt(cp + 4) - 1);
+
+    size_t blockIdx = level.blockIdx;
+    while (fs_data.size() > blockIdx + 1) {
+        fs_data.pop_back();
+        fs_data_ptrs.pop_back();
+        fs_data_blksz.pop_back();
+    }
+    // restore the tail of the block cut off by reserveNodeSpace() (no reallocation within the capacity)
+    std::vector<uchar>& block = *fs_data[blockIdx];
+    if (block.size() < block.capacity()) {
+        block.resize(block.capacity());
+        fs_data_ptrs[blockIdx] = &block[0];
+        fs_data_blksz[blockIdx] = block.size();
+    }
+    freeSpaceOfs = level.ofs + headerSize;
 }
 
 void FileStorage::Impl::normalizeNodeOfs(size_t &blockIdx, size_t &ofs) const {
@@ -1800,6 +1931,22 @@ double FileStorage::Impl::Base64Decoder::getFloat64() {
     return fval;
 }
 
+size_t FileStorage::Impl::Base64Decoder::getBytes(uchar *dst, size_t count) {
+    size_t n = 0;
+    while (n < count) {
+        if (ofs >= decoded.size()) {
+            readMore((int) std::min(count - n, (size_t) INT_MAX));
+            if (ofs >= decoded.size())
+                break;
+        }
+        size_t k = std::min(count - n, decoded.size() - ofs);
+        memcpy(dst + n, &decoded[ofs], k);
+        ofs += k;
+        n += k;
+    }
+    return n;
+}
+
 bool FileStorage::Impl::Base64Decoder::endOfStream() const { return eos; }
 
 char *FileStorage::Impl::Base64Decoder::getPtr() const { return ptr; }
@@ -1826,6 +1973,41 @@ char *FileStorage::Impl::parseBase64(char *ptr, int indent, FileNode &collection
     int64_t ival = 0;
     double fval = 0;
 
+    // streaming mode: decode homogeneous data directly into the buffer provided by the visitor
+    StreamLevel* parent = visitor ? streamFindParent(collection.blockIdx, collection.ofs) : 0;
+    if (parent && parent->action == FileNodeVisitor::ENTER && parent->depth + 1 >= 0) {
+        int elem_depth = fmt_pairs[1];
+        for (k = 1; k < fmt_pair_count; k++)
+            if (fmt_pairs[k * 2 + 1] != elem_depth)
+                elem_depth = -1;
+        Mat dst;
+        if (elem_depth >= 0)
+            dst = visitor->rawDataBuffer(streamNodeName(collection), dt, parent->depth + 1);
+        if (!dst.empty()) {
+            CV_CheckDepthEQ(dst.depth(), elem_depth, "Destination buffer doesn't match the format of base64 data");
+            CV_Assert(dst.isContinuous());
+            size_t esz = CV_ELEM_SIZE1(elem_depth), nbytes = dst.total() * dst.elemSize();
+            uchar *data = dst.ptr(), extra = 0;
+            if (base64decoder.getBytes(data, nbytes) != nbytes || base64decoder.getBytes(&extra, 1) != 0)
+                CV_Error(Error::StsUnmatchedSizes, "The size of base64 data doesn't match the destination buffer");
+#if !CV_LITTLE_ENDIAN_MEM_ACCESS
+            // the data is stored in little-endian byte order
+            for (size_t j = 0; j < nbytes; j += esz) {
+                uint64_t v = 0;
+                for (size_t b = 0; b < esz; b++)
+                    v |= (uint64_t) data[j + b] << (b * 8);
+                if (esz == 2) { ushort v16 = (ushort) v; memcpy(data + j, &v16, 2); }
+                else if (esz == 4) { unsigned v32 = (unsigned) v; memcpy(data + j, &v32, 4); }
+                else if (esz == 8) memcpy(data + j, &v, 8);
+            }
+#else
+            CV_UNUSED(esz);
+#endif
+            parent->pendingVisit = false;
+            return base64decoder.getPtr();
+        }
+    }
+
     for (;;) {
         for (k = 0; k < fmt_pair_count; k++) {
             int elem_type = fmt_pairs[k * 2 + 1];
@@ -1957,6 +2139,36 @@ bool FileStorage::open(const String& filename, int flags, const String& encoding
     }
 }
 
+bool FileStorage::readStream(const String& filename, FileNodeVisitor& visitor, int flags)
+{
+    CV_Assert((flags & 3) == READ);
+    FileStorage fs;
+    fs.p->visitor = &visitor;
+    bool ok = false;
+    try
+    {
+        ok = fs.p->open(filename.c_str(), flags, 0);
+    }
+    catch (...)
+    {
+        fs.p->visitor = 0;
+        throw;
+    }
+    fs.p->visitor = 0;
+    fs.release();
+    return ok;
+}
+
+FileNodeVisitor::~FileNodeVisitor() {}
+
+int FileNodeVisitor::startCollection(const std::string&, int, int) { return ENTER; }
+
+void FileNodeVisitor::visit(const std::string&, const FileNode&, int) {}
+
+void FileNodeVisitor::endCollection(const std::string&, int, int) {}
+
+Mat FileNodeVisitor::rawDataBuffer(const std::string&, const std::string&, int) { return Mat(); }
+
 bool FileStorage::isOpened() const { return p->is_opened; }
 
 void FileStorage::release()
@@ -153,6 +153,9 @@ public:
 
         double getFloat64();
 
+        //! copies up to `count` decoded bytes to `dst`, returns the number of copied bytes
+        size_t getBytes(uchar* dst, size_t count);
+
         bool endOfStream() const;
         char* getPtr() const;
     protected:
@@ -175,6 +178,26 @@ public:
 
     char* parseBase64(char* ptr, int indent, FileNode& collection);
 
+    // Streaming mode (FileStorage::readStream()).
+    // The parsers allocate nodes in document order, so once an element of a collection is complete
+    // (the next element is added or the collection is finalized) it is reported to the visitor and
+    // its storage is released by moving freeSpaceOfs back. Only the current path of collections
+    // (stream_stack) and the materialized collections are stored.
+    struct StreamLevel
+    {
+        size_t blockIdx, ofs;   //!< the collection node
+        int action;             //!< FileNodeVisitor::Action
+        int depth;              //!< -2 for the list of streams, -1 for stream roots
+        bool hasPending;        //!< the last element is not reported yet
+        bool pendingVisit;      //!< the last element should be passed to FileNodeVisitor::visit()
+        size_t pendingBlockIdx, pendingOfs;
+    };
+
+    StreamLevel* streamFindLevel( const FileNode& collection );
+    StreamLevel* streamFindParent( size_t blockIdx, size_t ofs );
+    void streamStartCollection( FileNode& node, size_t oldBlockIdx, size_t oldOfs );
+    void streamFlush( StreamLevel& level );
+
     void parseError( const char* func_name, const std::string& err_msg, const char* source_file, int source_line );
 
     const uchar* getNodePtr(size_t blockIdx, size_t ofs) const;
@@ -239,6 +262,9 @@ public:
     str_hash_t str_hash;
     std::vector<char> str_hash_data;
 
+    FileNodeVisitor* visitor;
+    std::vector<StreamLevel> stream_stack;
+
     std::vector<char> strbufv;
     char* strbuf;
     size_t strbufsize;
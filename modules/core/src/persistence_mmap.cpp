@@ -0,0 +1,476 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "precomp.hpp"
+#include "opencv2/core/mat_storage.hpp"
+#include "opencv2/core/utils/filesystem.private.hpp"
+#include "opencv2/core/utils/logger.hpp"
+
+#include <map>
+#include <set>
+
+#if OPENCV_HAVE_FILESYSTEM_SUPPORT
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#undef NOMINMAX
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#endif
+
+/*
+ * Binary matrix container.
+ *
+ * [FileHeader][data of matrix 0][data of matrix 1]...[index]
+ *
+ * Data of each matrix is continuous and aligned to MatStorageWriter::ALIGNMENT bytes.
+ * The index is a sequence of IndexEntry records, each followed by dims sizes (int32)
+ * and the name (nameLength bytes), padded to 8 bytes.
+ * All fields use the native byte order, FileHeader::byteOrder is used to detect a mismatch.
+ */
+
+namespace cv {
+
+namespace {
+
+static const char MAT_STORAGE_MAGIC[8] = { 'C', 'V', 'M', 'A', 'T', 'S', 'T', 'G' };
+static const uint32_t MAT_STORAGE_VERSION = 1;
+static const uint32_t MAT_STORAGE_BYTE_ORDER = 0x01020304;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t indexOffset;
+    uint64_t indexSize;
+    uint32_t count;
+    uint32_t reserved[7];
+};
+
+struct IndexEntry
+{
+    uint64_t offset;
+    uint64_t size;
+    int32_t type;
+    int32_t dims;
+    int32_t nameLength;
+    int32_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == (size_t)MatStorageWriter::ALIGNMENT, "");
+static_assert(sizeof(IndexEntry) % 8 == 0, "");
+
+static inline uint64_t alignSize64(uint64_t sz, uint64_t n)
+{
+    return (sz + n - 1) & ~(n - 1);
+}
+
+} // namespace
+
+//==================================================================================================
+
+class MatStorageWriter::Impl
+{
+public:
+    Impl() : file(0), pos(0) {}
+    ~Impl()
+    {
+        if (file)
+            fclose(file);  // release() has failed, the file is incomplete
+    }
+
+    bool open(const String& filename)
+    {
+        close();
+        file = fopen(filename.c_str(), "wb");
+        if (!file)
+            return false;
+        FileHeader header;
+        memset(&header, 0, sizeof(header));
+        writeBytes(&header, sizeof(header));
+        return true;
+    }
+
+    void write(const String& name, InputArray _mat)
+    {
+        CV_Assert(file);
+        CV_Assert(!name.empty());
+        if (names.count(name))
+            CV_Error_(Error::StsBadArg, ("Matrix '%s' is already stored", name.c_str()));
+
+        Mat mat = _mat.getMat();
+        CV_Assert(mat.dims <= CV_MAX_DIM);
+        padTo(alignSize64(pos, ALIGNMENT));
+
+        IndexEntry e;
+        memset(&e, 0, sizeof(e));
+        e.offset = pos;
+        e.size = mat.total() * mat.elemSize();
+        e.type = mat.type();
+        e.dims = mat.empty() ? 0 : mat.dims;
+        e.nameLength = (int32_t)name.size();
+
+        if (!mat.empty())
+        {
+            const Mat* arrays[] = { &mat, 0 };
+            uchar* ptrs[1] = {};
+            NAryMatIterator it(arrays, ptrs);
+            size_t planeSize = it.size * mat.elemSize();
+            for (size_t i = 0; i < it.nplanes; i++, ++it)
+                writeBytes(ptrs[0], planeSize);
+        }
+
+        size_t ofs = index.size();
+        index.resize(ofs + alignSize(sizeof(e) + e.dims * sizeof(int32_t) + name.size(), 8));
+        uchar* p = &index[ofs];
+        memcpy(p, &e, sizeof(e));
+        p += sizeof(e);
+        for (int i = 0; i < e.dims; i++, p += sizeof(int32_t))
+        {
+            int32_t sz = mat.size.p[i];
+            memcpy(p, &sz, sizeof(sz));
+        }
+        memcpy(p, name.c_str(), name.size());
+        names.insert(name);
+    }
+
+    void close()
+    {
+        if (!file)
+            return;
+        padTo(alignSize64(pos, 8));
+        FileHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, MAT_STORAGE_MAGIC, sizeof(header.magic));
+        header.version = MAT_STORAGE_VERSION;
+        header.byteOrder = MAT_STORAGE_BYTE_ORDER;
+        header.indexOffset = pos;
+        header.indexSize = index.size();
+        header.count = (uint32_t)names.size();
+        if (!index.empty())
+            writeBytes(&index[0], index.size());
+        bool ok = fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, file) == 1;
+        ok = fclose(file) == 0 && ok;
+        file = 0;
+        pos = 0;
+        index.clear();
+        names.clear();
+        if (!ok)
+            CV_Error(Error::StsError, "Can't write the index of matrix storage");
+    }
+
+    void writeBytes(const void* data, size_t size)
+    {
+        if (size > 0 && fwrite(data, 1, size, file) != size)
+            CV_Error(Error::StsError, "Can't write to matrix storage file");
+        pos += size;
+    }
+
+    void padTo(uint64_t newPos)
+    {
+        static const uchar zeros[ALIGNMENT] = {};
+        CV_DbgAssert(newPos >= pos && newPos - pos <= sizeof(zeros));
+        writeBytes(zeros, (size_t)(newPos - pos));
+    }
+
+    FILE* file;
+    uint64_t pos;
+    std::vector<uchar> index;
+    std::set<String> names;
+};
+
+MatStorageWriter::MatStorageWriter() : p(makePtr<Impl>()) {}
+
+MatStorageWriter::MatStorageWriter(const String& filename) : p(makePtr<Impl>())
+{
+    open(filename);
+}
+
+MatStorageWriter::~MatStorageWriter()
+{
+    try
+    {
+        release();
+    }
+    catch (const cv::Exception& e)
+    {
+        CV_LOG_ERROR(NULL, "MatStorageWriter: can't finalize matrix storage file: " << e.what());
+    }
+}
+
+bool MatStorageWriter::open(const String& filename) { return p->open(filename); }
+
+bool MatStorageWriter::isOpened() const { return p->file != 0; }
+
+void MatStorageWriter::write(const String& name, InputArray mat) { p->write(name, mat); }
+
+void MatStorageWriter::release() { p->close(); }
+
+//==================================================================================================
+
+namespace {
+
+/* Private (copy-on-write) read-only file mapping.
+   It is used as allocator of the returned matrices, each UMatData holds a reference to the mapping. */
+class MappedFile CV_FINAL : public MatAllocator
+{
+public:
+    MappedFile() : data(0), size(0)
+#ifdef _WIN32
+        , hFile(INVALID_HANDLE_VALUE), hMapping(NULL)
+#endif
+    {}
+
+    ~MappedFile()
+    {
+#if OPENCV_HAVE_FILESYSTEM_SUPPORT
+#ifdef _WIN32
+        if (data)
+            UnmapViewOfFile(data);
+        if (hMapping)
+            CloseHandle(hMapping);
+        if (hFile != INVALID_HANDLE_VALUE)
+            CloseHandle(hFile);
+#else
+        if (data)
+            munmap(data, size);
+#endif
+#endif
+    }
+
+    bool map(const String& filename)
+    {
+#if OPENCV_HAVE_FILESYSTEM_SUPPORT
+#ifdef _WIN32
+        hFile = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+        if (hFile == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0)
+            return false;
+        size = (size_t)fileSize.QuadPart;
+        hMapping = CreateFileMappingA(hFile, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+        if (!hMapping)
+            return false;
+        data = (uchar*)MapViewOfFile(hMapping, FILE_MAP_COPY, 0, 0, 0);
+        return data != 0;
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        size = (size_t)st.st_size;
+        void* ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (ptr == MAP_FAILED)
+            return false;
+        data = (uchar*)ptr;
+        return true;
+#endif
+#else
+        CV_UNUSED(filename);
+        CV_Error(Error::StsNotImplemented, "File system support is disabled in this OpenCV build");
+#endif
+    }
+
+    UMatData* allocate(int dims, const int* sizes, int type, void* data0, size_t* step,
+                       AccessFlag flags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        return Mat::getStdAllocator()->allocate(dims, sizes, type, data0, step, flags, usageFlags);
+    }
+
+    bool allocate(UMatData* u, AccessFlag accessFlags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        return Mat::getStdAllocator()->allocate(u, accessFlags, usageFlags);
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if (!u)
+            return;
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        Ptr<MappedFile>* holder = (Ptr<MappedFile>*)u->userdata;
+        delete u;
+        delete holder;  // may destroy this object
+    }
+
+    uchar* data;
+    size_t size;
+#if OPENCV_HAVE_FILESYSTEM_SUPPORT && defined(_WIN32)
+    HANDLE hFile;
+    HANDLE hMapping;
+#endif
+};
+
+} // namespace
+
+class MatStorageReader::Impl
+{
+public:
+    struct Entry
+    {
+        String name;
+        int type;
+        std::vector<int> sizes;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    bool open(const String& filename)
+    {
+        release();
+        Ptr<MappedFile> m = makePtr<MappedFile>();
+        if (!m->map(filename))
+            return false;
+
+        const uchar* data = m->data;
+        const uint64_t fileSize = m->size;
+        FileHeader header;
+        if (fileSize < sizeof(header))
+            CV_Error(Error::StsParseError, "Invalid matrix storage file: the file is too small");
+        memcpy(&header, data, sizeof(header));
+        if (memcmp(header.magic, MAT_STORAGE_MAGIC, sizeof(header.magic)) != 0)
+            CV_Error(Error::StsParseError, "Invalid matrix storage file: wrong signature");
+        if (header.byteOrder != MAT_STORAGE_BYTE_ORDER)
+            CV_Error(Error::StsParseError, "Matrix storage file has been written on a platform with different byte order");
+        if (header.version != MAT_STORAGE_VERSION)
+            CV_Error_(Error::StsParseError, ("Unsupported matrix storage version: %u", header.version));
+        if (header.indexOffset > fileSize || header.indexSize > fileSize - header.indexOffset)
+            CV_Error(Error::StsParseError, "Invalid matrix storage file: the index is out of file bounds");
+        if (header.count > header.indexSize / sizeof(IndexEntry))
+            CV_Error(Error::StsParseError, "Invalid matrix storage file: too many index entries");
+
+        std::vector<Entry> newEntries(header.count);
+        const uchar* p = data + header.indexOffset;
+        const uchar* indexEnd = p + header.indexSize;
+        for (uint32_t i = 0; i < header.count; i++)
+        {
+            // all reads below are within [p; p + recordSize), recordSize is checked against the index end
+            IndexEntry e;
+            const size_t available = (size_t)(indexEnd - p);
+            if (available < sizeof(e))
+                CV_Error(Error::StsParseError, "Invalid matrix storage file: truncated index");
+            memcpy(&e, p, sizeof(e));
+            if (e.dims < 0 || e.dims > CV_MAX_DIM || e.nameLength <= 0 ||
+                e.offset > fileSize || e.size > fileSize - e.offset)
+                CV_Error(Error::StsParseError, "Invalid matrix storage file: corrupted index entry");
+            const uint64_t recordSize = alignSize64(sizeof(e) + e.dims * sizeof(int32_t) + (uint64_t)e.nameLength, 8);
+            if (recordSize > available)
+                CV_Error(Error::StsParseError, "Invalid matrix storage file: truncated index");
+            // data is aligned by the writer, so returned matrices are aligned to the element size too
+            if (e.offset % MatStorageWriter::ALIGNMENT != 0)
+                CV_Error(Error::StsParseError, "Invalid matrix storage file: misaligned matrix data");
+            const uchar* recordEnd = p + recordSize;
+            p += sizeof(e);
+
+            Entry& entry = newEntries[i];
+            entry.type = CV_MAT_TYPE(e.type);
+            entry.offset = e.offset;
+            entry.size = e.size;
+            entry.sizes.resize(e.dims);
+            uint64_t total = e.dims > 0 ? (uint64_t)CV_ELEM_SIZE(entry.type) : 0;
+            for (int k = 0; k < e.dims; k++, p += sizeof(int32_t))
+            {
+                int32_t sz;
+                memcpy(&sz, p, sizeof(sz));
+                if (sz < 0)
+                    CV_Error(Error::StsParseError, "Invalid matrix storage file: negative matrix size");
+                entry.sizes[k] = sz;
+                if (sz != 0 && total > std::numeric_limits<uint64_t>::max() / (uint64_t)sz)
+                    CV_Error(Error::StsParseError, "Invalid matrix storage file: matrix size overflow");
+                total *= (uint64_t)sz;
+            }
+            if (total != e.size)
+                CV_Error(Error::StsParseError, "Invalid matrix storage file: matrix size mismatch");
+            entry.name.assign((const char*)p, (size_t)e.nameLength);
+            p = recordEnd;
+            byName[entry.name] = i;
+        }
+        entries.swap(newEntries);
+        mapping = m;
+        return true;
+    }
+
+    void release()
+    {
+        mapping.release();
+        entries.clear();
+        byName.clear();
+    }
+
+    Mat get(const String& name) const
+    {
+        std::map<String, size_t>::const_iterator it = byName.find(name);
+        if (!mapping || it == byName.end())
+            return Mat();
+        const Entry& e = entries[it->second];
+        if (e.sizes.empty())
+            return Mat();
+
+        uchar* data = mapping->data + e.offset;
+        Mat m((int)e.sizes.size(), &e.sizes[0], e.type, data);
+        UMatData* u = new UMatData(mapping.get());
+        u->data = u->origdata = data;
+        u->size = (size_t)e.size;
+        u->flags |= UMatData::USER_ALLOCATED;
+        u->userdata = new Ptr<MappedFile>(mapping);
+        u->refcount = 1;
+        m.u = u;
+        return m;
+    }
+
+    Ptr<MappedFile> mapping;
+    std::vector<Entry> entries;
+    std::map<String, size_t> byName;
+};
+
+MatStorageReader::MatStorageReader() : p(makePtr<Impl>()) {}
+
+MatStorageReader::MatStorageReader(const String& filename) : p(makePtr<Impl>())
+{
+    open(filename);
+}
+
+MatStorageReader::~MatStorageReader() {}
+
+bool MatStorageReader::open(const String& filename)
+{
+    CV_INSTRUMENT_REGION();
+    return p->open(filename);
+}
+
+bool MatStorageReader::isOpened() const { return !p->mapping.empty(); }
+
+void MatStorageReader::release() { p->release(); }
+
+std::vector<String> MatStorageReader::names() const
+{
+    std::vector<String> result;
+    for (size_t i = 0; i < p->entries.size(); i++)
+        result.push_back(p->entries[i].name);
+    return result;
+}
+
+bool MatStorageReader::contains(const String& name) const
+{
+    return p->byName.count(name) != 0;
+}
+
+Mat MatStorageReader::get(const String& name) const { return p->get(name); }
+
+} // namespace
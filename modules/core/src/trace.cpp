@@ -6,6 +6,7 @@
 
 #include <opencv2/core/utils/trace.hpp>
 #include <opencv2/core/utils/trace.private.hpp>
+#include <opencv2/core/utils/trace_profiler.hpp>
 #include <opencv2/core/utils/configuration.private.hpp>
 
 #include <opencv2/core/opencl/ocl_defs.hpp>
@@ -15,6 +16,7 @@
 #include <sstream>
 #include <ostream>
 #include <fstream>
+#include <map>
 
 #if 0
 #define CV_LOG(...) CV_LOG_INFO(NULL, __VA_ARGS__)
@@ -80,6 +82,24 @@ static const cv::String& getParameterTraceLocation()
     return param_traceLocation;
 }
 
+static size_t getParameterProfilerBufferSize()
+{
+    static size_t param_profilerBufferSize = std::max((size_t)1, utils::getConfigurationParameterSizeT("OPENCV_TRACE_PROFILER_BUFFER_SIZE", 65536));
+    return param_profilerBufferSize;
+}
+
+static std::atomic<int>& getProfilerSamplingPeriodRef()
+{
+    static std::atomic<int> period(std::max(1, (int)utils::getConfigurationParameterSizeT("OPENCV_TRACE_PROFILER_SAMPLING_PERIOD", 1)));
+    return period;
+}
+
+static const cv::String& getParameterProfilerOutput()
+{
+    static cv::String param_profilerOutput = utils::getConfigurationParameterString("OPENCV_TRACE_PROFILER_OUTPUT", "");
+    return param_profilerOutput;
+}
+
 #ifdef HAVE_OPENCL
 static bool param_synchronizeOpenCL = utils::getConfigurationParameterBool("OPENCV_TRACE_SYNC_OPENCL", false);
 #endif
@@ -311,6 +331,13 @@ void Region::Impl::enterRegion(TraceManagerThreadLocal& ctx)
 {
     ctx.currentActiveRegion = &region;
 
+    if (parentRegion == NULL)
+    {
+        // whole trees of regions are sampled, so nesting of recorded regions is preserved
+        const unsigned period = (unsigned)getProfilerSamplingPeriodRef().load(std::memory_order_relaxed);
+        ctx.profilerSampled = (ctx.profilerRootCounter++ % period) == 0;
+    }
+
     if (location.flags & REGION_FLAG_FUNCTION)
     {
         if ((location.flags & REGION_FLAG_APP_CODE) == 0)
@@ -375,6 +402,9 @@ void Region::Impl::leaveRegion(TraceManagerThreadLocal& ctx)
         s->put(msg);
     }
 
+    if (ctx.profilerSampled && isProfilerActivated())
+        ctx.profiler.put(ProfilerEvent(&location, beginTimestamp, endTimestamp - beginTimestamp));
+
     if (location.flags & REGION_FLAG_FUNCTION)
     {
         if ((location.flags & REGION_FLAG_APP_CODE) == 0)
@@ -831,6 +861,7 @@ TraceStorage* TraceManagerThreadLocal::getStorage() const
 
 
 static bool activated = false;
+static std::atomic<bool> profilerActivated(false);
 static bool isInitialized = false;
 
 TraceManager::TraceManager()
@@ -842,6 +873,7 @@ TraceManager::TraceManager()
 
     CV_LOG("TraceManager configure()");
     activated = getParameterTraceEnable();
+    profilerActivated = utils::getConfigurationParameterBool("OPENCV_TRACE_PROFILER", false);
 
     if (activated)
         trace_storage.reset(new SyncTraceStorage(std::string(getParameterTraceLocation()) + ".txt"));
@@ -886,10 +918,17 @@ TraceManager::~TraceManager()
         CV_LOG_WARNING(NULL, "Trace: Total skipped events: " << totalSkippedEvents);
     }
 
+    if (!getParameterProfilerOutput().empty())
+    {
+        if (!writeProfilerChromeTrace(getParameterProfilerOutput()))
+            CV_LOG_WARNING(NULL, "Trace: can't write profiler output: " << getParameterProfilerOutput());
+    }
+
     // This is a global static object, so process starts shutdown here
     // Turn off trace
     cv::__termination = true; // also set in DllMain() notifications handler for DLL_PROCESS_DETACH
     activated = false;
+    profilerActivated = false;
 }
 
 bool TraceManager::isActivated()
@@ -908,7 +947,7 @@ bool TraceManager::isActivated()
         CV_UNUSED(m); // TODO
     }
 
-    return activated;
+    return activated || profilerActivated;
 }
 
 
@@ -950,6 +989,8 @@ void parallelForSetRootRegion(const Region& rootRegion, const TraceManagerThread
     ctx.parallel_for_stack_size = 0;
 
     ctx.stat_status.propagateFrom(root_ctx.stat_status);
+
+    ctx.profilerSampled = root_ctx.profilerSampled;
 }
 
 void parallelForAttachNestedRegion(const Region& rootRegion)
@@ -1024,6 +1065,65 @@ void parallelForFinalize(const Region& rootRegion)
     CV_LOG_PARALLEL(NULL, ctx.stat);
 }
 
+bool isProfilerActivated()
+{
+    return profilerActivated && !cv::__termination;
+}
+
+void ProfilerBuffer::put(const ProfilerEvent& event)
+{
+    ProfilerEvent* buf = events.load(std::memory_order_relaxed);
+    if (!buf)
+    {
+        capacity = getParameterProfilerBufferSize();
+        buf = new ProfilerEvent[capacity];
+        events.store(buf, std::memory_order_release);
+    }
+    const uint64 n = total.load(std::memory_order_relaxed);
+    buf[n % capacity] = event;
+    total.store(n + 1, std::memory_order_release);
+}
+
+void ProfilerBuffer::copyTo(std::vector<ProfilerEvent>& dst) const
+{
+    const ProfilerEvent* buf = events.load(std::memory_order_acquire);
+    if (!buf)
+        return;
+    const uint64 end = total.load(std::memory_order_acquire);
+    const uint64 begin = std::max(cleared.load(), end > capacity ? end - capacity : 0);
+    const size_t dstStart = dst.size();
+    for (uint64 i = begin; i < end; i++)
+        dst.push_back(buf[i % capacity]);
+    // slot of event 'i' is rewritten by event 'i + capacity' (it may be in progress while 'total' is not updated yet)
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64 newEnd = total.load(std::memory_order_relaxed);
+    const uint64 firstValid = newEnd + 1 > capacity ? newEnd + 1 - capacity : 0;
+    if (firstValid > begin)
+    {
+        const size_t overwritten = (size_t)std::min(firstValid - begin, end - begin);
+        dst.erase(dst.begin() + dstStart, dst.begin() + dstStart + overwritten);
+    }
+}
+
+void ProfilerBuffer::clear()
+{
+    cleared.store(total.load(std::memory_order_acquire));
+}
+
+static Region::LocationExtraData* g_stripeLocationExtra = NULL;
+static const Region::LocationStaticStorage g_stripeLocation = {
+    &g_stripeLocationExtra, "parallel_for_body", CV_TRACE_FILENAME, __LINE__, REGION_FLAG_FUNCTION
+};
+
+void profilerRecordStripe(int64 beginTimestamp, int rangeStart, int rangeEnd)
+{
+    TraceManagerThreadLocal& ctx = getTraceManager().tls.getRef();
+    if (!ctx.profilerSampled)
+        return;
+    int64 endTimestamp = getTimestampNS();
+    ctx.profiler.put(ProfilerEvent(&g_stripeLocation, beginTimestamp, endTimestamp - beginTimestamp, rangeStart, rangeEnd));
+}
+
 struct TraceArg::ExtraData
 {
 #ifdef OPENCV_WITH_ITT
@@ -1142,4 +1242,166 @@ void traceArg(const TraceArg&, double) {};
 
 #endif
 
-}}}} // namespace
+} // namespace details
+
+#ifdef OPENCV_TRACE
+
+using namespace details;
+
+void setProfilerEnabled(bool enabled)
+{
+    getTraceManager();  // apply configuration parameters first
+    profilerActivated = enabled;
+}
+
+bool isProfilerEnabled()
+{
+    getTraceManager();
+    return isProfilerActivated();
+}
+
+void setProfilerSamplingPeriod(int period)
+{
+    CV_Assert(period >= 1);
+    getProfilerSamplingPeriodRef() = period;
+}
+
+int getProfilerSamplingPeriod()
+{
+    return getProfilerSamplingPeriodRef().load();
+}
+
+bool dumpProfiler()
+{
+    const cv::String& filename = getParameterProfilerOutput();
+    if (filename.empty())
+        return false;
+    return writeProfilerChromeTrace(filename);
+}
+
+void resetProfiler()
+{
+    std::vector<TraceManagerThreadLocal*> threads_ctx;
+    getTraceManager().tls.gather(threads_ctx);
+    for (size_t i = 0; i < threads_ctx.size(); i++)
+    {
+        if (threads_ctx[i])
+            threads_ctx[i]->profiler.clear();
+    }
+}
+
+std::vector<RegionProfile> getProfilerSummary()
+{
+    std::vector<TraceManagerThreadLocal*> threads_ctx;
+    getTraceManager().tls.gather(threads_ctx);
+    std::map<const Region::LocationStaticStorage*, std::vector<int64> > durations;
+    std::vector<ProfilerEvent> events;
+    for (size_t i = 0; i < threads_ctx.size(); i++)
+    {
+        if (!threads_ctx[i])
+            continue;
+        events.clear();
+        threads_ctx[i]->profiler.copyTo(events);
+        for (size_t j = 0; j < events.size(); j++)
+            durations[events[j].location].push_back(events[j].duration);
+    }
+
+    std::vector<RegionProfile> result;
+    result.reserve(durations.size());
+    std::map<const Region::LocationStaticStorage*, std::vector<int64> >::iterator it = durations.begin();
+    for (; it != durations.end(); ++it)
+    {
+        std::vector<int64>& d = it->second;
+        std::sort(d.begin(), d.end());
+        const size_t n = d.size();
+        int64 total = 0;
+        for (size_t j = 0; j < n; j++)
+            total += d[j];
+        const double scale = 1e-6;  // ns => ms
+        RegionProfile r;
+        r.name = it->first->name;
+        r.filename = it->first->filename;
+        r.line = it->first->line;
+        r.count = (int64)n;
+        r.total = total * scale;
+        r.mean = r.total / n;
+        // nearest-rank percentiles
+        r.p50 = d[(n * 50 + 99) / 100 - 1] * scale;
+        r.p90 = d[(n * 90 + 99) / 100 - 1] * scale;
+        r.p99 = d[(n * 99 + 99) / 100 - 1] * scale;
+        r.max = d[n - 1] * scale;
+        result.push_back(r);
+    }
+    std::sort(result.begin(), result.end(), [](const RegionProfile& a, const RegionProfile& b) { return a.total > b.total; });
+    return result;
+}
+
+static void writeJSONString(std::ostream& out, const char* str)
+{
+    out << '"';
+    for (; *str; str++)
+    {
+        const char c = *str;
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if ((unsigned char)c < 0x20)
+            out << cv::format("\\u%04x", (int)c);
+        else
+            out << c;
+    }
+    out << '"';
+}
+
+bool writeProfilerChromeTrace(const std::string& filename)
+{
+    std::ofstream out(filename.c_str(), std::ios::trunc);
+    if (!out.is_open())
+        return false;
+
+    std::vector<TraceManagerThreadLocal*> threads_ctx;
+    getTraceManager().tls.gather(threads_ctx);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    std::vector<ProfilerEvent> events;
+    for (size_t i = 0; i < threads_ctx.size(); i++)
+    {
+        const TraceManagerThreadLocal* ctx = threads_ctx[i];
+        if (!ctx)
+            continue;
+        events.clear();
+        ctx->profiler.copyTo(events);
+        for (size_t j = 0; j < events.size(); j++)
+        {
+            const ProfilerEvent& e = events[j];
+            const Region::LocationStaticStorage& location = *e.location;
+            out << (first ? "\n" : ",\n") << "{\"name\":";
+            writeJSONString(out, location.name);
+            out << ",\"cat\":\"" << ((location.flags & REGION_FLAG_APP_CODE) ? "app" : "opencv") << '"'
+                << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << ctx->threadID
+                << cv::format(",\"ts\":%.3f,\"dur\":%.3f", e.beginTimestamp * 1e-3, e.duration * 1e-3)
+                << ",\"args\":{\"location\":";
+            writeJSONString(out, cv::format("%s:%d", location.filename, location.line).c_str());
+            if (e.rangeStart != e.rangeEnd)
+                out << ",\"range.start\":" << e.rangeStart << ",\"range.end\":" << e.rangeEnd;
+            out << "}}";
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+    return !out.fail();
+}
+
+#else
+
+void setProfilerEnabled(bool) {}
+bool isProfilerEnabled() { return false; }
+void setProfilerSamplingPeriod(int) {}
+int getProfilerSamplingPeriod() { return 1; }
+bool dumpProfiler() { return false; }
+void resetProfiler() {}
+std::vector<RegionProfile> getProfilerSummary() { return std::vector<RegionProfile>(); }
+bool writeProfilerChromeTrace(const std::string&) { return false; }
+
+#endif
+
+}}} // namespace
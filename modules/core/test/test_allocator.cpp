@@ -2,6 +2,12 @@
 // It is subject to the license terms in the LICENSE file found in the top-level directory
 // of this distribution and at http://opencv.org/license.html.
 #include "test_precomp.hpp"
+#include "opencv2/core/utils/allocator_stats.hpp"
+#include "opencv2/core/utils/huge_pages.private.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace opencv_test { namespace {
 
@@ -141,4 +147,146 @@ TEST_F(AllocatorTest, DummyAllocator)
     EXPECT_EQ(2, DummyAllocator::deallocations);
 }
 
+TEST(PoolAllocator, reuse)
+{
+    cv::MatAllocator* pool = cv::Mat::getPoolAllocator();
+    cv::BufferPoolController* ctrl = pool->getBufferPoolController();
+    ASSERT_TRUE(ctrl != nullptr);
+    cv::utils::AllocatorStatisticsInterface& stats = cv::utils::getPoolAllocatorStatistics();
+    ctrl->freeAllReservedBuffers();
+    EXPECT_EQ(0u, ctrl->getReservedSize());
+
+    const uint64_t allocations0 = stats.getNumberOfAllocations();
+    const uchar* data = NULL;
+    {
+        cv::Mat m;
+        m.allocator = pool;
+        m.create(480, 640, CV_8UC3);
+        EXPECT_EQ(pool, m.allocator);
+        data = m.data;
+        m.setTo(cv::Scalar::all(7));
+    }
+    EXPECT_EQ(allocations0 + 1, stats.getNumberOfAllocations());
+    EXPECT_GE(ctrl->getReservedSize(), (size_t)480 * 640 * 3);
+
+    cv::Mat::setDefaultAllocator(pool);
+    {
+        cv::Mat m(480, 640, CV_8UC3);  // the same size class
+        EXPECT_EQ(pool, m.allocator);
+        EXPECT_EQ(data, m.data);
+        cv::Mat m2 = cv::Mat::zeros(480, 640, CV_8UC3);  // new buffer
+        EXPECT_NE(data, m2.data);
+        EXPECT_EQ(0, cv::countNonZero(m2.reshape(1)));
+    }
+    cv::Mat::setDefaultAllocator(cv::Mat::getStdAllocator());
+    EXPECT_EQ(allocations0 + 2, stats.getNumberOfAllocations());
+
+    ctrl->freeAllReservedBuffers();
+    EXPECT_EQ(0u, ctrl->getReservedSize());
+}
+
+TEST(PoolAllocator, limit)
+{
+    cv::MatAllocator* pool = cv::Mat::getPoolAllocator();
+    cv::BufferPoolController* ctrl = pool->getBufferPoolController();
+    const size_t prevLimit = ctrl->getMaxReservedSize();
+    ctrl->freeAllReservedBuffers();
+    ctrl->setMaxReservedSize(1 << 20);
+
+    std::vector<cv::Mat> mats(8);
+    for (size_t i = 0; i < mats.size(); i++)
+    {
+        mats[i].allocator = pool;
+        mats[i].create(256, 1024, CV_8UC1);  // 256Kb
+    }
+    mats.clear();
+    EXPECT_LE(ctrl->getReservedSize(), (size_t)(1 << 20));
+    EXPECT_GT(ctrl->getReservedSize(), 0u);
+
+    ctrl->setMaxReservedSize(0);
+    EXPECT_EQ(0u, ctrl->getReservedSize());
+    {
+        cv::Mat m;
+        m.allocator = pool;
+        m.create(16, 16, CV_8UC1);
+    }
+    EXPECT_EQ(0u, ctrl->getReservedSize());
+
+    ctrl->setMaxReservedSize(prevLimit);
+}
+
+TEST(PoolAllocator, trim_other_thread_cache)
+{
+    cv::MatAllocator* pool = cv::Mat::getPoolAllocator();
+    cv::BufferPoolController* ctrl = pool->getBufferPoolController();
+    const size_t prevLimit = ctrl->getMaxReservedSize();
+    ctrl->freeAllReservedBuffers();
+    ASSERT_EQ(0u, ctrl->getReservedSize());
+
+    std::mutex mtx;
+    std::condition_variable cond;
+    bool cached = false, finish = false;
+    std::thread worker([&]()
+    {
+        {
+            cv::Mat m;
+            m.allocator = pool;
+            m.create(64, 64, CV_8UC1);  // released buffer goes into the cache of this thread
+        }
+        std::unique_lock<std::mutex> lock(mtx);
+        cached = true;
+        cond.notify_all();
+        cond.wait(lock, [&]() { return finish; });  // keep thread (and its cache) alive
+    });
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        cond.wait(lock, [&]() { return cached; });
+    }
+    EXPECT_GT(ctrl->getReservedSize(), 0u);
+
+    ctrl->freeAllReservedBuffers();
+    EXPECT_EQ(0u, ctrl->getReservedSize());
+
+    {
+        cv::Mat m;
+        m.allocator = pool;
+        m.create(64, 64, CV_8UC1);
+    }
+    EXPECT_GT(ctrl->getReservedSize(), 0u);
+    ctrl->setMaxReservedSize(0);
+    EXPECT_EQ(0u, ctrl->getReservedSize());
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        finish = true;
+        cond.notify_all();
+    }
+    worker.join();
+    EXPECT_EQ(0u, ctrl->getReservedSize());
+    ctrl->setMaxReservedSize(prevLimit);
+}
+
+TEST(HugePagesAllocator, basic)
+{
+    using namespace cv::utils;
+    const HugePagesMode prevMode = getHugePagesAllocationMode();
+    const size_t prevThreshold = getHugePagesAllocationThreshold();
+    for (int mode = HUGE_PAGES_NONE; mode <= HUGE_PAGES_HUGETLB; mode++)
+    {
+        SCOPED_TRACE(cv::format("mode=%d", mode));
+        setHugePagesAllocationMode((HugePagesMode)mode, 1 << 20);
+        cv::Mat small(16, 16, CV_8UC1, cv::Scalar::all(1));
+        cv::Mat large(1024, 1024 + 1, CV_32FC1, cv::Scalar::all(2));
+        EXPECT_TRUE(cv::isAligned<CV_MALLOC_ALIGN>(large.data));
+        if (mode != HUGE_PAGES_NONE && isHugePagesAllocationSupported())
+        {
+            EXPECT_TRUE(cv::isAligned<2 << 20>(large.data));
+        }
+        EXPECT_EQ(1024 * 1025 * 2, cv::sum(large)[0]);
+        if (mode != HUGE_PAGES_NONE)
+            setHugePagesAllocationMode(HUGE_PAGES_NONE, prevThreshold);  // buffers are released after mode change
+    }
+    setHugePagesAllocationMode(prevMode, prevThreshold);
+}
+
 }} // namespace
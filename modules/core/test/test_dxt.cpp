@@ -983,4 +983,104 @@ protected:
 TEST(Core_DFT, reverse) { Core_DXTReverseTest test(Core_DXTReverseTest::ModeDFT); test.safe_run(); }
 TEST(Core_DCT, reverse) { Core_DXTReverseTest test(Core_DXTReverseTest::ModeDCT); test.safe_run(); }
 
+typedef testing::TestWithParam<tuple<perf::MatDepth, int> > Core_DFT_Radix4;
+
+// power-of-2 lengths are processed by vectorized radix-4 passes
+TEST_P(Core_DFT_Radix4, accuracy)
+{
+    const int depth = get<0>(GetParam());
+    const int n = get<1>(GetParam());
+    const double eps = depth == CV_32F ? 1e-5 : 1e-12;
+
+    Mat src(1, n, CV_MAKETYPE(depth, 2)), dst, ref;
+    randu(src, -1., 1.);
+    Mat src64;
+    src.convertTo(src64, CV_64F);
+
+    for (int inv = 0; inv < 2; inv++)
+    {
+        const int flags = inv ? DFT_INVERSE | DFT_SCALE : 0;
+        cv::dft(src, dst, flags);
+        DFT_1D(src64, ref, flags);
+        dst.convertTo(dst, CV_64F);
+        EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), eps*std::max(1., cvtest::norm(ref, NORM_INF))) << "inv=" << inv;
+    }
+
+    // real input: the transform of length n/2 is used
+    Mat srcR(1, n, depth), srcC, dstR, refR;
+    randu(srcR, -1., 1.);
+    Mat planes[] = { srcR, Mat::zeros(1, n, depth) };
+    merge(planes, 2, srcC);
+    srcC.convertTo(src64, CV_64F);
+    cv::dft(srcR, dstR, DFT_COMPLEX_OUTPUT);
+    DFT_1D(src64, refR, 0);
+    dstR.convertTo(dstR, CV_64F);
+    EXPECT_LE(cvtest::norm(refR, dstR, NORM_INF), eps*std::max(1., cvtest::norm(refR, NORM_INF)));
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Core_DFT_Radix4, testing::Combine(
+    testing::Values(perf::MatDepth(CV_32F), CV_64F),
+    testing::Values(16, 64, 128, 256, 1024, 2048, 4096, 48, 96 * 64)
+));
+
+TEST(Core_DFTPlan, regression)
+{
+    const int flagsList[] = { 0, DFT_INVERSE, DFT_SCALE, DFT_ROWS, DFT_COMPLEX_OUTPUT,
+                              DFT_INVERSE | DFT_REAL_OUTPUT | DFT_SCALE };
+    const Size sizes[] = { Size(256, 64), Size(120, 36), Size(1, 64), Size(512, 1) };
+    RNG& rng = theRNG();
+    for (size_t si = 0; si < sizeof(sizes)/sizeof(sizes[0]); si++)
+    {
+        for (int depth = CV_32F; depth <= CV_64F; depth++)
+        {
+            for (int cn = 1; cn <= 2; cn++)
+            {
+                const int mtype = CV_MAKETYPE(depth, cn);
+                for (size_t fi = 0; fi < sizeof(flagsList)/sizeof(flagsList[0]); fi++)
+                {
+                    const int flags = flagsList[fi];
+                    if ((flags & DFT_COMPLEX_OUTPUT) && cn != 1)
+                        continue;
+                    if ((flags & DFT_REAL_OUTPUT) && cn != 2)
+                        continue;
+                    Mat src(sizes[si], mtype), expected;
+                    rng.fill(src, RNG::UNIFORM, -1, 1);
+                    cv::dft(src, expected, flags);
+
+                    DFTPlan plan(sizes[si], mtype, flags);
+                    ASSERT_FALSE(plan.empty());
+                    Mat dst;
+                    for (int iter = 0; iter < 3; iter++)  // plan is reused
+                    {
+                        plan.apply(src, dst);
+                        ASSERT_EQ(expected.type(), dst.type());
+                        EXPECT_EQ(0, cvtest::norm(expected, dst, NORM_INF))
+                            << sizes[si] << " type=" << mtype << " flags=" << flags;
+                    }
+
+                    // non-continuous and in-place data (single column transforms take another path in this case)
+                    const Rect roiRect(1, 1, sizes[si].width, sizes[si].height);
+                    Mat big(sizes[si].height + 2, sizes[si].width + 3, expected.type());
+                    Mat bigExpected = big.clone();
+                    Mat roi = big(roiRect), roiExpected = bigExpected(roiRect);
+                    cv::dft(src, roiExpected, flags);
+                    plan.apply(src, roi);
+                    EXPECT_EQ(0, cvtest::norm(roiExpected, roi, NORM_INF));
+                    if (expected.type() == mtype)
+                    {
+                        Mat inplace = src.clone();
+                        plan.apply(inplace, inplace);
+                        EXPECT_EQ(0, cvtest::norm(expected, inplace, NORM_INF));
+                    }
+                }
+            }
+        }
+    }
+
+    DFTPlan plan;
+    EXPECT_TRUE(plan.empty());
+    plan.create(Size(64, 64), CV_32FC1);
+    EXPECT_THROW(plan.apply(Mat(32, 64, CV_32FC1, Scalar(0)), noArray()), cv::Exception);
+}
+
 }} // namespace
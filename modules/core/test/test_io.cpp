@@ -5,6 +5,8 @@
 
 #include <fstream>
 
+#include "opencv2/core/mat_storage.hpp"
+
 namespace opencv_test { namespace {
 
 static SparseMat cvTsGetRandomSparseMat(int dims, const int* sz, int type,
@@ -2050,4 +2052,245 @@ INSTANTIATE_TEST_CASE_P(Core_InputOutput,
     FileStorage_exact_type, Values(".yml", ".xml", ".json")
 );
 
+struct TestStreamVisitor : public FileNodeVisitor
+{
+    std::vector<std::string> events;
+    Mat K;
+    std::vector<Mat> descs;
+    int rows = 0, cols = 0;
+
+    int startCollection(const std::string& name, int type, int depth) CV_OVERRIDE
+    {
+        events.push_back(cv::format("start %s %d %d", name.c_str(), type, depth));
+        return name == "skipped" ? SKIP : name == "K" ? MATERIALIZE : ENTER;
+    }
+    void visit(const std::string& name, const FileNode& node, int depth) CV_OVERRIDE
+    {
+        if (name == "type_id")  // JSON
+            return;
+        std::string value = node.isString() ? node.string() : node.isMap() ? std::string("map") :
+                            node.isInt() ? cv::format("%d", (int)node) : cv::format("%g", (double)node);
+        events.push_back(cv::format("visit %s %d %s", name.c_str(), depth, value.c_str()));
+        if (name == "K")
+            node >> K;
+        else if (name == "rows")
+            rows = (int)node;
+        else if (name == "cols")
+            cols = (int)node;
+    }
+    void endCollection(const std::string& name, int type, int depth) CV_OVERRIDE
+    {
+        events.push_back(cv::format("end %s %d %d", name.c_str(), type, depth));
+    }
+    Mat rawDataBuffer(const std::string& name, const std::string& dt, int depth) CV_OVERRIDE
+    {
+        events.push_back(cv::format("raw %s %s %d", name.c_str(), dt.c_str(), depth));
+        descs.push_back(Mat(rows, cols, CV_32F));
+        return descs.back();
+    }
+};
+
+TEST_P(FileStorage_exact_type, readStream)
+{
+    Mat K = (Mat_<double>(3, 3) << 500, 0, 320, 0, 500, 240, 0, 0, 1);
+    std::vector<Mat> descs(3);
+    String content;
+    {
+        FileStorage fs(GetParam(), FileStorage::WRITE_BASE64 | FileStorage::MEMORY);
+        fs << "header" << "{" << "version" << 3 << "name" << "calib" << "}";
+        fs << "skipped" << "[" << 1 << 2 << 3 << "]";
+        fs << "K" << K;
+        fs << "features" << "[";
+        for (int i = 0; i < (int)descs.size(); i++)
+        {
+            descs[i].create(4, 32 + i, CV_32F);
+            randu(descs[i], -1, 1);
+            fs << "{" << "id" << i << "desc" << descs[i] << "}";
+        }
+        fs << "]";
+        fs << "tail" << 1.5;
+        content = fs.releaseAndGetString();
+    }
+
+    TestStreamVisitor visitor;
+    ASSERT_TRUE(FileStorage::readStream(content, visitor, FileStorage::READ | FileStorage::MEMORY));
+
+    std::vector<std::string> expected;
+    expected.push_back("start header 5 0");
+    expected.push_back("visit version 1 3");
+    expected.push_back("visit name 1 calib");
+    expected.push_back("end header 5 0");
+    expected.push_back("start skipped 4 0");
+    expected.push_back("start K 5 0");
+    expected.push_back("visit K 0 map");
+    expected.push_back("start features 4 0");
+    for (int i = 0; i < (int)descs.size(); i++)
+    {
+        expected.push_back("start  5 1");
+        expected.push_back(cv::format("visit id 2 %d", i));
+        expected.push_back("start desc 5 2");
+        expected.push_back("visit rows 3 4");
+        expected.push_back(cv::format("visit cols 3 %d", 32 + i));
+        expected.push_back("visit dt 3 f");
+        expected.push_back("raw data 1f 3");  // format of base64 header
+        expected.push_back("end desc 5 2");
+        expected.push_back("end  5 1");
+    }
+    expected.push_back("end features 4 0");
+    expected.push_back("visit tail 0 1.5");
+
+    EXPECT_EQ(expected, visitor.events);
+    EXPECT_EQ(0, cvtest::norm(K, visitor.K, NORM_INF));
+    ASSERT_EQ(descs.size(), visitor.descs.size());
+    for (size_t i = 0; i < descs.size(); i++)
+        EXPECT_EQ(0, cvtest::norm(descs[i], visitor.descs[i], NORM_INF)) << i;
+}
+
+TEST_P(FileStorage_exact_type, readStream_size_mismatch)
+{
+    String content;
+    {
+        FileStorage fs(GetParam(), FileStorage::WRITE_BASE64 | FileStorage::MEMORY);
+        fs << "m" << Mat(5, 7, CV_32F, Scalar(1));
+        content = fs.releaseAndGetString();
+    }
+    struct SmallBufferVisitor : public FileNodeVisitor
+    {
+        Mat rawDataBuffer(const std::string&, const std::string&, int) CV_OVERRIDE
+        {
+            return Mat(5, 6, CV_32F);
+        }
+    } visitor;
+    EXPECT_THROW(FileStorage::readStream(content, visitor, FileStorage::READ | FileStorage::MEMORY), cv::Exception);
+}
+
+TEST(Core_MatStorage, write_read)
+{
+    const std::string fname = cv::tempfile(".cvmat");
+    RNG& rng = theRNG();
+    const int sizes3d[] = { 3, 4, 5 };
+    Mat m8u(17, 31, CV_8UC3), m16s(7, 5, CV_16SC1), m32f(1, 100, CV_32FC2), m64f(3, sizes3d, CV_64F);
+    Mat big(64, 64, CV_32SC1);
+    rng.fill(m8u, RNG::UNIFORM, 0, 256);
+    rng.fill(m16s, RNG::UNIFORM, -1000, 1000);
+    rng.fill(m32f, RNG::UNIFORM, -1, 1);
+    rng.fill(m64f, RNG::UNIFORM, -1, 1);
+    rng.fill(big, RNG::UNIFORM, -100000, 100000);
+    Mat roi = big(Rect(3, 5, 20, 11));
+    {
+        MatStorageWriter writer(fname);
+        ASSERT_TRUE(writer.isOpened());
+        writer.write("m8u", m8u);
+        writer.write("m16s", m16s);
+        writer.write("m32f", m32f);
+        writer.write("m64f", m64f);
+        writer.write("roi", roi);
+        writer.write("empty", Mat());
+        EXPECT_THROW(writer.write("m8u", m8u), cv::Exception);
+    }
+
+    Mat loaded;
+    {
+        MatStorageReader reader(fname);
+        ASSERT_TRUE(reader.isOpened());
+        std::vector<String> expectedNames;
+        expectedNames.push_back("m8u");
+        expectedNames.push_back("m16s");
+        expectedNames.push_back("m32f");
+        expectedNames.push_back("m64f");
+        expectedNames.push_back("roi");
+        expectedNames.push_back("empty");
+        EXPECT_EQ(expectedNames, reader.names());
+        EXPECT_TRUE(reader.contains("roi"));
+        EXPECT_FALSE(reader.contains("missing"));
+        EXPECT_TRUE(reader.get("missing").empty());
+        EXPECT_TRUE(reader.get("empty").empty());
+
+        const Mat* src[] = { &m8u, &m16s, &m32f, &m64f, &roi };
+        for (size_t i = 0; i < expectedNames.size() - 1; i++)
+        {
+            Mat m = reader.get(expectedNames[i]);
+            ASSERT_EQ(src[i]->type(), m.type()) << expectedNames[i];
+            ASSERT_EQ(src[i]->dims, m.dims) << expectedNames[i];
+            EXPECT_TRUE(m.isContinuous());
+            EXPECT_EQ(0u, (size_t)m.data % MatStorageWriter::ALIGNMENT) << expectedNames[i];
+            EXPECT_EQ(0, cvtest::norm(*src[i], m, NORM_INF)) << expectedNames[i];
+        }
+        loaded = reader.get("m8u");
+    }
+    // the mapping is alive while the matrix exists
+    EXPECT_EQ(0, cvtest::norm(m8u, loaded, NORM_INF));
+
+    // modifications are private
+    loaded.setTo(Scalar::all(0));
+    {
+        MatStorageReader reader(fname);
+        EXPECT_EQ(0, cvtest::norm(m8u, reader.get("m8u"), NORM_INF));
+    }
+    loaded.release();
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+TEST(Core_MatStorage, invalid_file)
+{
+    MatStorageReader reader;
+    EXPECT_FALSE(reader.open(cv::tempfile(".cvmat")));
+    EXPECT_FALSE(reader.isOpened());
+
+    const std::string fname = cv::tempfile(".cvmat");
+    {
+        std::ofstream f(fname.c_str(), std::ios::binary);
+        std::string garbage(256, 'x');
+        f.write(garbage.c_str(), garbage.size());
+    }
+    EXPECT_THROW(reader.open(fname), cv::Exception);
+    EXPECT_FALSE(reader.isOpened());
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+TEST(Core_MatStorage, corrupted_index)
+{
+    const std::string fname = cv::tempfile(".cvmat");
+    const int sizes[] = { 2, 3, 4 };
+    {
+        MatStorageWriter writer(fname);
+        writer.write("m", Mat(3, sizes, CV_32FC1, Scalar::all(1)));
+    }
+    std::vector<char> content;
+    {
+        std::ifstream f(fname.c_str(), std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    }
+    ASSERT_GT(content.size(), (size_t)64);
+    uint64_t indexOffset = 0;
+    memcpy(&indexOffset, &content[16], sizeof(indexOffset));  // FileHeader::indexOffset
+    ASSERT_LT(indexOffset, (uint64_t)content.size());
+    const size_t entry = (size_t)indexOffset;  // IndexEntry: offset, size, type, dims, nameLength, reserved
+
+    struct Patch { size_t pos; uint64_t value; size_t size; const char* what; };
+    const Patch patches[] = {
+        { 32, 0x7fffffff, 4, "count" },
+        { entry, 64 + 4, 8, "misaligned offset" },
+        { entry + 24, 1000, 4, "name out of index" },
+        { entry + 32, 0x7fffffff, 4, "size overflow" },  // together with the next patch
+        { entry + 36, 0x7fffffff, 4, "size overflow" },
+    };
+    MatStorageReader reader;
+    for (size_t i = 0; i < sizeof(patches) / sizeof(patches[0]); i++)
+    {
+        SCOPED_TRACE(patches[i].what);
+        std::vector<char> corrupted = content;
+        memcpy(&corrupted[patches[i].pos], &patches[i].value, patches[i].size);
+        if (i == 4)
+            memcpy(&corrupted[patches[3].pos], &patches[3].value, patches[3].size);
+        {
+            std::ofstream f(fname.c_str(), std::ios::binary);
+            f.write(&corrupted[0], corrupted.size());
+        }
+        EXPECT_THROW(reader.open(fname), cv::Exception);
+        EXPECT_FALSE(reader.isOpened());
+    }
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
 }} // namespace
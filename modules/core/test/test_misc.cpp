@@ -7,7 +7,9 @@
 #include "opencv2/core/utils/logger.hpp"
 
 #include <opencv2/core/utils/fp_control_utils.hpp>
+#include <opencv2/core/parallel/parallel_backend.hpp>
 
+#include <atomic>
 #include <chrono>
 #include <thread>
 
@@ -304,6 +306,108 @@ TEST(Core_Parallel, propagate_fp_denormals_ignore_hint)
     }
 }
 
+TEST(Core_Parallel, nested_sequential_is_per_thread)
+{
+    const std::string framework = currentParallelFramework() ? currentParallelFramework() : "";
+    EXPECT_FALSE(isNestedParallelForSequential());
+    std::atomic<int> bodies(0), sequential(0), otherThread(0);
+    parallel_for_(cv::Range(0, 4), [&](const cv::Range&) {
+        bodies++;
+        if (isNestedParallelForSequential())
+            sequential++;
+        std::thread other([&]() {  // unrelated thread is not inside of parallel region
+            if (isNestedParallelForSequential())
+                otherThread++;
+        });
+        other.join();
+    });
+    EXPECT_FALSE(isNestedParallelForSequential());
+    EXPECT_EQ(0, otherThread.load());
+    if (framework != "workstealing")  // backends without nesting support
+    {
+        EXPECT_EQ(bodies.load(), sequential.load());
+    }
+}
+
+class NestedFillParallelLoopBody : public cv::ParallelLoopBody
+{
+public:
+    NestedFillParallelLoopBody(cv::Mat& dst) : dst_(dst) {}
+    void operator()(const cv::Range& r) const
+    {
+        for (int i = r.start; i < r.end; i++)
+        {
+            Mat block = dst_.rowRange(i * 100, (i + 1) * 100);
+            parallel_for_(cv::Range(0, block.rows), [&](const cv::Range& rr) {
+                for (int y = rr.start; y < rr.end; y++)
+                    block.row(y).setTo(i * 100 + y);
+            });
+        }
+    }
+protected:
+    Mat dst_;
+};
+
+TEST(Core_Parallel, workstealing_backend)
+{
+    const std::string framework = currentParallelFramework() ? currentParallelFramework() : "";
+    if (!cv::parallel::setParallelForBackend("WORKSTEALING"))
+        throw SkipTestException("Work-stealing backend is not available");
+    EXPECT_EQ(std::string("workstealing"), std::string(currentParallelFramework()));
+    const int prevNumThreads = getNumThreads();
+    setNumThreads(std::max(4, prevNumThreads));  // exercise worker threads on small systems too
+
+    Mat dst(16 * 100, 10, CV_32SC1, Scalar::all(-1));
+    EXPECT_NO_THROW(parallel_for_(cv::Range(0, 16), NestedFillParallelLoopBody(dst)));
+    for (int y = 0; y < dst.rows; y++)
+    {
+        ASSERT_EQ(y, dst.at<int>(y, 0)) << "y=" << y;
+        ASSERT_EQ(y, dst.at<int>(y, dst.cols - 1)) << "y=" << y;
+    }
+
+    Mat dst2(1000, 100, CV_8SC1, Scalar::all(0));
+    EXPECT_THROW(parallel_for_(cv::Range(0, dst2.rows), ThrowErrorParallelLoopBody(dst2, dst2.rows / 2)), cv::Exception);
+
+    // nested calls are parallel
+    std::atomic<int> sequential(0);
+    parallel_for_(cv::Range(0, 8), [&](const cv::Range&) {
+        if (isNestedParallelForSequential())
+            sequential++;
+    });
+    EXPECT_EQ(0, sequential.load());
+
+    // reconfiguration inside of a parallel region is ignored
+    const int numThreads = getNumThreads();
+    parallel_for_(cv::Range(0, 8), [&](const cv::Range&) { setNumThreads(2); });
+    EXPECT_EQ(numThreads, getNumThreads());
+
+    // reconfiguration waits for the jobs started by other threads
+    std::atomic<bool> done(false);
+    std::atomic<int> failures(0);
+    std::thread producer([&]() {
+        Mat buf(64, 256, CV_32SC1);
+        for (int iter = 0; iter < 200; iter++)
+        {
+            buf.setTo(Scalar::all(-1));
+            parallel_for_(cv::Range(0, buf.rows), [&](const cv::Range& r) {
+                for (int y = r.start; y < r.end; y++)
+                    buf.row(y).setTo(y);
+            });
+            for (int y = 0; y < buf.rows; y++)
+                if (buf.at<int>(y, buf.cols - 1) != y)
+                    failures++;
+        }
+        done = true;
+    });
+    for (int i = 0; !done; i++)
+        setNumThreads(2 + i % 3);
+    producer.join();
+    EXPECT_EQ(0, failures.load());
+
+    setNumThreads(prevNumThreads);
+    cv::parallel::setParallelForBackend(framework == "workstealing" ? framework : std::string());
+}
+
 TEST(Core_Version, consistency)
 {
     // this test verifies that OpenCV version loaded in runtime
@@ -1499,10 +1499,57 @@ INSTANTIATE_TEST_CASE_P(Core, sortIdx, Combine(
         Values(CV_8U, CV_8S, CV_16S, CV_32S, CV_32F, CV_64F), // depth
         Values(SORT_EVERY_COLUMN, SORT_EVERY_ROW),
         Values(SORT_ASCENDING, SORT_DESCENDING),
-        Values(Size(3, 3), Size(16, 8)),
+        Values(Size(3, 3), Size(16, 8), Size(301, 160)),
         ::testing::Bool()
 ));
 
+PARAM_TEST_CASE(Core_Sort, MatDepth, SortRowCol, SortOrder, Size)
+{
+};
+
+TEST_P(Core_Sort, accuracy)
+{
+    const int depth = GET_PARAM(0);
+    const int flags = GET_PARAM(1) | GET_PARAM(2);
+    const Size size = GET_PARAM(3);
+    const bool sortRows = (flags & SORT_EVERY_COLUMN) == 0;
+
+    Mat src_(size.height + 2, size.width + 3, depth);
+    double vmin = depth == CV_8U ? 0 : depth == CV_8S ? -128 : -1000;
+    cvtest::randUni(theRNG(), src_, Scalar::all(vmin), Scalar::all(vmin + 2000));
+    Mat src = src_(Rect(1, 1, size.width, size.height));
+
+    Mat expected = src.clone();
+    Mat lines = sortRows ? expected : Mat(expected.t());
+    for (int i = 0; i < lines.rows; i++)
+    {
+        Mat line;
+        lines.row(i).convertTo(line, CV_64F);
+        double* ptr = line.ptr<double>();
+        std::sort(ptr, ptr + line.cols);
+        if (flags & SORT_DESCENDING)
+            std::reverse(ptr, ptr + line.cols);
+        line.convertTo(lines.row(i), depth);
+    }
+    if (!sortRows)
+        expected = lines.t();
+
+    Mat dst;
+    cv::sort(src, dst, flags);
+    EXPECT_EQ(0, cvtest::norm(expected, dst, NORM_INF));
+
+    Mat inplace = src_.clone()(Rect(1, 1, size.width, size.height));
+    cv::sort(inplace, inplace, flags);
+    EXPECT_EQ(0, cvtest::norm(expected, inplace, NORM_INF));
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Core_Sort, Combine(
+        Values(CV_8U, CV_8S, CV_16U, CV_16S, CV_32S, CV_32F, CV_64F),
+        Values(SORT_EVERY_COLUMN, SORT_EVERY_ROW),
+        Values(SORT_ASCENDING, SORT_DESCENDING),
+        Values(Size(7, 5), Size(1000, 70), Size(35, 600))
+));
+
 
 TEST(Core_sortIdx, regression_8941)
 {
@@ -1561,6 +1608,159 @@ TEST(Core_MatExpr, empty_check_15760)
     EXPECT_THROW(Mat c = Mat().cross(Mat()), cv::Exception);
 }
 
+TEST(Core_MatExpr, abs_diff_with_scalar)
+{
+    Mat a = (Mat_<float>(1, 4) << 1, 5, -3, 10);
+    Mat b = (Mat_<float>(1, 4) << 4, 2, 0, 10);
+    Mat expected = (Mat_<float>(1, 4) << 1, 5, 1, 2);
+    Mat res = abs(a - b + 2);  // the scalar must not be dropped by absdiff(a, b)
+    EXPECT_EQ(0, cvtest::norm(expected, res, NORM_INF));
+    res = abs(b - a - 2);
+    EXPECT_EQ(0, cvtest::norm(expected, res, NORM_INF));
+}
+
+typedef tuple<perf::MatDepth, int, bool> MatExpr_Fused_Param;
+typedef testing::TestWithParam<MatExpr_Fused_Param> Core_MatExpr_Fused;
+
+// evaluates expression over single rows, they are shorter than OPENCV_MATEXPR_FUSION_THRESHOLD,
+// so temporary matrices are used
+template<typename Expr> static
+Mat evalMatExprByRows(const Mat& a, const Mat& b, const Mat& c, const Expr& expr)
+{
+    Mat res;
+    for (int y = 0; y < a.rows; y++)
+    {
+        Mat row = expr(a.row(y), b.row(y), c.row(y));
+        if (res.empty())
+            res.create(a.size(), row.type());
+        row.copyTo(res.row(y));
+    }
+    return res;
+}
+
+template<typename Expr> static
+void checkFusedMatExpr(const Mat& a, const Mat& b, const Mat& c, const Expr& expr)
+{
+    Mat expected = evalMatExprByRows(a, b, c, expr);
+    Mat res = expr(a, b, c);
+    ASSERT_EQ(expected.type(), res.type());
+    if (a.depth() == CV_32F || a.depth() == CV_64F)
+        EXPECT_LE(cvtest::norm(expected, res, NORM_INF | NORM_RELATIVE), a.depth() == CV_32F ? 1e-5 : 1e-12);
+    else  // integer inputs must give the same results
+        EXPECT_EQ(0, cvtest::norm(expected, res, NORM_INF));
+}
+
+static Mat matExprFused_weighted(const Mat& a, const Mat& b, const Mat& c) { return a*3.3 + b*1.7 - c; }
+static Mat matExprFused_scaledSum(const Mat& a, const Mat& b, const Mat& c) { return (a + b)*0.7 - c; }
+static Mat matExprFused_halfSum(const Mat& a, const Mat& b, const Mat& c) { return a*0.5 + b*0.5 - c; }
+static Mat matExprFused_absDiff(const Mat& a, const Mat& b, const Mat& c) { return abs(a - b)*2 + c; }
+static Mat matExprFused_mulMin(const Mat& a, const Mat& b, const Mat& c) { return min(a.mul(b, 1/64.), c); }
+static Mat matExprFused_cmp(const Mat& a, const Mat& b, const Mat& c) { return (a + b)/2 > c; }
+static Mat matExprFused_maxScale(const Mat& a, const Mat& b, const Mat&) { return max(a - b, 10.5)*0.25; }
+static Mat matExprFused_div(const Mat& a, const Mat& b, const Mat& c) { return (30.0 / (a + c)) / b * 3; }
+static Mat matExprFused_cmpMin(const Mat& a, const Mat& b, const Mat& c) { return min(abs(a*0.3 - b)*1.5 + 7.5, c) < a; }
+// (a + s) - b is evaluated as (a - b) + s
+static Mat matExprFused_absScalar(const Mat& a, const Mat& b, const Mat&) { return abs((a + Scalar(1, 2, 3, 4)) - b); }
+
+static Mat matExprFused_inplace(const Mat& a, const Mat& b, const Mat& c)
+{
+    Mat res = a.clone();
+    res = res*0.5 + b*0.5 - c;
+    return res;
+}
+
+// preallocated output of different depth: Mat::convertTo() semantic
+static Mat matExprFused_toFloat(const Mat& a, const Mat& b, const Mat&)
+{
+    if (a.channels() == 1)
+    {
+        Mat_<float> res(a.size());
+        res = max(a - b, 10.5)*0.25;
+        return res;
+    }
+    Mat_<Vec3f> res(a.size());
+    res = max(a - b, 10.5)*0.25;
+    return res;
+}
+
+TEST_P(Core_MatExpr_Fused, chains)
+{
+    const int depth = get<0>(GetParam());
+    const int cn = get<1>(GetParam());
+    const bool roi = get<2>(GetParam());
+    const int type = CV_MAKETYPE(depth, cn);
+
+    // full range of integer types
+    const double minval = depth == CV_8U || depth == CV_16U ? 0 : depth == CV_8S ? -128 :
+                          depth == CV_16S ? -32768 : -1000;
+    const double maxval = depth == CV_8U ? 256 : depth == CV_8S ? 128 : depth == CV_16U ? 65536 :
+                          depth == CV_16S ? 32768 : 1000;
+    RNG& rng = theRNG();
+    Mat a_(67, 131, type), b_(67, 131, type), c_(67, 131, type);
+    rng.fill(a_, RNG::UNIFORM, minval, maxval);
+    rng.fill(b_, RNG::UNIFORM, minval, maxval);
+    rng.fill(c_, RNG::UNIFORM, minval, maxval);
+    const Rect r = roi ? Rect(3, 5, 120, 60) : Rect(0, 0, 131, 67);
+    Mat a = a_(r), b = b_(r), c = c_(r);
+
+    {
+        SCOPED_TRACE("a*3.3 + b*1.7 - c");
+        checkFusedMatExpr(a, b, c, matExprFused_weighted);
+    }
+    {
+        SCOPED_TRACE("(a + b)*0.7 - c");
+        checkFusedMatExpr(a, b, c, matExprFused_scaledSum);
+    }
+    {
+        SCOPED_TRACE("a*0.5 + b*0.5 - c");
+        checkFusedMatExpr(a, b, c, matExprFused_halfSum);
+    }
+    {
+        SCOPED_TRACE("abs(a - b)*2 + c");
+        checkFusedMatExpr(a, b, c, matExprFused_absDiff);
+    }
+    {
+        SCOPED_TRACE("min(a.mul(b, 1/64.), c)");
+        checkFusedMatExpr(a, b, c, matExprFused_mulMin);
+    }
+    {
+        SCOPED_TRACE("(a + b)/2 > c");
+        ASSERT_EQ(CV_MAKETYPE(CV_8U, cn), matExprFused_cmp(a, b, c).type());
+        checkFusedMatExpr(a, b, c, matExprFused_cmp);
+    }
+    {
+        SCOPED_TRACE("max(a - b, 10.5)*0.25");
+        checkFusedMatExpr(a, b, c, matExprFused_maxScale);
+    }
+    {
+        SCOPED_TRACE("(30.0 / (a + c)) / b * 3");
+        checkFusedMatExpr(a, b, c, matExprFused_div);
+    }
+    {
+        SCOPED_TRACE("min(abs(a*0.3 - b)*1.5 + 7.5, c) < a");
+        checkFusedMatExpr(a, b, c, matExprFused_cmpMin);
+    }
+    {
+        SCOPED_TRACE("abs((a + Scalar(1, 2, 3, 4)) - b)");
+        checkFusedMatExpr(a, b, c, matExprFused_absScalar);
+    }
+    {
+        SCOPED_TRACE("in-place");
+        checkFusedMatExpr(a, b, c, matExprFused_inplace);
+    }
+    {
+        SCOPED_TRACE("float output");
+        ASSERT_EQ(CV_MAKETYPE(CV_32F, cn), matExprFused_toFloat(a, b, c).type());
+        checkFusedMatExpr(a, b, c, matExprFused_toFloat);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Core_MatExpr_Fused, testing::Combine(
+    testing::Values(perf::MatDepth(CV_8U), CV_8S, CV_16U, CV_16S, CV_32F, CV_64F),
+    testing::Values(1, 3),
+    testing::Bool()
+));
+
 TEST(Core_Arithm, scalar_handling_19599)  // https://github.com/opencv/opencv/issues/19599 (OpenCV 4.x+ only)
 {
     Mat a(1, 1, CV_32F, Scalar::all(1));
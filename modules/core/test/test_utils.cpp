@@ -7,9 +7,18 @@
 #define CV_LOG_STRIP_LEVEL CV_LOG_LEVEL_VERBOSE + 1
 #include "opencv2/core/utils/logger.hpp"
 #include "opencv2/core/utils/buffer_area.private.hpp"
+#include "opencv2/core/utils/numa.hpp"
+#include "opencv2/core/utils/trace_profiler.hpp"
 
 #include "opencv2/core/utils/filesystem.private.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+#if defined __linux__ && !defined __ANDROID__
+#include <sched.h>
+#endif
+
 #ifndef OPENCV_DISABLE_THREAD_SUPPORT
 #include "test_utils_tls.impl.hpp"
 #endif
@@ -494,5 +503,177 @@ TEST_P(BufferArea, bad)
 
 INSTANTIATE_TEST_CASE_P(/**/, BufferArea, testing::Values(true, false));
 
+TEST(NUMA, policy_local)
+{
+    using namespace cv::utils;
+    const NumaPolicy prevPolicy = getNumaPolicy();
+    const int prevNumThreads = getNumThreads();
+    EXPECT_GE(getNumaNodesCount(), 1);
+
+    setNumaPolicy(NUMA_POLICY_LOCAL);
+    EXPECT_EQ(NUMA_POLICY_LOCAL, getNumaPolicy());
+    setNumThreads(std::max(4, prevNumThreads));  // worker threads are re-bound on thread pool reconfiguration
+
+    // large buffers are first-touched by parallel stripes (no-op on single node systems)
+    Mat m(2048, 2048, CV_32FC1);
+    m.setTo(Scalar::all(1));
+    Mat m_odd(3, 3000007, CV_8UC1, Scalar::all(7));
+    EXPECT_EQ(2048 * 2048, countNonZero(m));
+    EXPECT_EQ(3 * 3000007, countNonZero(m_odd));
+
+#if defined __linux__ && !defined __ANDROID__
+    if (getNumaNodesCount() > 1)
+    {
+        cpu_set_t process_cpus;
+        CPU_ZERO(&process_cpus);
+        ASSERT_EQ(0, sched_getaffinity(0, sizeof(process_cpus), &process_cpus));
+        const int n_process_cpus = CPU_COUNT(&process_cpus);
+        std::atomic<int> n_pinned(0);
+        parallel_for_(Range(0, getNumThreads() * 4), [&](const Range&) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            if (0 == sched_getaffinity(0, sizeof(cpus), &cpus) && CPU_COUNT(&cpus) < n_process_cpus)
+                n_pinned++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        });
+        EXPECT_GT(n_pinned.load(), 0);
+    }
+#endif
+
+    setNumaPolicy(NUMA_POLICY_NONE);
+    EXPECT_EQ(NUMA_POLICY_NONE, getNumaPolicy());
+    m.setTo(Scalar::all(2));
+    EXPECT_EQ(2 * 2048 * 2048, sum(m)[0]);
+
+    setNumThreads(prevNumThreads);
+    setNumaPolicy(prevPolicy);
+}
+
+
+static void runProfilerTestRegions(int iterations)
+{
+    for (int i = 0; i < iterations; i++)
+    {
+        CV_TRACE_REGION("test_profiler_outer");
+        for (int j = 0; j < 3; j++)
+        {
+            CV_TRACE_REGION("test_profiler_inner");
+            cv::Mat m(16, 16, CV_8UC1, cv::Scalar::all(j));
+        }
+    }
+}
+
+static const cv::utils::trace::RegionProfile* findRegionProfile(const std::vector<cv::utils::trace::RegionProfile>& summary, const std::string& name)
+{
+    for (size_t i = 0; i < summary.size(); i++)
+    {
+        if (summary[i].name == name)
+            return &summary[i];
+    }
+    return NULL;
+}
+
+TEST(Trace, profiler)
+{
+    using namespace cv::utils::trace;
+    const bool prevEnabled = isProfilerEnabled();
+    setProfilerEnabled(true);
+    if (!isProfilerEnabled())
+        throw SkipTestException("OpenCV is built without trace support");
+    const int prevPeriod = getProfilerSamplingPeriod();
+    setProfilerSamplingPeriod(1);
+    resetProfiler();
+
+    runProfilerTestRegions(10);
+    parallel_for_(Range(0, 16), [&](const Range&) {
+        cv::Mat m(16, 16, CV_8UC1, cv::Scalar::all(1));
+    });
+    setProfilerEnabled(prevEnabled);
+
+    std::vector<RegionProfile> summary = getProfilerSummary();
+    for (size_t i = 1; i < summary.size(); i++)
+        EXPECT_GE(summary[i - 1].total, summary[i].total);
+    const RegionProfile* outer = findRegionProfile(summary, "test_profiler_outer");
+    const RegionProfile* inner = findRegionProfile(summary, "test_profiler_inner");
+    ASSERT_TRUE(outer != NULL);
+    ASSERT_TRUE(inner != NULL);
+    EXPECT_EQ(10, outer->count);
+    EXPECT_EQ(30, inner->count);
+    EXPECT_LE(outer->p50, outer->p90);
+    EXPECT_LE(outer->p90, outer->p99);
+    EXPECT_LE(outer->p99, outer->max);
+    EXPECT_NEAR(outer->total, outer->mean * 10, 1e-6);
+    if (getNumThreads() > 1)
+    {
+        const RegionProfile* stripes = findRegionProfile(summary, "parallel_for_body");
+        ASSERT_TRUE(stripes != NULL);
+        EXPECT_GE(stripes->count, 16);
+    }
+
+    // each inner region is nested into outer region of the same thread
+    const std::string fname = cv::tempfile(".json");
+    ASSERT_TRUE(writeProfilerChromeTrace(fname));
+    FileStorage fs(fname, FileStorage::READ | FileStorage::FORMAT_JSON);
+    FileNode events = fs["traceEvents"];
+    ASSERT_TRUE(events.isSeq());
+    std::vector<Vec3d> outerEvents, innerEvents;  // tid, ts, dur
+    for (FileNodeIterator it = events.begin(); it != events.end(); ++it)
+    {
+        EXPECT_EQ("X", (std::string)(*it)["ph"]);
+        const std::string name = (std::string)(*it)["name"];
+        const Vec3d e((double)(*it)["tid"], (double)(*it)["ts"], (double)(*it)["dur"]);
+        if (name == "test_profiler_outer")
+            outerEvents.push_back(e);
+        else if (name == "test_profiler_inner")
+            innerEvents.push_back(e);
+    }
+    fs.release();
+    EXPECT_EQ(0, remove(fname.c_str()));
+    ASSERT_EQ(10u, outerEvents.size());
+    ASSERT_EQ(30u, innerEvents.size());
+    for (size_t i = 0; i < innerEvents.size(); i++)
+    {
+        const Vec3d& e = innerEvents[i];
+        int parents = 0;
+        for (size_t j = 0; j < outerEvents.size(); j++)
+        {
+            const Vec3d& p = outerEvents[j];
+            if (p[0] == e[0] && p[1] <= e[1] + 1e-3 && e[1] + e[2] <= p[1] + p[2] + 1e-3)
+                parents++;
+        }
+        EXPECT_EQ(1, parents) << "inner region " << i;
+    }
+
+    resetProfiler();
+    EXPECT_TRUE(getProfilerSummary().empty());
+    setProfilerSamplingPeriod(prevPeriod);
+}
+
+TEST(Trace, profiler_sampling)
+{
+    using namespace cv::utils::trace;
+    const bool prevEnabled = isProfilerEnabled();
+    setProfilerEnabled(true);
+    if (!isProfilerEnabled())
+        throw SkipTestException("OpenCV is built without trace support");
+    const int prevPeriod = getProfilerSamplingPeriod();
+    resetProfiler();
+
+    setProfilerSamplingPeriod(4);
+    runProfilerTestRegions(40);
+    setProfilerSamplingPeriod(prevPeriod);
+    setProfilerEnabled(prevEnabled);
+
+    // whole trees of regions are sampled
+    std::vector<RegionProfile> summary = getProfilerSummary();
+    const RegionProfile* outer = findRegionProfile(summary, "test_profiler_outer");
+    const RegionProfile* inner = findRegionProfile(summary, "test_profiler_inner");
+    ASSERT_TRUE(outer != NULL);
+    ASSERT_TRUE(inner != NULL);
+    EXPECT_EQ(10, outer->count);
+    EXPECT_EQ(30, inner->count);
+
+    resetProfiler();
+}
 
 }} // namespace
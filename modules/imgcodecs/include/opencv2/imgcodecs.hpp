@@ -108,6 +108,9 @@ enum ImwriteFlags {
        IMWRITE_TIFF_COMPRESSION    = 259,//!< For TIFF, use to specify the image compression scheme. See cv::ImwriteTiffCompressionFlags. Note, for images whose depth is CV_32F, only libtiff's SGILOG compression scheme is used. For other supported depths, the compression scheme can be specified by this flag; LZW compression is the default.
        IMWRITE_TIFF_ROWSPERSTRIP   = 278,//!< For TIFF, use to specify the number of rows per strip.
        IMWRITE_TIFF_PREDICTOR      = 317,//!< For TIFF, use to specify predictor. See cv::ImwriteTiffPredictorFlags.
+       IMWRITE_TIFF_TILE_WIDTH     = 322,//!< For TIFF, use to write the image in tiles of the specified width instead of strips. It is rounded up to a multiple of 16. Default is 0 - strips.
+       IMWRITE_TIFF_TILE_HEIGHT    = 323,//!< For TIFF, use to specify the height of the tiles. It is rounded up to a multiple of 16. Default is the tile width.
+       IMWRITE_TIFF_BIGTIFF        = 260,//!< For TIFF, 1 to write BigTIFF with 64-bit offsets, 0 to write classic TIFF. By default, BigTIFF is used if the uncompressed image data exceeds 2GB.
        IMWRITE_JPEG2000_COMPRESSION_X1000 = 272,//!< For JPEG2000, use to specify the target compression rate (multiplied by 1000). The value can be from 0 to 1000. Default is 1000.
        IMWRITE_AVIF_QUALITY        = 512,//!< For AVIF, it can be a quality between 0 and 100 (the higher the better). Default is 95.
        IMWRITE_AVIF_DEPTH          = 513,//!< For AVIF, it can be 8, 10 or 12. If >8, it is stored/read as CV_32F. Default is 8.
@@ -328,9 +331,28 @@ This is an overloaded member function, provided for convenience. It differs from
 @param flags Flag that can take values of cv::ImreadModes
 @note
 The image passing through the img parameter can be pre-allocated. The memory is reused if the shape and the type match with the load image.
+The pre-allocated image need not be continuous, see cv::imdecode(InputArray, OutputArray, int).
  */
 CV_EXPORTS_W void imread( const String& filename, OutputArray dst, int flags = IMREAD_COLOR_BGR );
 
+/** @brief Loads a region of an image from a file.
+
+The function returns the same pixels as `imread(filename, flags)(roi)`, but the JPEG, PNG and TIFF decoders
+skip the data outside of the region where the format allows it: JPEG scanlines above and below the
+region are skipped and only the iMCU columns covering it are decoded (with libjpeg-turbo), PNG rows below
+the region are not decompressed, and only the TIFF tiles or strips intersecting the region are read.
+Other formats, interlaced PNG images and TIFF images with non-default orientation are decoded as a whole
+and cropped.
+
+@param filename Name of file to be loaded.
+@param roi Region of the image in the coordinates of the image returned by cv::imread with the same flags,
+including the cv::IMREAD_REDUCED_* scaling. An empty rectangle selects the whole image.
+@param flags Flag that can take values of cv::ImreadModes
+@note The EXIF orientation is not applied when the region is not empty, the region is taken from the image
+as it is stored.
+ */
+CV_EXPORTS_AS(imreadROI) Mat imread( const String& filename, const Rect& roi, int flags = IMREAD_COLOR_BGR );
+
 /** @brief Loads a multi-page image from a file.
 
 The function imreadmulti loads a multi-page image from the specified file into a vector of Mat objects.
@@ -467,6 +489,31 @@ failure the function returns empty cv::Mat object, but does not release user-pro
 */
 CV_EXPORTS Mat imdecode( InputArray buf, int flags, Mat* dst);
 
+/** @brief Reads an image from a buffer in memory into a pre-allocated matrix.
+
+This is an overloaded member function, provided for convenience. It differs from the above function only in what argument(s) it accepts and the return value.
+@param buf Input array or vector of bytes.
+@param dst object in which the image will be decoded. If it is empty, it is allocated.
+@param flags The same flags as in cv::imread, see cv::ImreadModes.
+@note
+A non-empty dst must have the size and the type of the decoded image (after the reduction requested by
+IMREAD_REDUCED_* flags), otherwise an exception is thrown. Its buffer is filled in place and need not be
+continuous, so dst can be a header over a part of a larger buffer, e.g. one slot of an N×H×W×C batch tensor.
+The decoders that support it convert the colors row by row straight into dst. An EXIF orientation that swaps
+the width and the height reallocates dst, pass IMREAD_IGNORE_ORIENTATION to prevent it. In case of decoder
+failure dst is released.
+*/
+CV_EXPORTS_W void imdecode( InputArray buf, OutputArray dst, int flags );
+
+/** @brief Reads a region of an image from a buffer in memory.
+
+See cv::imread for the description of the region decoding.
+@param buf Input array or vector of bytes.
+@param roi Region of the decoded image, an empty rectangle selects the whole image.
+@param flags The same flags as in cv::imread, see cv::ImreadModes.
+*/
+CV_EXPORTS_AS(imdecodeROI) Mat imdecode( InputArray buf, const Rect& roi, int flags );
+
 /** @brief Reads a multi-page image from a buffer in memory.
 
 The function imdecodemulti reads a multi-page image from the specified buffer in the memory. If the buffer is too short or
@@ -482,6 +529,23 @@ See cv::imreadmulti for the list of supported formats and flags description.
 */
 CV_EXPORTS_W bool imdecodemulti(InputArray buf, int flags, CV_OUT std::vector<Mat>& mats, const cv::Range& range = Range::all());
 
+/** @brief Reads a batch of images from buffers in memory in parallel.
+
+The function decodes the buffers concurrently using the OpenCV parallel framework, so the number of worker
+threads is bounded by cv::setNumThreads. Each buffer is decoded as with cv::imdecode(InputArray, OutputArray, int).
+A broken buffer does not stop the batch: its image is left empty and the reason is reported in errors.
+
+@param bufs Encoded images, each one an array or a vector of bytes.
+@param flags The same flags as in cv::imread, see cv::ImreadModes.
+@param dst Decoded images. If dst has as many elements as bufs, its non-empty elements are filled in place and
+must have the size and the type of the decoded images, e.g. headers over the slots of a batch tensor.
+Otherwise it is resized and the images are allocated.
+@param errors Error message for each image, empty for the images decoded successfully.
+@return Number of images decoded successfully.
+*/
+CV_EXPORTS_W int imdecodeBatch( InputArrayOfArrays bufs, int flags, CV_IN_OUT std::vector<Mat>& dst,
+                                CV_OUT std::vector<String>& errors );
+
 /** @brief Encodes an image into a memory buffer.
 
 The function imencode compresses the image and stores it in the memory buffer that is resized to fit the
@@ -588,6 +652,91 @@ protected:
     Ptr<Impl> pImpl;
 };
 
+/** @brief Writes an image incrementally, by strips of rows or by tiles
+
+The class encodes images that are too large to be kept in memory as a whole. The image is written to the file
+while it is produced, the memory used by the encoder is proportional to one strip of rows or one row of tiles.
+Only the TIFF, PNG and JPEG formats support incremental encoding. For TIFF, the image is organized in tiles if
+IMWRITE_TIFF_TILE_WIDTH is specified and BigTIFF is used for large images, see cv::ImwriteFlags.
+Progressive or optimized JPEG encoding keeps the whole image in memory inside of libjpeg.
+
+The strips and tiles may be passed in any order and from several threads at once, e.g. from the body of
+cv::parallel_for_. The data which cannot be encoded yet, i.e. the strips below the first missing row,
+is copied and kept until the missing rows arrive. While the encoder is busy with the rows above, the threads
+which run ahead of it wait once the kept data exceeds OPENCV_IO_MAX_WRITER_QUEUE_SIZE bytes (64 MB by default).
+For tiled TIFF the tiles are written immediately. Each pixel of the image must be written exactly once,
+overlapping strips or tiles raise an exception.
+
+@code
+    ImageWriter writer("mosaic.tif", Size(width, height), CV_8UC3, { IMWRITE_TIFF_TILE_WIDTH, 512 });
+    parallel_for_(Range(0, height / 512), [&](const Range& r) {
+        for (int i = r.start; i < r.end; i++)
+            writer.writeRows(renderStrip(i), i * 512);
+    });
+    writer.close();
+@endcode
+*/
+class CV_EXPORTS_W ImageWriter
+{
+public:
+    CV_WRAP ImageWriter();
+
+    /** @overload
+    @param filename Name of the file, the format is chosen by the extension.
+    @param size Size of the whole image.
+    @param type Type of the image. Depths which are not supported by the format are converted to CV_8U, like in cv::imwrite.
+    @param params Format-specific parameters, see cv::imwrite and cv::ImwriteFlags.
+    */
+    CV_WRAP ImageWriter(const String& filename, Size size, int type, const std::vector<int>& params = std::vector<int>());
+
+    /** @brief Closes the image, see close(). */
+    ~ImageWriter();
+
+    /** @brief Starts writing an image of the given size and type to the file.
+
+    The image written previously is closed first.
+    @param filename Name of the file, the format is chosen by the extension.
+    @param size Size of the whole image.
+    @param type Type of the image. Depths which are not supported by the format are converted to CV_8U, like in cv::imwrite.
+    @param params Format-specific parameters, see cv::imwrite and cv::ImwriteFlags.
+    @return true if the format supports incremental encoding and the file is opened, false otherwise.
+    */
+    CV_WRAP bool open(const String& filename, Size size, int type, const std::vector<int>& params = std::vector<int>());
+
+    /** @brief Returns true if an image is opened for writing. */
+    CV_WRAP bool isOpened() const;
+
+    /** @brief Writes a strip of rows.
+
+    @param rows Rows of the full image width and of the type passed to open().
+    @param y Index of the first row in the image. Negative value means the row after the last row written before.
+    @return false if the encoding has failed, true otherwise.
+    */
+    CV_WRAP bool writeRows(InputArray rows, int y = -1);
+
+    /** @brief Writes a rectangular tile.
+
+    For tiled TIFF the position must be a multiple of the tile size, and the tile must have the tile size, except
+    for the tiles at the right and bottom borders. For other formats any tiles can be used, they are combined into
+    strips of rows.
+    @param tile Tile of the type passed to open().
+    @param pos Position of the top-left corner of the tile in the image.
+    @return false if the encoding has failed, true otherwise.
+    */
+    CV_WRAP bool writeTile(InputArray tile, Point pos);
+
+    /** @brief Completes the image and closes the file.
+
+    If some rows of the image have not been written, the file is removed.
+    @return true if the whole image has been successfully written, false otherwise.
+    */
+    CV_WRAP bool close();
+
+    class Impl;
+protected:
+    Ptr<Impl> pImpl;
+};
+
 //! @} imgcodecs
 
 } // cv
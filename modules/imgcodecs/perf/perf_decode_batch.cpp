@@ -0,0 +1,63 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "perf_precomp.hpp"
+#include "opencv2/imgproc.hpp"
+
+namespace opencv_test
+{
+
+using namespace perf;
+
+// Each cycle decodes the whole batch, the throughput is batch_size / time per cycle (images/sec).
+static const int batch_size = 64;
+
+typedef tuple<std::string, bool> Ext_Batched_t;
+typedef perf::TestBaseWithParam<Ext_Batched_t> Ext_Batched;
+
+PERF_TEST_P(Ext_Batched, imdecodeBatch,
+            testing::Combine(
+                testing::Values(
+#ifdef HAVE_JPEG
+                    ".jpg",
+#endif
+#if defined(HAVE_PNG) || defined(HAVE_SPNG)
+                    ".png",
+#endif
+                    ".bmp"),
+                testing::Bool()))
+{
+    const std::string ext = get<0>(GetParam());
+    const bool batched = get<1>(GetParam());
+
+    std::vector<std::vector<uchar> > bufs(batch_size);
+    for (int i = 0; i < batch_size; i++)
+    {
+        Mat src(240 + 8 * (i % 4), 320, CV_8UC3);
+        randu(src, Scalar::all(0), Scalar::all(255));
+        GaussianBlur(src, src, Size(9, 9), 0);
+        ASSERT_TRUE(imencode(ext, src, bufs[i]));
+    }
+
+    // Both variants decode into dst, the buffers allocated by the first cycle are reused by the next ones.
+    std::vector<Mat> dst(batch_size);
+    std::vector<String> errors;
+
+    if (batched)
+    {
+        TEST_CYCLE() ASSERT_EQ(batch_size, imdecodeBatch(bufs, IMREAD_COLOR, dst, errors));
+    }
+    else
+    {
+        TEST_CYCLE()
+        {
+            for (int i = 0; i < batch_size; i++)
+                imdecode(bufs[i], dst[i], IMREAD_COLOR);
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+} // namespace
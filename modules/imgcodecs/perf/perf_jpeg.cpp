@@ -2,6 +2,7 @@
 // It is subject to the license terms in the LICENSE file found in the top-level directory
 // of this distribution and at http://opencv.org/license.html
 #include "perf_precomp.hpp"
+#include "opencv2/imgproc.hpp"
 
 namespace opencv_test
 {
@@ -44,6 +45,27 @@ PERF_TEST(JPEG, Decode_rgb)
     SANITY_CHECK_NOTHING();
 }
 
+PERF_TEST(JPEG, Decode_roi)
+{
+    String filename = getDataPath("stitching/boat1.jpg");
+
+    FILE *f = fopen(filename.c_str(), "rb");
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    vector<uchar> file_buf((size_t)len);
+    EXPECT_EQ(len, (long)fread(&file_buf[0], 1, (size_t)len, f));
+    fclose(f); f = NULL;
+
+    const Mat full = imdecode(file_buf, IMREAD_COLOR);
+    ASSERT_FALSE(full.empty());
+    const Rect roi(full.cols/2 - 128, full.rows/2 - 128, 256, 256);
+
+    TEST_CYCLE() imdecode(file_buf, roi, IMREAD_COLOR);
+
+    SANITY_CHECK_NOTHING();
+}
+
 PERF_TEST(JPEG, Encode)
 {
     String filename = getDataPath("stitching/boat1.jpg");
@@ -55,6 +77,39 @@ PERF_TEST(JPEG, Encode)
     SANITY_CHECK_NOTHING();
 }
 
+// Restart intervals let large images be encoded and decoded in independent strips.
+static Mat makeRestartTestImage()
+{
+    Mat src(2160, 3840, CV_8UC3);
+    randu(src, Scalar::all(0), Scalar::all(255));
+    blur(src, src, Size(15, 15));
+    return src;
+}
+
+PERF_TEST(JPEG, Encode_4k_rst)
+{
+    const Mat src = makeRestartTestImage();
+    const std::vector<int> params = { IMWRITE_JPEG_RST_INTERVAL, 64 };
+
+    vector<uchar> buf;
+    TEST_CYCLE() imencode(".jpg", src, buf, params);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST(JPEG, Decode_4k_rst)
+{
+    const Mat src = makeRestartTestImage();
+    const std::vector<int> params = { IMWRITE_JPEG_RST_INTERVAL, 64 };
+
+    vector<uchar> buf;
+    ASSERT_TRUE(imencode(".jpg", src, buf, params));
+
+    TEST_CYCLE() imdecode(buf, IMREAD_COLOR);
+
+    SANITY_CHECK_NOTHING();
+}
+
 #endif // HAVE_JPEG
 
 } // namespace
\ No newline at end of file
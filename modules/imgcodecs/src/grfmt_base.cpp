@@ -96,6 +96,11 @@ int BaseImageDecoder::setScale( const int& scale_denom )
     return temp;
 }
 
+bool BaseImageDecoder::setROI(const Rect&)
+{
+    return false;
+}
+
 void BaseImageDecoder::setRGB(bool useRGB)
 {
     m_use_rgb = useRGB;
@@ -149,6 +154,31 @@ bool BaseImageEncoder::writeanimation(const Animation&, const std::vector<int>&
     return false;
 }
 
+bool BaseImageEncoder::beginStream(Size, int, const std::vector<int>& )
+{
+    return false;
+}
+
+bool BaseImageEncoder::writeRows(const Mat& )
+{
+    return false;
+}
+
+Size BaseImageEncoder::streamTileSize() const
+{
+    return Size();
+}
+
+bool BaseImageEncoder::writeTile(const Mat&, Point )
+{
+    return false;
+}
+
+bool BaseImageEncoder::endStream()
+{
+    return false;
+}
+
 ImageEncoder BaseImageEncoder::newEncoder() const
 {
     return ImageEncoder();
@@ -107,6 +107,15 @@ public:
      */
     virtual bool readData(Mat& img) = 0;
 
+    /**
+     * @brief Restrict decoding to a region of the image.
+     * Called after readHeader(). The default implementation does not support regions and returns false,
+     * in this case the caller decodes the whole image and crops it.
+     * @param roi The region inside of the width() x height() image.
+     * @return true if readData() will decode only the region into an image of roi.size(), false otherwise.
+     */
+    virtual bool setROI(const Rect& roi);
+
     /**
      * @brief Set whether to decode the image in RGB order instead of the default BGR.
      * @param useRGB If true, the image will be decoded in RGB order.
@@ -151,6 +160,7 @@ protected:
     Mat m_buf;            ///< Buffer holding the image data when loaded from memory.
     bool m_buf_supported; ///< Flag indicating whether buffer-based loading is supported.
     bool m_use_rgb;       ///< Flag indicating whether to decode the image in RGB order.
+    Rect m_roi;           ///< Region to decode (set by setROI), empty for the whole image.
     ExifReader m_exif;    ///< Object for reading EXIF metadata from the image.
     size_t m_frame_count; ///< Number of frames in the image (for animations and multi-page images).
     Animation m_animation;
@@ -220,6 +230,48 @@ public:
 
     virtual bool writeanimation(const Animation& animation, const std::vector<int>& params);
 
+    /**
+     * @brief Start the incremental encoding of an image.
+     * The image data is passed later by writeRows() or writeTile() and the image is completed by endStream().
+     * Destroying the encoder before endStream() abandons the image.
+     * By default, this method returns false, indicating that the format does not support incremental encoding.
+     * @param size The size of the whole image.
+     * @param type The type of the image, the depth must be supported by isFormatSupported().
+     * @param params A vector of parameters controlling the encoding process.
+     * @return true if the encoding was successfully started, false otherwise.
+     */
+    virtual bool beginStream(Size size, int type, const std::vector<int>& params);
+
+    /**
+     * @brief Encode the next rows of the image started by beginStream().
+     * The rows are passed from top to bottom, each row exactly once.
+     * @param rows The rows of the image, of the full image width.
+     * @return true if the rows were successfully written, false otherwise.
+     */
+    virtual bool writeRows(const Mat& rows);
+
+    /**
+     * @brief Get the tile size of the image started by beginStream().
+     * @return The tile size if writeTile() is supported, an empty size otherwise.
+     */
+    virtual Size streamTileSize() const;
+
+    /**
+     * @brief Encode a tile of the image started by beginStream().
+     * The tiles may be passed in any order. The position must be a multiple of streamTileSize(),
+     * the tile size is equal to streamTileSize() except for the tiles at the right and bottom borders.
+     * @param tile The tile data.
+     * @param pos The position of the top-left corner of the tile in the image.
+     * @return true if the tile was successfully written, false otherwise.
+     */
+    virtual bool writeTile(const Mat& tile, Point pos);
+
+    /**
+     * @brief Complete the image started by beginStream() and flush it to the destination.
+     * @return true if the image was successfully written, false otherwise.
+     */
+    virtual bool endStream();
+
     /**
      * @brief Get a description of the image encoder (e.g., the format it supports).
      * @return A string describing the encoder.
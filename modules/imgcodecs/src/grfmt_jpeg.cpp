@@ -88,6 +88,10 @@ extern "C" {
   #undef CV_MANUAL_JPEG_STD_HUFF_TABLES
 #endif
 
+#if defined(LIBJPEG_TURBO_VERSION_NUMBER) && LIBJPEG_TURBO_VERSION_NUMBER >= 1005000
+  #define CV_JPEG_CROP_SKIP_SCANLINES  // jpeg_crop_scanline() and jpeg_skip_scanlines() are available
+#endif
+
 namespace cv
 {
 
@@ -174,6 +178,176 @@ error_exit( j_common_ptr cinfo )
 }
 
 
+/////////////////////// Restart-marker strips ///////////////////
+
+// Large baseline images with restart markers are encoded and decoded in horizontal strips on the
+// parallel_for_ pool. A strip spans whole restart intervals, so it is coded independently of the others.
+static const int64 JPEG_PARALLEL_MIN_PIXELS = 1 << 20;
+
+// Inside a body of another parallel_for_ (e.g. imdecodeBatch) the loop over the strips runs sequentially
+// unless the backend supports nesting, so the strips would only add the splitting and stitching overhead.
+static bool useParallelStrips( int64 pixels )
+{
+    return getNumThreads() >= 2 && pixels >= JPEG_PARALLEL_MIN_PIXELS && !isNestedParallelForSequential();
+}
+
+/**
+ * Groups of MCU rows that start and end at restart interval boundaries
+ */
+struct JpegRestartLayout
+{
+    int rows_per_group;      //!< image rows in a group
+    int intervals_per_group; //!< restart intervals in a group
+    int ngroups;             //!< number of groups, the last one may be shorter
+};
+
+static bool getRestartLayout( int width, int height, int mcu_width, int mcu_height,
+                              int restart_interval, JpegRestartLayout& layout )
+{
+    if( restart_interval <= 0 )
+        return false;
+    const int mcu_cols = divUp(width, mcu_width);
+    int a = restart_interval, b = mcu_cols;
+    while( b != 0 )
+    {
+        const int t = a % b;
+        a = b;
+        b = t;
+    }
+    const int group_mcu_rows = restart_interval / a; // the shortest run of whole rows of whole intervals
+    layout.rows_per_group = group_mcu_rows * mcu_height;
+    layout.intervals_per_group = group_mcu_rows * mcu_cols / restart_interval;
+    layout.ngroups = divUp(height, layout.rows_per_group);
+    return layout.ngroups >= 2;
+}
+
+/**
+ * Locates the frame height field and the end of the scan header of a sequential JPEG stream
+ */
+static bool parseJpegHeaders( const uchar* data, size_t size, size_t& height_pos, size_t& sos_end )
+{
+    if( size < 4 || data[0] != 0xFF || data[1] != SOI )
+        return false;
+    height_pos = 0;
+    size_t pos = 2;
+    while( pos + 4 <= size )
+    {
+        if( data[pos] != 0xFF )
+            return false;
+        const uchar marker = data[pos + 1];
+        if( marker == 0xFF ) // fill byte
+        {
+            pos++;
+            continue;
+        }
+        const size_t length = ((size_t)data[pos + 2] << 8) | data[pos + 3];
+        if( length < 2 || pos + 2 + length > size )
+            return false;
+        if( marker == SOF0 || marker == SOF1 )
+            height_pos = pos + 5; // after the length and the sample precision
+        else if( marker >= SOF2 && marker <= 0xCF && marker != DHT && marker != 0xC8 && marker != 0xCC )
+            return false; // progressive, lossless or arithmetic coding
+        else if( marker == SOS )
+        {
+            sos_end = pos + 2 + length;
+            return height_pos != 0;
+        }
+        pos += 2 + length;
+    }
+    return false;
+}
+
+/**
+ * Collects the positions of the restart markers in the entropy-coded data starting at pos
+ *
+ * @return Position of the marker that ends the data, 0 if the stream is truncated
+ */
+static size_t findRestartMarkers( const uchar* data, size_t size, size_t pos, std::vector<size_t>& rst )
+{
+    while( pos + 1 < size )
+    {
+        const uchar* ff = (const uchar*)memchr(data + pos, 0xFF, size - 1 - pos);
+        if( !ff )
+            break;
+        pos = ff - data;
+        const uchar marker = data[pos + 1];
+        if( marker >= RST0 && marker <= RST7 )
+            rst.push_back(pos);
+        else if( marker != 0x00 && marker != 0xFF ) // neither a stuffed zero nor a fill byte
+            return pos;
+        pos++;
+    }
+    return 0;
+}
+
+static void setFrameHeight( uchar* height_field, int height )
+{
+    height_field[0] = (uchar)(height >> 8);
+    height_field[1] = (uchar)height;
+}
+
+/**
+ * Builds a standalone stream of the groups [g0, g1) of a restart-coded stream
+ */
+static void makeRestartStrip( const uchar* data, size_t height_pos, size_t sos_end, size_t data_end,
+                              const std::vector<size_t>& rst, const JpegRestartLayout& layout,
+                              int g0, int g1, int height, std::vector<uchar>& strip )
+{
+    const size_t r0 = (size_t)g0 * layout.intervals_per_group; // first interval of the strip
+    const size_t r1 = (size_t)g1 * layout.intervals_per_group;
+    const size_t first = r0 == 0 ? sos_end : rst[r0 - 1] + 2;
+    const size_t last = r1 - 1 < rst.size() ? rst[r1 - 1] : data_end;
+
+    strip.assign(data, data + sos_end);
+    setFrameHeight(&strip[height_pos], std::min(g1 * layout.rows_per_group, height) - g0 * layout.rows_per_group);
+    const size_t start = strip.size();
+    strip.insert(strip.end(), data + first, data + last);
+    // the restart markers are numbered from 0 in each stream
+    for( size_t r = r0; r + 1 < r1 && r < rst.size(); r++ )
+        strip[start + rst[r] - first + 1] = (uchar)(RST0 + ((r - r0) & 7));
+    strip.push_back(0xFF);
+    strip.push_back(EOI);
+}
+
+/**
+ * Concatenates the streams of consecutive strips, separated by restart markers, into one stream
+ */
+static bool joinRestartStrips( const std::vector<std::vector<uchar> >& strips, int height, std::vector<uchar>& out )
+{
+    size_t nrst = 0, height_pos = 0;
+    for( size_t s = 0; s < strips.size(); s++ )
+    {
+        const std::vector<uchar>& strip = strips[s];
+        size_t strip_height_pos = 0, sos_end = 0;
+        std::vector<size_t> rst;
+        if( !parseJpegHeaders(strip.data(), strip.size(), strip_height_pos, sos_end) )
+            return false;
+        const size_t data_end = findRestartMarkers(strip.data(), strip.size(), sos_end, rst);
+        if( data_end == 0 || strip[data_end + 1] != EOI )
+            return false;
+
+        if( s == 0 )
+        {
+            height_pos = out.size() + strip_height_pos;
+            out.insert(out.end(), strip.begin(), strip.begin() + sos_end);
+        }
+        else
+        {
+            out.push_back(0xFF);
+            out.push_back((uchar)(RST0 + (nrst++ & 7)));
+        }
+        const size_t start = out.size();
+        out.insert(out.end(), strip.begin() + sos_end, strip.begin() + data_end);
+        for( size_t r = 0; r < rst.size(); r++ )
+            out[start + rst[r] - sos_end + 1] = (uchar)(RST0 + (nrst++ & 7));
+    }
+    setFrameHeight(&out[height_pos], height);
+    out.push_back(0xFF);
+    out.push_back(EOI);
+    return true;
+}
+
+
 /////////////////////// JpegDecoder ///////////////////
 
 
@@ -263,6 +437,12 @@ bool  JpegDecoder::readHeader()
     return result;
 }
 
+bool  JpegDecoder::setROI( const Rect& roi )
+{
+    m_roi = roi;
+    return true;
+}
+
 #ifdef CV_MANUAL_JPEG_STD_HUFF_TABLES
 /***************************************************************************
  * following code is for supporting MJPEG image files
@@ -491,56 +671,96 @@ bool  JpegDecoder::readData( Mat& img )
                 }
             }
 
+            if( m_roi.empty() && readDataParallel( img ) )
+            {
+                jpeg_abort_decompress( cinfo );
+                return true;
+            }
 
             jpeg_start_decompress( cinfo );
 
-            if( doDirectRead)
+            // rows [y0, y1) and columns [xofs, xofs + width) of the decoded scanlines go to img
+            int y0 = 0, y1 = m_height, xofs = 0, width = m_width, iy = 0;
+            if( !m_roi.empty() )
             {
-                for( int iy = 0 ; iy < m_height; iy ++ )
+                y0 = m_roi.y;
+                y1 = m_roi.y + m_roi.height;
+                xofs = m_roi.x;
+                width = m_roi.width;
+#ifdef CV_JPEG_CROP_SKIP_SCANLINES
+                // the decoded columns are extended to the iMCU boundaries on the left. The chroma upsampling
+                // replicates the edge columns of the decoded area, so a margin is added around the region.
+                const int margin = 2;
+                JDIMENSION crop_x = (JDIMENSION)std::max(m_roi.x - margin, 0);
+                JDIMENSION crop_width = (JDIMENSION)(std::min(m_roi.x + m_roi.width + margin, m_width) - (int)crop_x);
+                jpeg_crop_scanline( cinfo, &crop_x, &crop_width );
+                xofs = m_roi.x - (int)crop_x;
+                if( y0 > 0 )
+                    iy = (int)jpeg_skip_scanlines( cinfo, (JDIMENSION)y0 );
+#endif
+            }
+            const bool cropped = xofs != 0 || width != (int)cinfo->output_width;
+
+            if( doDirectRead && !cropped )
+            {
+                for( ; iy < y1; iy++ )
                 {
-                    uchar* data = img.ptr<uchar>(iy);
+                    // the rows above the region are decoded into the first row and overwritten
+                    uchar* data = img.ptr<uchar>(std::max(iy - y0, 0));
                     if (jpeg_read_scanlines( cinfo, &data, 1 ) != 1) return false;
                 }
             }
             else
             {
                 JSAMPARRAY buffer = (*cinfo->mem->alloc_sarray)((j_common_ptr)cinfo,
-                                                                 JPOOL_IMAGE, m_width*4, 1 );
+                                                                 JPOOL_IMAGE, cinfo->output_width*4, 1 );
 
-                for( int iy = 0 ; iy < m_height; iy ++ )
+                for( ; iy < y1; iy++ )
                 {
-                    uchar* data = img.ptr<uchar>(iy);
                     if (jpeg_read_scanlines( cinfo, buffer, 1 ) != 1) return false;
+                    if( iy < y0 )
+                        continue;
+
+                    uchar* data = img.ptr<uchar>(iy - y0);
+                    const uchar* src = buffer[0] + xofs*cinfo->out_color_components;
 
-                    if( color )
+                    if( doDirectRead )
+                    {
+                        memcpy( data, src, width*cinfo->out_color_components );
+                    }
+                    else if( color )
                     {
                         if (m_use_rgb)
                         {
                             if( cinfo->out_color_components == 3 )
-                                icvCvt_BGR2RGB_8u_C3R( buffer[0], 0, data, 0, Size(m_width,1) );
+                                icvCvt_BGR2RGB_8u_C3R( src, 0, data, 0, Size(width,1) );
                             else
-                                icvCvt_CMYK2RGB_8u_C4C3R( buffer[0], 0, data, 0, Size(m_width,1) );
+                                icvCvt_CMYK2RGB_8u_C4C3R( src, 0, data, 0, Size(width,1) );
                         }
                         else
                         {
                             if( cinfo->out_color_components == 3 )
-                                icvCvt_RGB2BGR_8u_C3R( buffer[0], 0, data, 0, Size(m_width,1) );
+                                icvCvt_RGB2BGR_8u_C3R( src, 0, data, 0, Size(width,1) );
                             else
-                                icvCvt_CMYK2BGR_8u_C4C3R( buffer[0], 0, data, 0, Size(m_width,1) );
+                                icvCvt_CMYK2BGR_8u_C4C3R( src, 0, data, 0, Size(width,1) );
                         }
                     }
                     else
                     {
                         if( cinfo->out_color_components == 1 )
-                            memcpy( data, buffer[0], m_width );
+                            memcpy( data, src, width );
                         else
-                            icvCvt_CMYK2Gray_8u_C4C1R( buffer[0], 0, data, 0, Size(m_width,1) );
+                            icvCvt_CMYK2Gray_8u_C4C1R( src, 0, data, 0, Size(width,1) );
                     }
                 }
             }
 
             result = true;
-            jpeg_finish_decompress( cinfo );
+            // the rows below the region are not decoded
+            if( cinfo->output_scanline < cinfo->output_height )
+                jpeg_abort_decompress( cinfo );
+            else
+                jpeg_finish_decompress( cinfo );
         }
     }
 
@@ -548,6 +768,91 @@ bool  JpegDecoder::readData( Mat& img )
 }
 
 
+bool JpegDecoder::readDataParallel( Mat& img )
+{
+    jpeg_decompress_struct* cinfo = &((JpegState*)m_state)->cinfo;
+    if( !useParallelStrips((int64)m_width * m_height) ||
+        cinfo->restart_interval == 0 || cinfo->progressive_mode || cinfo->arith_code ||
+        cinfo->comps_in_scan != cinfo->num_components ||
+        (int)cinfo->image_width != m_width || (int)cinfo->image_height != m_height )
+        return false;
+
+    // a non-interleaved scan of a single component has MCUs of one block
+    const int mcu_width = cinfo->comps_in_scan > 1 ? DCTSIZE * cinfo->max_h_samp_factor : DCTSIZE;
+    const int mcu_height = cinfo->comps_in_scan > 1 ? DCTSIZE * cinfo->max_v_samp_factor : DCTSIZE;
+    JpegRestartLayout layout;
+    if( !getRestartLayout(m_width, m_height, mcu_width, mcu_height, (int)cinfo->restart_interval, layout) )
+        return false;
+
+    std::vector<uchar> file_buf;
+    const uchar* data = m_buf.ptr();
+    size_t size = m_buf.total() * m_buf.elemSize();
+    if( m_buf.empty() )
+    {
+        FILE* f = fopen( m_filename.c_str(), "rb" );
+        if( !f )
+            return false;
+        fseek( f, 0, SEEK_END );
+        const long length = ftell( f );
+        fseek( f, 0, SEEK_SET );
+        if( length > 0 )
+        {
+            file_buf.resize( (size_t)length );
+            file_buf.resize( fread( file_buf.data(), 1, file_buf.size(), f ) );
+        }
+        fclose( f );
+        data = file_buf.data();
+        size = file_buf.size();
+    }
+
+    size_t height_pos = 0, sos_end = 0;
+    if( !parseJpegHeaders(data, size, height_pos, sos_end) )
+        return false;
+    std::vector<size_t> rst;
+    const size_t data_end = findRestartMarkers(data, size, sos_end, rst);
+    const int64 mcus = (int64)divUp(m_width, mcu_width) * divUp(m_height, mcu_height);
+    if( data_end == 0 || data[data_end + 1] != EOI ||
+        (int64)rst.size() + 1 != (mcus + cinfo->restart_interval - 1) / cinfo->restart_interval )
+        return false;
+
+    // the vertical chroma upsampling blends neighbouring rows, so such strips are decoded
+    // together with one group above and below and these rows are skipped
+    const int context = cinfo->max_v_samp_factor > 1 ? 1 : 0;
+    const int groups_per_strip = divUp(layout.ngroups, std::min(layout.ngroups, getNumThreads()));
+    const int nstrips = divUp(layout.ngroups, groups_per_strip);
+    std::vector<uchar> decoded(nstrips, 0);
+
+    parallel_for_(Range(0, nstrips), [&](const Range& range)
+    {
+        std::vector<uchar> strip;
+        for( int s = range.start; s < range.end; s++ )
+        {
+            const int g0 = s * groups_per_strip, g1 = std::min(g0 + groups_per_strip, layout.ngroups);
+            const int c0 = std::max(g0 - context, 0), c1 = std::min(g1 + context, layout.ngroups);
+            const int y0 = g0 * layout.rows_per_group, y1 = std::min(g1 * layout.rows_per_group, m_height);
+            makeRestartStrip(data, height_pos, sos_end, data_end, rst, layout, c0, c1, m_height, strip);
+            try
+            {
+                JpegDecoder decoder;
+                decoder.setSource(Mat(1, (int)strip.size(), CV_8U, strip.data()));
+                decoder.setRGB(m_use_rgb);
+                Mat dst = img.rowRange(y0, y1);
+                decoded[s] = decoder.readHeader() &&
+                             decoder.setROI(Rect(0, y0 - c0 * layout.rows_per_group, m_width, y1 - y0)) &&
+                             decoder.readData(dst);
+            }
+            catch (const cv::Exception& e)
+            {
+                CV_LOG_DEBUG(NULL, "JPEG: restart strip " << s << " is not decoded: " << e.what());
+            }
+        }
+    }, nstrips);
+
+    // any failure falls back to the sequential decoding, which reports the error
+    return std::count(decoded.begin(), decoded.end(), 0) == 0;
+}
+
+
 /////////////////////// JpegEncoder ///////////////////
 
 struct JpegDestination
@@ -612,256 +917,455 @@ ImageEncoder JpegEncoder::newEncoder() const
     return makePtr<JpegEncoder>();
 }
 
-bool JpegEncoder::write( const Mat& img, const std::vector<int>& params )
+namespace {
+
+struct JpegEncoderParams
 {
-    m_last_error.clear();
+    int quality = 95;
+    int progressive = 0;
+    int optimize = 0;
+    int rst_interval = 0;
+    int luma_quality = -1;
+    int chroma_quality = -1;
+    uint32_t sampling_factor = 0; // same as 0x221111
+};
 
-    struct fileWrapper
-    {
-        FILE* f;
+} // namespace
 
-        fileWrapper() : f(0) {}
-        ~fileWrapper() { if(f) fclose(f); }
-    };
-    volatile bool result = false;
-    fileWrapper fw;
-    int width = img.cols, height = img.rows;
+static JpegEncoderParams parseEncoderParams( const std::vector<int>& params )
+{
+    JpegEncoderParams p;
 
-    std::vector<uchar> out_buf(1 << 12);
+    for( size_t i = 0; i < params.size(); i += 2 )
+    {
+        if( params[i] == IMWRITE_JPEG_QUALITY )
+        {
+            p.quality = params[i+1];
+            p.quality = MIN(MAX(p.quality, 0), 100);
+        }
 
-    struct jpeg_compress_struct cinfo;
-    JpegErrorMgr jerr;
-    JpegDestination dest;
+        if( params[i] == IMWRITE_JPEG_PROGRESSIVE )
+        {
+            p.progressive = params[i+1];
+        }
 
-    cinfo.err = jpeg_std_error(&jerr.pub);
-    jerr.pub.error_exit = error_exit;
-    jpeg_create_compress(&cinfo);
+        if( params[i] == IMWRITE_JPEG_OPTIMIZE )
+        {
+            p.optimize = params[i+1];
+        }
 
-    if( !m_buf )
-    {
-        fw.f = fopen( m_filename.c_str(), "wb" );
-        if( !fw.f )
-            goto _exit_;
-        jpeg_stdio_dest( &cinfo, fw.f );
-    }
-    else
-    {
-        dest.dst = m_buf;
-        dest.buf = &out_buf;
+        if( params[i] == IMWRITE_JPEG_LUMA_QUALITY )
+        {
+            if (params[i+1] >= 0)
+            {
+                p.luma_quality = MIN(MAX(params[i+1], 0), 100);
 
-        jpeg_buffer_dest( &cinfo, &dest );
+                p.quality = p.luma_quality;
 
-        dest.pub.next_output_byte = &out_buf[0];
-        dest.pub.free_in_buffer = out_buf.size();
-    }
+                if (p.chroma_quality < 0)
+                {
+                    p.chroma_quality = p.luma_quality;
+                }
+            }
+        }
 
-    if( setjmp( jerr.setjmp_buffer ) == 0 )
-    {
-        cinfo.image_width = width;
-        cinfo.image_height = height;
+        if( params[i] == IMWRITE_JPEG_CHROMA_QUALITY )
+        {
+            if (params[i+1] >= 0)
+            {
+                p.chroma_quality = MIN(MAX(params[i+1], 0), 100);
+            }
+        }
 
-        int _channels = img.channels();
-        int channels = _channels > 1 ? 3 : 1;
+        if( params[i] == IMWRITE_JPEG_RST_INTERVAL )
+        {
+            p.rst_interval = params[i+1];
+            p.rst_interval = MIN(MAX(p.rst_interval, 0), 65535L);
+        }
 
-        bool doDirectWrite = false;
-        switch( _channels )
+        if( params[i] == IMWRITE_JPEG_SAMPLING_FACTOR )
         {
-            case 1:
-                cinfo.input_components = 1;
-                cinfo.in_color_space = JCS_GRAYSCALE;
-                doDirectWrite = true; // GRAY -> GRAY
+            p.sampling_factor = static_cast<uint32_t>(params[i+1]);
+
+            switch ( p.sampling_factor )
+            {
+                case IMWRITE_JPEG_SAMPLING_FACTOR_411:
+                case IMWRITE_JPEG_SAMPLING_FACTOR_420:
+                case IMWRITE_JPEG_SAMPLING_FACTOR_422:
+                case IMWRITE_JPEG_SAMPLING_FACTOR_440:
+                case IMWRITE_JPEG_SAMPLING_FACTOR_444:
+                // OK.
+                break;
+
+                default:
+                CV_LOG_WARNING(NULL, cv::format("Unknown value for IMWRITE_JPEG_SAMPLING_FACTOR: 0x%06x", p.sampling_factor ) );
+                p.sampling_factor = 0;
                 break;
-            case 3:
+            }
+        }
+    }
+
+    return p;
+}
+
+/**
+ * Sets the input format of the image and the coding parameters
+ *
+ * @return true if the image rows are passed to the encoder as is, false if they are converted to RGB
+ */
+static bool setCompressParams( jpeg_compress_struct& cinfo, int _channels, const JpegEncoderParams& p )
+{
+    int channels = _channels > 1 ? 3 : 1;
+
+    bool doDirectWrite = false;
+    switch( _channels )
+    {
+        case 1:
+            cinfo.input_components = 1;
+            cinfo.in_color_space = JCS_GRAYSCALE;
+            doDirectWrite = true; // GRAY -> GRAY
+            break;
+        case 3:
 #ifdef JCS_EXTENSIONS
-                cinfo.input_components = 3;
-                cinfo.in_color_space = JCS_EXT_BGR;
-                doDirectWrite = true; // BGR -> BGR
+            cinfo.input_components = 3;
+            cinfo.in_color_space = JCS_EXT_BGR;
+            doDirectWrite = true; // BGR -> BGR
 #else
-                cinfo.input_components = 3;
-                cinfo.in_color_space = JCS_RGB;
-                doDirectWrite = false; // BGR -> RGB
+            cinfo.input_components = 3;
+            cinfo.in_color_space = JCS_RGB;
+            doDirectWrite = false; // BGR -> RGB
 #endif
-                break;
-            case 4:
+            break;
+        case 4:
 #ifdef JCS_EXTENSIONS
-                cinfo.input_components = 4;
-                cinfo.in_color_space = JCS_EXT_BGRX;
-                doDirectWrite = true; // BGRX -> BGRX
+            cinfo.input_components = 4;
+            cinfo.in_color_space = JCS_EXT_BGRX;
+            doDirectWrite = true; // BGRX -> BGRX
 #else
-                cinfo.input_components = 3;
-                cinfo.in_color_space = JCS_RGB;
-                doDirectWrite = false; // BGRA -> RGB
+            cinfo.input_components = 3;
+            cinfo.in_color_space = JCS_RGB;
+            doDirectWrite = false; // BGRA -> RGB
 #endif
-                break;
-            default:
-                CV_Error(cv::Error::StsError, cv::format("Unsupported number of _channels: %06d", _channels) );
-                break;
+            break;
+        default:
+            CV_Error(cv::Error::StsError, cv::format("Unsupported number of _channels: %06d", _channels) );
+            break;
+    }
+
+    jpeg_set_defaults( &cinfo );
+    cinfo.restart_interval = p.rst_interval;
+
+    jpeg_set_quality( &cinfo, p.quality,
+                      TRUE /* limit to baseline-JPEG values */ );
+    if( p.progressive )
+        jpeg_simple_progression( &cinfo );
+    if( p.optimize )
+        cinfo.optimize_coding = TRUE;
+
+    if( (channels > 1) && ( p.sampling_factor != 0 ) )
+    {
+        cinfo.comp_info[0].v_samp_factor = (p.sampling_factor >> 16 ) & 0xF;
+        cinfo.comp_info[0].h_samp_factor = (p.sampling_factor >> 20 ) & 0xF;
+        cinfo.comp_info[1].v_samp_factor = 1;
+        cinfo.comp_info[1].h_samp_factor = 1;
+    }
+
+    if (p.luma_quality >= 0 && p.chroma_quality >= 0)
+    {
+#if JPEG_LIB_VERSION >= 70
+        cinfo.q_scale_factor[0] = jpeg_quality_scaling(p.luma_quality);
+        cinfo.q_scale_factor[1] = jpeg_quality_scaling(p.chroma_quality);
+        if ( p.luma_quality != p.chroma_quality )
+        {
+            /* disable subsampling - ref. Libjpeg.txt */
+            cinfo.comp_info[0].v_samp_factor = 1;
+            cinfo.comp_info[0].h_samp_factor = 1;
+            cinfo.comp_info[1].v_samp_factor = 1;
+            cinfo.comp_info[1].h_samp_factor = 1;
         }
+        jpeg_default_qtables( &cinfo, TRUE );
+#else
+        // See https://github.com/opencv/opencv/issues/25646
+        CV_LOG_ONCE_WARNING(NULL, cv::format("IMWRITE_JPEG_LUMA/CHROMA_QUALITY are not supported bacause JPEG_LIB_VERSION < 70."));
+#endif // #if JPEG_LIB_VERSION >= 70
+    }
 
-        int quality = 95;
-        int progressive = 0;
-        int optimize = 0;
-        int rst_interval = 0;
-        int luma_quality = -1;
-        int chroma_quality = -1;
-        uint32_t sampling_factor = 0; // same as 0x221111
+    return doDirectWrite;
+}
 
-        for( size_t i = 0; i < params.size(); i += 2 )
+static void writeScanlines( jpeg_compress_struct& cinfo, const Mat& img, int y0, int y1, bool doDirectWrite )
+{
+    const int width = img.cols, _channels = img.channels();
+    if( doDirectWrite )
+    {
+        for( int y = y0; y < y1; y++ )
         {
-            if( params[i] == IMWRITE_JPEG_QUALITY )
-            {
-                quality = params[i+1];
-                quality = MIN(MAX(quality, 0), 100);
-            }
+            uchar *data = const_cast<uchar*>(img.ptr<uchar>(y));
+            jpeg_write_scanlines( &cinfo, &data, 1 );
+        }
+    }
+    else
+    {
+        CV_Check(_channels, (_channels == 3) || (_channels == 4), "Unsupported number of channels(indirect write)");
 
-            if( params[i] == IMWRITE_JPEG_PROGRESSIVE )
+        AutoBuffer<uchar> _buffer;
+        _buffer.allocate(width*3);
+        uchar *buffer = _buffer.data();
+
+        for( int y = y0; y < y1; y++ )
+        {
+            uchar *data = const_cast<uchar*>(img.ptr<uchar>(y));
+            if( _channels == 3 )
             {
-                progressive = params[i+1];
+                icvCvt_BGR2RGB_8u_C3R( data, 0, buffer, 0, Size(width,1) );
             }
-
-            if( params[i] == IMWRITE_JPEG_OPTIMIZE )
+            else // if( _channels == 4 )
             {
-                optimize = params[i+1];
+                icvCvt_BGRA2BGR_8u_C4C3R( data, 0, buffer, 0, Size(width,1), 2 );
             }
+            jpeg_write_scanlines( &cinfo, &buffer, 1 );
+        }
+    }
+}
 
-            if( params[i] == IMWRITE_JPEG_LUMA_QUALITY )
-            {
-                if (params[i+1] >= 0)
-                {
-                    luma_quality = MIN(MAX(params[i+1], 0), 100);
+/**
+ * Compresses the rows [y0, y1) of the image into a separate stream in memory
+ */
+static bool compressRows( const Mat& img, int y0, int y1, const JpegEncoderParams& p, std::vector<uchar>& out )
+{
+    volatile bool result = false;
+    std::vector<uchar> out_buf(1 << 16);
 
-                    quality = luma_quality;
+    struct jpeg_compress_struct cinfo;
+    JpegErrorMgr jerr;
+    JpegDestination dest;
 
-                    if (chroma_quality < 0)
-                    {
-                        chroma_quality = luma_quality;
-                    }
-                }
-            }
+    cinfo.err = jpeg_std_error(&jerr.pub);
+    jerr.pub.error_exit = error_exit;
+    jpeg_create_compress(&cinfo);
 
-            if( params[i] == IMWRITE_JPEG_CHROMA_QUALITY )
-            {
-                if (params[i+1] >= 0)
-                {
-                    chroma_quality = MIN(MAX(params[i+1], 0), 100);
-                }
-            }
+    dest.dst = &out;
+    dest.buf = &out_buf;
+    jpeg_buffer_dest( &cinfo, &dest );
+    dest.pub.next_output_byte = &out_buf[0];
+    dest.pub.free_in_buffer = out_buf.size();
 
-            if( params[i] == IMWRITE_JPEG_RST_INTERVAL )
-            {
-                rst_interval = params[i+1];
-                rst_interval = MIN(MAX(rst_interval, 0), 65535L);
-            }
+    if( setjmp( jerr.setjmp_buffer ) == 0 )
+    {
+        cinfo.image_width = img.cols;
+        cinfo.image_height = y1 - y0;
+        const bool doDirectWrite = setCompressParams( cinfo, img.channels(), p );
+        jpeg_start_compress( &cinfo, TRUE );
+        writeScanlines( cinfo, img, y0, y1, doDirectWrite );
+        jpeg_finish_compress( &cinfo );
+        result = true;
+    }
 
-            if( params[i] == IMWRITE_JPEG_SAMPLING_FACTOR )
-            {
-                sampling_factor = static_cast<uint32_t>(params[i+1]);
+    jpeg_destroy_compress( &cinfo );
+    return result;
+}
+
+bool JpegEncoder::writeParallel( const Mat& img, const std::vector<int>& params )
+{
+    const JpegEncoderParams p = parseEncoderParams( params );
+    if( !useParallelStrips((int64)img.cols * img.rows) ||
+        p.rst_interval == 0 || p.progressive || p.optimize )
+        return false;
 
-                switch ( sampling_factor )
+    // the MCU size follows from the sampling factors chosen by the library
+    int mcu_width = DCTSIZE, mcu_height = DCTSIZE;
+    {
+        struct jpeg_compress_struct cinfo;
+        JpegErrorMgr jerr;
+        cinfo.err = jpeg_std_error(&jerr.pub);
+        jerr.pub.error_exit = error_exit;
+        jpeg_create_compress(&cinfo);
+        if( setjmp( jerr.setjmp_buffer ) == 0 )
+        {
+            setCompressParams( cinfo, img.channels(), p );
+            if( cinfo.num_components > 1 )
+            {
+                for( int i = 0; i < cinfo.num_components; i++ )
                 {
-                    case IMWRITE_JPEG_SAMPLING_FACTOR_411:
-                    case IMWRITE_JPEG_SAMPLING_FACTOR_420:
-                    case IMWRITE_JPEG_SAMPLING_FACTOR_422:
-                    case IMWRITE_JPEG_SAMPLING_FACTOR_440:
-                    case IMWRITE_JPEG_SAMPLING_FACTOR_444:
-                    // OK.
-                    break;
-
-                    default:
-                    CV_LOG_WARNING(NULL, cv::format("Unknown value for IMWRITE_JPEG_SAMPLING_FACTOR: 0x%06x", sampling_factor ) );
-                    sampling_factor = 0;
-                    break;
+                    mcu_width = std::max(mcu_width, DCTSIZE * cinfo.comp_info[i].h_samp_factor);
+                    mcu_height = std::max(mcu_height, DCTSIZE * cinfo.comp_info[i].v_samp_factor);
                 }
             }
         }
-
-        jpeg_set_defaults( &cinfo );
-        cinfo.restart_interval = rst_interval;
-
-        jpeg_set_quality( &cinfo, quality,
-                          TRUE /* limit to baseline-JPEG values */ );
-        if( progressive )
-            jpeg_simple_progression( &cinfo );
-        if( optimize )
-            cinfo.optimize_coding = TRUE;
-
-        if( (channels > 1) && ( sampling_factor != 0 ) )
+        else
         {
-            cinfo.comp_info[0].v_samp_factor = (sampling_factor >> 16 ) & 0xF;
-            cinfo.comp_info[0].h_samp_factor = (sampling_factor >> 20 ) & 0xF;
-            cinfo.comp_info[1].v_samp_factor = 1;
-            cinfo.comp_info[1].h_samp_factor = 1;
+            mcu_width = 0;
         }
+        jpeg_destroy_compress( &cinfo );
+    }
+    JpegRestartLayout layout;
+    if( mcu_width == 0 || !getRestartLayout(img.cols, img.rows, mcu_width, mcu_height, p.rst_interval, layout) )
+        return false;
+
+    const int groups_per_strip = divUp(layout.ngroups, std::min(layout.ngroups, getNumThreads()));
+    const int nstrips = divUp(layout.ngroups, groups_per_strip);
+    std::vector<std::vector<uchar> > strips(nstrips);
+    std::vector<uchar> compressed(nstrips, 0);
 
-        if (luma_quality >= 0 && chroma_quality >= 0)
+    parallel_for_(Range(0, nstrips), [&](const Range& range)
+    {
+        for( int s = range.start; s < range.end; s++ )
         {
-#if JPEG_LIB_VERSION >= 70
-            cinfo.q_scale_factor[0] = jpeg_quality_scaling(luma_quality);
-            cinfo.q_scale_factor[1] = jpeg_quality_scaling(chroma_quality);
-            if ( luma_quality != chroma_quality )
-            {
-                /* disable subsampling - ref. Libjpeg.txt */
-                cinfo.comp_info[0].v_samp_factor = 1;
-                cinfo.comp_info[0].h_samp_factor = 1;
-                cinfo.comp_info[1].v_samp_factor = 1;
-                cinfo.comp_info[1].h_samp_factor = 1;
-            }
-            jpeg_default_qtables( &cinfo, TRUE );
-#else
-            // See https://github.com/opencv/opencv/issues/25646
-            CV_LOG_ONCE_WARNING(NULL, cv::format("IMWRITE_JPEG_LUMA/CHROMA_QUALITY are not supported bacause JPEG_LIB_VERSION < 70."));
-#endif // #if JPEG_LIB_VERSION >= 70
+            const int y0 = s * groups_per_strip * layout.rows_per_group;
+            const int y1 = std::min(y0 + groups_per_strip * layout.rows_per_group, img.rows);
+            compressed[s] = compressRows( img, y0, y1, p, strips[s] );
         }
+    }, nstrips);
 
-        jpeg_start_compress( &cinfo, TRUE );
+    // any failure falls back to the sequential encoding, which reports the error
+    if( std::count(compressed.begin(), compressed.end(), 0) != 0 )
+        return false;
+
+    std::vector<uchar> joined;
+    std::vector<uchar>& out = m_buf ? *m_buf : joined;
+    const size_t prefix = out.size();
+    if( !joinRestartStrips(strips, img.rows, out) )
+    {
+        out.resize(prefix);
+        return false;
+    }
+    if( !m_buf )
+    {
+        FILE* f = fopen( m_filename.c_str(), "wb" );
+        if( !f )
+            return false;
+        const bool written = fwrite( joined.data(), 1, joined.size(), f ) == joined.size();
+        if( fclose( f ) != 0 || !written )
+            return false;
+    }
+    return true;
+}
+
+/**
+ * State of the image compressed incrementally by beginStream() / writeRows() / endStream()
+ */
+struct JpegEncoder::Stream
+{
+    struct jpeg_compress_struct cinfo;
+    JpegErrorMgr jerr;
+    JpegDestination dest;
+    std::vector<uchar> out_buf;
+    FILE* f;
+    bool doDirectWrite;
+
+    Stream() : f(0), doDirectWrite(false)
+    {
+        cinfo.err = jpeg_std_error(&jerr.pub);
+        jerr.pub.error_exit = error_exit;
+        jpeg_create_compress(&cinfo);
+    }
+
+    ~Stream()
+    {
+        jpeg_destroy_compress( &cinfo );
+        if( f )
+            fclose( f );
+    }
+};
+
+void JpegEncoder::streamFailed()
+{
+    char jmsg_buf[JMSG_LENGTH_MAX];
+    m_stream->jerr.pub.format_message((j_common_ptr)&m_stream->cinfo, jmsg_buf);
+    m_last_error = jmsg_buf;
+    m_stream.release();
+}
+
+bool JpegEncoder::beginStream( Size size, int type, const std::vector<int>& params )
+{
+    m_last_error.clear();
+    m_stream = makePtr<Stream>();
+    Stream& s = *m_stream;
+
+    if( CV_MAT_DEPTH(type) != CV_8U )
+    {
+        m_stream.release();
+        return false;
+    }
 
-        if( doDirectWrite )
+    if( !m_buf )
+    {
+        s.f = fopen( m_filename.c_str(), "wb" );
+        if( !s.f )
         {
-            for( int y = 0; y < height; y++ )
-            {
-                uchar *data = const_cast<uchar*>(img.ptr<uchar>(y));
-                jpeg_write_scanlines( &cinfo, &data, 1 );
-            }
+            m_stream.release();
+            return false;
         }
-        else
-        {
-            CV_Check(_channels, (_channels == 3) || (_channels == 4), "Unsupported number of channels(indirect write)");
+        jpeg_stdio_dest( &s.cinfo, s.f );
+    }
+    else
+    {
+        s.out_buf.resize(1 << 12);
+        s.dest.dst = m_buf;
+        s.dest.buf = &s.out_buf;
 
-            AutoBuffer<uchar> _buffer;
-            _buffer.allocate(width*channels);
-            uchar *buffer = _buffer.data();
+        jpeg_buffer_dest( &s.cinfo, &s.dest );
 
-            for( int y = 0; y < height; y++ )
-            {
-                uchar *data = const_cast<uchar*>(img.ptr<uchar>(y));
-                if( _channels == 3 )
-                {
-                    icvCvt_BGR2RGB_8u_C3R( data, 0, buffer, 0, Size(width,1) );
-                }
-                else // if( _channels == 4 )
-                {
-                    icvCvt_BGRA2BGR_8u_C4C3R( data, 0, buffer, 0, Size(width,1), 2 );
-                }
-                jpeg_write_scanlines( &cinfo, &buffer, 1 );
-            }
-        }
+        s.dest.pub.next_output_byte = &s.out_buf[0];
+        s.dest.pub.free_in_buffer = s.out_buf.size();
+    }
 
-        jpeg_finish_compress( &cinfo );
-        result = true;
+    if( setjmp( s.jerr.setjmp_buffer ) == 0 )
+    {
+        s.cinfo.image_width = size.width;
+        s.cinfo.image_height = size.height;
+
+        s.doDirectWrite = setCompressParams( s.cinfo, CV_MAT_CN(type), parseEncoderParams( params ) );
+
+        jpeg_start_compress( &s.cinfo, TRUE );
+        return true;
     }
 
-_exit_:
+    streamFailed();
+    return false;
+}
+
+bool JpegEncoder::writeRows( const Mat& rows )
+{
+    if( !m_stream )
+        return false;
+    Stream& s = *m_stream;
 
-    if(!result)
+    if( setjmp( s.jerr.setjmp_buffer ) == 0 )
     {
-        char jmsg_buf[JMSG_LENGTH_MAX];
-        jerr.pub.format_message((j_common_ptr)&cinfo, jmsg_buf);
-        m_last_error = jmsg_buf;
+        writeScanlines( s.cinfo, rows, 0, rows.rows, s.doDirectWrite );
+        return true;
     }
 
-    jpeg_destroy_compress( &cinfo );
+    streamFailed();
+    return false;
+}
 
-    return result;
+bool JpegEncoder::endStream()
+{
+    if( !m_stream )
+        return false;
+    Stream& s = *m_stream;
+
+    if( setjmp( s.jerr.setjmp_buffer ) == 0 )
+    {
+        jpeg_finish_compress( &s.cinfo );
+        m_stream.release();
+        return true;
+    }
+
+    streamFailed();
+    return false;
+}
+
+bool JpegEncoder::write( const Mat& img, const std::vector<int>& params )
+{
+    m_last_error.clear();
+
+    if( writeParallel( img, params ) )
+        return true;
+
+    return beginStream( img.size(), img.type(), params ) && writeRows( img ) && endStream();
 }
 
 }
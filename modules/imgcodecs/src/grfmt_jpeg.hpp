@@ -57,7 +57,7 @@ namespace cv
 */
 enum AppMarkerTypes
 {
-    SOI = 0xD8, SOF0 = 0xC0, SOF2 = 0xC2, DHT = 0xC4,
+    SOI = 0xD8, SOF0 = 0xC0, SOF1 = 0xC1, SOF2 = 0xC2, DHT = 0xC4,
     DQT = 0xDB, DRI = 0xDD, SOS = 0xDA,
 
     RST0 = 0xD0, RST1 = 0xD1, RST2 = 0xD2, RST3 = 0xD3,
@@ -81,12 +81,16 @@ public:
 
     bool  readData( Mat& img ) CV_OVERRIDE;
     bool  readHeader() CV_OVERRIDE;
+    bool  setROI( const Rect& roi ) CV_OVERRIDE;
     void  close();
 
     ImageDecoder newDecoder() const CV_OVERRIDE;
 
 protected:
 
+    /// decodes restart-aligned strips in parallel, returns false if the stream is not suitable
+    bool  readDataParallel( Mat& img );
+
     FILE* m_f;
     void* m_state;
 
@@ -104,6 +108,20 @@ public:
 
     bool  write( const Mat& img, const std::vector<int>& params ) CV_OVERRIDE;
     ImageEncoder newEncoder() const CV_OVERRIDE;
+
+    bool  beginStream( Size size, int type, const std::vector<int>& params ) CV_OVERRIDE;
+    bool  writeRows( const Mat& rows ) CV_OVERRIDE;
+    bool  endStream() CV_OVERRIDE;
+
+protected:
+    /// encodes restart-aligned strips in parallel, returns false if the parameters are not suitable
+    bool  writeParallel( const Mat& img, const std::vector<int>& params );
+
+    /// stores the libjpeg error message and abandons the stream
+    void  streamFailed();
+
+    struct Stream;
+    Ptr<Stream> m_stream;
 };
 
 }
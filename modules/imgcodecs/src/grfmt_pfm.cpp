@@ -127,26 +127,44 @@ bool PFMDecoder::readData(Mat& mat)
     CV_Error(Error::StsError, "Unexpected status in data stream");
   }
 
-  Mat buffer(mat.size(), m_type);
+  CV_Assert(fabs(m_scale_factor) > 0.0f);
+  const float scale = 1.f / fabs(m_scale_factor);
+
+  // rows are stored bottom-up, each one is read into its destination row
+  // or, if the type differs, converted there through a single row buffer
+  const bool direct = mat.type() == m_type;
+  Mat row_buffer, cn_buffer;
+  if (!direct)
+    row_buffer.create(1, m_width, m_type);
   for (int y = m_height - 1; y >= 0; --y) {
-    m_strm.getBytes(buffer.ptr(y), static_cast<int>(m_width * buffer.elemSize()));
+    Mat buffer = direct ? mat.row(y) : row_buffer;
+    m_strm.getBytes(buffer.ptr(), static_cast<int>(m_width * buffer.elemSize()));
     if (is_byte_order_swapped(m_scale_factor)) {
       for (int i = 0; i < m_width * buffer.channels(); ++i) {
         static_assert( sizeof(uint32_t) == sizeof(float),
                        "uint32_t and float must have same size." );
-        swap_endianness(buffer.ptr<uint32_t>(y)[i]);
+        swap_endianness(buffer.ptr<uint32_t>()[i]);
       }
     }
-  }
 
-  if (buffer.channels() == 3 && !m_use_rgb) {
-    cv::cvtColor(buffer, buffer, cv::COLOR_BGR2RGB);
-  }
+    if (buffer.channels() == 3 && !m_use_rgb) {
+      cv::cvtColor(buffer, buffer, cv::COLOR_BGR2RGB);
+    }
 
-  CV_Assert(fabs(m_scale_factor) > 0.0f);
-  buffer *= 1.f / fabs(m_scale_factor);
+    buffer *= scale;
 
-  buffer.convertTo(mat, mat.type());
+    if (!direct) {
+      Mat src = buffer;
+      if (buffer.channels() != mat.channels()) {
+        CV_CheckEQ(mat.channels(), buffer.channels() == 1 ? 3 : 1, "");
+        cv::cvtColor(buffer, cn_buffer, buffer.channels() == 1 ? cv::COLOR_GRAY2BGR :
+                     m_use_rgb ? cv::COLOR_RGB2GRAY : cv::COLOR_BGR2GRAY);
+        src = cn_buffer;
+      }
+      Mat dst_row = mat.row(y);
+      src.convertTo(dst_row, mat.type());
+    }
+  }
 
   return true;
 }
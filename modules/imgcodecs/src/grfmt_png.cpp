@@ -214,6 +214,16 @@ bool  PngDecoder::readHeader()
 }
 
 
+bool  PngDecoder::setROI( const Rect& roi )
+{
+    // the rows of interlaced images are known only after the last pass
+    if( !m_png_ptr || !m_info_ptr ||
+        png_get_interlace_type( (png_structp)m_png_ptr, (png_infop)m_info_ptr ) != PNG_INTERLACE_NONE )
+        return false;
+    m_roi = roi;
+    return true;
+}
+
 bool  PngDecoder::readData( Mat& img )
 {
     volatile bool result = false;
@@ -271,11 +281,29 @@ bool  PngDecoder::readData( Mat& img )
             png_set_interlace_handling( png_ptr );
             png_read_update_info( png_ptr, info_ptr );
 
-            for( y = 0; y < m_height; y++ )
-                buffer[y] = img.data + y*img.step;
+            if( m_roi.empty() )
+            {
+                for( y = 0; y < m_height; y++ )
+                    buffer[y] = img.data + y*img.step;
 
-            png_read_image( png_ptr, buffer );
-            png_read_end( png_ptr, end_info );
+                png_read_image( png_ptr, buffer );
+                png_read_end( png_ptr, end_info );
+            }
+            else
+            {
+                // the rows above the region are decompressed and dropped, the rows below it are not read
+                AutoBuffer<uchar> _row(png_get_rowbytes( png_ptr, info_ptr ));
+                uchar* row = _row.data();
+                const size_t esz = img.elemSize();
+                for( y = 0; y < m_roi.y + m_roi.height; y++ )
+                {
+                    png_read_row( png_ptr, row, NULL );
+                    if( y >= m_roi.y )
+                        memcpy( img.ptr(y - m_roi.y), row + m_roi.x*esz, m_roi.width*esz );
+                }
+                if( m_roi.y + m_roi.height == m_height )
+                    png_read_end( png_ptr, end_info );
+            }
 
 #ifdef PNG_eXIf_SUPPORTED
             png_uint_32 num_exif = 0;
@@ -344,109 +372,152 @@ void PngEncoder::flushBuf(void*)
 {
 }
 
-bool  PngEncoder::write( const Mat& img, const std::vector<int>& params )
+/**
+ * State of the image compressed incrementally by beginStream() / writeRows() / endStream()
+ */
+struct PngEncoder::Stream
 {
-    png_structp png_ptr = png_create_write_struct( PNG_LIBPNG_VER_STRING, 0, 0, 0 );
-    png_infop info_ptr = 0;
-    FILE * volatile f = 0;
-    int y, width = img.cols, height = img.rows;
-    int depth = img.depth(), channels = img.channels();
-    volatile bool result = false;
-    AutoBuffer<uchar*> buffer;
+    png_structp png_ptr;
+    png_infop info_ptr;
+    FILE* f;
+
+    Stream() : png_ptr(0), info_ptr(0), f(0) {}
+
+    ~Stream()
+    {
+        if( png_ptr )
+            png_destroy_write_struct( &png_ptr, &info_ptr );
+        if( f )
+            fclose( f );
+    }
+};
+
+bool  PngEncoder::beginStream( Size size, int type, const std::vector<int>& params )
+{
+    int depth = CV_MAT_DEPTH(type), channels = CV_MAT_CN(type);
 
+    m_stream.release();
     if( depth != CV_8U && depth != CV_16U )
         return false;
 
-    if( png_ptr )
+    Ptr<Stream> stream = makePtr<Stream>();
+    png_structp png_ptr = stream->png_ptr = png_create_write_struct( PNG_LIBPNG_VER_STRING, 0, 0, 0 );
+    if( !png_ptr )
+        return false;
+    png_infop info_ptr = stream->info_ptr = png_create_info_struct( png_ptr );
+    if( !info_ptr )
+        return false;
+
+    if( m_buf )
+    {
+        png_set_write_fn(png_ptr, this,
+            (png_rw_ptr)writeDataToBuf, (png_flush_ptr)flushBuf);
+    }
+    else
     {
-        info_ptr = png_create_info_struct( png_ptr );
+        stream->f = fopen( m_filename.c_str(), "wb" );
+        if( !stream->f )
+            return false;
+        png_init_io( png_ptr, (png_FILE_p)stream->f );
+    }
 
-        if( info_ptr )
+    if( setjmp( png_jmpbuf ( png_ptr ) ) == 0 )
+    {
+        int compression_level = -1; // Invalid value to allow setting 0-9 as valid
+        int compression_strategy = IMWRITE_PNG_STRATEGY_RLE; // Default strategy
+        bool isBilevel = false;
+
+        for( size_t i = 0; i < params.size(); i += 2 )
         {
-            if( setjmp( png_jmpbuf ( png_ptr ) ) == 0 )
+            if( params[i] == IMWRITE_PNG_COMPRESSION )
             {
-                if( m_buf )
-                {
-                    png_set_write_fn(png_ptr, this,
-                        (png_rw_ptr)writeDataToBuf, (png_flush_ptr)flushBuf);
-                }
-                else
-                {
-                    f = fopen( m_filename.c_str(), "wb" );
-                    if( f )
-                        png_init_io( png_ptr, (png_FILE_p)f );
-                }
+                compression_strategy = IMWRITE_PNG_STRATEGY_DEFAULT; // Default strategy
+                compression_level = params[i+1];
+                compression_level = MIN(MAX(compression_level, 0), Z_BEST_COMPRESSION);
+            }
+            if( params[i] == IMWRITE_PNG_STRATEGY )
+            {
+                compression_strategy = params[i+1];
+                compression_strategy = MIN(MAX(compression_strategy, 0), Z_FIXED);
+            }
+            if( params[i] == IMWRITE_PNG_BILEVEL )
+            {
+                isBilevel = params[i+1] != 0;
+            }
+        }
 
-                int compression_level = -1; // Invalid value to allow setting 0-9 as valid
-                int compression_strategy = IMWRITE_PNG_STRATEGY_RLE; // Default strategy
-                bool isBilevel = false;
+        if( compression_level >= 0 )
+        {
+            png_set_compression_level( png_ptr, compression_level );
+        }
+        else
+        {
+            // tune parameters for speed
+            // (see http://wiki.linuxquestions.org/wiki/Libpng)
+            png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB);
+            png_set_compression_level(png_ptr, Z_BEST_SPEED);
+        }
+        png_set_compression_strategy(png_ptr, compression_strategy);
 
-                for( size_t i = 0; i < params.size(); i += 2 )
-                {
-                    if( params[i] == IMWRITE_PNG_COMPRESSION )
-                    {
-                        compression_strategy = IMWRITE_PNG_STRATEGY_DEFAULT; // Default strategy
-                        compression_level = params[i+1];
-                        compression_level = MIN(MAX(compression_level, 0), Z_BEST_COMPRESSION);
-                    }
-                    if( params[i] == IMWRITE_PNG_STRATEGY )
-                    {
-                        compression_strategy = params[i+1];
-                        compression_strategy = MIN(MAX(compression_strategy, 0), Z_FIXED);
-                    }
-                    if( params[i] == IMWRITE_PNG_BILEVEL )
-                    {
-                        isBilevel = params[i+1] != 0;
-                    }
-                }
+        png_set_IHDR( png_ptr, info_ptr, size.width, size.height, depth == CV_8U ? isBilevel?1:8 : 16,
+            channels == 1 ? PNG_COLOR_TYPE_GRAY :
+            channels == 3 ? PNG_COLOR_TYPE_RGB : PNG_COLOR_TYPE_RGBA,
+            PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
+            PNG_FILTER_TYPE_DEFAULT );
 
-                if( m_buf || f )
-                {
-                    if( compression_level >= 0 )
-                    {
-                        png_set_compression_level( png_ptr, compression_level );
-                    }
-                    else
-                    {
-                        // tune parameters for speed
-                        // (see http://wiki.linuxquestions.org/wiki/Libpng)
-                        png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB);
-                        png_set_compression_level(png_ptr, Z_BEST_SPEED);
-                    }
-                    png_set_compression_strategy(png_ptr, compression_strategy);
+        png_write_info( png_ptr, info_ptr );
 
-                    png_set_IHDR( png_ptr, info_ptr, width, height, depth == CV_8U ? isBilevel?1:8 : 16,
-                        channels == 1 ? PNG_COLOR_TYPE_GRAY :
-                        channels == 3 ? PNG_COLOR_TYPE_RGB : PNG_COLOR_TYPE_RGBA,
-                        PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
-                        PNG_FILTER_TYPE_DEFAULT );
+        if (isBilevel)
+            png_set_packing(png_ptr);
 
-                    png_write_info( png_ptr, info_ptr );
+        png_set_bgr( png_ptr );
+        if( !isBigEndian() )
+            png_set_swap( png_ptr );
 
-                    if (isBilevel)
-                        png_set_packing(png_ptr);
+        m_stream = stream;
+        return true;
+    }
 
-                    png_set_bgr( png_ptr );
-                    if( !isBigEndian() )
-                        png_set_swap( png_ptr );
+    return false;
+}
 
-                    buffer.allocate(height);
-                    for( y = 0; y < height; y++ )
-                        buffer[y] = img.data + y*img.step;
+bool  PngEncoder::writeRows( const Mat& rows )
+{
+    if( !m_stream )
+        return false;
+    png_structp png_ptr = m_stream->png_ptr;
 
-                    png_write_image( png_ptr, buffer.data() );
-                    png_write_end( png_ptr, info_ptr );
+    if( setjmp( png_jmpbuf ( png_ptr ) ) == 0 )
+    {
+        for( int y = 0; y < rows.rows; y++ )
+            png_write_row( png_ptr, rows.ptr(y) );
+        return true;
+    }
 
-                    result = true;
-                }
-            }
-        }
+    m_stream.release();
+    return false;
+}
+
+bool  PngEncoder::endStream()
+{
+    if( !m_stream )
+        return false;
+    png_structp png_ptr = m_stream->png_ptr;
+
+    if( setjmp( png_jmpbuf ( png_ptr ) ) == 0 )
+    {
+        png_write_end( png_ptr, m_stream->info_ptr );
+        m_stream.release();
+        return true;
     }
 
-    png_destroy_write_struct( &png_ptr, &info_ptr );
-    if(f) fclose( (FILE*)f );
+    m_stream.release();
+    return false;
+}
 
-    return result;
+bool  PngEncoder::write( const Mat& img, const std::vector<int>& params )
+{
+    return beginStream( img.size(), img.type(), params ) && writeRows( img ) && endStream();
 }
 
 }
@@ -584,6 +584,20 @@ static void _unpack14To16(const uchar* src, const uchar* srcEnd, ushort* dst, us
 }
 //end _unpack14To16()
 
+bool TiffDecoder::setROI( const Rect& roi )
+{
+    CV_Assert(!m_tif.empty());
+    TIFF* tif = (TIFF*)m_tif.get();
+
+    // fixOrientation() transforms the whole image, so the region is supported for the default orientation only
+    uint16_t img_orientation = ORIENTATION_TOPLEFT;
+    CV_TIFF_CHECK_CALL_DEBUG(TIFFGetField(tif, TIFFTAG_ORIENTATION, &img_orientation));
+    if (img_orientation != ORIENTATION_TOPLEFT)
+        return false;
+    m_roi = roi;
+    return true;
+}
+
 bool  TiffDecoder::readData( Mat& img )
 {
     int type = img.type();
@@ -785,21 +799,33 @@ bool  TiffDecoder::readData( Mat& img )
                            "src_buffer_size is smaller than TIFFScanlineSize().");
             }
 
-            int tileidx = 0;
+            // with a region only the tiles (strips) intersecting it are decoded into dst
+            Rect box(0, 0, m_width, m_height);
+            if (!m_roi.empty())
+            {
+                box.x = m_roi.x - m_roi.x % (int)tile_width0;
+                box.y = m_roi.y - m_roi.y % (int)tile_height0;
+                box.width = std::min(divUp(m_roi.x + m_roi.width, tile_width0) * (int)tile_width0, m_width) - box.x;
+                box.height = std::min(divUp(m_roi.y + m_roi.height, tile_height0) * (int)tile_height0, m_height) - box.y;
+            }
+            Mat dst = m_roi.empty() || box == m_roi ? img : Mat(box.size(), type);
+            const int tiles_per_row = divUp(m_width, tile_width0);
 
             #define MAKE_FLAG(a,b) ( (a << 8) | b )
             const int  convert_flag = MAKE_FLAG( ncn, wanted_channels );
             const bool isNeedConvert16to8 = ( doReadScanline ) && ( bpp == 16 ) && ( dst_bpp == 8);
 
-            for (int y = 0; y < m_height; y += (int)tile_height0)
+            for (int y = box.y; y < box.y + box.height; y += (int)tile_height0)
             {
                 int tile_height = std::min((int)tile_height0, m_height - y);
 
-                const int img_y = vert_flip ? m_height - y - tile_height : y;
+                const int img_y = (vert_flip ? m_height - y - tile_height : y) - box.y;
 
-                for(int x = 0; x < m_width; x += (int)tile_width0, tileidx++)
+                for(int x = box.x; x < box.x + box.width; x += (int)tile_width0)
                 {
                     int tile_width = std::min((int)tile_width0, m_width - x);
+                    const int tileidx = (y / (int)tile_height0) * tiles_per_row + x / (int)tile_width0;
+                    const int img_x = x - box.x;
 
                     switch (dst_bpp)
                     {
@@ -839,7 +865,7 @@ bool  TiffDecoder::readData( Mat& img )
                                 bstart += (tile_height0 - tile_height) * tile_width0 * 4;
                             }
 
-                            uchar* img_line_buffer = (uchar*) img.ptr(y, 0);
+                            uchar* img_line_buffer = (uchar*) dst.ptr(y - box.y, 0);
 
                             for (int i = 0; i < tile_height; i++)
                             {
@@ -869,7 +895,7 @@ bool  TiffDecoder::readData( Mat& img )
                                         if (m_use_rgb)
                                             std::memcpy( (void*) img_line_buffer,
                                                          (void*) bstart,
-                                                         tile_width * sizeof(uchar) );
+                                                         tile_width * 3 * sizeof(uchar) );
                                         else
                                             icvCvt_BGR2RGB_8u_C3R( bstart, 0,
                                                     img_line_buffer, 0,
@@ -907,14 +933,14 @@ bool  TiffDecoder::readData( Mat& img )
                                     if (wanted_channels == 4)
                                     {
                                         icvCvt_BGRA2RGBA_8u_C4R(bstart + i*tile_width0*4, 0,
-                                                img.ptr(img_y + tile_height - i - 1, x), 0,
+                                                dst.ptr(img_y + tile_height - i - 1, img_x), 0,
                                                 Size(tile_width, 1) );
                                     }
                                     else
                                     {
                                         CV_CheckEQ(wanted_channels, 3, "TIFF-8bpp: BGR/BGRA images are supported only");
                                         icvCvt_BGRA2BGR_8u_C4C3R(bstart + i*tile_width0*4, 0,
-                                                img.ptr(img_y + tile_height - i - 1, x), 0,
+                                                dst.ptr(img_y + tile_height - i - 1, img_x), 0,
                                                 Size(tile_width, 1), m_use_rgb ? 0 : 2);
                                     }
                                 }
@@ -922,7 +948,7 @@ bool  TiffDecoder::readData( Mat& img )
                                 {
                                     CV_CheckEQ(wanted_channels, 1, "");
                                     icvCvt_BGRA2Gray_8u_C4C1R( bstart + i*tile_width0*4, 0,
-                                            img.ptr(img_y + tile_height - i - 1, x), 0,
+                                            dst.ptr(img_y + tile_height - i - 1, img_x), 0,
                                             Size(tile_width, 1), 2);
                                 }
                             }
@@ -964,6 +990,10 @@ bool  TiffDecoder::readData( Mat& img )
                                                       (ushort*)dst_unpacked, (ushort*)(dst_unpacked+src_buffer_unpacked_bytes_per_row),
                                                       ncn * tile_width0);
                                     buffer16 = (ushort*)dst_unpacked;
+                                    // scale to the full 16-bit range while the row is in cache
+                                    const int shift = dst_bpp - bpp;
+                                    for (int k = 0; k < tile_width * ncn; k++)
+                                        buffer16[k] = (ushort)(buffer16[k] << shift);
                                 }
 
                                 if (color)
@@ -972,17 +1002,17 @@ bool  TiffDecoder::readData( Mat& img )
                                     {
                                         CV_CheckEQ(wanted_channels, 3, "");
                                         icvCvt_Gray2BGR_16u_C1C3R(buffer16, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                dst.ptr<ushort>(img_y + i, img_x), 0,
                                                 Size(tile_width, 1));
                                     }
                                     else if (ncn == 3)
                                     {
                                         CV_CheckEQ(wanted_channels, 3, "");
                                         if (m_use_rgb)
-                                            std::memcpy(buffer16, img.ptr<ushort>(img_y + i, x), tile_width * sizeof(ushort));
+                                            std::memcpy(dst.ptr<ushort>(img_y + i, img_x), buffer16, tile_width * 3 * sizeof(ushort));
                                         else
                                             icvCvt_RGB2BGR_16u_C3R(buffer16, 0,
-                                                    img.ptr<ushort>(img_y + i, x), 0,
+                                                    dst.ptr<ushort>(img_y + i, img_x), 0,
                                                     Size(tile_width, 1));
                                     }
                                     else if (ncn == 4)
@@ -990,14 +1020,14 @@ bool  TiffDecoder::readData( Mat& img )
                                         if (wanted_channels == 4)
                                         {
                                             icvCvt_BGRA2RGBA_16u_C4R(buffer16, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                dst.ptr<ushort>(img_y + i, img_x), 0,
                                                 Size(tile_width, 1));
                                         }
                                         else
                                         {
                                             CV_CheckEQ(wanted_channels, 3, "TIFF-16bpp: BGR/BGRA images are supported only");
                                             icvCvt_BGRA2BGR_16u_C4C3R(buffer16, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                dst.ptr<ushort>(img_y + i, img_x), 0,
                                                 Size(tile_width, 1), m_use_rgb ? 0 : 2);
                                         }
                                     }
@@ -1011,14 +1041,14 @@ bool  TiffDecoder::readData( Mat& img )
                                     CV_CheckEQ(wanted_channels, 1, "");
                                     if( ncn == 1 )
                                     {
-                                        std::memcpy(img.ptr<ushort>(img_y + i, x),
+                                        std::memcpy(dst.ptr<ushort>(img_y + i, img_x),
                                                     buffer16,
                                                     tile_width*sizeof(ushort));
                                     }
                                     else
                                     {
                                         icvCvt_BGRA2Gray_16u_CnC1R(buffer16, 0,
-                                                img.ptr<ushort>(img_y + i, x), 0,
+                                                dst.ptr<ushort>(img_y + i, img_x), 0,
                                                 Size(tile_width, 1), ncn, 2);
                                     }
                                 }
@@ -1040,13 +1070,13 @@ bool  TiffDecoder::readData( Mat& img )
 
                             Mat m_tile(Size(tile_width0, tile_height0), CV_MAKETYPE((dst_bpp == 32) ? (depth == CV_32S ? CV_32S : CV_32F) : CV_64F, ncn), src_buffer);
                             Rect roi_tile(0, 0, tile_width, tile_height);
-                            Rect roi_img(x, img_y, tile_width, tile_height);
+                            Rect roi_img(img_x, img_y, tile_width, tile_height);
                             if (!m_hdr && ncn == 3 && !m_use_rgb)
-                                extend_cvtColor(m_tile(roi_tile), img(roi_img), COLOR_RGB2BGR);
+                                extend_cvtColor(m_tile(roi_tile), dst(roi_img), COLOR_RGB2BGR);
                             else if (!m_hdr && ncn == 4)
-                                extend_cvtColor(m_tile(roi_tile), img(roi_img), COLOR_RGBA2BGRA);
+                                extend_cvtColor(m_tile(roi_tile), dst(roi_img), COLOR_RGBA2BGRA);
                             else
-                                m_tile(roi_tile).copyTo(img(roi_img));
+                                m_tile(roi_tile).copyTo(dst(roi_img));
                             break;
                         }
                         default:
@@ -1056,10 +1086,10 @@ bool  TiffDecoder::readData( Mat& img )
                     }  // switch (dst_bpp)
                 }  // for x
             }  // for y
-        }
-        if (bpp < dst_bpp)
-          img *= (1<<(dst_bpp-bpp));
 
+            if (dst.data != img.data)
+                dst(Rect(m_roi.x - box.x, m_roi.y - box.y, m_roi.width, m_roi.height)).copyTo(img);
+        }
         // If TIFFReadRGBA* function is used -> fixOrientationPartial().
         // Otherwise                         -> fixOrientationFull().
         fixOrientation(img, img_orientation,
@@ -1108,11 +1138,9 @@ public:
             : m_buf(buf), m_buf_pos(0)
     {}
 
-    TIFF* open ()
+    TIFF* open (const char* mode)
     {
-        // do NOT put "wb" as the mode, because the b means "big endian" mode, not "binary" mode.
-        // http://www.simplesystems.org/libtiff/functions/TIFFOpen.html
-        return TIFFClientOpen( "", "w", reinterpret_cast<thandle_t>(this), &TiffEncoderBufHelper::read,
+        return TIFFClientOpen( "", mode, reinterpret_cast<thandle_t>(this), &TiffEncoderBufHelper::read,
                                &TiffEncoderBufHelper::write, &TiffEncoderBufHelper::seek,
                                &TiffEncoderBufHelper::close, &TiffEncoderBufHelper::size,
                                /*map=*/0, /*unmap=*/0 );
@@ -1196,189 +1224,296 @@ static bool readParam(const std::vector<int>& params, int key, int& value)
     return false;
 }
 
-bool TiffEncoder::writeLibTiff( const std::vector<Mat>& img_vec, const std::vector<int>& params)
+// classic TIFF uses 32-bit offsets, BigTIFF is used by default if compression may not keep the file below 4GB
+static const uint64 TIFF_BIGTIFF_MIN_RAW_SIZE = (uint64)1 << 31;
+
+static bool useBigTiff(const std::vector<int>& params, uint64 rawSize)
+{
+    int bigTiff = -1;
+    readParam(params, IMWRITE_TIFF_BIGTIFF, bigTiff);
+    return bigTiff < 0 ? rawSize >= TIFF_BIGTIFF_MIN_RAW_SIZE : bigTiff != 0;
+}
+
+static TIFF* openForWriting(TiffEncoderBufHelper& buf_helper, const String& filename, bool toBuffer, bool bigTiff)
 {
     // do NOT put "wb" as the mode, because the b means "big endian" mode, not "binary" mode.
+    // "w8" writes a BigTIFF file.
     // http://www.simplesystems.org/libtiff/functions/TIFFOpen.html
-    TIFF* tif = NULL;
+    const char* mode = bigTiff ? "w8" : "w";
+    return toBuffer ? buf_helper.open(mode) : TIFFOpen(filename.c_str(), mode);
+}
 
-    TiffEncoderBufHelper buf_helper(m_buf);
-    if ( m_buf )
-    {
-        tif = buf_helper.open();
-    }
-    else
-    {
-        tif = TIFFOpen(m_filename.c_str(), "w");
-    }
-    if (!tif)
-    {
-        return false;
-    }
-    cv::Ptr<void> tif_cleanup(tif, cv_tiffCloseHandle);
+static bool useSgiLog(int type, const std::vector<int>& params)
+{
+    int compression_param = -1;  // OPENCV_FUTURE
+    return type == CV_32FC3 && (!readParam(params, IMWRITE_TIFF_COMPRESSION, compression_param) || compression_param == COMPRESSION_SGILOG);
+}
+
+/**
+ * Sets the fields describing an image of the given size and type
+ *
+ * @param tileSize is set to the tile size if the image is organized in tiles, to an empty size for strips
+ * @return false if the depth is not supported
+ */
+static bool setImageFields(TIFF* tif, Size size, int type, const std::vector<int>& params, Size& tileSize)
+{
+    int channels = CV_MAT_CN(type), depth = CV_MAT_DEPTH(type);
+    int width = size.width, height = size.height;
 
-    //Settings that matter to all images
     int compression = COMPRESSION_LZW;
     int predictor = PREDICTOR_HORIZONTAL;
     int resUnit = -1, dpiX = -1, dpiY = -1;
+    int tileWidth = 0, tileHeight = 0;
 
     readParam(params, IMWRITE_TIFF_COMPRESSION, compression);
     readParam(params, IMWRITE_TIFF_PREDICTOR, predictor);
     readParam(params, IMWRITE_TIFF_RESUNIT, resUnit);
     readParam(params, IMWRITE_TIFF_XDPI, dpiX);
     readParam(params, IMWRITE_TIFF_YDPI, dpiY);
+    readParam(params, IMWRITE_TIFF_TILE_WIDTH, tileWidth);
+    readParam(params, IMWRITE_TIFF_TILE_HEIGHT, tileHeight);
 
-    //Iterate through each image in the vector and write them out as Tiff directories
-    for (size_t page = 0; page < img_vec.size(); page++)
-    {
-        const Mat& img = img_vec[page];
-        CV_Assert(!img.empty());
-        int channels = img.channels();
-        int width = img.cols, height = img.rows;
-        int type = img.type();
-        int depth = CV_MAT_DEPTH(type);
-        CV_CheckType(type, depth == CV_8U || depth == CV_8S || depth == CV_16U || depth == CV_16S || depth == CV_32S || depth == CV_32F || depth == CV_64F, "");
-        CV_CheckType(type, channels >= 1 && channels <= 4, "");
-
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, width));
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_IMAGELENGTH, height));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, width));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_IMAGELENGTH, height));
 
-        if (img_vec.size() > 1)
+    int bitsPerChannel = -1;
+    uint16_t sample_format = SAMPLEFORMAT_INT;
+    switch (depth)
+    {
+        case CV_8U:
+            sample_format = SAMPLEFORMAT_UINT;
+            /* FALLTHRU */
+        case CV_8S:
         {
-            CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SUBFILETYPE, FILETYPE_PAGE));
-            CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PAGENUMBER, page, img_vec.size()));
+            bitsPerChannel = 8;
+            break;
         }
 
-        int compression_param = -1;  // OPENCV_FUTURE
-        if (type == CV_32FC3 && (!readParam(params, IMWRITE_TIFF_COMPRESSION, compression_param) || compression_param == COMPRESSION_SGILOG))
+        case CV_16U:
+            sample_format = SAMPLEFORMAT_UINT;
+            /* FALLTHRU */
+        case CV_16S:
         {
-            if (!write_32FC3_SGILOG(img, tif))
-                return false;
-            continue;
+            bitsPerChannel = 16;
+            break;
         }
 
-        int page_compression = compression;
-
-        int bitsPerChannel = -1;
-        uint16_t sample_format = SAMPLEFORMAT_INT;
-        switch (depth)
+        case CV_32S:
         {
-            case CV_8U:
-                sample_format = SAMPLEFORMAT_UINT;
-                /* FALLTHRU */
-            case CV_8S:
-            {
-                bitsPerChannel = 8;
-                break;
-            }
+            bitsPerChannel = 32;
+            sample_format = SAMPLEFORMAT_INT;
+            break;
+        }
+        case CV_32F:
+        {
+            bitsPerChannel = 32;
+            compression = COMPRESSION_NONE;
+            sample_format = SAMPLEFORMAT_IEEEFP;
+            break;
+        }
+        case CV_64F:
+        {
+            bitsPerChannel = 64;
+            compression = COMPRESSION_NONE;
+            sample_format = SAMPLEFORMAT_IEEEFP;
+            break;
+        }
+        default:
+        {
+            return false;
+        }
+    }
 
-            case CV_16U:
-                sample_format = SAMPLEFORMAT_UINT;
-                /* FALLTHRU */
-            case CV_16S:
-            {
-                bitsPerChannel = 16;
-                break;
-            }
+    const int bitsPerByte = 8;
+    size_t fileStep = (width * channels * bitsPerChannel) / bitsPerByte;
+    CV_Assert(fileStep > 0);
 
-            case CV_32S:
-            {
-                bitsPerChannel = 32;
-                sample_format = SAMPLEFORMAT_INT;
-                break;
-            }
-            case CV_32F:
-            {
-                bitsPerChannel = 32;
-                page_compression = COMPRESSION_NONE;
-                sample_format = SAMPLEFORMAT_IEEEFP;
-                break;
-            }
-            case CV_64F:
-            {
-                bitsPerChannel = 64;
-                page_compression = COMPRESSION_NONE;
-                sample_format = SAMPLEFORMAT_IEEEFP;
-                break;
-            }
-            default:
-            {
-                return false;
-            }
-        }
+    int colorspace = channels > 1 ? PHOTOMETRIC_RGB : PHOTOMETRIC_MINISBLACK;
 
-        const int bitsPerByte = 8;
-        size_t fileStep = (width * channels * bitsPerChannel) / bitsPerByte;
-        CV_Assert(fileStep > 0);
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, bitsPerChannel));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_COMPRESSION, compression));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, colorspace));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, channels));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG));
 
+    if (tileWidth > 0 || tileHeight > 0)
+    {
+        // the tile dimensions must be multiples of 16
+        tileSize.width = alignSize(std::max(tileWidth > 0 ? tileWidth : tileHeight, 16), 16);
+        tileSize.height = alignSize(std::max(tileHeight > 0 ? tileHeight : tileWidth, 16), 16);
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_TILEWIDTH, tileSize.width));
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_TILELENGTH, tileSize.height));
+    }
+    else
+    {
         int rowsPerStrip = (int)((1 << 13) / fileStep);
         readParam(params, IMWRITE_TIFF_ROWSPERSTRIP, rowsPerStrip);
         rowsPerStrip = std::max(1, std::min(height, rowsPerStrip));
 
-        int colorspace = channels > 1 ? PHOTOMETRIC_RGB : PHOTOMETRIC_MINISBLACK;
-
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, bitsPerChannel));
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_COMPRESSION, page_compression));
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, colorspace));
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, channels));
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG));
+        tileSize = Size();
         CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, rowsPerStrip));
+    }
+
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, sample_format));
+
+    if (compression == COMPRESSION_LZW || compression == COMPRESSION_ADOBE_DEFLATE || compression == COMPRESSION_DEFLATE)
+    {
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PREDICTOR, predictor));
+    }
+
+    if (resUnit >= RESUNIT_NONE && resUnit <= RESUNIT_CENTIMETER)
+    {
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_RESOLUTIONUNIT, resUnit));
+    }
+    if (dpiX >= 0)
+    {
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_XRESOLUTION, (float)dpiX));
+    }
+    if (dpiY >= 0)
+    {
+        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_YRESOLUTION, (float)dpiY));
+    }
+    return true;
+}
 
-        CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SAMPLEFORMAT, sample_format));
+static void setSgiLogFields(TIFF* tif, Size size)
+{
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, size.width));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_IMAGELENGTH, size.height));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, 3));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, 32));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_COMPRESSION, COMPRESSION_SGILOG));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_LOGLUV));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SGILOGDATAFMT, SGILOGDATAFMT_FLOAT));
+    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, 1));
+}
 
-        if (page_compression == COMPRESSION_LZW || page_compression == COMPRESSION_ADOBE_DEFLATE || page_compression == COMPRESSION_DEFLATE)
+static void writeSgiLogRows(TIFF* tif, const Mat& rows, int y0)
+{
+    Mat img;
+    cvtColor(rows, img, COLOR_BGR2XYZ);
+
+    const int strip_size = 3 * img.cols;
+    for (int i = 0; i < img.rows; i++)
+    {
+        CV_TIFF_CHECK_CALL(TIFFWriteEncodedStrip(tif, y0 + i, (tdata_t)img.ptr<float>(i), strip_size * sizeof(float)) != (tsize_t)-1);
+    }
+}
+
+// reorders BGR(A) pixels to RGB(A) samples of the file
+static void convertToFileOrder(const Mat& src, Mat& dst)
+{
+    switch (src.channels())
+    {
+        case 3:
         {
-            CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PREDICTOR, predictor));
+            extend_cvtColor(src, dst, COLOR_BGR2RGB);
+            break;
         }
 
-        if (resUnit >= RESUNIT_NONE && resUnit <= RESUNIT_CENTIMETER)
+        case 4:
         {
-            CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_RESOLUTIONUNIT, resUnit));
+            extend_cvtColor(src, dst, COLOR_BGRA2RGBA);
+            break;
         }
-        if (dpiX >= 0)
+
+        default:
         {
-            CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_XRESOLUTION, (float)dpiX));
+            src.copyTo(dst);
         }
-        if (dpiY >= 0)
+    }
+}
+
+// writes the rows [y0, y0 + rows.rows) of an image organized in strips, buffer holds TIFFScanlineSize() bytes
+static void writeScanlines(TIFF* tif, const Mat& rows, int y0, uchar* buffer)
+{
+    // row buffer, because TIFFWriteScanline modifies the original data!
+    Mat m_buffer(Size(rows.cols, 1), rows.type(), buffer);
+
+    for (int y = 0; y < rows.rows; ++y)
+    {
+        convertToFileOrder(rows.row(y), m_buffer);
+        CV_TIFF_CHECK_CALL(TIFFWriteScanline(tif, buffer, y0 + y, 0) == 1);
+    }
+}
+
+// writes one tile at pos, the tiles at the right and bottom borders may be smaller than tileSize
+static void writeTileAt(TIFF* tif, const Mat& tile, Point pos, Size tileSize, uchar* buffer)
+{
+    Mat m_buffer(tileSize, tile.type(), buffer);
+    if (tile.size() != tileSize)
+        m_buffer.setTo(Scalar::all(0));
+
+    Mat dst = m_buffer(Rect(Point(), tile.size()));
+    convertToFileOrder(tile, dst);
+    CV_TIFF_CHECK_CALL(TIFFWriteTile(tif, buffer, pos.x, pos.y, 0, 0) >= 0);
+}
+
+// writes the tiles covering the rows [y0, y0 + rows.rows), y0 is a multiple of the tile height
+static void writeTileRows(TIFF* tif, const Mat& rows, int y0, Size tileSize, uchar* buffer)
+{
+    for (int y = 0; y < rows.rows; y += tileSize.height)
+    {
+        for (int x = 0; x < rows.cols; x += tileSize.width)
         {
-            CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_YRESOLUTION, (float)dpiY));
+            Rect roi(x, y, std::min(tileSize.width, rows.cols - x), std::min(tileSize.height, rows.rows - y));
+            writeTileAt(tif, rows(roi), Point(x, y0 + y), tileSize, buffer);
         }
+    }
+}
 
-        // row buffer, because TIFFWriteScanline modifies the original data!
-        size_t scanlineSize = TIFFScanlineSize(tif);
-        AutoBuffer<uchar> _buffer(scanlineSize + 32);
-        uchar* buffer = _buffer.data(); CV_DbgAssert(buffer);
-        Mat m_buffer(Size(width, 1), CV_MAKETYPE(depth, channels), buffer, (size_t)scanlineSize);
+bool TiffEncoder::writeLibTiff( const std::vector<Mat>& img_vec, const std::vector<int>& params)
+{
+    uint64 rawSize = 0;
+    for (size_t page = 0; page < img_vec.size(); page++)
+        rawSize += (uint64)img_vec[page].total() * img_vec[page].elemSize();
 
-        for (int y = 0; y < height; ++y)
-        {
-            switch (channels)
-            {
-                case 1:
-                {
-                    std::memcpy(buffer, img.ptr(y), scanlineSize);
-                    break;
-                }
+    TiffEncoderBufHelper buf_helper(m_buf);
+    TIFF* tif = openForWriting(buf_helper, m_filename, m_buf != NULL, useBigTiff(params, rawSize));
+    if (!tif)
+    {
+        return false;
+    }
+    cv::Ptr<void> tif_cleanup(tif, cv_tiffCloseHandle);
 
-                case 3:
-                {
-                    extend_cvtColor(img(Rect(0, y, width, 1)), (const Mat&)m_buffer, COLOR_BGR2RGB);
-                    break;
-                }
+    //Iterate through each image in the vector and write them out as Tiff directories
+    for (size_t page = 0; page < img_vec.size(); page++)
+    {
+        const Mat& img = img_vec[page];
+        CV_Assert(!img.empty());
+        int channels = img.channels();
+        int type = img.type();
+        int depth = CV_MAT_DEPTH(type);
+        CV_CheckType(type, depth == CV_8U || depth == CV_8S || depth == CV_16U || depth == CV_16S || depth == CV_32S || depth == CV_32F || depth == CV_64F, "");
+        CV_CheckType(type, channels >= 1 && channels <= 4, "");
 
-                case 4:
-                {
-                    extend_cvtColor(img(Rect(0, y, width, 1)), (const Mat&)m_buffer, COLOR_BGRA2RGBA);
-                    break;
-                }
+        if (img_vec.size() > 1)
+        {
+            CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SUBFILETYPE, FILETYPE_PAGE));
+            CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PAGENUMBER, page, img_vec.size()));
+        }
 
-                default:
-                {
-                    CV_Assert(0);
-                }
-            }
+        if (useSgiLog(type, params))
+        {
+            if (!write_32FC3_SGILOG(img, tif))
+                return false;
+            continue;
+        }
 
-            CV_TIFF_CHECK_CALL(TIFFWriteScanline(tif, buffer, y, 0) == 1);
+        Size tileSize;
+        if (!setImageFields(tif, img.size(), type, params, tileSize))
+            return false;
+
+        if (tileSize.empty())
+        {
+            AutoBuffer<uchar> _buffer(TIFFScanlineSize(tif) + 32);
+            writeScanlines(tif, img, 0, _buffer.data());
+        }
+        else
+        {
+            AutoBuffer<uchar> _buffer(TIFFTileSize(tif));
+            writeTileRows(tif, img, 0, tileSize, _buffer.data());
         }
 
         CV_TIFF_CHECK_CALL(TIFFWriteDirectory(tif));
@@ -1387,28 +1522,13 @@ bool TiffEncoder::writeLibTiff( const std::vector<Mat>& img_vec, const std::vect
     return true;
 }
 
-bool TiffEncoder::write_32FC3_SGILOG(const Mat& _img, void* tif_)
+bool TiffEncoder::write_32FC3_SGILOG(const Mat& img, void* tif_)
 {
     TIFF* tif = (TIFF*)tif_;
     CV_Assert(tif);
 
-    Mat img;
-    cvtColor(_img, img, COLOR_BGR2XYZ);
-
-    //done by caller: CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_IMAGEWIDTH, img.cols));
-    //done by caller: CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_IMAGELENGTH, img.rows));
-    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SAMPLESPERPIXEL, 3));
-    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_BITSPERSAMPLE, 32));
-    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_COMPRESSION, COMPRESSION_SGILOG));
-    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_LOGLUV));
-    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG));
-    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_SGILOGDATAFMT, SGILOGDATAFMT_FLOAT));
-    CV_TIFF_CHECK_CALL(TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, 1));
-    const int strip_size = 3 * img.cols;
-    for (int i = 0; i < img.rows; i++)
-    {
-        CV_TIFF_CHECK_CALL(TIFFWriteEncodedStrip(tif, i, (tdata_t)img.ptr<float>(i), strip_size * sizeof(float)) != (tsize_t)-1);
-    }
+    setSgiLogFields(tif, img.size());
+    writeSgiLogRows(tif, img, 0);
     CV_TIFF_CHECK_CALL(TIFFWriteDirectory(tif));
     return true;
 }
@@ -1430,6 +1550,137 @@ bool  TiffEncoder::write( const Mat& img, const std::vector<int>& params)
     return writeLibTiff(img_vec, params);
 }
 
+/**
+ * State of the image written incrementally by beginStream() / writeRows() / writeTile() / endStream()
+ */
+struct TiffEncoder::Stream
+{
+    TiffEncoderBufHelper buf_helper;
+    Ptr<void> tif;
+    Size size;
+    Size tileSize;              ///< empty if the image is organized in strips
+    bool sgilog;
+    int next_row;               ///< the first row not passed to writeRows() yet
+    Mat band;                   ///< rows of the incomplete row of tiles passed to writeRows()
+    int band_rows;
+    AutoBuffer<uchar> buffer;   ///< one scanline or tile in the sample order of the file
+
+    Stream(std::vector<uchar>* buf) : buf_helper(buf), sgilog(false), next_row(0), band_rows(0) {}
+};
+
+bool TiffEncoder::beginStream(Size size, int type, const std::vector<int>& params)
+{
+    int channels = CV_MAT_CN(type);
+    int depth = CV_MAT_DEPTH(type);
+    CV_CheckType(type, depth == CV_8U || depth == CV_8S || depth == CV_16U || depth == CV_16S || depth == CV_32S || depth == CV_32F || depth == CV_64F, "");
+    CV_CheckType(type, channels >= 1 && channels <= 4, "");
+
+    m_stream.release();
+    Ptr<Stream> stream = makePtr<Stream>(m_buf);
+
+    const uint64 rawSize = (uint64)size.width * size.height * CV_ELEM_SIZE(type);
+    TIFF* tif = openForWriting(stream->buf_helper, m_filename, m_buf != NULL, useBigTiff(params, rawSize));
+    if (!tif)
+    {
+        return false;
+    }
+    stream->tif = cv::Ptr<void>(tif, cv_tiffCloseHandle);
+    stream->size = size;
+    stream->sgilog = useSgiLog(type, params);
+
+    if (stream->sgilog)
+    {
+        setSgiLogFields(tif, size);
+    }
+    else
+    {
+        if (!setImageFields(tif, size, type, params, stream->tileSize))
+            return false;
+        stream->buffer.allocate(stream->tileSize.empty() ? TIFFScanlineSize(tif) + 32 : TIFFTileSize(tif));
+    }
+
+    m_stream = stream;
+    return true;
+}
+
+bool TiffEncoder::writeRows(const Mat& rows)
+{
+    if (!m_stream)
+        return false;
+    Stream& s = *m_stream;
+    TIFF* tif = (TIFF*)s.tif.get();
+    CV_Assert(rows.cols == s.size.width && s.next_row + rows.rows <= s.size.height);
+
+    if (s.sgilog)
+    {
+        writeSgiLogRows(tif, rows, s.next_row);
+        s.next_row += rows.rows;
+        return true;
+    }
+
+    if (s.tileSize.empty())
+    {
+        writeScanlines(tif, rows, s.next_row, s.buffer.data());
+        s.next_row += rows.rows;
+        return true;
+    }
+
+    // the tiles are written once the rows of the whole row of tiles are available
+    for (int y = 0; y < rows.rows; )
+    {
+        const int band_y = s.next_row - s.band_rows;
+        const int band_height = std::min(s.tileSize.height, s.size.height - band_y);
+        if (s.band_rows == 0 && rows.rows - y >= band_height)
+        {
+            writeTileRows(tif, rows.rowRange(y, y + band_height), band_y, s.tileSize, s.buffer.data());
+            s.next_row += band_height;
+            y += band_height;
+            continue;
+        }
+
+        if (s.band.empty())
+            s.band.create(s.tileSize.height, s.size.width, rows.type());
+        const int n = std::min(band_height - s.band_rows, rows.rows - y);
+        rows.rowRange(y, y + n).copyTo(s.band.rowRange(s.band_rows, s.band_rows + n));
+        s.band_rows += n;
+        s.next_row += n;
+        y += n;
+
+        if (s.band_rows == band_height)
+        {
+            writeTileRows(tif, s.band.rowRange(0, band_height), band_y, s.tileSize, s.buffer.data());
+            s.band_rows = 0;
+        }
+    }
+    return true;
+}
+
+Size TiffEncoder::streamTileSize() const
+{
+    return m_stream ? m_stream->tileSize : Size();
+}
+
+bool TiffEncoder::writeTile(const Mat& tile, Point pos)
+{
+    if (!m_stream || m_stream->tileSize.empty())
+        return false;
+    Stream& s = *m_stream;
+
+    writeTileAt((TIFF*)s.tif.get(), tile, pos, s.tileSize, s.buffer.data());
+    return true;
+}
+
+bool TiffEncoder::endStream()
+{
+    if (!m_stream)
+        return false;
+    Ptr<Stream> stream = m_stream;
+    m_stream.release();
+
+    CV_TIFF_CHECK_CALL(TIFFWriteDirectory((TIFF*)stream->tif.get()));
+    return true;
+}
+
 static void extend_cvtColor( InputArray _src, OutputArray _dst, int code )
 {
     CV_Assert( !_src.empty() );
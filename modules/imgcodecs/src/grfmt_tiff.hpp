@@ -98,6 +98,7 @@ public:
 
     bool  readHeader() CV_OVERRIDE;
     bool  readData( Mat& img ) CV_OVERRIDE;
+    bool  setROI( const Rect& roi ) CV_OVERRIDE;
     void  close();
     bool  nextPage() CV_OVERRIDE;
 
@@ -129,12 +130,21 @@ public:
 
     bool writemulti(const std::vector<Mat>& img_vec, const std::vector<int>& params) CV_OVERRIDE;
 
+    bool beginStream( Size size, int type, const std::vector<int>& params ) CV_OVERRIDE;
+    bool writeRows( const Mat& rows ) CV_OVERRIDE;
+    Size streamTileSize() const CV_OVERRIDE;
+    bool writeTile( const Mat& tile, Point pos ) CV_OVERRIDE;
+    bool endStream() CV_OVERRIDE;
+
     ImageEncoder newEncoder() const CV_OVERRIDE;
 
 protected:
     bool writeLibTiff( const std::vector<Mat>& img_vec, const std::vector<int>& params );
     bool write_32FC3_SGILOG(const Mat& img, void* tif);
 
+    struct Stream;
+    Ptr<Stream> m_stream;
+
 private:
     TiffEncoder(const TiffEncoder &); // copy disabled
     TiffEncoder& operator=(const TiffEncoder &); // assign disabled
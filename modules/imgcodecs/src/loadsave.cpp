@@ -52,6 +52,9 @@
 #include <iostream>
 #include <fstream>
 #include <cerrno>
+#include <map>
+#include <algorithm>
+#include <condition_variable>
 #include <opencv2/core/utils/logger.hpp>
 #include <opencv2/core/utils/configuration.private.hpp>
 #include <opencv2/imgcodecs.hpp>
@@ -399,16 +402,76 @@ static void ApplyExifOrientation(ExifEntry_t orientationTag, OutputArray img)
     }
 }
 
+/**
+ * Passes the region to the decoder, if the image is not resized after decoding
+ *
+ * @param[in] decoder Decoder with the header read
+ * @param[in] roi Region of the image, empty for the whole image
+ * @param[in] size Size of the image the region is taken from
+ * @param[in] resized Whether the decoded image is resized to the size
+ * @return true if the decoder reads the region only, false if the whole image is read and cropped
+*/
+static bool setDecoderROI( const ImageDecoder& decoder, const Rect& roi, Size size, bool resized )
+{
+    if( roi.empty() )
+        return false;
+    CV_Assert( 0 <= roi.x && 0 <= roi.width && roi.x + roi.width <= size.width &&
+               0 <= roi.y && 0 <= roi.height && roi.y + roi.height <= size.height );
+    return !resized && decoder->setROI( roi );
+}
+
+/**
+ * Computes the size of the image returned to the caller
+ *
+ * @param[in] size Size of the decoded image
+ * @param[in] roi Region of the image, empty for the whole image
+ * @param[in] scale_denom Scale denominator of the resize after decoding, 1 if the image is not resized
+ * @return Size of the output
+*/
+static Size getOutputSize( Size size, const Rect& roi, int scale_denom )
+{
+    if( !roi.empty() )
+        return roi.size();
+    return Size( size.width / scale_denom, size.height / scale_denom );
+}
+
+/**
+ * Resizes and crops the decoded image into the output, which keeps its buffer if it has the right size and type
+ *
+ * @param[in] img Decoded image, may be modified
+ * @param[out] dst Output image
+ * @param[in] roi Region of the image, empty for the whole image
+ * @param[in] scale_denom Scale denominator of the resize, 1 if the image is not resized
+*/
+static void copyDecodedToOutput( Mat& img, OutputArray dst, const Rect& roi, int scale_denom )
+{
+    if( scale_denom > 1 )
+    {
+        const Size rsize( img.cols / scale_denom, img.rows / scale_denom );
+        if( roi.empty() )
+        {
+            resize( img, dst, rsize, 0, 0, INTER_LINEAR_EXACT );
+            return;
+        }
+        resize( img, img, rsize, 0, 0, INTER_LINEAR_EXACT );
+    }
+    if( roi.empty() )
+        img.copyTo( dst );
+    else
+        img( roi ).copyTo( dst );
+}
+
 /**
  * Read an image into memory and return the information
  *
  * @param[in] filename File to load
  * @param[in] flags Flags
  * @param[in] mat Reference to C++ Mat object (If LOAD_MAT)
+ * @param[in] roi Region of the image to load, empty for the whole image
  *
 */
 static bool
-imread_( const String& filename, int flags, OutputArray mat )
+imread_( const String& filename, int flags, OutputArray mat, const Rect& roi = Rect() )
 {
     /// Search for the relevant decoder to handle the imagery
     ImageDecoder decoder;
@@ -475,19 +538,32 @@ imread_( const String& filename, int flags, OutputArray mat )
     // grab the decoded type
     const int type = calcType(decoder->type(), flags);
 
-    if (mat.empty())
+    const bool resized = decoder->setScale( scale_denom ) > 1; // if decoder is JpegDecoder then decoder->setScale always returns 1
+    const bool decoderROI = setDecoderROI(decoder, roi, resized ? Size(size.width / scale_denom, size.height / scale_denom) : size, resized);
+    const Size dsize = decoderROI ? roi.size() : size;
+    const Size osize = getOutputSize(size, roi, resized ? scale_denom : 1);
+
+    // a pre-allocated output may be a part of a larger buffer, it is filled in place
+    if (!mat.empty())
     {
-        mat.create( size.height, size.width, type );
+        CV_CheckEQ(osize, mat.size(), "");
+        CV_CheckTypeEQ(type, mat.type(), "");
+    }
+
+    // decode straight into the output, unless it is resized or cropped afterwards
+    const bool direct = !resized && (roi.empty() || decoderROI);
+    Mat real_mat;
+    if (direct)
+    {
+        mat.create( dsize.height, dsize.width, type );
+        real_mat = mat.getMat();
     }
     else
     {
-        CV_CheckEQ(size, mat.size(), "");
-        CV_CheckTypeEQ(type, mat.type(), "");
-        CV_Assert(mat.isContinuous());
+        real_mat.create( dsize.height, dsize.width, type );
     }
 
     // read the image data
-    Mat real_mat = mat.getMat();
     const void * original_ptr = real_mat.data;
     bool success = false;
     try
@@ -512,13 +588,13 @@ imread_( const String& filename, int flags, OutputArray mat )
         return false;
     }
 
-    if( decoder->setScale( scale_denom ) > 1 ) // if decoder is JpegDecoder then decoder->setScale always returns 1
+    if( !direct )
     {
-        resize( mat, mat, Size( size.width / scale_denom, size.height / scale_denom ), 0, 0, INTER_LINEAR_EXACT);
+        copyDecodedToOutput(real_mat, mat, roi, resized ? scale_denom : 1);
     }
 
     /// optionally rotate the data if EXIF orientation flag says so
-    if (!mat.empty() && (flags & IMREAD_IGNORE_ORIENTATION) == 0 && flags != IMREAD_UNCHANGED )
+    if (!mat.empty() && roi.empty() && (flags & IMREAD_IGNORE_ORIENTATION) == 0 && flags != IMREAD_UNCHANGED )
     {
         ApplyExifOrientation(decoder->getExifTag(ORIENTATION), mat);
     }
@@ -664,6 +740,15 @@ void imread( const String& filename, OutputArray dst, int flags )
     imread_(filename, flags, dst);
 }
 
+Mat imread( const String& filename, const Rect& roi, int flags )
+{
+    CV_TRACE_FUNCTION();
+
+    Mat img;
+    imread_( filename, flags, img, roi );
+    return img;
+}
+
 /**
 * Read a multi-page image
 *
@@ -982,8 +1067,383 @@ bool imwriteanimation(const String& filename, const Animation& animation, const
     return imwriteanimation_(filename, animation, params);
 }
 
+/**
+ * Incremental encoding of the image, see ImageWriter.
+ *
+ * The encoder receives the rows from top to bottom. The strips which arrive before the rows above them are copied
+ * to the queue, and the thread which passes the first missing rows encodes the queued strips following them as well.
+ * While the queue is drained, the producers wait once the queued data exceeds the limit, so the queue does not grow
+ * when the encoder is slower than the producers. For formats without tiled layout the tiles are collected into bands
+ * of the image width first.
+ */
+class ImageWriter::Impl
+{
+public:
+    Impl() : m_type(-1), m_stream_type(-1), m_next_row(0), m_append_row(0), m_tiles_written(0),
+             m_queued_bytes(0), m_max_queued_bytes(0), m_draining(false), m_failed(false) {}
+    ~Impl() { if (m_encoder) close(); }
+
+    bool open(const String& filename, Size size, int type, const std::vector<int>& params);
+    bool isOpened() const { return !m_encoder.empty(); }
+    bool writeRows(const Mat& rows, int y);
+    bool writeTile(const Mat& tile, Point pos);
+    bool close();
+
+private:
+    /// converts the depth not supported by the encoder, like imwrite() does
+    Mat toStreamType(const Mat& src, bool& copied) const;
+    /// queues or encodes the strip starting at the row y, the strip is not copied if owned is true
+    bool pushRows(const Mat& rows, int y, bool owned);
+    /// calls the encoder, catching its exceptions
+    bool encode(const Mat& data, const Point* tile_pos);
+
+    struct Strip
+    {
+        Mat data;
+        bool waiting; ///< the data is not copied yet, the producer waits for the room in the queue
+    };
+
+    struct Band
+    {
+        Mat data;
+        std::vector<uchar> covered; ///< columns covered by the tiles
+        int filled;                 ///< number of covered columns
+    };
+
+    String m_filename;
+    ImageEncoder m_encoder;
+    Size m_size;
+    int m_type;
+    int m_stream_type;
+    Size m_tile_size;
+    Mutex m_mutex;                           ///< guards the state below
+    Mutex m_encoder_mutex;                   ///< serializes the encoder calls
+    std::condition_variable_any m_queue_cond; ///< signalled when the queue shrinks or the draining stops
+    int m_next_row;                          ///< the first row which is neither encoded nor being encoded
+    int m_append_row;                        ///< the row after the last strip passed by writeRows()
+    std::vector<uchar> m_tiles;              ///< tiles passed by writeTile() to the tiled encoder
+    size_t m_tiles_written;
+    std::map<int, Strip> m_queue;            ///< strips waiting for the rows above them
+    size_t m_queued_bytes;                   ///< size of the strips copied to the queue
+    size_t m_max_queued_bytes;
+    std::map<int, Band> m_bands;
+    bool m_draining;
+    bool m_failed;
+};
+
+/// checks that the rows [y, y + rows) are not covered by the strips
+template<typename T> static
+void checkRowsNotWritten(const std::map<int, T>& strips, int y, int rows)
+{
+    typename std::map<int, T>::const_iterator next = strips.lower_bound(y);
+    if (next != strips.end())
+        CV_CheckLE(y + rows, next->first, "the rows have already been written");
+    if (next != strips.begin())
+    {
+        --next;
+        CV_CheckLE(next->first + next->second.data.rows, y, "the rows have already been written");
+    }
+}
+
+bool ImageWriter::Impl::open(const String& filename, Size size, int type, const std::vector<int>& params)
+{
+    if (m_encoder)
+        close();
+
+    ImageEncoder encoder = findEncoder(filename);
+    if (!encoder)
+        CV_Error(Error::StsError, "could not find a writer for the specified extension");
+
+    CV_Assert(size.width > 0 && size.height > 0);
+    const int channels = CV_MAT_CN(type);
+    CV_Assert(channels == 1 || channels == 3 || channels == 4);
+    CV_Check(params.size(), (params.size() & 1) == 0, "Encoding 'params' must be key-value pairs");
+    CV_CheckLE(params.size(), (size_t)(CV_IO_MAX_IMAGE_PARAMS*2), "");
+
+    int stream_type = type;
+    if (!encoder->isFormatSupported(CV_MAT_DEPTH(type)))
+    {
+        CV_LOG_ONCE_WARNING(NULL, "Unsupported depth image for selected encoder is fallbacked to CV_8U.");
+        CV_Assert(encoder->isFormatSupported(CV_8U));
+        stream_type = CV_MAKETYPE(CV_8U, channels);
+    }
+
+    encoder->setDestination(filename);
+    bool code = false;
+    try
+    {
+        code = encoder->beginStream(size, stream_type, params);
+    }
+    catch (const cv::Exception& e)
+    {
+        CV_LOG_ERROR(NULL, "ImageWriter('" << filename << "'): can't start writing: " << e.what());
+    }
+    catch (...)
+    {
+        CV_LOG_ERROR(NULL, "ImageWriter('" << filename << "'): can't start writing: unknown exception");
+    }
+    if (!code)
+        return false;
+
+    m_filename = filename;
+    m_encoder = encoder;
+    m_size = size;
+    m_type = type;
+    m_stream_type = stream_type;
+    m_tile_size = encoder->streamTileSize();
+    m_next_row = m_append_row = 0;
+    m_tiles.assign(m_tile_size.empty() ? 0 :
+                   (size_t)divUp(size.width, m_tile_size.width) * divUp(size.height, m_tile_size.height), 0);
+    m_tiles_written = 0;
+    m_queued_bytes = 0;
+    m_max_queued_bytes = utils::getConfigurationParameterSizeT("OPENCV_IO_MAX_WRITER_QUEUE_SIZE", (size_t)64 << 20);
+    m_draining = m_failed = false;
+    return true;
+}
+
+Mat ImageWriter::Impl::toStreamType(const Mat& src, bool& copied) const
+{
+    CV_CheckTypeEQ(src.type(), m_type, "");
+    copied = m_stream_type != m_type;
+    if (!copied)
+        return src;
+    Mat dst;
+    src.convertTo(dst, m_stream_type);
+    return dst;
+}
+
+bool ImageWriter::Impl::encode(const Mat& data, const Point* tile_pos)
+{
+    try
+    {
+        AutoLock lock(m_encoder_mutex);
+        return tile_pos ? m_encoder->writeTile(data, *tile_pos) : m_encoder->writeRows(data);
+    }
+    catch (const cv::Exception& e)
+    {
+        CV_LOG_ERROR(NULL, "ImageWriter('" << m_filename << "'): can't write data: " << e.what());
+    }
+    catch (...)
+    {
+        CV_LOG_ERROR(NULL, "ImageWriter('" << m_filename << "'): can't write data: unknown exception");
+    }
+    return false;
+}
+
+bool ImageWriter::Impl::writeRows(const Mat& rows, int y)
+{
+    CV_Assert(m_encoder);
+    CV_CheckEQ(rows.cols, m_size.width, "the rows must have the width of the image");
+
+    bool owned = false;
+    Mat data = toStreamType(rows, owned);
+    return pushRows(data, y, owned);
+}
+
+bool ImageWriter::Impl::pushRows(const Mat& rows, int y, bool owned)
+{
+    Mat strip = rows;
+    {
+        std::unique_lock<Mutex> lock(m_mutex);
+        if (y < 0)
+            y = m_append_row;
+        CV_CheckGE(y, m_next_row, "the rows have already been written");
+        CV_CheckLE(y + rows.rows, m_size.height, "the rows are out of the image");
+        checkRowsNotWritten(m_queue, y, rows.rows);
+        m_append_row = y + rows.rows;
+
+        if (m_failed)
+            return false;
+        if (m_draining || y != m_next_row)
+        {
+            // the strip takes its place in the queue before waiting, so the rows can't be passed twice.
+            // Nobody shrinks the queue when it is not drained, then the strip is copied anyway.
+            const size_t size = rows.total() * rows.elemSize();
+            Strip& queued = m_queue[y];
+            queued.data = rows;
+            queued.waiting = true;
+            while (m_draining && !m_failed && m_queued_bytes > 0 && m_queued_bytes + size > m_max_queued_bytes)
+                m_queue_cond.wait(lock);
+
+            if (m_failed)
+                return false;
+            if (m_draining || y != m_next_row)
+            {
+                if (!owned)
+                    queued.data = rows.clone();
+                queued.waiting = false;
+                m_queued_bytes += size;
+                return true;
+            }
+            // the draining has stopped at this strip
+            m_queue.erase(y);
+        }
+        m_draining = true;
+        m_next_row = y + rows.rows;
+    }
+
+    for (;;)
+    {
+        const bool code = encode(strip, NULL);
+
+        AutoLock lock(m_mutex);
+        m_failed = m_failed || !code;
+        std::map<int, Strip>::iterator it = m_queue.find(m_next_row);
+        if (m_failed || it == m_queue.end() || it->second.waiting)
+        {
+            // the producer of the waiting strip encodes it and the strips following it
+            if (m_failed)
+            {
+                m_queue.clear();
+                m_queued_bytes = 0;
+            }
+            m_draining = false;
+            m_queue_cond.notify_all();
+            return !m_failed;
+        }
+        strip = it->second.data;
+        m_next_row += strip.rows;
+        m_queued_bytes -= strip.total() * strip.elemSize();
+        m_queue.erase(it);
+        m_queue_cond.notify_all();
+    }
+}
+
+bool ImageWriter::Impl::writeTile(const Mat& tile, Point pos)
+{
+    CV_Assert(m_encoder);
+    const Rect roi(pos, tile.size());
+    CV_Assert(!roi.empty() && (roi & Rect(Point(), m_size)) == roi);
+
+    bool owned = false;
+    Mat data = toStreamType(tile, owned);
+
+    if (!m_tile_size.empty())
+    {
+        CV_Assert(pos.x % m_tile_size.width == 0 && pos.y % m_tile_size.height == 0);
+        CV_Assert(tile.cols == std::min(m_tile_size.width, m_size.width - pos.x) &&
+                  tile.rows == std::min(m_tile_size.height, m_size.height - pos.y));
+        const size_t index = (size_t)(pos.y / m_tile_size.height) * divUp(m_size.width, m_tile_size.width) +
+                             pos.x / m_tile_size.width;
+
+        bool failed = false;
+        {
+            AutoLock lock(m_mutex);
+            CV_CheckEQ((int)m_tiles[index], 0, "the tile has already been written");
+            m_tiles[index] = 1;
+            failed = m_failed;
+        }
+        const bool code = !failed && encode(data, &pos);
+
+        AutoLock lock(m_mutex);
+        m_failed = m_failed || !code;
+        m_tiles_written++;
+        return !m_failed;
+    }
+
+    Mat band;
+    {
+        AutoLock lock(m_mutex);
+        CV_CheckGE(pos.y, m_next_row, "the rows have already been written");
+        std::map<int, Band>::iterator it = m_bands.find(pos.y);
+        if (it == m_bands.end())
+        {
+            checkRowsNotWritten(m_bands, pos.y, tile.rows);
+            checkRowsNotWritten(m_queue, pos.y, tile.rows);
+            it = m_bands.insert(std::make_pair(pos.y, Band())).first;
+            it->second.data.create(tile.rows, m_size.width, m_stream_type);
+            it->second.covered.assign(m_size.width, 0);
+            it->second.filled = 0;
+        }
+        Band& b = it->second;
+        CV_CheckEQ(tile.rows, b.data.rows, "the tiles at the same row must have the same height");
+        const std::vector<uchar>::iterator first = b.covered.begin() + pos.x, last = first + tile.cols;
+        CV_Check(pos.x, std::find(first, last, (uchar)1) == last, "the tile overlaps the tiles written before");
+        std::fill(first, last, (uchar)1);
+        data.copyTo(b.data(Rect(pos.x, 0, tile.cols, tile.rows)));
+        b.filled += tile.cols;
+        if (b.filled < m_size.width)
+            return !m_failed;
+        band = b.data;
+        m_bands.erase(it);
+    }
+    return pushRows(band, pos.y, true);
+}
+
+bool ImageWriter::Impl::close()
+{
+    if (!m_encoder)
+        return false;
+
+    bool code = !m_failed && m_queue.empty() && m_bands.empty() &&
+                (m_next_row == m_size.height || (!m_tiles.empty() && m_tiles_written == m_tiles.size()));
+    if (code)
+    {
+        try
+        {
+            code = m_encoder->endStream();
+        }
+        catch (const cv::Exception& e)
+        {
+            CV_LOG_ERROR(NULL, "ImageWriter('" << m_filename << "'): can't write data: " << e.what());
+            code = false;
+        }
+        catch (...)
+        {
+            CV_LOG_ERROR(NULL, "ImageWriter('" << m_filename << "'): can't write data: unknown exception");
+            code = false;
+        }
+    }
+    else if (!m_failed)
+    {
+        CV_LOG_WARNING(NULL, "ImageWriter('" << m_filename << "'): the image is incomplete, the file is removed");
+    }
+
+    // the encoder closes the file
+    m_encoder.release();
+    m_queue.clear();
+    m_queued_bytes = 0;
+    m_bands.clear();
+    if (!code)
+        remove(m_filename.c_str());
+    return code;
+}
+
+ImageWriter::ImageWriter() : pImpl(new Impl()) {}
+
+ImageWriter::ImageWriter(const String& filename, Size size, int type, const std::vector<int>& params)
+    : pImpl(new Impl())
+{
+    pImpl->open(filename, size, type, params);
+}
+
+ImageWriter::~ImageWriter() {}
+
+bool ImageWriter::open(const String& filename, Size size, int type, const std::vector<int>& params)
+{
+    return pImpl->open(filename, size, type, params);
+}
+
+bool ImageWriter::isOpened() const { return pImpl->isOpened(); }
+
+bool ImageWriter::writeRows(InputArray rows, int y) { return pImpl->writeRows(rows.getMat(), y); }
+
+bool ImageWriter::writeTile(InputArray tile, Point pos) { return pImpl->writeTile(tile.getMat(), pos); }
+
+bool ImageWriter::close() { return pImpl->close(); }
+
+/**
+ * Decode an image from memory
+ *
+ * @param[in] buf Encoded image
+ * @param[in] flags Flags
+ * @param[out] mat Decoded image
+ * @param[in] roi Region of the image to decode, empty for the whole image
+ * @param[in] fixedOutput If true, a non-empty mat must have the size and the type of the decoded image and
+ *                        is filled in place, otherwise it is reallocated when they do not match
+*/
 static bool
-imdecode_( const Mat& buf, int flags, Mat& mat )
+imdecode_( const Mat& buf, int flags, OutputArray mat, const Rect& roi = Rect(), bool fixedOutput = false )
 {
     CV_Assert(!buf.empty());
     CV_Assert(buf.isContinuous());
@@ -1067,13 +1527,43 @@ imdecode_( const Mat& buf, int flags, Mat& mat )
 
     const int type = calcType(decoder->type(), flags);
 
-    mat.create( size.height, size.width, type );
+    const bool resized = decoder->setScale( scale_denom ) > 1; // if decoder is JpegDecoder then decoder->setScale always returns 1
+    const bool decoderROI = setDecoderROI(decoder, roi, resized ? Size(size.width / scale_denom, size.height / scale_denom) : size, resized);
+    const Size dsize = decoderROI ? roi.size() : size;
+    const Size osize = getOutputSize(size, roi, resized ? scale_denom : 1);
+
+    if (fixedOutput && !mat.empty() && (mat.size() != osize || mat.type() != type))
+    {
+        if (!filename.empty() && 0 != remove(filename.c_str()))
+        {
+            CV_LOG_WARNING(NULL, "unable to remove temporary file: " << filename);
+        }
+        CV_CheckEQ(osize, mat.size(), "");
+        CV_CheckTypeEQ(type, mat.type(), "");
+    }
+
+    // decode straight into the output, unless it is resized or cropped afterwards
+    const bool direct = !resized && (roi.empty() || decoderROI);
+    Mat real_mat;
+    if (direct)
+    {
+        mat.create( dsize.height, dsize.width, type );
+        real_mat = mat.getMat();
+    }
+    else
+    {
+        real_mat.create( dsize.height, dsize.width, type );
+    }
 
+    const void * original_ptr = real_mat.data;
     success = false;
     try
     {
-        if (decoder->readData(mat))
+        if (decoder->readData(real_mat))
+        {
+            CV_CheckTrue(original_ptr == real_mat.data, "Internal imdecode issue");
             success = true;
+        }
     }
     catch (const cv::Exception& e)
     {
@@ -1097,13 +1587,13 @@ imdecode_( const Mat& buf, int flags, Mat& mat )
         return false;
     }
 
-    if( decoder->setScale( scale_denom ) > 1 ) // if decoder is JpegDecoder then decoder->setScale always returns 1
+    if( !direct )
     {
-        resize(mat, mat, Size( size.width / scale_denom, size.height / scale_denom ), 0, 0, INTER_LINEAR_EXACT);
+        copyDecodedToOutput(real_mat, mat, roi, resized ? scale_denom : 1);
     }
 
     /// optionally rotate the data if EXIF' orientation flag says so
-    if (!mat.empty() && (flags & IMREAD_IGNORE_ORIENTATION) == 0 && flags != IMREAD_UNCHANGED)
+    if (!mat.empty() && roi.empty() && (flags & IMREAD_IGNORE_ORIENTATION) == 0 && flags != IMREAD_UNCHANGED)
     {
         ApplyExifOrientation(decoder->getExifTag(ORIENTATION), mat);
     }
@@ -1123,6 +1613,26 @@ Mat imdecode( InputArray _buf, int flags )
     return img;
 }
 
+Mat imdecode( InputArray _buf, const Rect& roi, int flags )
+{
+    CV_TRACE_FUNCTION();
+
+    Mat buf = _buf.getMat(), img;
+    if (!imdecode_(buf, flags, img, roi))
+        img.release();
+
+    return img;
+}
+
+void imdecode( InputArray _buf, OutputArray dst, int flags )
+{
+    CV_TRACE_FUNCTION();
+
+    Mat buf = _buf.getMat();
+    if (!imdecode_(buf, flags, dst, Rect(), true))
+        dst.release();
+}
+
 Mat imdecode( InputArray _buf, int flags, Mat* dst )
 {
     CV_TRACE_FUNCTION();
@@ -1290,6 +1800,75 @@ bool imdecodemulti(InputArray _buf, int flags, CV_OUT std::vector<Mat>& mats, co
     }
 }
 
+class ImdecodeBatchInvoker : public ParallelLoopBody
+{
+public:
+    ImdecodeBatchInvoker(const std::vector<Mat>& bufs, int flags, std::vector<Mat>& dst, std::vector<String>& errors)
+        : bufs_(bufs), flags_(flags), dst_(dst), errors_(errors)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        for (int i = range.start; i < range.end; i++)
+        {
+            // every image gets its own decoder, they keep per-image state (stream, EXIF, region)
+            Mat& img = dst_[i];
+            String& error = errors_[i];
+            try
+            {
+                if (bufs_[i].empty())
+                    error = "empty buffer";
+                else if (!imdecode_(bufs_[i], flags_, img, Rect(), true))
+                    error = "can't decode the image: unknown format or corrupted data";
+            }
+            catch (const cv::Exception& e)
+            {
+                error = e.what();
+            }
+            catch (const std::exception& e)
+            {
+                error = e.what();
+            }
+            catch (...)
+            {
+                error = "unknown exception";
+            }
+            if (!error.empty())
+                img.release();
+        }
+    }
+
+private:
+    const std::vector<Mat>& bufs_;
+    const int flags_;
+    std::vector<Mat>& dst_;
+    std::vector<String>& errors_;
+};
+
+int imdecodeBatch( InputArrayOfArrays _bufs, int flags, std::vector<Mat>& dst, std::vector<String>& errors )
+{
+    CV_TRACE_FUNCTION();
+
+    std::vector<Mat> bufs;
+    _bufs.getMatVector(bufs);
+    const int count = (int)bufs.size();
+    if (dst.size() != bufs.size())
+    {
+        dst.clear();
+        dst.resize(bufs.size());
+    }
+    errors.assign(bufs.size(), String());
+
+    // one stripe per image balances the workers when the images differ in size
+    parallel_for_(Range(0, count), ImdecodeBatchInvoker(bufs, flags, dst, errors), count);
+
+    int decoded = 0;
+    for (int i = 0; i < count; i++)
+        decoded += errors[i].empty() ? 1 : 0;
+    return decoded;
+}
+
 bool imencode( const String& ext, InputArray _img,
                std::vector<uchar>& buf, const std::vector<int>& params_ )
 {
@@ -289,6 +289,89 @@ INSTANTIATE_TEST_CASE_P( /* nothing */,
                             testing::Values(70, 95, 100),    // IMWRITE_JPEG_LUMA_QUALITY
                             testing::Values(70, 95, 100) )); // IMWRITE_JPEG_CHROMA_QUALITY
 
+//==================================================================================================
+// Large images with restart markers are encoded and decoded in strips in parallel,
+// the result must be the same as with the sequential coding.
+typedef testing::TestWithParam<std::tuple<int, uint32_t, int>> Imgcodecs_Jpeg_rst_parallel;
+
+struct NumThreadsSetter
+{
+    NumThreadsSetter(int num_threads) : original_num_threads(getNumThreads())
+    {
+        setNumThreads(num_threads);
+    }
+    ~NumThreadsSetter()
+    {
+        setNumThreads(original_num_threads);
+    }
+private:
+    int original_num_threads;
+};
+
+TEST_P(Imgcodecs_Jpeg_rst_parallel, same_as_sequential)
+{
+    const int channels = get<0>(GetParam());
+    const uint32_t sampling_factor = get<1>(GetParam());
+    const int rst_interval = get<2>(GetParam());
+
+    Mat src(1030, 1032, CV_8UC(channels));
+    randu(src, Scalar::all(0), Scalar::all(255));
+    GaussianBlur(src, src, Size(7, 7), 0);
+    const std::vector<int> params = { IMWRITE_JPEG_RST_INTERVAL, rst_interval,
+                                      IMWRITE_JPEG_SAMPLING_FACTOR, (int)sampling_factor };
+
+    std::vector<uchar> buf_seq, buf_par;
+    Mat bgr_seq, rgb_seq, gray_seq, bgr_par, rgb_par, gray_par, file_par;
+    std::vector<Mat> batch;
+    std::vector<String> errors;
+    const string filename = cv::tempfile(".jpg");
+    {
+        NumThreadsSetter threads(1);
+        ASSERT_TRUE(imencode(".jpg", src, buf_seq, params));
+        bgr_seq = imdecode(buf_seq, IMREAD_COLOR);
+        rgb_seq = imdecode(buf_seq, IMREAD_COLOR_RGB);
+        gray_seq = imdecode(buf_seq, IMREAD_GRAYSCALE);
+    }
+    {
+        NumThreadsSetter threads(4);
+        EXPECT_TRUE(imencode(".jpg", src, buf_par, params));
+        bgr_par = imdecode(buf_seq, IMREAD_COLOR);
+        rgb_par = imdecode(buf_seq, IMREAD_COLOR_RGB);
+        gray_par = imdecode(buf_seq, IMREAD_GRAYSCALE);
+
+        EXPECT_TRUE(imwrite(filename, src, params));
+        file_par = imread(filename, IMREAD_COLOR);
+
+        // the images of a batch are decoded in parallel, each one without strips
+        const std::vector<std::vector<uchar> > bufs(3, buf_seq);
+        EXPECT_EQ(3, imdecodeBatch(bufs, IMREAD_COLOR, batch, errors));
+    }
+
+    EXPECT_TRUE(buf_seq == buf_par);
+    ASSERT_FALSE(bgr_par.empty());
+    EXPECT_EQ(0, cvtest::norm(bgr_seq, bgr_par, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(rgb_seq, rgb_par, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(gray_seq, gray_par, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(bgr_seq, file_par, NORM_INF));
+    ASSERT_EQ(3u, batch.size());
+    for (size_t i = 0; i < batch.size(); i++)
+        EXPECT_EQ(0, cvtest::norm(bgr_seq, batch[i], NORM_INF));
+    EXPECT_EQ(0, remove(filename.c_str()));
+}
+
+INSTANTIATE_TEST_CASE_P( /*nothing*/, Imgcodecs_Jpeg_rst_parallel,
+    testing::Values(
+        std::make_tuple(1, IMWRITE_JPEG_SAMPLING_FACTOR_444, 1),
+        std::make_tuple(1, IMWRITE_JPEG_SAMPLING_FACTOR_444, 7),
+        std::make_tuple(3, IMWRITE_JPEG_SAMPLING_FACTOR_420, 1),
+        std::make_tuple(3, IMWRITE_JPEG_SAMPLING_FACTOR_420, 7),
+        std::make_tuple(3, IMWRITE_JPEG_SAMPLING_FACTOR_420, 65),
+        std::make_tuple(3, IMWRITE_JPEG_SAMPLING_FACTOR_422, 13),
+        std::make_tuple(3, IMWRITE_JPEG_SAMPLING_FACTOR_440, 5),
+        std::make_tuple(3, IMWRITE_JPEG_SAMPLING_FACTOR_444, 129),
+        std::make_tuple(3, IMWRITE_JPEG_SAMPLING_FACTOR_411, 33),
+        std::make_tuple(4, IMWRITE_JPEG_SAMPLING_FACTOR_420, 2)));
+
 #endif // HAVE_JPEG
 
 }} // namespace
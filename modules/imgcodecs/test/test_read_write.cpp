@@ -324,6 +324,482 @@ TEST(Imgcodecs_Image, imread_overload)
 
 //==================================================================================================
 
+typedef testing::TestWithParam<Ext> Imgcodecs_Image_ROI;
+
+TEST_P(Imgcodecs_Image_ROI, imdecode)
+{
+    const string ext = GetParam();
+    Mat src(257, 333, CV_8UC3);
+    randu(src, Scalar::all(0), Scalar::all(255));
+    GaussianBlur(src, src, Size(5, 5), 0);
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode(ext, src, buf));
+
+    const Rect rois[] = { Rect(0, 0, 333, 257), Rect(0, 0, 1, 1), Rect(37, 50, 101, 67),
+                          Rect(200, 17, 133, 240), Rect(5, 250, 300, 7), Rect(332, 0, 1, 257) };
+    const int flags[] = { IMREAD_COLOR, IMREAD_GRAYSCALE, IMREAD_UNCHANGED };
+    for (size_t i = 0; i < sizeof(rois)/sizeof(rois[0]); i++)
+    {
+        for (size_t j = 0; j < sizeof(flags)/sizeof(flags[0]); j++)
+        {
+            SCOPED_TRACE(cv::format("roi=[%d, %d, %d x %d] flags=%d", rois[i].x, rois[i].y, rois[i].width, rois[i].height, flags[j]));
+            Mat full = imdecode(buf, flags[j]);
+            ASSERT_FALSE(full.empty());
+            Mat img = imdecode(buf, rois[i], flags[j]);
+            ASSERT_FALSE(img.empty());
+            EXPECT_EQ(full.type(), img.type());
+            EXPECT_EQ(0, cvtest::norm(full(rois[i]), img, NORM_INF));
+        }
+    }
+
+    // the region is taken from the reduced image
+    Mat reduced = imdecode(buf, IMREAD_REDUCED_COLOR_2);
+    ASSERT_FALSE(reduced.empty());
+    const Rect roi(10, 20, 100, 60);
+    Mat img = imdecode(buf, roi, IMREAD_REDUCED_COLOR_2);
+    EXPECT_EQ(0, cvtest::norm(reduced(roi), img, NORM_INF));
+
+    // the whole image for the empty region
+    EXPECT_EQ(0, cvtest::norm(imdecode(buf, IMREAD_COLOR), imdecode(buf, Rect(), IMREAD_COLOR), NORM_INF));
+
+    if (ext == ".png" || ext == ".tiff")
+    {
+        Mat src16;
+        src.convertTo(src16, CV_16U, 255);
+        std::vector<uchar> buf16;
+        ASSERT_TRUE(imencode(ext, src16, buf16));
+        const Rect roi16(37, 50, 101, 67);
+        Mat full16 = imdecode(buf16, IMREAD_UNCHANGED);
+        ASSERT_EQ(CV_16UC3, full16.type());
+        EXPECT_EQ(0, cvtest::norm(full16(roi16), imdecode(buf16, roi16, IMREAD_UNCHANGED), NORM_INF));
+    }
+
+    if (ext == ".tiff")
+    {
+        // tiled image: 333 = 5*64 + 13, 257 = 8*32 + 1, so there are partial tiles at the right and bottom
+        const int tparams[] = { IMWRITE_TIFF_TILE_WIDTH, 64, IMWRITE_TIFF_TILE_HEIGHT, 32 };
+        const Rect trois[] = { Rect(0, 0, 333, 257), Rect(63, 31, 2, 2), Rect(50, 20, 150, 100), Rect(64, 32, 64, 32),
+                               Rect(320, 256, 13, 1), Rect(330, 100, 3, 10), Rect(300, 250, 33, 7), Rect(0, 256, 333, 1) };
+        const int ttypes[] = { CV_8UC1, CV_8UC3, CV_8UC4, CV_16UC3 };
+        for (size_t t = 0; t < sizeof(ttypes)/sizeof(ttypes[0]); t++)
+        {
+            Mat tsrc(src.size(), ttypes[t]);
+            randu(tsrc, Scalar::all(0), Scalar::all(ttypes[t] == CV_16UC3 ? 65535 : 255));
+            std::vector<uchar> tbuf;
+            ASSERT_TRUE(imencode(ext, tsrc, tbuf, std::vector<int>(tparams, tparams + sizeof(tparams)/sizeof(tparams[0]))));
+            for (size_t j = 0; j < sizeof(flags)/sizeof(flags[0]); j++)
+            {
+                Mat full = imdecode(tbuf, flags[j]);
+                ASSERT_FALSE(full.empty());
+                for (size_t i = 0; i < sizeof(trois)/sizeof(trois[0]); i++)
+                {
+                    SCOPED_TRACE(cv::format("tiled type=%d roi=[%d, %d, %d x %d] flags=%d", ttypes[t],
+                                            trois[i].x, trois[i].y, trois[i].width, trois[i].height, flags[j]));
+                    Mat timg = imdecode(tbuf, trois[i], flags[j]);
+                    ASSERT_FALSE(timg.empty());
+                    EXPECT_EQ(full.type(), timg.type());
+                    EXPECT_EQ(0, cvtest::norm(full(trois[i]), timg, NORM_INF));
+                }
+            }
+        }
+    }
+
+    EXPECT_ANY_THROW(imdecode(buf, Rect(300, 0, 34, 10), IMREAD_COLOR));
+    EXPECT_ANY_THROW(imdecode(buf, Rect(-1, 0, 10, 10), IMREAD_COLOR));
+}
+
+TEST_P(Imgcodecs_Image_ROI, imread)
+{
+    const string ext = GetParam();
+    const string filename = cv::tempfile(ext.c_str());
+    Mat src(120, 160, CV_8UC3);
+    randu(src, Scalar::all(0), Scalar::all(255));
+    ASSERT_TRUE(imwrite(filename, src));
+
+    const Rect roi(17, 33, 64, 48);
+    Mat full = imread(filename, IMREAD_COLOR);
+    ASSERT_FALSE(full.empty());
+    Mat img = imread(filename, roi, IMREAD_COLOR);
+    EXPECT_EQ(0, cvtest::norm(full(roi), img, NORM_INF));
+    EXPECT_EQ(0, remove(filename.c_str()));
+}
+
+const string roi_exts[] = {
+#ifdef HAVE_JPEG
+    ".jpg",
+#endif
+#if defined(HAVE_PNG) || defined(HAVE_SPNG)
+    ".png",
+#endif
+#ifdef HAVE_TIFF
+    ".tiff",
+#endif
+    ".bmp",
+    ".ppm",
+};
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/, Imgcodecs_Image_ROI, testing::ValuesIn(roi_exts));
+
+//==================================================================================================
+
+typedef testing::TestWithParam<Ext> Imgcodecs_Image_Preallocated;
+
+TEST_P(Imgcodecs_Image_Preallocated, imdecode_batch_slot)
+{
+    const string ext = GetParam();
+    Mat src(61, 83, CV_8UC3);
+    randu(src, Scalar::all(0), Scalar::all(255));
+    std::vector<uchar> buf;
+    ASSERT_TRUE(imencode(ext, src, buf));
+
+    const int flags[] = { IMREAD_COLOR, IMREAD_COLOR_RGB, IMREAD_GRAYSCALE, IMREAD_REDUCED_COLOR_2 };
+    for (size_t j = 0; j < sizeof(flags)/sizeof(flags[0]); j++)
+    {
+        SCOPED_TRACE(cv::format("flags=%d", flags[j]));
+        Mat ref = imdecode(buf, flags[j]);
+        ASSERT_FALSE(ref.empty());
+
+        // N x H x W x C tensor, the image is decoded into the middle of slot 1
+        const int cn = ref.channels();
+        const int sz[] = { 3, ref.rows + 4, ref.cols + 6, cn };
+        Mat batch(4, sz, CV_8U, Scalar::all(7));
+        Mat slot(ref.rows, ref.cols, ref.type(), batch.ptr(1, 2, 3), batch.step[1]);
+        ASSERT_FALSE(slot.isContinuous());
+        const uchar* data = slot.data;
+
+        ASSERT_NO_THROW(imdecode(buf, slot, flags[j]));
+        EXPECT_EQ(data, slot.data);
+        EXPECT_EQ(0, cvtest::norm(ref, slot, NORM_INF));
+
+        // everything around the slot is untouched
+        Mat plane = batch.reshape(cn, std::vector<int>{ 3 * sz[1], sz[2] });
+        Mat outside = plane.clone();
+        outside(Rect(3, sz[1] + 2, ref.cols, ref.rows)).setTo(Scalar::all(7));
+        EXPECT_EQ(0, cvtest::norm(Mat(plane.size(), plane.type(), Scalar::all(7)), outside, NORM_INF));
+    }
+
+    // the pre-allocated output must match the decoded image
+    Mat wrong_size(src.rows + 1, src.cols, CV_8UC3);
+    EXPECT_ANY_THROW(imdecode(buf, wrong_size, IMREAD_COLOR));
+    Mat wrong_type(src.size(), CV_8UC1);
+    EXPECT_ANY_THROW(imdecode(buf, wrong_type, IMREAD_COLOR));
+
+    // an empty output is allocated
+    Mat img;
+    imdecode(buf, img, IMREAD_COLOR);
+    EXPECT_EQ(0, cvtest::norm(imdecode(buf, IMREAD_COLOR), img, NORM_INF));
+}
+
+TEST_P(Imgcodecs_Image_Preallocated, imread_submatrix)
+{
+    const string ext = GetParam();
+    const string filename = cv::tempfile(ext.c_str());
+    Mat src(40, 50, CV_8UC3);
+    randu(src, Scalar::all(0), Scalar::all(255));
+    ASSERT_TRUE(imwrite(filename, src));
+
+    Mat ref = imread(filename, IMREAD_COLOR);
+    ASSERT_FALSE(ref.empty());
+    Mat big(ref.rows + 10, ref.cols + 10, CV_8UC3, Scalar::all(7));
+    Mat dst = big(Rect(5, 5, ref.cols, ref.rows));
+    imread(filename, dst, IMREAD_COLOR);
+    EXPECT_EQ(big.ptr(5, 5), dst.data);
+    EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(Mat(big.rows, 5, CV_8UC3, Scalar::all(7)), big.colRange(0, 5), NORM_INF));
+    EXPECT_EQ(0, remove(filename.c_str()));
+}
+
+const string preallocated_exts[] = {
+#ifdef HAVE_JPEG
+    ".jpg",
+#endif
+#if defined(HAVE_PNG) || defined(HAVE_SPNG)
+    ".png",
+#endif
+#ifdef HAVE_TIFF
+    ".tiff",
+#endif
+#ifdef HAVE_IMGCODEC_PFM
+    ".pfm",
+#endif
+    ".bmp",
+    ".ppm",
+};
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/, Imgcodecs_Image_Preallocated, testing::ValuesIn(preallocated_exts));
+
+TEST(Imgcodecs_Image, imdecodeBatch)
+{
+    std::vector<std::vector<uchar> > bufs;
+    for (int i = 0; i < 12; i++)
+    {
+        Mat src(40 + 7 * i, 50 + 3 * i, CV_8UC3);
+        randu(src, Scalar::all(0), Scalar::all(255));
+        std::vector<uchar> buf;
+        ASSERT_TRUE(imencode(preallocated_exts[i % (sizeof(preallocated_exts)/sizeof(preallocated_exts[0]))], src, buf));
+        bufs.push_back(buf);
+    }
+    ASSERT_TRUE(imencode(".bmp", Mat(10, 10, CV_8UC3, Scalar::all(1)), bufs[3]));
+    bufs[3].resize(20);  // truncated header
+    std::fill(bufs[5].begin(), bufs[5].end(), (uchar)0);  // unknown format
+    bufs[7].clear();
+
+    std::vector<Mat> dst;
+    std::vector<String> errors;
+    EXPECT_EQ(9, imdecodeBatch(bufs, IMREAD_COLOR, dst, errors));
+    ASSERT_EQ(bufs.size(), dst.size());
+    ASSERT_EQ(bufs.size(), errors.size());
+    for (size_t i = 0; i < bufs.size(); i++)
+    {
+        SCOPED_TRACE(cv::format("image %d", (int)i));
+        if (i == 3 || i == 5 || i == 7)
+        {
+            EXPECT_TRUE(dst[i].empty());
+            EXPECT_FALSE(errors[i].empty());
+            continue;
+        }
+        EXPECT_TRUE(errors[i].empty()) << errors[i];
+        EXPECT_EQ(0, cvtest::norm(imdecode(bufs[i], IMREAD_COLOR), dst[i], NORM_INF));
+    }
+
+    // decode into the slots of a batch tensor
+    std::vector<std::vector<uchar> > same(4, bufs[0]);
+    Mat ref = imdecode(bufs[0], IMREAD_GRAYSCALE);
+    const int sz[] = { 4, ref.rows, ref.cols };
+    Mat batch(3, sz, CV_8U, Scalar::all(0));
+    std::vector<Mat> slots;
+    for (int i = 0; i < 4; i++)
+        slots.push_back(Mat(ref.size(), CV_8UC1, batch.ptr(i)));
+    EXPECT_EQ(4, imdecodeBatch(same, IMREAD_GRAYSCALE, slots, errors));
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(batch.ptr(i), slots[i].data);
+        EXPECT_EQ(0, cvtest::norm(ref, slots[i], NORM_INF));
+    }
+}
+
+//==================================================================================================
+
+static std::vector<uchar> readFileBytes(const string& filename)
+{
+    std::ifstream ifs(filename.c_str(), std::ios::in | std::ios::binary);
+    return std::vector<uchar>((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+}
+
+/* < ext, TIFF tile width or 0 > */
+typedef testing::TestWithParam< tuple<Ext, int> > Imgcodecs_ImageWriter;
+
+static std::vector<int> imageWriterParams(int tile)
+{
+    std::vector<int> params;
+    if (tile > 0)
+    {
+        params.push_back(IMWRITE_TIFF_TILE_WIDTH);
+        params.push_back(tile);
+        params.push_back(IMWRITE_TIFF_TILE_HEIGHT);
+        params.push_back(tile / 2);
+    }
+    return params;
+}
+
+TEST_P(Imgcodecs_ImageWriter, strips_in_parallel)
+{
+    const string ext = get<0>(GetParam());
+    const std::vector<int> params = imageWriterParams(get<1>(GetParam()));
+    Mat src(203, 181, CV_8UC3);
+    randu(src, Scalar::all(0), Scalar::all(255));
+
+    const string ref_name = cv::tempfile(ext.c_str());
+    const string filename = cv::tempfile(ext.c_str());
+    ASSERT_TRUE(imwrite(ref_name, src, params));
+
+    const int strip = 24, nstrips = divUp(src.rows, strip);
+    std::vector<uchar> written(nstrips, 0);
+    const int nthreads = getNumThreads();
+    setNumThreads(4);
+    {
+        ImageWriter writer(filename, src.size(), src.type(), params);
+        ASSERT_TRUE(writer.isOpened());
+        // the strips are produced from bottom to top
+        parallel_for_(Range(0, nstrips), [&](const Range& range)
+        {
+            for (int i = range.start; i < range.end; i++)
+            {
+                const int y = (nstrips - 1 - i) * strip;
+                written[i] = writer.writeRows(src.rowRange(y, std::min(y + strip, src.rows)), y);
+            }
+        });
+        EXPECT_TRUE(writer.close());
+        EXPECT_FALSE(writer.isOpened());
+    }
+    setNumThreads(nthreads);
+    EXPECT_EQ(0, std::count(written.begin(), written.end(), 0));
+
+    // the same encoding as for the whole image
+    EXPECT_EQ(readFileBytes(ref_name), readFileBytes(filename));
+    Mat img = imread(filename, IMREAD_COLOR);
+    ASSERT_FALSE(img.empty());
+    if (ext != ".jpg")
+    {
+        EXPECT_EQ(0, cvtest::norm(src, img, NORM_INF));
+    }
+    EXPECT_EQ(0, remove(ref_name.c_str()));
+    EXPECT_EQ(0, remove(filename.c_str()));
+}
+
+TEST_P(Imgcodecs_ImageWriter, tiles_in_any_order)
+{
+    const string ext = get<0>(GetParam());
+    const int tile = get<1>(GetParam());
+    const std::vector<int> params = imageWriterParams(tile);
+    Mat src(150, 170, CV_16UC1);
+    randu(src, Scalar::all(0), Scalar::all(65535));
+
+    const string ref_name = cv::tempfile(ext.c_str());
+    const string filename = cv::tempfile(ext.c_str());
+    ASSERT_TRUE(imwrite(ref_name, src, params));
+
+    const Size tile_size = tile > 0 ? Size(tile, tile / 2) : Size(40, 25);
+    std::vector<Rect> tiles;
+    for (int y = 0; y < src.rows; y += tile_size.height)
+        for (int x = 0; x < src.cols; x += tile_size.width)
+            tiles.push_back(Rect(Point(x, y), tile_size) & Rect(Point(), src.size()));
+    cv::RNG& rng = theRNG();
+    for (size_t i = tiles.size() - 1; i > 0; i--)
+        std::swap(tiles[i], tiles[rng.uniform(0, (int)i + 1)]);
+
+    ImageWriter writer;
+    ASSERT_TRUE(writer.open(filename, src.size(), src.type(), params));
+    for (size_t i = 0; i < tiles.size(); i++)
+        ASSERT_TRUE(writer.writeTile(src(tiles[i]), tiles[i].tl()));
+    ASSERT_TRUE(writer.close());
+
+    // tiled TIFF stores the tiles in the order of arrival
+    if (tile == 0)
+    {
+        EXPECT_EQ(readFileBytes(ref_name), readFileBytes(filename));
+    }
+    Mat img = imread(filename, IMREAD_UNCHANGED);
+    ASSERT_FALSE(img.empty());
+    EXPECT_EQ(0, cvtest::norm(imread(ref_name, IMREAD_UNCHANGED), img, NORM_INF));
+    EXPECT_EQ(0, remove(ref_name.c_str()));
+    EXPECT_EQ(0, remove(filename.c_str()));
+}
+
+TEST_P(Imgcodecs_ImageWriter, incomplete_image_is_removed)
+{
+    const string ext = get<0>(GetParam());
+    const std::vector<int> params = imageWriterParams(get<1>(GetParam()));
+    const string filename = cv::tempfile(ext.c_str());
+
+    Mat src(64, 48, CV_8UC1, Scalar::all(3));
+    ImageWriter writer(filename, src.size(), src.type(), params);
+    ASSERT_TRUE(writer.isOpened());
+    EXPECT_TRUE(writer.writeRows(src.rowRange(0, 16)));
+    EXPECT_TRUE(writer.writeRows(src.rowRange(32, 48), 32));
+    EXPECT_ANY_THROW(writer.writeRows(src.rowRange(40, 56), 40));  // overlapping strips
+    EXPECT_ANY_THROW(writer.writeRows(Mat(8, 48, CV_8UC3)));       // wrong type
+    EXPECT_FALSE(writer.close());
+
+    std::ifstream ifs(filename.c_str());
+    EXPECT_FALSE(ifs.is_open());
+}
+
+TEST_P(Imgcodecs_ImageWriter, overlapping_tiles)
+{
+    const string ext = get<0>(GetParam());
+    const int tile = get<1>(GetParam());
+    const std::vector<int> params = imageWriterParams(tile);
+    const string filename = cv::tempfile(ext.c_str());
+
+    Mat src(64, 128, CV_8UC1, Scalar::all(3));
+    ImageWriter writer(filename, src.size(), src.type(), params);
+    ASSERT_TRUE(writer.isOpened());
+    const Size tile_size = tile > 0 ? Size(tile, tile / 2) : Size(32, 16);
+    const Rect first(Point(0, 0), tile_size);
+    EXPECT_TRUE(writer.writeTile(src(first), first.tl()));
+    EXPECT_ANY_THROW(writer.writeTile(src(first), first.tl()));  // the same tile
+    if (tile == 0)
+    {
+        const Rect shifted_x = first + Point(tile_size.width / 2, 0);
+        const Rect shifted_y = first + Point(0, tile_size.height / 2);
+        EXPECT_ANY_THROW(writer.writeTile(src(shifted_x), shifted_x.tl()));
+        EXPECT_ANY_THROW(writer.writeTile(src(shifted_y), shifted_y.tl()));
+    }
+    EXPECT_FALSE(writer.close());
+}
+
+// the producers which run ahead of the encoder wait for it instead of queueing the whole image
+TEST_P(Imgcodecs_ImageWriter, queue_limit)
+{
+    const string ext = get<0>(GetParam());
+    const std::vector<int> params = imageWriterParams(get<1>(GetParam()));
+    Mat src(203, 181, CV_8UC3);
+    randu(src, Scalar::all(0), Scalar::all(255));
+
+    const string ref_name = cv::tempfile(ext.c_str());
+    const string filename = cv::tempfile(ext.c_str());
+    ASSERT_TRUE(imwrite(ref_name, src, params));
+
+    const int strip = 8, nstrips = divUp(src.rows, strip);
+    std::vector<uchar> written(nstrips, 0);
+    const int nthreads = getNumThreads();
+    setNumThreads(4);
+#ifdef _WIN32
+    _putenv_s("OPENCV_IO_MAX_WRITER_QUEUE_SIZE", "1");
+#else
+    setenv("OPENCV_IO_MAX_WRITER_QUEUE_SIZE", "1", 1);
+#endif
+    {
+        ImageWriter writer(filename, src.size(), src.type(), params);
+        ASSERT_TRUE(writer.isOpened());
+        parallel_for_(Range(0, nstrips), [&](const Range& range)
+        {
+            for (int i = range.start; i < range.end; i++)
+            {
+                const int y = i * strip;
+                written[i] = writer.writeRows(src.rowRange(y, std::min(y + strip, src.rows)), y);
+            }
+        });
+        EXPECT_TRUE(writer.close());
+
+        // a single producer writing from bottom to top does not wait for itself
+        ImageWriter reversed(filename, src.size(), src.type(), params);
+        ASSERT_TRUE(reversed.isOpened());
+        for (int i = nstrips - 1; i >= 0; i--)
+            EXPECT_TRUE(reversed.writeRows(src.rowRange(i * strip, std::min((i + 1) * strip, src.rows)), i * strip));
+        EXPECT_TRUE(reversed.close());
+    }
+#ifdef _WIN32
+    _putenv_s("OPENCV_IO_MAX_WRITER_QUEUE_SIZE", "");
+#else
+    unsetenv("OPENCV_IO_MAX_WRITER_QUEUE_SIZE");
+#endif
+    setNumThreads(nthreads);
+    EXPECT_EQ(0, std::count(written.begin(), written.end(), 0));
+
+    EXPECT_EQ(readFileBytes(ref_name), readFileBytes(filename));
+    EXPECT_EQ(0, remove(ref_name.c_str()));
+    EXPECT_EQ(0, remove(filename.c_str()));
+}
+
+const tuple<Ext, int> image_writer_params[] = {
+#ifdef HAVE_JPEG
+    make_tuple(".jpg", 0),
+#endif
+#ifdef HAVE_PNG
+    make_tuple(".png", 0),
+#endif
+#ifdef HAVE_TIFF
+    make_tuple(".tiff", 0),
+    make_tuple(".tiff", 64),
+#endif
+};
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/, Imgcodecs_ImageWriter, testing::ValuesIn(image_writer_params));
+
+//==================================================================================================
+
 TEST(Imgcodecs_Image, write_umat)
 {
     const string src_name = TS::ptr()->get_data_path() + "../python/images/baboon.bmp";
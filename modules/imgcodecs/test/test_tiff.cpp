@@ -836,6 +836,25 @@ TEST(Imgcodecs_Tiff, read_palette_color_image_rgb_and_bgr)
     EXPECT_EQ(img_bgr.at<Vec3b>(32, 24), Vec3b(0, 0, 255));
 }
 
+TEST(Imgcodecs_Tiff, read_16bit_rgb_and_bgr)
+{
+    Mat src(31, 47, CV_16UC3);
+    randu(src, Scalar::all(0), Scalar::all(65535));
+    std::vector<uchar> buf;
+    ASSERT_TRUE(cv::imencode(".tiff", src, buf));
+
+    Mat img_bgr, img_rgb;
+    ASSERT_NO_THROW(img_bgr = cv::imdecode(buf, IMREAD_ANYDEPTH | IMREAD_COLOR_BGR));
+    ASSERT_NO_THROW(img_rgb = cv::imdecode(buf, IMREAD_ANYDEPTH | IMREAD_COLOR_RGB));
+    ASSERT_EQ(CV_16UC3, img_bgr.type());
+    ASSERT_EQ(CV_16UC3, img_rgb.type());
+    EXPECT_EQ(0, cvtest::norm(src, img_bgr, NORM_INF));
+
+    Mat src_rgb;
+    cvtColor(src, src_rgb, COLOR_BGR2RGB);
+    EXPECT_EQ(0, cvtest::norm(src_rgb, img_rgb, NORM_INF));
+}
+
 TEST(Imgcodecs_Tiff, read_4_bit_palette_color_image)
 {
     const string root = cvtest::TS::ptr()->get_data_path();
@@ -1300,6 +1319,36 @@ TEST(Imgcodecs_Tiff, read_bigtiff_images)
     }
 }
 
+TEST(Imgcodecs_Tiff, write_bigtiff_tiles)
+{
+    const string filename = cv::tempfile(".tiff");
+    Mat src(100, 120, CV_32FC1);
+    randu(src, Scalar::all(-1), Scalar::all(1));
+    const std::vector<int> params = { IMWRITE_TIFF_BIGTIFF, 1, IMWRITE_TIFF_TILE_WIDTH, 32 };
+
+    // whole image
+    ASSERT_TRUE(imwrite(filename, src, params));
+    Mat img = imread(filename, IMREAD_UNCHANGED);
+    EXPECT_EQ(0, cvtest::norm(src, img, NORM_INF));
+
+    // incrementally, by strips which do not match the tile rows
+    ImageWriter writer(filename, src.size(), src.type(), params);
+    ASSERT_TRUE(writer.isOpened());
+    for (int y = 0; y < src.rows; y += 10)
+        ASSERT_TRUE(writer.writeRows(src.rowRange(y, y + 10)));
+    ASSERT_TRUE(writer.close());
+
+    std::ifstream ifs(filename.c_str(), std::ios::in | std::ios::binary);
+    char signature[4] = {};
+    ifs.read(signature, 4);
+    ifs.close();
+    EXPECT_EQ(0, memcmp(signature, "II\x2b\x00", 4));
+
+    img = imread(filename, IMREAD_UNCHANGED);
+    EXPECT_EQ(0, cvtest::norm(src, img, NORM_INF));
+    EXPECT_EQ(0, remove(filename.c_str()));
+}
+
 #endif
 
 }} // namespace
@@ -1512,7 +1512,7 @@ In-place operation is supported.
 @note The median filter uses #BORDER_REPLICATE internally to cope with border pixels, see #BorderTypes
 
 @param src input 1-, 3-, or 4-channel image; when ksize is 3 or 5, the image depth should be
-CV_8U, CV_16U, or CV_32F, for larger aperture sizes, it can only be CV_8U.
+CV_8U, CV_16U, or CV_32F, for larger aperture sizes, it can be CV_8U or CV_16U (up to 255 for CV_16U).
 @param dst destination array of the same size and type as src.
 @param ksize aperture linear size; it must be odd and greater than 1, for example: 3, 5, 7 ...
 @sa  bilateralFilter, blur, boxFilter, GaussianBlur
@@ -1536,7 +1536,12 @@ respectively (see #getGaussianKernel for details); to fully control the result r
 possible future modifications of all this semantics, it is recommended to specify all of ksize,
 sigmaX, and sigmaY.
 @param borderType pixel extrapolation method, see #BorderTypes. #BORDER_WRAP is not supported.
-@param hint Implementation modfication flags. See #AlgorithmHint
+@param hint Implementation modfication flags. See #AlgorithmHint. With #ALGO_HINT_APPROX and
+both sigmas of 10 or more, the function may use a recursive (IIR) approximation of the Gaussian
+filter (Young - van Vliet), whose cost does not depend on sigma. It is used for images of any depth
+but CV_64F, when the aperture is not set smaller than 3*sigma, the border is not #BORDER_CONSTANT
+and the source is not a submatrix (or #BORDER_ISOLATED is set). The result differs from the
+separable filter by about 1 for 8-bit images.
 
 @sa  sepFilter2D, filter2D, blur, boxFilter, bilateralFilter, medianBlur
  */
@@ -1857,6 +1862,86 @@ CV_EXPORTS_W void Laplacian( InputArray src, OutputArray dst, int ddepth,
                              int ksize = 1, double scale = 1, double delta = 0,
                              int borderType = BORDER_DEFAULT );
 
+/** @brief Chain of filters, color conversions and per-element operations executed strip by strip.
+
+Calling a sequence of functions such as #cvtColor, #GaussianBlur, #Sobel and #threshold on a large image
+streams every intermediate image through the main memory. FilterPipeline runs the whole chain on horizontal
+strips instead: each strip is small enough for all its intermediate results to stay in the CPU cache, and the
+strips are processed in parallel. Every stage processes its strip together with the rows which are needed by
+the following filters, so the result is the same as the result of the separate calls:
+
+@code
+    FilterPipeline pipeline;
+    pipeline.cvtColor(COLOR_BGR2GRAY)
+            .GaussianBlur(Size(5, 5), 0)
+            .Sobel(CV_16S, 1, 0)
+            .convertScaleAbs()
+            .threshold(64, 255, THRESH_BINARY);
+    pipeline.apply(frame, edges);
+@endcode
+
+Only operations which preserve the image size are accepted, color conversions of planar YUV 4:2:0 formats and
+Bayer demosaicing are not supported. The source image is always processed as an isolated one, i.e. the pixels
+outside of its ROI are never used (see #BORDER_ISOLATED).
+
+The object may be shared between threads once the chain is built.
+ */
+class CV_EXPORTS FilterPipeline
+{
+public:
+    //! creates an empty pipeline
+    FilterPipeline();
+    ~FilterPipeline();
+
+    //! appends a stage equivalent to #cvtColor
+    FilterPipeline& cvtColor(int code, int dstCn = 0);
+    //! appends a stage equivalent to #GaussianBlur
+    FilterPipeline& GaussianBlur(Size ksize, double sigmaX, double sigmaY = 0,
+                                 int borderType = BORDER_DEFAULT);
+    //! appends a stage equivalent to #boxFilter
+    FilterPipeline& boxFilter(int ddepth, Size ksize, Point anchor = Point(-1,-1),
+                              bool normalize = true, int borderType = BORDER_DEFAULT);
+    //! appends a stage equivalent to #sepFilter2D
+    FilterPipeline& sepFilter2D(int ddepth, InputArray kernelX, InputArray kernelY,
+                                Point anchor = Point(-1,-1), double delta = 0,
+                                int borderType = BORDER_DEFAULT);
+    //! appends a stage equivalent to #Sobel (#FILTER_SCHARR aperture is supported)
+    FilterPipeline& Sobel(int ddepth, int dx, int dy, int ksize = 3,
+                          double scale = 1, double delta = 0, int borderType = BORDER_DEFAULT);
+    //! appends a stage equivalent to #threshold. #THRESH_OTSU and #THRESH_TRIANGLE are not supported.
+    FilterPipeline& threshold(double thresh, double maxval, int type);
+    //! appends a stage equivalent to Mat::convertTo. rtype is the output depth or -1 to keep the depth.
+    FilterPipeline& convertTo(int rtype, double alpha = 1, double beta = 0);
+    //! appends a stage equivalent to cv::convertScaleAbs
+    FilterPipeline& convertScaleAbs(double alpha = 1, double beta = 0);
+
+    /** @brief Sets number of output rows per strip.
+
+    Default value 0 selects the strip height automatically, so that the intermediate buffers of one strip take
+    about `OPENCV_FILTER_PIPELINE_STRIP_SIZE` bytes (1 MB by default).
+     */
+    void setStripRows(int rows);
+    int getStripRows() const;
+
+    //! returns the number of stages
+    size_t size() const;
+    bool empty() const;
+    //! removes all stages
+    void clear();
+
+    /** @brief Runs the chain.
+
+    @param src input image.
+    @param dst output image of the same size as src. Its type is defined by the last stage of the chain.
+    If the chain is empty, src is copied into dst.
+     */
+    void apply(InputArray src, OutputArray dst) const;
+
+    class Impl;
+protected:
+    Ptr<Impl> p;
+};
+
 //! @} imgproc_filter
 
 //! @addtogroup imgproc_feature
@@ -2420,6 +2505,22 @@ CV_EXPORTS_W void resize( InputArray src, OutputArray dst,
                           Size dsize, double fx = 0, double fy = 0,
                           int interpolation = INTER_LINEAR );
 
+/** @brief Resizes a batch of images.
+
+The function is equivalent to calling #resize for every image of the batch, but it is more efficient for
+many small images (e.g. crops of detected objects): the interpolation tables are computed once for every
+distinct pair of the source and destination sizes, and the images are distributed between the threads
+instead of the rows of every image.
+
+@param src input images.
+@param dst output images. dst[i] has the type of src[i] and the size dsize[i].
+@param dsize output image sizes: either a single size for all images or one size per image.
+@param interpolation interpolation method, see #InterpolationFlags
+@sa resize
+ */
+CV_EXPORTS_W void resizeBatch( InputArrayOfArrays src, OutputArrayOfArrays dst,
+                               const std::vector<Size>& dsize, int interpolation = INTER_LINEAR );
+
 /** @brief Applies an affine transformation to an image.
 
 The function warpAffine transforms the source image using the specified matrix:
@@ -2559,6 +2660,82 @@ CV_EXPORTS_W void convertMaps( InputArray map1, InputArray map2,
                                OutputArray dstmap1, OutputArray dstmap2,
                                int dstmap1type, bool nninterpolation = false );
 
+/** @brief Precomputed geometric transformation for repeated warping with the same parameters.
+
+The plan converts the transformation into the compact fixed-point maps used by #remap (CV_16SC2
+integer coordinates plus CV_16UC1 indices of interpolation coefficients, see #convertMaps) once, so
+each following call only runs the remapping, without coordinate computations. It is useful when
+the same perspective, affine or undistortion transform is applied to every frame of a camera:
+@code
+    WarpPlan plan;
+    plan.createPerspective(H, dsize, INTER_LINEAR);
+    for (...)
+        plan.apply(frame, warped); // the same as warpPerspective(frame, warped, H, dsize, INTER_LINEAR)
+@endcode
+The maps take 6 bytes per destination pixel (4 bytes for #INTER_NEAREST) instead of 8 bytes
+for floating-point maps. The plan can be shared by several threads once it is created.
+@sa warpAffine, warpPerspective, remap, convertMaps
+*/
+class CV_EXPORTS WarpPlan
+{
+public:
+    WarpPlan();
+    ~WarpPlan();
+
+    /** @brief Creates the plan for #warpAffine with the same parameters.
+    @param M \f$2\times 3\f$ transformation matrix.
+    @param dsize size of the output image, it must not be empty.
+    @param flags combination of interpolation methods (#INTER_NEAREST, #INTER_LINEAR, #INTER_CUBIC,
+    #INTER_LANCZOS4; #INTER_AREA is treated as #INTER_LINEAR) and the optional flag #WARP_INVERSE_MAP.
+    @param borderMode pixel extrapolation method (see #BorderTypes).
+    @param borderValue value used in case of a constant border.
+    */
+    void createAffine(InputArray M, Size dsize, int flags = INTER_LINEAR,
+                      int borderMode = BORDER_CONSTANT, const Scalar& borderValue = Scalar());
+
+    /** @brief Creates the plan for #warpPerspective with the same parameters.
+    @param M \f$3\times 3\f$ transformation matrix.
+    @param dsize size of the output image, it must not be empty.
+    @param flags see createAffine.
+    @param borderMode pixel extrapolation method (see #BorderTypes).
+    @param borderValue value used in case of a constant border.
+    */
+    void createPerspective(InputArray M, Size dsize, int flags = INTER_LINEAR,
+                           int borderMode = BORDER_CONSTANT, const Scalar& borderValue = Scalar());
+
+    /** @brief Creates the plan from arbitrary #remap maps, for example, undistortion maps.
+
+    Floating-point maps are converted by #convertMaps, so the result is the same as remap with
+    the converted maps.
+    @param map1 the first map, see #remap.
+    @param map2 the second map, see #remap.
+    @param interpolation interpolation method, see #remap.
+    @param borderMode pixel extrapolation method (see #BorderTypes).
+    @param borderValue value used in case of a constant border.
+    */
+    void createFromMaps(InputArray map1, InputArray map2, int interpolation,
+                        int borderMode = BORDER_CONSTANT, const Scalar& borderValue = Scalar());
+
+    /** @brief Applies the transformation.
+    @param src input image.
+    @param dst output image of size dstSize() and the same type as src.
+    */
+    void apply(InputArray src, OutputArray dst) const;
+
+    //! returns the fixed-point maps of the plan (map2 is empty for #INTER_NEAREST)
+    void getMaps(OutputArray map1, OutputArray map2) const;
+
+    //! returns the size of the output image
+    Size dstSize() const;
+
+    //! returns true if the plan has not been created
+    bool empty() const;
+
+    class Impl;
+protected:
+    Ptr<Impl> p;
+};
+
 /** @brief Calculates an affine matrix of 2D rotation.
 
 The function calculates the following matrix:
@@ -3249,6 +3426,52 @@ CV_EXPORTS_W void calcHist( InputArrayOfArrays images,
                             const std::vector<float>& ranges,
                             bool accumulate = false );
 
+/** @brief Calculates the histograms of sliding windows.
+
+The function computes the histogram of every window of size winSize placed at
+(wx\*stride.width, wy\*stride.height), wx, wy >= 0, inside the image. The histograms are the
+same as the ones computed by #calcHist with the same channels, histSize and ranges for every
+window separately, but the work is shared between the overlapping windows: the function keeps the
+histograms of the image columns over the current window rows, updates them with the rows entering
+and leaving the window when it moves down, and updates the window histogram with the columns
+entering and leaving the window when it moves right. So moving the window by one pixel costs
+O(histSize) operations independently of the window size. Use it for a small number of bins.
+
+@param src Source image, 8-bit or 16-bit unsigned, up to 3 channels.
+@param channels List of the channels used to compute the histogram, as in #calcHist. Empty vector
+means all the channels of src.
+@param histSize Array of histogram sizes in each dimension, up to 3 dimensions.
+@param ranges Uniform ranges, see the #calcHist overload taking std::vector arguments.
+@param winSize Window size.
+@param stride Horizontal and vertical distance between the neighbor windows.
+@param hists Output histograms, a CV_32F matrix with a row per window (row-major order of the
+windows). Every row is the dense histogram of #calcHist stored as a flat array.
+ */
+CV_EXPORTS_W void calcHistSliding( InputArray src, const std::vector<int>& channels,
+                                   const std::vector<int>& histSize, const std::vector<float>& ranges,
+                                   Size winSize, Size stride, OutputArray hists );
+
+/** @brief Calculates the integral histogram of an image.
+
+The integral histogram holds the histogram of every rectangle (0, 0, x, y) of the image, so the
+histogram of any rectangle is computed by four lookups, as the sum of pixels with #integral:
+\f[\texttt{hist} (r) = \texttt{ihist} (r.y + r.height, r.x + r.width) - \texttt{ihist} (r.y, r.x + r.width) - \texttt{ihist} (r.y + r.height, r.x) + \texttt{ihist} (r.y, r.x)\f]
+where every term is the flat histogram ihist(y, x, :). The rows of the integral histogram are
+computed in parallel and then accumulated vertically in parallel.
+
+@param src Source image, 8-bit or 16-bit unsigned, up to 3 channels.
+@param channels List of the channels used to compute the histogram, as in #calcHist. Empty vector
+means all the channels of src.
+@param histSize Array of histogram sizes in each dimension, up to 3 dimensions.
+@param ranges Uniform ranges, see the #calcHist overload taking std::vector arguments.
+@param ihist Output integral histogram, a 3-dimensional CV_32S matrix of the size
+(src.rows + 1) x (src.cols + 1) x N, where N is the product of histSize elements. The bins are
+stored in the order of the dense histogram of #calcHist.
+ */
+CV_EXPORTS_W void calcIntegralHist( InputArray src, const std::vector<int>& channels,
+                                    const std::vector<int>& histSize, const std::vector<float>& ranges,
+                                    OutputArray ihist );
+
 /** @brief Calculates the back projection of a histogram.
 
 The function cv::calcBackProject calculates the back project of the histogram. That is, similarly to
@@ -3753,6 +3976,64 @@ This function only supports YUV420 to RGB conversion as of now.
 */
 CV_EXPORTS_W void cvtColorTwoPlane( InputArray src1, InputArray src2, OutputArray dst, int code, AlgorithmHint hint = cv::ALGO_HINT_DEFAULT );
 
+/** @brief Converts an image from one color space to another and resizes it.
+
+The function is equivalent to
+@code
+    cvtColor(src, tmp, code, 0, hint);
+    resize(tmp, tmp, dsize, 0, 0, interpolation);
+    int depth = ddepth < 0 ? tmp.depth() : ddepth;
+    tmp.convertTo(tmp, depth == CV_64F ? CV_64F : CV_32F);
+    subtract(tmp, mean, tmp);
+    tmp.convertTo(dst, depth, scale);
+@endcode
+i.e. it computes (resized - mean)*scale, which is the usual preprocessing of the network input.
+When mean is zero the last three lines reduce to `tmp.convertTo(dst, depth, scale)`.
+For the YUV 4:2:0 sources (#COLOR_YUV2BGR_NV12, #COLOR_YUV2BGR_I420 and the like) and #INTER_LINEAR,
+#INTER_CUBIC or #INTER_LANCZOS4 interpolation the conversion is fused with the resize: the image is
+converted band by band, and every band is resized while it is still in cache. The full-size color
+image is never stored, so the memory traffic is several times lower. The fused path always uses the
+generic cvtColor and resize kernels, while the sequence above may be dispatched to HAL or IPP
+implementations, so the 8-bit results of the two may differ by 1. Other conversions and
+interpolation methods run the sequence above.
+
+@param src input image, see cvtColor.
+@param dst output image of the size dsize, the depth ddepth and the number of channels of the
+converted image.
+@param code color space conversion code (see #ColorConversionCodes).
+@param dsize output image size.
+@param interpolation interpolation method, see #InterpolationFlags.
+@param ddepth output image depth, -1 means the depth of the converted image.
+@param scale scale factor applied after subtracting mean.
+@param mean per-channel values subtracted from the resized image.
+@param hint Implementation modfication flags. See #AlgorithmHint
+
+@sa cvtColor, resize, cvtColorTwoPlaneResize
+ */
+CV_EXPORTS_W void cvtColorResize( InputArray src, OutputArray dst, int code, Size dsize,
+                                  int interpolation = INTER_LINEAR, int ddepth = -1, double scale = 1.0,
+                                  const Scalar& mean = Scalar(), AlgorithmHint hint = cv::ALGO_HINT_DEFAULT );
+
+/** @brief Converts an image stored in two planes from one color space to another and resizes it.
+
+Same as cvtColorResize for the source of cvtColorTwoPlane. The conversion is fused with the resize
+for #INTER_LINEAR, #INTER_CUBIC and #INTER_LANCZOS4 interpolation.
+
+@param src1 8-bit image (#CV_8U) of the Y plane.
+@param src2 image containing interleaved U/V plane.
+@param dst output image of the size dsize.
+@param code Specifies the type of conversion, see cvtColorTwoPlane.
+@param dsize output image size.
+@param interpolation interpolation method, see #InterpolationFlags.
+@param ddepth output image depth, -1 means #CV_8U.
+@param scale scale factor applied after subtracting mean.
+@param mean per-channel values subtracted from the resized image.
+@param hint Implementation modfication flags. See #AlgorithmHint
+*/
+CV_EXPORTS_W void cvtColorTwoPlaneResize( InputArray src1, InputArray src2, OutputArray dst, int code, Size dsize,
+                                          int interpolation = INTER_LINEAR, int ddepth = -1, double scale = 1.0,
+                                          const Scalar& mean = Scalar(), AlgorithmHint hint = cv::ALGO_HINT_DEFAULT );
+
 /** @brief main function for all demosaicing processes
 
 @param src input image: 8-bit unsigned or 16-bit unsigned.
@@ -3913,6 +4194,28 @@ is \f$W \times H\f$ and templ is \f$w \times h\f$ , then result is \f$(W-w+1) \t
 CV_EXPORTS_W void matchTemplate( InputArray image, InputArray templ,
                                  OutputArray result, int method, InputArray mask = noArray() );
 
+/** @brief Compares many templates against overlapped image regions.
+
+The function is equivalent to calling #matchTemplate for every template, but it is more efficient when
+many templates are searched in the same image: the spectra of the image tiles and the integral images
+used by the normalized methods are computed once and shared by all the templates, and the templates
+are distributed between the threads. The tiles are chosen for the largest template, so the results may
+differ from #matchTemplate within the floating-point accuracy.
+
+@param image Image where the search is running. It must be 8-bit or 32-bit floating-point.
+@param templs Searched templates. They can be of different sizes and must have the same data type as
+the image. Like in #matchTemplate, a template can be larger than the image in both dimensions: the roles
+of the image and the template are swapped for it.
+@param results Maps of comparison results, one single-channel 32-bit floating-point map per template.
+@param method Parameter specifying the comparison method, see #TemplateMatchModes
+@param masks Optional masks, either empty or one per template. Templates with non-empty masks (for
+example, sparse templates) are matched by #matchTemplate with the mask.
+@sa matchTemplate
+ */
+CV_EXPORTS_W void matchTemplateBatch( InputArray image, InputArrayOfArrays templs,
+                                      OutputArrayOfArrays results, int method,
+                                      InputArrayOfArrays masks = noArray() );
+
 //! @}
 
 //! @addtogroup imgproc_shape
@@ -3997,6 +4300,28 @@ CV_EXPORTS_W int connectedComponentsWithStats(InputArray image, OutputArray labe
                                               OutputArray stats, OutputArray centroids,
                                               int connectivity = 8, int ltype = CV_32S);
 
+/** @brief computes the statistics of the connected components of boolean image without producing the labeled image
+
+The output is the same as the stats and centroids outputs of #connectedComponentsWithStats called with the
+same connectivity and ccltype, including the order of the labels. The components are found with a run-based
+labeling that keeps only two rows of runs at a time and accumulates the statistics during the scan, so no
+label image is written. The image is split into horizontal stripes that are processed in parallel.
+#connectedComponentsWithStats falls back to this function when labels is not needed (e.g. noArray()).
+
+@param image the 8-bit single-channel image to be labeled
+@param stats statistics output for each label, including the background label.
+Statistics are accessed via stats(label, COLUMN) where COLUMN is one of
+#ConnectedComponentsTypes, selecting the statistic. The data type is CV_32S.
+@param centroids centroid output for each label, including the background label. Centroids are
+accessed via centroids(label, 0) for x and centroids(label, 1) for y. The data type CV_64F.
+@param connectivity 8 or 4 for 8-way or 4-way connectivity respectively
+@param ccltype connected components algorithm type (see #ConnectedComponentsAlgorithmsTypes), defines
+the order of the labels.
+@return N, the total number of labels [0, N-1] where 0 represents the background label.
+*/
+CV_EXPORTS_W int connectedComponentsStats(InputArray image, OutputArray stats, OutputArray centroids,
+                                          int connectivity = 8, int ccltype = CCL_DEFAULT);
+
 
 /** @brief Finds contours in a binary image.
 
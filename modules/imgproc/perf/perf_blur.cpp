@@ -33,6 +33,30 @@ PERF_TEST_P(Size_MatType_kSize, medianBlur,
     SANITY_CHECK(dst);
 }
 
+PERF_TEST_P(Size_MatType_kSize, medianBlur_large,
+            testing::Combine(
+                testing::Values(sz720p, sz1080p),
+                testing::Values(CV_8UC1, CV_16UC1),
+                testing::Values(7, 15, 31)
+                )
+            )
+{
+    Size size = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    int ksize = get<2>(GetParam());
+
+    Mat src(size, type);
+    Mat dst(size, type);
+
+    // depth-map like data: the value range is limited to 12 bits
+    randu(src, 0, CV_MAT_DEPTH(type) == CV_8U ? 256 : 4096);
+    declare.in(src).out(dst);
+
+    TEST_CYCLE() medianBlur(src, dst, ksize);
+
+    SANITY_CHECK_NOTHING();
+}
+
 CV_ENUM(BorderType3x3, BORDER_REPLICATE, BORDER_CONSTANT)
 CV_ENUM(BorderType, BORDER_REPLICATE, BORDER_CONSTANT, BORDER_REFLECT, BORDER_REFLECT101)
 
@@ -218,6 +242,33 @@ PERF_TEST_P(Size_MatType_BorderType, gaussianBlur5x5,
     SANITY_CHECK(dst, 1);
 }
 
+typedef tuple<Size, MatType, double, bool> Size_MatType_Sigma_Recursive_t;
+typedef perf::TestBaseWithParam<Size_MatType_Sigma_Recursive_t> Size_MatType_Sigma_Recursive;
+
+PERF_TEST_P(Size_MatType_Sigma_Recursive, gaussianBlur_largeSigma,
+            testing::Combine(
+                testing::Values(sz720p, sz1080p),
+                testing::Values(CV_8UC1, CV_8UC3, CV_32FC1),
+                testing::Values(10, 30, 100),
+                testing::Bool()
+                )
+            )
+{
+    Size size = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    double sigma = get<2>(GetParam());
+    AlgorithmHint hint = get<3>(GetParam()) ? ALGO_HINT_APPROX : ALGO_HINT_ACCURATE;
+
+    Mat src(size, type);
+    Mat dst(size, type);
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() GaussianBlur(src, dst, Size(), sigma, sigma, BORDER_DEFAULT, hint);
+
+    SANITY_CHECK_NOTHING();
+}
+
 PERF_TEST_P(Size_MatType_BorderType, blur5x5,
             testing::Combine(
                 testing::Values(szVGA, sz720p),
@@ -0,0 +1,77 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#include "perf_precomp.hpp"
+
+namespace opencv_test {
+
+CV_ENUM(CCLType, CCL_SAUF, CCL_BBDT, CCL_SPAGHETTI)
+
+static Mat makeBlobs(Size size)
+{
+    Mat noise(size, CV_8UC1), img;
+    RNG rng(0);
+    rng.fill(noise, RNG::UNIFORM, 0, 256);
+    blur(noise, noise, Size(9, 9));
+    cv::threshold(noise, img, 128, 255, THRESH_BINARY);
+    return img;
+}
+
+typedef tuple<Size, int, CCLType, MatDepth> Size_Conn_CCL_Depth_t;
+typedef perf::TestBaseWithParam<Size_Conn_CCL_Depth_t> Size_Conn_CCL_Depth;
+
+PERF_TEST_P(Size_Conn_CCL_Depth, connectedComponents,
+            testing::Combine(
+                testing::Values(sz1080p, sz2160p),
+                testing::Values(4, 8),
+                CCLType::all(),
+                testing::Values(CV_16U, CV_32S)
+                )
+            )
+{
+    Size size = get<0>(GetParam());
+    int connectivity = get<1>(GetParam());
+    int ccltype = get<2>(GetParam());
+    int ltype = get<3>(GetParam());
+
+    Mat img = makeBlobs(size), labels;
+    declare.in(img).out(labels);
+
+    TEST_CYCLE() connectedComponents(img, labels, connectivity, ltype, ccltype);
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef tuple<Size, int, CCLType, bool> Size_Conn_CCL_StatsOnly_t;
+typedef perf::TestBaseWithParam<Size_Conn_CCL_StatsOnly_t> Size_Conn_CCL_StatsOnly;
+
+PERF_TEST_P(Size_Conn_CCL_StatsOnly, connectedComponentsWithStats,
+            testing::Combine(
+                testing::Values(sz1080p, sz2160p),
+                testing::Values(4, 8),
+                CCLType::all(),
+                testing::Bool()
+                )
+            )
+{
+    Size size = get<0>(GetParam());
+    int connectivity = get<1>(GetParam());
+    int ccltype = get<2>(GetParam());
+    bool statsOnly = get<3>(GetParam());
+
+    Mat img = makeBlobs(size), labels, stats, centroids;
+    declare.in(img).out(stats, centroids);
+
+    if (statsOnly)
+    {
+        TEST_CYCLE() connectedComponentsStats(img, stats, centroids, connectivity, ccltype);
+    }
+    else
+    {
+        TEST_CYCLE() connectedComponentsWithStats(img, labels, stats, centroids, connectivity, CV_32S, ccltype);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+} // namespace
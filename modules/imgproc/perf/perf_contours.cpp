@@ -47,6 +47,50 @@ PERF_TEST_P(TestFindContours, findContours,
     SANITY_CHECK_NOTHING();
 }
 
+typedef TestBaseWithParam< tuple<RetrMode, ApproxMode, bool> > TestFindContours4K;
+
+// segmentation-like 4K masks: a few large blobs or noisy masks with many small regions
+PERF_TEST_P(TestFindContours4K, findContours_4K,
+            Combine(
+               RetrMode::all(), // retrieval mode
+               Values( (int)CHAIN_APPROX_NONE, (int)CHAIN_APPROX_SIMPLE, (int)CHAIN_APPROX_TC89_KCOS ),
+               testing::Bool() // noisy mask
+            )
+           )
+{
+    const Size img_size = sz2160p;
+    int retr_mode = get<0>(GetParam());
+    int approx_method = get<1>(GetParam());
+    bool noisy = get<2>(GetParam());
+
+    RNG rng;
+    Mat img = Mat::zeros(img_size, CV_8UC1);
+    if (noisy)
+    {
+        Mat noise(img_size, CV_8UC1), fimg;
+        rng.fill(noise, RNG::UNIFORM, 0, 256);
+        boxFilter(noise, fimg, CV_8U, Size(9, 9));
+        cv::threshold(fimg, img, 130, 255, THRESH_BINARY);
+    }
+    else
+    {
+        for (int i = 0; i < 64; i++)
+        {
+            Point center((unsigned)rng % (img.cols - 2), (unsigned)rng % (img.rows - 2));
+            Size axes(((unsigned)rng % 400 + 2)/2, ((unsigned)rng % 400 + 2)/2);
+            double angle = (unsigned)rng % 180;
+            int brightness = (unsigned)rng % 2;
+            ellipse(img(Rect(1, 1, img.cols - 2, img.rows - 2)), center, axes, angle, 0., 360., Scalar(brightness), -1);
+        }
+    }
+    vector< vector<Point> > contours;
+    vector<Vec4i> hierarchy;
+
+    TEST_CYCLE() findContours( img, contours, hierarchy, retr_mode, approx_method );
+
+    SANITY_CHECK_NOTHING();
+}
+
 typedef TestBaseWithParam< tuple<Size, ApproxMode, int> > TestFindContoursFF;
 
 PERF_TEST_P(TestFindContoursFF, findContours,
@@ -506,4 +506,51 @@ PERF_TEST_P(EdgeAwareDemosaicingTest, demosaicingEA,
     SANITY_CHECK(dst, 1);
 }
 
+CV_ENUM(CvtModeResize, COLOR_YUV2BGR_NV12, COLOR_YUV2BGR_IYUV)
+
+typedef tuple<Size, CvtModeResize, MatDepth, bool> Size_CvtModeResize_Depth_Fused_t;
+typedef perf::TestBaseWithParam<Size_CvtModeResize_Depth_Fused_t> Size_CvtModeResize_Depth_Fused;
+
+PERF_TEST_P(Size_CvtModeResize_Depth_Fused, cvtColorResize,
+            testing::Combine(
+                testing::Values(sz720p, sz1080p),
+                CvtModeResize::all(),
+                testing::Values(CV_8U, CV_32F),
+                testing::Bool()
+                )
+            )
+{
+    Size sz = get<0>(GetParam());
+    int mode = get<1>(GetParam());
+    int ddepth = get<2>(GetParam());
+    bool fused = get<3>(GetParam());
+    const Size dsize(640, 640);
+    const Scalar mean(104, 117, 123);
+    const double scale = 1./255;
+
+    Mat src(sz.height + sz.height / 2, sz.width, CV_8UC1);
+    Mat dst(dsize, CV_MAKETYPE(ddepth, 3));
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    if (fused)
+    {
+        TEST_CYCLE() cvtColorResize(src, dst, mode, dsize, INTER_LINEAR, ddepth, scale, mean);
+    }
+    else
+    {
+        Mat bgr, resized, tmp;
+        TEST_CYCLE()
+        {
+            cvtColor(src, bgr, mode);
+            resize(bgr, resized, dsize, 0, 0, INTER_LINEAR);
+            resized.convertTo(tmp, CV_32F);
+            subtract(tmp, mean, tmp);
+            tmp.convertTo(dst, ddepth, scale);
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
@@ -0,0 +1,90 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#include "perf_precomp.hpp"
+
+namespace opencv_test {
+
+typedef tuple<Size, bool> Size_Fused_t;
+typedef perf::TestBaseWithParam<Size_Fused_t> Size_Fused;
+
+// cvtColor -> GaussianBlur -> Sobel -> convertScaleAbs -> threshold
+PERF_TEST_P(Size_Fused, FilterPipeline_edges,
+            testing::Combine(
+                testing::Values(sz1080p, sz2160p, sz4320p),
+                testing::Bool()
+                )
+            )
+{
+    Size size = get<0>(GetParam());
+    bool fused = get<1>(GetParam());
+
+    Mat src(size, CV_8UC3), dst(size, CV_8UC1);
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    FilterPipeline pipeline;
+    pipeline.cvtColor(COLOR_BGR2GRAY)
+            .GaussianBlur(Size(5, 5), 0)
+            .Sobel(CV_16S, 1, 0)
+            .convertScaleAbs()
+            .threshold(64, 255, THRESH_BINARY);
+
+    Mat gray, blurred, grad, absGrad;
+    if (fused)
+    {
+        TEST_CYCLE() pipeline.apply(src, dst);
+    }
+    else
+    {
+        TEST_CYCLE()
+        {
+            cvtColor(src, gray, COLOR_BGR2GRAY);
+            GaussianBlur(gray, blurred, Size(5, 5), 0);
+            Sobel(blurred, grad, CV_16S, 1, 0);
+            convertScaleAbs(grad, absGrad);
+            cv::threshold(absGrad, dst, 64, 255, THRESH_BINARY);
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+// GaussianBlur -> sepFilter2D (float) -> convertTo on color images
+PERF_TEST_P(Size_Fused, FilterPipeline_smooth_float,
+            testing::Combine(
+                testing::Values(sz1080p, sz2160p),
+                testing::Bool()
+                )
+            )
+{
+    Size size = get<0>(GetParam());
+    bool fused = get<1>(GetParam());
+
+    Mat src(size, CV_8UC3), dst(size, CV_8UC3);
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    Mat kx = (Mat_<float>(1, 5) << 0.1f, 0.2f, 0.4f, 0.2f, 0.1f), ky = kx.t();
+    FilterPipeline pipeline;
+    pipeline.GaussianBlur(Size(3, 3), 0)
+            .sepFilter2D(CV_32F, kx, ky)
+            .convertTo(CV_8U, 1.5, -10);
+
+    Mat blurred, filtered;
+    if (fused)
+    {
+        TEST_CYCLE() pipeline.apply(src, dst);
+    }
+    else
+    {
+        TEST_CYCLE()
+        {
+            GaussianBlur(src, blurred, Size(3, 3), 0);
+            sepFilter2D(blurred, filtered, CV_32F, kx, ky);
+            filtered.convertTo(dst, CV_8U, 1.5, -10);
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+} // namespace
@@ -165,4 +165,89 @@ PERF_TEST_P(Sz_ClipLimit, CLAHE,
     SANITY_CHECK(dst);
 }
 
+typedef tuple<Size, MatType, bool> Sz_Type_Sliding_t;
+typedef TestBaseWithParam<Sz_Type_Sliding_t> Sz_Type_Sliding;
+
+PERF_TEST_P(Sz_Type_Sliding, calcHistSliding,
+            testing::Combine(testing::Values(::perf::szVGA, ::perf::sz720p),
+                             testing::Values(MatType(CV_8UC1), MatType(CV_8UC3), MatType(CV_16UC1)),
+                             testing::Bool())
+            )
+{
+    const Size size = get<0>(GetParam());
+    const int type = get<1>(GetParam());
+    const bool sliding = get<2>(GetParam());
+    const int cn = CV_MAT_CN(type);
+    const Size winSize(64, 64), stride(8, 8);
+
+    Mat src(size, type);
+    declare.in(src, WARMUP_RNG);
+
+    std::vector<int> channels, histSize;
+    std::vector<float> ranges;
+    for (int c = 0; c < cn; c++)
+    {
+        channels.push_back(c);
+        histSize.push_back(cn == 1 ? 32 : 8);
+        ranges.push_back(0.f);
+        ranges.push_back(CV_MAT_DEPTH(type) == CV_8U ? 256.f : 65536.f);
+    }
+
+    const int nx = (size.width - winSize.width)/stride.width + 1;
+    const int ny = (size.height - winSize.height)/stride.height + 1;
+    Mat hists;
+
+    if (sliding)
+    {
+        TEST_CYCLE() calcHistSliding(src, channels, histSize, ranges, winSize, stride, hists);
+    }
+    else
+    {
+        Mat hist;
+        std::vector<Mat> images(1);
+        TEST_CYCLE()
+        {
+            for (int wy = 0; wy < ny; wy++)
+                for (int wx = 0; wx < nx; wx++)
+                {
+                    images[0] = src(Rect(wx*stride.width, wy*stride.height, winSize.width, winSize.height));
+                    calcHist(images, channels, noArray(), hist, histSize, ranges);
+                }
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef tuple<Size, MatType> Sz_Type_t;
+typedef TestBaseWithParam<Sz_Type_t> Sz_Type;
+
+PERF_TEST_P(Sz_Type, calcIntegralHist,
+            testing::Combine(testing::Values(::perf::szVGA, ::perf::sz720p),
+                             testing::Values(MatType(CV_8UC1), MatType(CV_8UC3), MatType(CV_16UC1)))
+            )
+{
+    const Size size = get<0>(GetParam());
+    const int type = get<1>(GetParam());
+    const int cn = CV_MAT_CN(type);
+
+    Mat src(size, type);
+    declare.in(src, WARMUP_RNG);
+
+    std::vector<int> channels, histSize;
+    std::vector<float> ranges;
+    for (int c = 0; c < cn; c++)
+    {
+        channels.push_back(c);
+        histSize.push_back(cn == 1 ? 16 : 4);
+        ranges.push_back(0.f);
+        ranges.push_back(CV_MAT_DEPTH(type) == CV_8U ? 256.f : 65536.f);
+    }
+
+    Mat ihist;
+    TEST_CYCLE() calcIntegralHist(src, channels, histSize, ranges, ihist);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
@@ -81,4 +81,49 @@ PERF_TEST_P(ImgSize_TmplSize_Method, matchTemplateBig,
     SANITY_CHECK(result, eps);
 }
 
+typedef tuple<Size, int, MethodType, bool> ImgSize_TmplCount_Method_Batch_t;
+typedef perf::TestBaseWithParam<ImgSize_TmplCount_Method_Batch_t> ImgSize_TmplCount_Method_Batch;
+
+PERF_TEST_P(ImgSize_TmplCount_Method_Batch, matchTemplateBatch,
+            testing::Combine(
+                testing::Values(cv::Size(640, 480), cv::Size(1280, 720)),
+                testing::Values(16, 64),
+                testing::Values(TM_CCORR, TM_CCOEFF_NORMED),
+                testing::Bool()
+                )
+    )
+{
+    Size imgSz = get<0>(GetParam());
+    int count = get<1>(GetParam());
+    int method = get<2>(GetParam());
+    bool batch = get<3>(GetParam());
+
+    Mat img(imgSz, CV_8UC1);
+    std::vector<Mat> templs(count), results(count);
+    RNG& rng = theRNG();
+    rng.fill(img, RNG::UNIFORM, 0, 256);
+    for (int i = 0; i < count; i++)
+    {
+        templs[i].create(24 + i % 3 * 8, 32 - i % 2 * 8, CV_8UC1);
+        rng.fill(templs[i], RNG::UNIFORM, 0, 256);
+    }
+
+    declare.in(img).time(60);
+
+    if (batch)
+    {
+        TEST_CYCLE() matchTemplateBatch(img, templs, results, method);
+    }
+    else
+    {
+        TEST_CYCLE()
+        {
+            for (int i = 0; i < count; i++)
+                matchTemplate(img, templs[i], results[i], method);
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
@@ -280,4 +280,47 @@ PERF_TEST_P(MatInfo_Size_Scale_NN, ResizeNNExact,
     SANITY_CHECK_NOTHING();
 }
 
+typedef tuple<MatType, int, bool> MatType_Interp_Batch_t;
+typedef perf::TestBaseWithParam<MatType_Interp_Batch_t> MatType_Interp_Batch;
+
+// 256 crops of 64x64 are resized to 224x224 (typical classifier input)
+PERF_TEST_P(MatType_Interp_Batch, ResizeBatch,
+    testing::Combine(
+        testing::Values(CV_8UC3, CV_32FC3),
+        testing::Values((int)INTER_LINEAR, (int)INTER_CUBIC, (int)INTER_AREA),
+        testing::Bool()
+    )
+)
+{
+    int matType = get<0>(GetParam());
+    int interpolation = get<1>(GetParam());
+    bool batch = get<2>(GetParam());
+
+    const int count = 256;
+    const Size from(64, 64), to(224, 224);
+    std::vector<Mat> src(count), dst(count);
+    for (int i = 0; i < count; i++)
+    {
+        src[i].create(from, matType);
+        dst[i].create(to, matType);
+        declare.in(src[i], WARMUP_RNG);
+    }
+    std::vector<Size> sizes(1, to);
+
+    if (batch)
+    {
+        TEST_CYCLE() resizeBatch(src, dst, sizes, interpolation);
+    }
+    else
+    {
+        TEST_CYCLE()
+        {
+            for (int i = 0; i < count; i++)
+                resize(src[i], dst[i], to, 0, 0, interpolation);
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
@@ -192,6 +192,52 @@ PERF_TEST_P( TestWarpPerspectiveNear_t, WarpPerspectiveNear,
     SANITY_CHECK(dst, 1);
 }
 
+typedef TestBaseWithParam< tuple<MatType, Size, InterType, bool> > TestWarpPlan;
+
+PERF_TEST_P( TestWarpPlan, WarpPerspective_plan,
+             Combine(
+                 Values( CV_8UC1, CV_8UC3 ),
+                 Values( sz720p, sz1080p ),
+                 InterType::all(),
+                 testing::Bool()
+                 )
+             )
+{
+    int type       = get<0>(GetParam());
+    Size size      = get<1>(GetParam());
+    int interType  = get<2>(GetParam());
+    bool usePlan   = get<3>(GetParam());
+
+    Mat src(size, type), dst(size, type);
+    cvtest::fillGradient(src);
+    int shift = static_cast<int>(src.cols*0.04);
+    Mat srcVertices = (Mat_<Vec2f>(1, 4) << Vec2f(0, 0),
+                                            Vec2f(static_cast<float>(size.width-1), 0),
+                                            Vec2f(static_cast<float>(size.width-1), static_cast<float>(size.height-1)),
+                                            Vec2f(0, static_cast<float>(size.height-1)));
+    Mat dstVertices = (Mat_<Vec2f>(1, 4) << Vec2f(0, static_cast<float>(shift)),
+                                            Vec2f(static_cast<float>(size.width-shift/2), 0),
+                                            Vec2f(static_cast<float>(size.width-shift), static_cast<float>(size.height-shift)),
+                                            Vec2f(static_cast<float>(shift/2), static_cast<float>(size.height-1)));
+    Mat warpMat = getPerspectiveTransform(srcVertices, dstVertices);
+
+    WarpPlan plan;
+    plan.createPerspective(warpMat, size, interType);
+
+    declare.in(src).out(dst);
+
+    if (usePlan)
+    {
+        TEST_CYCLE() plan.apply(src, dst);
+    }
+    else
+    {
+        TEST_CYCLE() warpPerspective(src, dst, warpMat, size, interType);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 PERF_TEST_P( TestRemap, remap,
              Combine(
                  Values( CV_8UC1, CV_8UC3, CV_8UC4, CV_32FC1 ),
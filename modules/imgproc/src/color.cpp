@@ -185,6 +185,95 @@ void cvtColorTwoPlane( InputArray _ysrc, InputArray _uvsrc, OutputArray _dst, in
 }
 
 
+// color conversion fused with resize
+
+void cvtColorResize( InputArray _src, OutputArray _dst, int code, Size dsize, int interpolation,
+                     int ddepth, double scale, const Scalar& mean, AlgorithmHint hint )
+{
+    CV_INSTRUMENT_REGION();
+
+    if (hint == cv::ALGO_HINT_DEFAULT)
+        hint = cv::getDefaultAlgorithmHint();
+
+    CV_Assert(!_src.empty() && !dsize.empty());
+
+    // the source may be overwritten by the destination
+    Mat src = _src.getMat();
+
+    switch (code)
+    {
+        case COLOR_YUV2BGR_NV21:  case COLOR_YUV2RGB_NV21:  case COLOR_YUV2BGR_NV12:  case COLOR_YUV2RGB_NV12:
+        case COLOR_YUV2BGRA_NV21: case COLOR_YUV2RGBA_NV21: case COLOR_YUV2BGRA_NV12: case COLOR_YUV2RGBA_NV12:
+            if (src.type() == CV_8UC1 && src.rows % 3 == 0 && src.cols % 2 == 0 && (src.rows*2/3) % 2 == 0)
+            {
+                const int height = src.rows*2/3;
+                Mat ysrc = src.rowRange(0, height);
+                Mat uvsrc(height/2, src.cols/2, CV_8UC2, src.ptr(height), src.step);
+                if (cvtColorTwoPlaneYUV2BGRResize(ysrc, uvsrc, _dst, dsize, interpolation, ddepth, scale, mean, hint,
+                                                  dstChannels(code), swapBlue(code), uIndex(code)))
+                    return;
+            }
+            break;
+
+        case COLOR_YUV2BGR_YV12: case COLOR_YUV2RGB_YV12: case COLOR_YUV2BGRA_YV12: case COLOR_YUV2RGBA_YV12:
+        case COLOR_YUV2BGR_IYUV: case COLOR_YUV2RGB_IYUV: case COLOR_YUV2BGRA_IYUV: case COLOR_YUV2RGBA_IYUV:
+            if (src.type() == CV_8UC1 && src.rows % 3 == 0 && src.cols % 2 == 0 && (src.rows*2/3) % 2 == 0)
+            {
+                if (cvtColorThreePlaneYUV2BGRResize(src, _dst, dsize, interpolation, ddepth, scale, mean,
+                                                    dstChannels(code), swapBlue(code), uIndex(code)))
+                    return;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    Mat converted, resized;
+    cvtColor(src, converted, code, 0, hint);
+    resize(converted, resized, dsize, 0, 0, interpolation);
+    _dst.create(dsize, CV_MAKETYPE(ddepth < 0 ? resized.depth() : ddepth, resized.channels()));
+    Mat dst = _dst.getMat();
+    normalizeResized(resized, dst, scale, mean);
+}
+
+void cvtColorTwoPlaneResize( InputArray _ysrc, InputArray _uvsrc, OutputArray _dst, int code, Size dsize, int interpolation,
+                             int ddepth, double scale, const Scalar& mean, AlgorithmHint hint )
+{
+    CV_INSTRUMENT_REGION();
+
+    if (hint == cv::ALGO_HINT_DEFAULT)
+        hint = cv::getDefaultAlgorithmHint();
+
+    // only YUV420 is currently supported
+    switch (code)
+    {
+        case COLOR_YUV2BGR_NV21:  case COLOR_YUV2RGB_NV21:  case COLOR_YUV2BGR_NV12:  case COLOR_YUV2RGB_NV12:
+        case COLOR_YUV2BGRA_NV21: case COLOR_YUV2RGBA_NV21: case COLOR_YUV2BGRA_NV12: case COLOR_YUV2RGBA_NV12:
+            break;
+        default:
+            CV_Error( cv::Error::StsBadFlag, "Unknown/unsupported color conversion code" );
+            return;
+    }
+
+    CV_Assert(!_ysrc.empty() && !dsize.empty());
+
+    // the sources may be overwritten by the destination
+    Mat ysrc = _ysrc.getMat(), uvsrc = _uvsrc.getMat();
+
+    if (cvtColorTwoPlaneYUV2BGRResize(ysrc, uvsrc, _dst, dsize, interpolation, ddepth, scale, mean, hint,
+                                      dstChannels(code), swapBlue(code), uIndex(code)))
+        return;
+
+    Mat converted, resized;
+    cvtColorTwoPlane(ysrc, uvsrc, converted, code, hint);
+    resize(converted, resized, dsize, 0, 0, interpolation);
+    _dst.create(dsize, CV_MAKETYPE(ddepth < 0 ? resized.depth() : ddepth, resized.channels()));
+    Mat dst = _dst.getMat();
+    normalizeResized(resized, dst, scale, mean);
+}
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 //                                   The main function                                  //
 //////////////////////////////////////////////////////////////////////////////////////////
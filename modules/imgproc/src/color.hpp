@@ -563,7 +563,13 @@ void cvtColorOnePlaneYUV2BGR( InputArray _src, OutputArray _dst, AlgorithmHint h
 void cvtColorOnePlaneBGR2YUV( InputArray _src, OutputArray _dst, AlgorithmHint hint, bool swapb, int uidx, int ycn );
 void cvtColorTwoPlaneYUV2BGR( InputArray _src, OutputArray _dst, AlgorithmHint hint, int dcn, bool swapb, int uidx );
 void cvtColorTwoPlaneYUV2BGRpair( InputArray _ysrc, InputArray _uvsrc, OutputArray _dst, AlgorithmHint hint, int dcn, bool swapb, int uidx );
+bool cvtColorTwoPlaneYUV2BGRResize( InputArray _ysrc, InputArray _uvsrc, OutputArray _dst, Size dsize, int interpolation,
+                                    int ddepth, double scale, const Scalar& mean, AlgorithmHint hint,
+                                    int dcn, bool swapb, int uidx );
 void cvtColorThreePlaneYUV2BGR( InputArray _src, OutputArray _dst, AlgorithmHint hint, int dcn, bool swapb, int uidx );
+bool cvtColorThreePlaneYUV2BGRResize( InputArray _src, OutputArray _dst, Size dsize, int interpolation, int ddepth,
+                                      double scale, const Scalar& mean, int dcn, bool swapb, int uidx );
+void normalizeResized( const Mat& src, Mat& dst, double scale, const Scalar& mean );
 void cvtColorBGR2ThreePlaneYUV( InputArray _src, OutputArray _dst, AlgorithmHint hint, bool swapb, int uidx );
 void cvtColorYUV2Gray_420( InputArray _src, OutputArray _dst );
 void cvtColorYUV2Gray_ch( InputArray _src, OutputArray _dst, int coi );
@@ -6,6 +6,7 @@
 #include "opencl_kernels_imgproc.hpp"
 
 #include "color.hpp"
+#include "resize.hpp"
 
 #include "color_yuv.simd.hpp"
 #include "color_yuv.simd_declarations.hpp" // defines CV_CPU_DISPATCH_MODES_ALL=AVX2,...,BASELINE based on CMakeLists.txt content
@@ -204,6 +205,17 @@ void cvtThreePlaneYUVtoBGR(const uchar * src_data, size_t src_step,
         CV_CPU_DISPATCH_MODES_ALL);
 }
 
+// band of rows of a 4:2:0 three-plane image, used by the fused conversion + resize
+static void cvtThreePlaneYUVtoBGRBand(const uchar * y_data, const uchar * u_data, const uchar * v_data, size_t src_step,
+                                      int ustepIdx, int vstepIdx,
+                                      uchar * dst_data, size_t dst_step,
+                                      int dst_width, int dst_height,
+                                      int dcn, bool swapBlue)
+{
+    CV_CPU_DISPATCH(cvtThreePlaneYUVtoBGRBand, (y_data, u_data, v_data, src_step, ustepIdx, vstepIdx, dst_data, dst_step, dst_width, dst_height, dcn, swapBlue),
+        CV_CPU_DISPATCH_MODES_ALL);
+}
+
 // 4:2:0, three planes in one array: Y, U, V
 // Y : [16, 235]; Cb, Cr: [16, 240] centered at 128
 // 20-bit fixed-point arithmetics
@@ -554,4 +566,144 @@ void cvtColorTwoPlaneYUV2BGRpair( InputArray _ysrc, InputArray _uvsrc, OutputArr
     }
 }
 
+
+//
+// 4:2:0 to BGR conversion fused with resize, see cvtColorResize()
+//
+
+namespace {
+
+class YUV420toBGRBandSource : public ResizeBandSource
+{
+public:
+    // two planes: Y, UV interleaved
+    YUV420toBGRBandSource(const Mat& _ysrc, const Mat& _uvsrc, AlgorithmHint _hint, int _dcn, bool _swapb, int _uidx) :
+        ysrc(_ysrc), uvsrc(_uvsrc), u(0), v(0), twoPlanes(true), hint(_hint), dcn(_dcn), swapb(_swapb), uidx(_uidx),
+        ustepIdx(0), vstepIdx(0)
+    {
+    }
+
+    // three planes in one array: Y, U, V
+    YUV420toBGRBandSource(const Mat& src, int _dcn, bool _swapb, int _uidx) :
+        twoPlanes(false), hint(ALGO_HINT_DEFAULT), dcn(_dcn), swapb(_swapb), uidx(_uidx)
+    {
+        const int height = src.rows*2/3;
+        ysrc = src.rowRange(0, height);
+        // same layout of the chroma planes as in hal::cvtThreePlaneYUVtoBGR()
+        u = src.ptr(height);
+        v = src.ptr(height + height/4) + (src.cols/2)*((height % 4)/2);
+        ustepIdx = 0;
+        vstepIdx = height % 4 == 2 ? 1 : 0;
+        if (uidx == 1) { std::swap(u, v), std::swap(ustepIdx, vstepIdx); }
+    }
+
+    void getBand(int y, Mat& band) const CV_OVERRIDE
+    {
+        CV_DbgAssert(y % 2 == 0 && band.rows % 2 == 0);
+        if (twoPlanes)
+        {
+            hal::cvtTwoPlaneYUVtoBGR(ysrc.ptr(y), ysrc.step, uvsrc.ptr(y/2), uvsrc.step,
+                                     band.data, band.step, band.cols, band.rows,
+                                     dcn, swapb, uidx, hint);
+        }
+        else
+        {
+            // every row of the source holds two chroma rows of the same plane
+            const int p = y/2;
+            const size_t uvsteps[2] = { (size_t)ysrc.cols/2, ysrc.step - ysrc.cols/2 };
+            hal::cvtThreePlaneYUVtoBGRBand(ysrc.ptr(y), u + (p/2)*ysrc.step + (p%2)*uvsteps[ustepIdx],
+                                           v + (p/2)*ysrc.step + (p%2)*uvsteps[vstepIdx], ysrc.step,
+                                           (ustepIdx + p) & 1, (vstepIdx + p) & 1,
+                                           band.data, band.step, band.cols, band.rows, dcn, swapb);
+        }
+    }
+
+    int rowAlignment() const CV_OVERRIDE { return 2; }
+
+private:
+    Mat ysrc, uvsrc;
+    const uchar *u, *v;
+    bool twoPlanes;
+    AlgorithmHint hint;
+    int dcn;
+    bool swapb;
+    int uidx, ustepIdx, vstepIdx;
+};
+
+class NormalizeBandSink : public ResizeBandSink
+{
+public:
+    NormalizeBandSink(const Mat& _dst, double _scale, const Scalar& _mean) :
+        dst(_dst), scale(_scale), mean(_mean)
+    {
+    }
+
+    void putBand(int y, const Mat& band) const CV_OVERRIDE
+    {
+        Mat dstBand = dst.rowRange(y, y + band.rows);
+        normalizeResized(band, dstBand, scale, mean);
+    }
+
+private:
+    Mat dst;
+    double scale;
+    Scalar mean;
+};
+
+static bool cvtColorYUV420toBGRResize( const ResizeBandSource& source, Size ssize, int dcn, Size dsize, int interpolation,
+                                       OutputArray _dst, int ddepth, double scale, const Scalar& mean )
+{
+    const int type = CV_MAKETYPE(CV_8U, dcn);
+    _dst.create(dsize, CV_MAKETYPE(ddepth < 0 ? CV_8U : ddepth, dcn));
+    NormalizeBandSink sink(_dst.getMat(), scale, mean);
+    return resizeBands(source, ssize, type, dsize, interpolation, sink);
+}
+
+} // namespace
+
+void normalizeResized( const Mat& src, Mat& dst, double scale, const Scalar& mean )
+{
+    const int ddepth = dst.depth();
+    if (mean == Scalar())
+    {
+        src.convertTo(dst, ddepth, scale);
+        return;
+    }
+    // (src - mean)*scale is computed in floating point and rounded to ddepth once
+    const int wdepth = ddepth == CV_64F ? CV_64F : CV_32F;
+    Mat buf;
+    Mat& tmp = ddepth == wdepth ? dst : buf;
+    src.convertTo(tmp, wdepth);
+    subtract(tmp, mean, tmp);
+    tmp.convertTo(dst, ddepth, scale);
+}
+
+bool cvtColorThreePlaneYUV2BGRResize( InputArray _src, OutputArray _dst, Size dsize, int interpolation, int ddepth,
+                                      double scale, const Scalar& mean, int dcn, bool swapb, int uidx )
+{
+    if(dcn <= 0) dcn = 3;
+    CV_Assert( dcn == 3 || dcn == 4 );
+    CV_Assert( _src.type() == CV_8UC1 && _src.rows() % 3 == 0 && _src.cols() % 2 == 0 && (_src.rows()*2/3) % 2 == 0 );
+
+    Mat src = _src.getMat();
+    Size ssize(src.cols, src.rows*2/3);
+    YUV420toBGRBandSource source(src, dcn, swapb, uidx);
+    return cvtColorYUV420toBGRResize(source, ssize, dcn, dsize, interpolation, _dst, ddepth, scale, mean);
+}
+
+bool cvtColorTwoPlaneYUV2BGRResize( InputArray _ysrc, InputArray _uvsrc, OutputArray _dst, Size dsize, int interpolation,
+                                    int ddepth, double scale, const Scalar& mean, AlgorithmHint hint,
+                                    int dcn, bool swapb, int uidx )
+{
+    if(dcn <= 0) dcn = 3;
+    Size ysz = _ysrc.size(), uvs = _uvsrc.size();
+    CV_Assert( dcn == 3 || dcn == 4 );
+    CV_Assert( _ysrc.type() == CV_8UC1 );
+    CV_Assert( ysz.width == uvs.width * 2 && ysz.height == uvs.height * 2 );
+
+    Mat ysrc = _ysrc.getMat(), uvsrc = _uvsrc.getMat();
+    YUV420toBGRBandSource source(ysrc, uvsrc, hint, dcn, swapb, uidx);
+    return cvtColorYUV420toBGRResize(source, ysz, dcn, dsize, interpolation, _dst, ddepth, scale, mean);
+}
+
 } // namespace cv
@@ -25,6 +25,11 @@ void cvtThreePlaneYUVtoBGR(const uchar * src_data, size_t src_step,
                            uchar * dst_data, size_t dst_step,
                            int dst_width, int dst_height,
                            int dcn, bool swapBlue, int uIdx);
+void cvtThreePlaneYUVtoBGRBand(const uchar * y_data, const uchar * u_data, const uchar * v_data, size_t src_step,
+                               int ustepIdx, int vstepIdx,
+                               uchar * dst_data, size_t dst_step,
+                               int dst_width, int dst_height,
+                               int dcn, bool swapBlue);
 void cvtBGRtoThreePlaneYUV(const uchar * src_data, size_t src_step,
                            uchar * dst_data, size_t dst_step,
                            int width, int height,
@@ -2071,6 +2076,19 @@ void cvtThreePlaneYUVtoBGR(const uchar * src_data, size_t src_step,
     int vstepIdx = dst_height % 4 == 2 ? 1 : 0;
 
     if(uIdx == 1) { std::swap(u ,v), std::swap(ustepIdx, vstepIdx); }
+
+    cvtThreePlaneYUVtoBGRBand(src_data, u, v, src_step, ustepIdx, vstepIdx,
+                              dst_data, dst_step, dst_width, dst_height, dcn, swapBlue);
+}
+
+// Same as above for a band of rows of the image, the chroma rows of the band start
+// at u_data and v_data, the alternation of their steps is given by ustepIdx and vstepIdx
+void cvtThreePlaneYUVtoBGRBand(const uchar * y_data, const uchar * u_data, const uchar * v_data, size_t src_step,
+                               int ustepIdx, int vstepIdx,
+                               uchar * dst_data, size_t dst_step,
+                               int dst_width, int dst_height,
+                               int dcn, bool swapBlue)
+{
     int blueIdx = swapBlue ? 2 : 0;
 
     cvt_3plane_yuv_ptr_t cvtPtr;
@@ -2083,7 +2101,7 @@ void cvtThreePlaneYUVtoBGR(const uchar * src_data, size_t src_step,
     default: CV_Error( cv::Error::StsBadFlag, "Unknown/unsupported color conversion code" ); break;
     };
 
-    cvtPtr(dst_data, dst_step, dst_width, dst_height, src_step, src_data, u, v, ustepIdx, vstepIdx);
+    cvtPtr(dst_data, dst_step, dst_width, dst_height, src_step, y_data, u_data, v_data, ustepIdx, vstepIdx);
 }
 
 // 4:2:0, three planes in one array: Y, U, V
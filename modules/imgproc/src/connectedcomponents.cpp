@@ -48,6 +48,7 @@
 //
 #include "precomp.hpp"
 #include <vector>
+#include "opencv2/core/hal/intrin.hpp"
 
 namespace cv{
     namespace connectedcomponents{
@@ -5614,8 +5615,297 @@ namespace cv{
 
         }   //End function LabelingGrana operator()
     };//End struct LabelingGrana
+
+
+    //Run-based labeling that keeps only the runs of two consecutive rows instead of the labels image.
+    //Statistics are accumulated for the provisional labels during the scan and merged after it,
+    //the final labels are ordered in the same way as the given labeling algorithm orders them:
+    //by the first pixel in raster order (SAUF and 4-way Spaghetti) or by the first 2x2 block (BBDT and 8-way Spaghetti).
+    struct LabelingRunsStats
+    {
+        struct Run
+        {
+            int start, end; // [start, end)
+            int label;
+        };
+
+        struct LabelStats
+        {
+            int left, top, right, bottom;
+            int area;
+            uint64 sumx, sumy;
+            int64 key;
+
+            void add(int y, int start, int end, int64 runKey)
+            {
+                const int len = end - start;
+                left = MIN(left, start);
+                right = MAX(right, end - 1);
+                top = MIN(top, y);
+                bottom = MAX(bottom, y);
+                area += len;
+                sumx += (uint64)(start + end - 1) * (uint64)len / 2;
+                sumy += (uint64)y * (uint64)len;
+                key = MIN(key, runKey);
+            }
+
+            void merge(const LabelStats& s)
+            {
+                left = MIN(left, s.left);
+                right = MAX(right, s.right);
+                top = MIN(top, s.top);
+                bottom = MAX(bottom, s.bottom);
+                area += s.area;
+                sumx += s.sumx;
+                sumy += s.sumy;
+                key = MIN(key, s.key);
+            }
+
+            static LabelStats empty()
+            {
+                LabelStats s = { INT_MAX, INT_MAX, INT_MIN, INT_MIN, 0, 0, 0, std::numeric_limits<int64>::max() };
+                return s;
+            }
+        };
+
+        struct StripeResult
+        {
+            std::vector<int> P;
+            std::vector<LabelStats> stats;
+            std::vector<Run> firstRow, lastRow;
+            LabelStats background;
+        };
+
+        static inline int findRoot(std::vector<int>& P, int i)
+        {
+            while (P[i] != i)
+            {
+                P[i] = P[P[i]];
+                i = P[i];
+            }
+            return i;
+        }
+
+        static inline int setUnion(std::vector<int>& P, int i, int j)
+        {
+            i = findRoot(P, i);
+            j = findRoot(P, j);
+            if (i < j)
+                P[j] = i;
+            else if (j < i)
+                P[i] = j;
+            return MIN(i, j);
+        }
+
+        static inline int findNonZero(const uchar* row, int x, int w)
+        {
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+            const v_uint8 v_zero = vx_setzero_u8();
+            for (; x <= w - VTraits<v_uint8>::vlanes(); x += VTraits<v_uint8>::vlanes())
+            {
+                v_uint8 vmask = v_ne(vx_load(row + x), v_zero);
+                if (v_check_any(vmask))
+                    return x + v_scan_forward(vmask);
+            }
+#endif
+            for (; x < w && !row[x]; ++x)
+                ;
+            return x;
+        }
+
+        static inline int findZero(const uchar* row, int x, int w)
+        {
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+            const v_uint8 v_zero = vx_setzero_u8();
+            for (; x <= w - VTraits<v_uint8>::vlanes(); x += VTraits<v_uint8>::vlanes())
+            {
+                v_uint8 vmask = v_eq(vx_load(row + x), v_zero);
+                if (v_check_any(vmask))
+                    return x + v_scan_forward(vmask);
+            }
+#endif
+            for (; x < w && row[x]; ++x)
+                ;
+            return x;
+        }
+
+        class StripeScan : public cv::ParallelLoopBody
+        {
+        public:
+            StripeScan(const cv::Mat& img_, int connectivity_, bool blockOrder_, int nStripes_, StripeResult* results_) :
+                img(img_), connectivity(connectivity_), blockOrder(blockOrder_), nStripes(nStripes_), results(results_)
+            {
+            }
+
+            void operator()(const cv::Range& range) const CV_OVERRIDE
+            {
+                const int h = img.rows, w = img.cols;
+                const int d = connectivity == 8 ? 1 : 0;
+                std::vector<Run> prevRuns, curRuns;
+                for (int s = range.start; s < range.end; ++s)
+                {
+                    const int r0 = (int)((int64)s * h / nStripes), r1 = (int)((int64)(s + 1) * h / nStripes);
+                    StripeResult& res = results[s];
+                    std::vector<int>& P = res.P;
+                    std::vector<LabelStats>& stats = res.stats;
+                    LabelStats& bg = res.background;
+                    bg = LabelStats::empty();
+                    prevRuns.clear();
+
+                    for (int y = r0; y < r1; ++y)
+                    {
+                        const uchar* row = img.ptr<uchar>(y);
+                        curRuns.clear();
+                        size_t p = 0;
+                        int fgArea = 0;
+                        uint64 fgSumX = 0;
+                        int firstZero = -1, lastZero = -1;
+                        int x = 0;
+                        for (;;)
+                        {
+                            const int start = findNonZero(row, x, w);
+                            if (start > x)
+                            {
+                                if (firstZero < 0)
+                                    firstZero = x;
+                                lastZero = start - 1;
+                            }
+                            if (start >= w)
+                                break;
+                            const int end = findZero(row, start + 1, w);
+
+                            int label = -1;
+                            while (p < prevRuns.size() && prevRuns[p].end <= start - d)
+                                ++p;
+                            for (size_t q = p; q < prevRuns.size() && prevRuns[q].start < end + d; ++q)
+                                label = label < 0 ? findRoot(P, prevRuns[q].label) : setUnion(P, label, prevRuns[q].label);
+                            if (label < 0)
+                            {
+                                label = (int)P.size();
+                                P.push_back(label);
+                                stats.push_back(LabelStats::empty());
+                            }
+
+                            const int64 key = blockOrder ? (int64)(y >> 1) * w + (start >> 1) : (int64)y * w + start;
+                            stats[label].add(y, start, end, key);
+                            Run run = { start, end, label };
+                            curRuns.push_back(run);
+                            fgArea += end - start;
+                            fgSumX += (uint64)(start + end - 1) * (uint64)(end - start) / 2;
+                            x = end;
+                        }
+
+                        if (fgArea < w)
+                        {
+                            bg.left = MIN(bg.left, firstZero);
+                            bg.right = MAX(bg.right, lastZero);
+                            bg.top = MIN(bg.top, y);
+                            bg.bottom = MAX(bg.bottom, y);
+                            bg.area += w - fgArea;
+                            bg.sumx += (uint64)w * (uint64)(w - 1) / 2 - fgSumX;
+                            bg.sumy += (uint64)y * (uint64)(w - fgArea);
+                        }
+
+                        if (y == r0)
+                            res.firstRow = curRuns;
+                        std::swap(prevRuns, curRuns);
+                    }
+                    res.lastRow = prevRuns;
+                }
+            }
+
+        private:
+            const cv::Mat& img;
+            int connectivity;
+            bool blockOrder;
+            int nStripes;
+            StripeResult* results;
+        };
+
+        int operator()(const cv::Mat& img, int connectivity, bool blockOrder, int nStripes, CCStatsOp& sop)
+        {
+            const int d = connectivity == 8 ? 1 : 0;
+            std::vector<StripeResult> results(nStripes);
+            cv::parallel_for_(cv::Range(0, nStripes), StripeScan(img, connectivity, blockOrder, nStripes, results.data()), nStripes);
+
+            //Join provisional labels of all stripes
+            std::vector<int> offsets(nStripes + 1, 0);
+            for (int s = 0; s < nStripes; ++s)
+                offsets[s + 1] = offsets[s] + (int)results[s].P.size();
+            const int total = offsets[nStripes];
+            std::vector<int> P(total);
+            for (int s = 0; s < nStripes; ++s)
+                for (size_t i = 0; i < results[s].P.size(); ++i)
+                    P[offsets[s] + i] = offsets[s] + results[s].P[i];
+
+            for (int s = 1; s < nStripes; ++s)
+            {
+                const std::vector<Run>& prevRuns = results[s - 1].lastRow;
+                const std::vector<Run>& curRuns = results[s].firstRow;
+                size_t p = 0;
+                for (size_t i = 0; i < curRuns.size(); ++i)
+                {
+                    const Run& run = curRuns[i];
+                    while (p < prevRuns.size() && prevRuns[p].end <= run.start - d)
+                        ++p;
+                    for (size_t q = p; q < prevRuns.size() && prevRuns[q].start < run.end + d; ++q)
+                        setUnion(P, offsets[s] + run.label, offsets[s - 1] + prevRuns[q].label);
+                }
+            }
+
+            //Merge statistics into the roots and order the components
+            std::vector<LabelStats> stats(total);
+            for (int s = 0; s < nStripes; ++s)
+                std::copy(results[s].stats.begin(), results[s].stats.end(), stats.begin() + offsets[s]);
+            std::vector<std::pair<int64, int> > roots;
+            for (int l = 0; l < total; ++l)
+            {
+                const int root = findRoot(P, l);
+                if (root == l)
+                    roots.push_back(std::make_pair((int64)0, l));
+                else
+                    stats[root].merge(stats[l]);
+            }
+            for (size_t i = 0; i < roots.size(); ++i)
+                roots[i].first = stats[roots[i].second].key;
+            std::sort(roots.begin(), roots.end());
+
+            LabelStats bg = LabelStats::empty();
+            for (int s = 0; s < nStripes; ++s)
+                bg.merge(results[s].background);
+
+            const int nLabels = (int)roots.size() + 1;
+            sop.init(nLabels);
+            for (int l = 0; l < nLabels; ++l)
+            {
+                const LabelStats& st = l == 0 ? bg : stats[roots[l - 1].second];
+                if (st.area == 0)
+                    continue;
+                int *row = sop.statsv.ptr<int>(l);
+                row[CC_STAT_LEFT] = st.left;
+                row[CC_STAT_TOP] = st.top;
+                row[CC_STAT_WIDTH] = st.right;
+                row[CC_STAT_HEIGHT] = st.bottom;
+                row[CC_STAT_AREA] = st.area;
+                sop.integrals[l] = Point2ui64(st.sumx, st.sumy);
+            }
+            sop.finish();
+            return nLabels;
+        }
+    };//End struct LabelingRunsStats
     }//end namespace connectedcomponents
 
+    //Parallel algorithms number the provisional labels by stripe and these numbers do not fit in 16 bits,
+    //so the image is labeled with CV_32S and converted afterwards
+    template<typename Labeling, typename StatsOp>
+    static
+    int connectedComponentsParallel16U(const cv::Mat& I, cv::Mat& L, int connectivity, StatsOp& sop){
+        cv::Mat L32(L.size(), CV_32S);
+        const int nLabels = (int)Labeling()(I, L32, connectivity, sop);
+        L32.convertTo(L, CV_16U);
+        return nLabels;
+    }
+
     //L's type must have an appropriate depth for the number of pixels in I
     template<typename StatsOp>
     static
@@ -5643,7 +5933,10 @@ namespace cv{
                 //Not supported yet
             }
             else if (lDepth == CV_16U){
-                return (int)LabelingWu<ushort, uchar, StatsOp>()(I, L, connectivity, sop);
+                if (!is_parallel)
+                    return (int)LabelingWu<ushort, uchar, StatsOp>()(I, L, connectivity, sop);
+                else
+                    return connectedComponentsParallel16U<LabelingWuParallel<int, uchar, StatsOp> >(I, L, connectivity, sop);
             }
             else if (lDepth == CV_32S){
                 //note that signed types don't really make sense here and not being able to use unsigned matters for scientific projects
@@ -5663,7 +5956,10 @@ namespace cv{
                 //Not supported yet
             }
             else if (lDepth == CV_16U){
-                return (int)LabelingGrana<ushort, uchar, StatsOp>()(I, L, connectivity, sop);
+                if (!is_parallel)
+                    return (int)LabelingGrana<ushort, uchar, StatsOp>()(I, L, connectivity, sop);
+                else
+                    return connectedComponentsParallel16U<LabelingGranaParallel<int, uchar, StatsOp> >(I, L, connectivity, sop);
             }
             else if (lDepth == CV_32S){
                 //note that signed types don't really make sense here and not being able to use unsigned matters for scientific projects
@@ -5684,7 +5980,10 @@ namespace cv{
                     //Not supported yet
                 }
                 else if (lDepth == CV_16U) {
-                    return (int)LabelingBolelli<ushort, uchar, StatsOp>()(I, L, connectivity, sop);
+                    if (!is_parallel)
+                        return (int)LabelingBolelli<ushort, uchar, StatsOp>()(I, L, connectivity, sop);
+                    else
+                        return connectedComponentsParallel16U<LabelingBolelliParallel<int, uchar, StatsOp> >(I, L, connectivity, sop);
                 }
                 else if (lDepth == CV_32S) {
                     //note that signed types don't really make sense here and not being able to use unsigned matters for scientific projects
@@ -5703,7 +6002,10 @@ namespace cv{
                     //Not supported yet
                 }
                 else if (lDepth == CV_16U) {
-                    return (int)LabelingBolelli4C<ushort, uchar, StatsOp>()(I, L, connectivity, sop);
+                    if (!is_parallel)
+                        return (int)LabelingBolelli4C<ushort, uchar, StatsOp>()(I, L, connectivity, sop);
+                    else
+                        return connectedComponentsParallel16U<LabelingBolelli4CParallel<int, uchar, StatsOp> >(I, L, connectivity, sop);
                 }
                 else if (lDepth == CV_32S) {
                     //note that signed types don't really make sense here and not being able to use unsigned matters for scientific projects
@@ -5752,6 +6054,9 @@ int cv::connectedComponentsWithStats(InputArray img_, OutputArray _labels, Outpu
 int cv::connectedComponentsWithStats(InputArray img_, OutputArray _labels, OutputArray statsv,
     OutputArray centroids, int connectivity, int ltype, int ccltype)
 {
+    if (!_labels.needed())
+        return cv::connectedComponentsStats(img_, statsv, centroids, connectivity, ccltype);
+
     const cv::Mat img = img_.getMat();
     _labels.create(img.size(), CV_MAT_DEPTH(ltype));
     cv::Mat labels = _labels.getMat();
@@ -5767,3 +6072,22 @@ int cv::connectedComponentsWithStats(InputArray img_, OutputArray _labels, Outpu
         return 0;
     }
 }
+
+int cv::connectedComponentsStats(InputArray img_, OutputArray statsv, OutputArray centroids, int connectivity, int ccltype)
+{
+    const cv::Mat img = img_.getMat();
+    CV_Assert(img.channels() == 1 && (img.depth() == CV_8U || img.depth() == CV_8S));
+    CV_Assert(connectivity == 8 || connectivity == 4);
+    CV_Assert(ccltype == CCL_SPAGHETTI || ccltype == CCL_BBDT || ccltype == CCL_SAUF || ccltype == CCL_BOLELLI || ccltype == CCL_GRANA || ccltype == CCL_WU || ccltype == CCL_DEFAULT);
+
+    //Labels are numbered as connectedComponentsWithStats numbers them: block-based algorithms
+    //(8-way BBDT and Spaghetti) order the components by their first 2x2 block, the others by their first pixel
+    const bool blockOrder = connectivity == 8 && ccltype != CCL_SAUF && ccltype != CCL_WU;
+
+    const int nThreads = cv::getNumThreads();
+    const bool is_parallel = cv::currentParallelFramework() != NULL && nThreads > 1 && img.rows / nThreads >= 2;
+    const int nStripes = is_parallel ? std::min(img.rows, nThreads * 4) : 1;
+
+    connectedcomponents::CCStatsOp sop(statsv, centroids);
+    return connectedcomponents::LabelingRunsStats()(img, connectivity, blockOrder, nStripes, sop);
+}
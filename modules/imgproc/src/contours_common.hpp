@@ -40,13 +40,11 @@ public:
     // 1st linked list - bidirectional - sibling children
     int prev;
     int next;
-    // 2nd linked list - unidirectional - not related to 1st list
-    int ctable_next;
     T body;
 
 public:
     TreeNode(int self) :
-        self_(self), parent(-1), first_child(-1), prev(-1), next(-1), ctable_next(-1)
+        self_(self), parent(-1), first_child(-1), prev(-1), next(-1)
     {
         CV_Assert(self >= 0);
     }
@@ -96,14 +96,19 @@ struct Trait<int>
 
 namespace {
 
+// Border pixels visited when following the contour, sorted by position. The visited path only
+// depends on pixel labels, which are not changed by the contour marks, so it is traced
+// once per contour and reused for all subsequent end points.
+// Each item is (offset << 4) | (direction + 1), direction -1 marks a single pixel domain.
 template <typename T>
-static bool icvTraceContour(Mat& image, const Point& start, const Point& end, bool isHole)
+static void icvTraceContourPath(Mat& image, const Point& start, bool isHole, vector<int64>& path)
 {
-    const T* stop_ptr = image.ptr<T>(end.y, end.x);
+    const T* base = image.ptr<T>();
     const size_t step = image.step1();
     const T *i0 = image.ptr<T>(start.y, start.x), *i1, *i3, *i4 = NULL;
     const schar s_end = isHole ? 0 : 4;
 
+    path.clear();
     schar s = s_end;
     do
     {
@@ -120,39 +125,16 @@ static bool icvTraceContour(Mat& image, const Point& start, const Point& end, bo
         // follow border
         for (;;)
         {
-            CV_Assert(i3 != NULL);
             s = clamp_direction(s);
             while (s < MAX_SIZE - 1)
             {
                 ++s;
                 i4 = i3 + getDelta(s, step);
-                CV_Assert(i4 != NULL);
                 if (Trait<T>::checkValue(i4, i0))
                     break;
             }
 
-            if (i3 == stop_ptr)
-            {
-                if (!Trait<T>::isRight(i3, i0))
-                {
-                    // it's the only contour
-                    return true;
-                }
-
-                // check if this is the last contour
-                // encountered during a raster scan
-                const T* i5;
-                schar t = s;
-                while (true)
-                {
-                    t = (t - 1) & 7;
-                    i5 = i3 + getDelta(t, step);
-                    if (*i5 != 0)
-                        break;
-                    if (t == 0)
-                        return true;
-                }
-            }
+            path.push_back(((int64)(i3 - base) << 4) | (s + 1));
 
             if ((i4 == i0 && i3 == i1))
                 break;
@@ -160,12 +142,44 @@ static bool icvTraceContour(Mat& image, const Point& start, const Point& end, bo
             i3 = i4;
             s = (s + 4) & 7;
         }  // end of border following loop
+        std::sort(path.begin(), path.end());
     }
     else
     {
-        return i3 == stop_ptr;
+        path.push_back((int64)(i3 - base) << 4);
     }
+}
 
+// Checks if the end point belongs to the contour and the contour is the last one
+// encountered at this point during a raster scan
+template <typename T>
+static bool icvCheckContourPath(Mat& image, const vector<int64>& path, const Point& start, const Point& end)
+{
+    const T* base = image.ptr<T>();
+    const size_t step = image.step1();
+    const T* i0 = image.ptr<T>(start.y, start.x);
+    const T* stop_ptr = image.ptr<T>(end.y, end.x);
+    const int64 key = (int64)(stop_ptr - base) << 4;
+
+    for (vector<int64>::const_iterator it = std::lower_bound(path.begin(), path.end(), key);
+         it != path.end() && *it < key + 16; ++it)
+    {
+        const int s = (int)(*it & 15) - 1;
+        if (s < 0 || !Trait<T>::isRight(stop_ptr, i0))
+            return true;
+
+        // check if this is the last contour
+        // encountered during a raster scan
+        schar t = (schar)s;
+        while (true)
+        {
+            t = (t - 1) & 7;
+            if (*(stop_ptr + getDelta(t, step)) != 0)
+                break;
+            if (t == 0)
+                return true;
+        }
+    }
     return false;
 }
 
@@ -290,7 +304,14 @@ struct ContourScanner_
     int approx_method2;  // final approx method
     int mode;
     CTree tree;
-    array<int, 128> ctable;
+    struct CTableItem
+    {
+        Rect brect;
+        int node;  // tree element
+    };
+    array<vector<CTableItem>, 128> ctable;  // contours grouped by their mark, in creation order
+    vector<int> approx_queue;  // contours waiting for TC89 approximation
+    vector<vector<int64> > trace_paths;  // cached border paths, see icvTraceContourPath
 
 public:
     ContourScanner_() {}
@@ -309,6 +330,7 @@ public:
     int findFirstBoundingContour(const Point& last_pos, const int y, const int lval, int par);
     int findNextX(int x, int y, int& prev, int& p);
     bool findNext();
+    void approximateChains();
 
     static shared_ptr<ContourScanner_> create(Mat img, int mode, int method, Point offset);
 };  // class ContourScanner_
@@ -353,7 +375,6 @@ shared_ptr<ContourScanner_> ContourScanner_::create(Mat img, int mode, int metho
     CV_Assert(root.self() == 0);
     root.body.isHole = true;
     root.body.brect = Rect(Point(0, 0), size);
-    scanner->ctable.fill(-1);
     scanner->approx_method2 = scanner->approx_method1 = method;
     if (method == CHAIN_APPROX_TC89_L1 || method == CHAIN_APPROX_TC89_KCOS)
         scanner->approx_method1 = CV_CHAIN_CODE;
@@ -369,9 +390,9 @@ CNode& ContourScanner_::makeContour(schar& nbd_, const bool is_hole, const int x
 
     CNode& res = tree.newElem();
     if (isChain)
-        res.body.codes.reserve(200);
+        res.body.codes.reserve(16);
     else
-        res.body.pts.reserve(200);
+        res.body.pts.reserve(16);
     res.body.isHole = is_hole;
     res.body.isChain = isChain;
     res.body.origin = start_pt + offset;
@@ -399,20 +420,62 @@ CNode& ContourScanner_::makeContour(schar& nbd_, const bool is_hole, const int x
         }
         res.body.brect.x -= this->offset.x;
         res.body.brect.y -= this->offset.y;
-        res.ctable_next = this->ctable[lval];
-        this->ctable[lval] = res.self();
+        CTableItem item = {res.body.brect, res.self()};
+        this->ctable[lval].push_back(item);
     }
-    const Point prev_origin = res.body.origin;
     res.body.origin = start_pt;
     if (this->approx_method1 != this->approx_method2)
     {
+        // chain is approximated after the scan, see approximateChains
         CV_Assert(res.body.isChain);
-        res.body.pts = approximateChainTC89(res.body.codes, prev_origin, this->approx_method2);
-        res.body.isChain = false;
+        approx_queue.push_back(res.self());
     }
     return res;
 }
 
+namespace {
+
+class ChainApproxInvoker : public ParallelLoopBody
+{
+public:
+    ChainApproxInvoker(CTree& tree_, const vector<int>& queue_, const Point& offset_, int method_) :
+        tree(tree_), queue(queue_), offset(offset_), method(method_)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        for (int i = range.start; i < range.end; ++i)
+        {
+            Contour& body = tree.elem(queue[i]).body;
+            body.pts = approximateChainTC89(body.codes, body.origin + offset, method);
+            body.isChain = false;
+            vector<schar>().swap(body.codes);
+        }
+    }
+
+private:
+    CTree& tree;
+    const vector<int>& queue;
+    Point offset;
+    int method;
+};
+
+}  // namespace
+
+void ContourScanner_::approximateChains()
+{
+    if (approx_queue.empty())
+        return;
+    size_t total = 0;
+    for (size_t i = 0; i < approx_queue.size(); ++i)
+        total += tree.elem(approx_queue[i]).body.codes.size();
+    // contours are independent, so they are approximated in parallel once all of them are traced
+    ChainApproxInvoker invoker(tree, approx_queue, offset, approx_method2);
+    parallel_for_(Range(0, (int)approx_queue.size()), invoker, total / (double)(1 << 14));
+    approx_queue.clear();
+}
+
 bool ContourScanner_::contourScan(const int prev, int& p, Point& last_pos, const int x, const int y)
 {
     bool is_hole = false;
@@ -516,32 +579,39 @@ int ContourScanner_::findFirstBoundingContour(const Point& last_pos,
 {
     const Point end_point(last_pos.x, y);
     int res = par;
-    int cur = ctable[lval];
-    while (cur != -1)
+    const vector<CTableItem>& items = ctable[lval];
+    // the most recent contours go first
+    for (size_t i = items.size(); i-- > 0;)
     {
-        CNode& cur_elem = tree.elem(cur);
-        if (((last_pos.x - cur_elem.body.brect.x) < cur_elem.body.brect.width) &&
-            ((last_pos.y - cur_elem.body.brect.y) < cur_elem.body.brect.height))
+        const CTableItem& cur_item = items[i];
+        if (((last_pos.x - cur_item.brect.x) < cur_item.brect.width) &&
+            ((last_pos.y - cur_item.brect.y) < cur_item.brect.height))
         {
             if (res != -1)
             {
                 CNode& res_elem = tree.elem(res);
                 const Point origin = res_elem.body.origin;
                 const bool isHole = res_elem.body.isHole;
+                if (trace_paths.size() <= (size_t)res)
+                    trace_paths.resize(res + 1);
+                vector<int64>& path = trace_paths[res];
                 if (isInt())
                 {
-                    if (icvTraceContour<int>(this->image, origin, end_point, isHole))
+                    if (path.empty())
+                        icvTraceContourPath<int>(this->image, origin, isHole, path);
+                    if (icvCheckContourPath<int>(this->image, path, origin, end_point))
                         break;
                 }
                 else
                 {
-                    if (icvTraceContour<schar>(this->image, origin, end_point, isHole))
+                    if (path.empty())
+                        icvTraceContourPath<schar>(this->image, origin, isHole, path);
+                    if (icvCheckContourPath<schar>(this->image, path, origin, end_point))
                         break;
                 }
             }
-            res = cur;
+            res = cur_item.node;
         }
-        cur = cur_elem.ctable_next;
     }
     return res;
 }
@@ -551,6 +621,24 @@ int ContourScanner_::findNextX(int x, int y, int& prev, int& p)
     const int width = this->image.size().width - 1;
     if (isInt())
     {
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+        // 'prev' is always the pixel to the left of 'x' here, so labels are compared
+        // with the left neighbours directly
+        const int* row = this->image.ptr<int>(y);
+        const v_int32 v_mask = vx_setall_s32(MASK_VAL);
+        const int x0 = x;
+        for (; x <= width - VTraits<v_int32>::vlanes(); x += VTraits<v_int32>::vlanes())
+        {
+            v_int32 vmask = v_ne(v_and(vx_load(row + x), v_mask), v_and(vx_load(row + x - 1), v_mask));
+            if (v_check_any(vmask))
+            {
+                x += v_scan_forward(vmask);
+                break;
+            }
+        }
+        if (x > x0)
+            prev = row[x - 1];
+#endif
         for (; x < width &&
                ((p = this->image.at<int>(y, x)) == prev || (p & MASK_VAL) == (prev & MASK_VAL));
              x++)
@@ -625,6 +713,47 @@ bool ContourScanner_::findNext()
 
 //==============================================================================
 
+namespace {
+
+// Same as copyMakeBorder with 1px zero border followed by threshold(0, 1, THRESH_BINARY),
+// but done in one parallel pass
+class BinarizeWithBorderInvoker : public ParallelLoopBody
+{
+public:
+    BinarizeWithBorderInvoker(const Mat& src_, Mat& dst_) : src(src_), dst(dst_) {}
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        const int width = src.cols;
+        for (int y = range.start; y < range.end; ++y)
+        {
+            uchar* d = dst.ptr<uchar>(y);
+            if (y == 0 || y == dst.rows - 1)
+            {
+                memset(d, 0, width + 2);
+                continue;
+            }
+            const uchar* s = src.ptr<uchar>(y - 1);
+            d[0] = d[width + 1] = 0;
+            d++;
+            int x = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+            const v_uint8 v_one = vx_setall_u8(1);
+            for (; x <= width - VTraits<v_uint8>::vlanes(); x += VTraits<v_uint8>::vlanes())
+                v_store(d + x, v_min(vx_load(s + x), v_one));
+#endif
+            for (; x < width; ++x)
+                d[x] = s[x] != 0;
+        }
+    }
+
+private:
+    const Mat& src;
+    Mat& dst;
+};
+
+}  // namespace
+
 void cv::findContours(InputArray _image,
                       OutputArrayOfArrays _contours,
                       OutputArray _hierarchy,
@@ -673,15 +802,26 @@ void cv::findContours(InputArray _image,
 
     // preprocess
     Mat image;
-    copyMakeBorder(_image, image, 1, 1, 1, 1, BORDER_CONSTANT | BORDER_ISOLATED, Scalar(0));
-    if (image.type() != CV_32SC1)
-        threshold(image, image, 0, 1, THRESH_BINARY);
+    if (_image.type() == CV_8UC1)
+    {
+        Mat src = _image.getMat();
+        image.create(src.rows + 2, src.cols + 2, CV_8UC1);
+        BinarizeWithBorderInvoker invoker(src, image);
+        parallel_for_(Range(0, image.rows), invoker, image.total() / (double)(1 << 16));
+    }
+    else
+    {
+        copyMakeBorder(_image, image, 1, 1, 1, 1, BORDER_CONSTANT | BORDER_ISOLATED, Scalar(0));
+        if (image.type() != CV_32SC1)
+            threshold(image, image, 0, 1, THRESH_BINARY);
+    }
 
     // find contours
     ContourScanner scanner = ContourScanner_::create(image, mode, method, offset + Point(-1, -1));
     while (scanner->findNext())
     {
     }
+    scanner->approximateChains();
 
     contourTreeToResults(scanner->tree, res_type, _contours, _hierarchy);
 }
@@ -64,6 +64,8 @@ bool ocl_sepFilter2D_BitExact(
 
 void preprocess2DKernel(const Mat& kernel, std::vector<Point>& coords, std::vector<uchar>& coeffs);
 
+void GaussianBlurRecursive(const Mat& src, Mat& dst, double sigmaX, double sigmaY, int borderType);
+
 }  // namespace
 
 #endif
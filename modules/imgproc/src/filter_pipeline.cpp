@@ -0,0 +1,409 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "opencv2/core/utils/configuration.private.hpp"
+
+/*
+ FilterPipeline splits the image into horizontal strips and runs the whole chain on each strip.
+ Every stage is applied to an isolated image made of the rows it needs, so the same (bit-exact)
+ code paths as in the standalone functions are used. Rows near the strip boundaries are affected by
+ the extrapolated border of such isolated image: stage with `top`/`bottom` rows of vertical aperture
+ produces valid output for its input range shrunk by `top` and `bottom` rows. The input ranges are
+ selected backwards from the output strip, so only valid rows reach the destination image.
+*/
+
+namespace cv
+{
+
+namespace
+{
+
+class PipelineStage
+{
+public:
+    PipelineStage(int top_ = 0, int bottom_ = 0) : top(top_), bottom(bottom_) {}
+    virtual ~PipelineStage() {}
+    //! src and dst have the same number of rows, dst is preallocated (except the probing)
+    virtual void apply(const Mat& src, Mat& dst) const = 0;
+
+    int top;
+    int bottom;
+};
+
+static void checkBorderType(int borderType)
+{
+    CV_CheckNE(borderType & ~BORDER_ISOLATED, (int)BORDER_WRAP, "FilterPipeline: BORDER_WRAP is not supported");
+}
+
+static bool isDemosaicingCode(int code)
+{
+    switch (code)
+    {
+    case COLOR_BayerBG2GRAY: case COLOR_BayerGB2GRAY: case COLOR_BayerRG2GRAY: case COLOR_BayerGR2GRAY:
+    case COLOR_BayerBG2BGR: case COLOR_BayerGB2BGR: case COLOR_BayerRG2BGR: case COLOR_BayerGR2BGR:
+    case COLOR_BayerBG2BGR_VNG: case COLOR_BayerGB2BGR_VNG: case COLOR_BayerRG2BGR_VNG: case COLOR_BayerGR2BGR_VNG:
+    case COLOR_BayerBG2BGR_EA: case COLOR_BayerGB2BGR_EA: case COLOR_BayerRG2BGR_EA: case COLOR_BayerGR2BGR_EA:
+    case COLOR_BayerBG2BGRA: case COLOR_BayerGB2BGRA: case COLOR_BayerRG2BGRA: case COLOR_BayerGR2BGRA:
+        return true;
+    default:
+        return false;
+    }
+}
+
+class CvtColorStage CV_FINAL : public PipelineStage
+{
+public:
+    CvtColorStage(int code_, int dcn_) : code(code_), dcn(dcn_)
+    {
+        if (isDemosaicingCode(code))
+            CV_Error(Error::StsNotImplemented, "FilterPipeline: Bayer demosaicing is not supported");
+    }
+    void apply(const Mat& src, Mat& dst) const CV_OVERRIDE
+    {
+        cv::cvtColor(src, dst, code, dcn);
+    }
+
+    int code, dcn;
+};
+
+class GaussianBlurStage CV_FINAL : public PipelineStage
+{
+public:
+    GaussianBlurStage(Size ksize_, double sigma1_, double sigma2_, int borderType_)
+        : ksize(ksize_), sigma1(sigma1_), sigma2(sigma2_), borderType(borderType_)
+    {
+        checkBorderType(borderType);
+        int height = ksize.height;
+        if (height <= 0)
+        {
+            // upper bound of the aperture selected by createGaussianKernels() for all depths
+            double sigma = sigma2 > 0 ? sigma2 : sigma1;
+            height = cvRound(sigma*4*2 + 1) | 1;
+        }
+        top = bottom = height/2;
+    }
+    void apply(const Mat& src, Mat& dst) const CV_OVERRIDE
+    {
+        cv::GaussianBlur(src, dst, ksize, sigma1, sigma2, borderType | BORDER_ISOLATED);
+    }
+
+    Size ksize;
+    double sigma1, sigma2;
+    int borderType;
+};
+
+class BoxFilterStage CV_FINAL : public PipelineStage
+{
+public:
+    BoxFilterStage(int ddepth_, Size ksize_, Point anchor_, bool normalize_, int borderType_)
+        : ddepth(ddepth_), ksize(ksize_), anchor(anchor_), normalize(normalize_), borderType(borderType_)
+    {
+        checkBorderType(borderType);
+        CV_Assert(ksize.height > 0 && ksize.width > 0);
+        top = anchor.y < 0 ? ksize.height/2 : anchor.y;
+        bottom = ksize.height - 1 - top;
+    }
+    void apply(const Mat& src, Mat& dst) const CV_OVERRIDE
+    {
+        cv::boxFilter(src, dst, ddepth, ksize, anchor, normalize, borderType | BORDER_ISOLATED);
+    }
+
+    int ddepth;
+    Size ksize;
+    Point anchor;
+    bool normalize;
+    int borderType;
+};
+
+class SepFilterStage CV_FINAL : public PipelineStage
+{
+public:
+    SepFilterStage(int ddepth_, const Mat& kernelX_, const Mat& kernelY_, Point anchor_, double delta_, int borderType_)
+        : ddepth(ddepth_), kernelX(kernelX_.clone()), kernelY(kernelY_.clone()), anchor(anchor_), delta(delta_), borderType(borderType_)
+    {
+        checkBorderType(borderType);
+        int height = (int)kernelY.total();
+        CV_Assert(height > 0 && !kernelX.empty());
+        top = anchor.y < 0 ? height/2 : anchor.y;
+        bottom = height - 1 - top;
+    }
+    void apply(const Mat& src, Mat& dst) const CV_OVERRIDE
+    {
+        cv::sepFilter2D(src, dst, ddepth, kernelX, kernelY, anchor, delta, borderType | BORDER_ISOLATED);
+    }
+
+    int ddepth;
+    Mat kernelX, kernelY;
+    Point anchor;
+    double delta;
+    int borderType;
+};
+
+class SobelStage CV_FINAL : public PipelineStage
+{
+public:
+    SobelStage(int ddepth_, int dx_, int dy_, int ksize_, double scale_, double delta_, int borderType_)
+        : ddepth(ddepth_), dx(dx_), dy(dy_), ksize(ksize_), scale(scale_), delta(delta_), borderType(borderType_)
+    {
+        checkBorderType(borderType);
+        // ksize == 1 and FILTER_SCHARR use 3-tap kernels
+        top = bottom = std::max(ksize, 3)/2;
+    }
+    void apply(const Mat& src, Mat& dst) const CV_OVERRIDE
+    {
+        cv::Sobel(src, dst, ddepth, dx, dy, ksize, scale, delta, borderType | BORDER_ISOLATED);
+    }
+
+    int ddepth, dx, dy, ksize;
+    double scale, delta;
+    int borderType;
+};
+
+class ThresholdStage CV_FINAL : public PipelineStage
+{
+public:
+    ThresholdStage(double thresh_, double maxval_, int type_)
+        : thresh(thresh_), maxval(maxval_), type(type_)
+    {
+        CV_CheckEQ(type & ~THRESH_MASK, 0, "FilterPipeline: automatic threshold selection is not supported");
+    }
+    void apply(const Mat& src, Mat& dst) const CV_OVERRIDE
+    {
+        cv::threshold(src, dst, thresh, maxval, type);
+    }
+
+    double thresh, maxval;
+    int type;
+};
+
+class ConvertStage CV_FINAL : public PipelineStage
+{
+public:
+    ConvertStage(int rtype_, double alpha_, double beta_, bool absolute_)
+        : rtype(rtype_), alpha(alpha_), beta(beta_), absolute(absolute_)
+    {}
+    void apply(const Mat& src, Mat& dst) const CV_OVERRIDE
+    {
+        if (absolute)
+            cv::convertScaleAbs(src, dst, alpha, beta);
+        else
+            src.convertTo(dst, rtype, alpha, beta);
+    }
+
+    int rtype;
+    double alpha, beta;
+    bool absolute;
+};
+
+static size_t getFilterPipelineStripSize()
+{
+    static size_t value = utils::getConfigurationParameterSizeT("OPENCV_FILTER_PIPELINE_STRIP_SIZE", 1 << 20);
+    return value;
+}
+
+class FilterPipelineInvoker CV_FINAL : public ParallelLoopBody
+{
+public:
+    FilterPipelineInvoker(const std::vector<Ptr<PipelineStage> >& stages_, const std::vector<int>& types_,
+                          const Mat& src_, Mat& dst_, int nstrips_, size_t bufSize_)
+        : stages(stages_), types(types_), src(src_), dst(dst_), nstrips(nstrips_), bufSize(bufSize_)
+    {}
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        const int n = (int)stages.size(), height = src.rows, width = src.cols;
+        AutoBuffer<uchar> _buf(bufSize*2 + CV_MALLOC_ALIGN*2);
+        uchar* buf[2];
+        buf[0] = alignPtr(_buf.data(), CV_MALLOC_ALIGN);
+        buf[1] = alignPtr(buf[0] + bufSize, CV_MALLOC_ALIGN);
+        AutoBuffer<int> _rows(n*2 + 2);
+        int* rows = _rows.data();
+
+        for (int k = range.start; k < range.end; k++)
+        {
+            int y0 = (int)((int64)height*k/nstrips), y1 = (int)((int64)height*(k + 1)/nstrips);
+
+            // rows[2*i + 2], rows[2*i + 3] - range of valid output rows of i-th stage
+            rows[n*2] = y0;
+            rows[n*2 + 1] = y1;
+            for (int i = n - 1; i >= 0; i--)
+            {
+                rows[i*2] = std::max(rows[i*2 + 2] - stages[i]->top, 0);
+                rows[i*2 + 1] = std::min(rows[i*2 + 3] + stages[i]->bottom, height);
+            }
+
+            Mat in = src.rowRange(rows[0], rows[1]);
+            bool done = false;
+            for (int i = 0; i < n; i++)
+            {
+                const PipelineStage& stage = *stages[i];
+                Mat out;
+                if (i == n - 1 && stage.top == 0 && stage.bottom == 0)
+                {
+                    out = dst.rowRange(y0, y1);
+                    done = true;
+                }
+                else
+                    out = Mat(in.rows, width, types[i], buf[i & 1]);
+                stage.apply(in, out);
+                CV_DbgAssert(out.size() == in.size() && out.type() == types[i]);
+                in = out.rowRange(rows[i*2 + 2] - rows[i*2], rows[i*2 + 3] - rows[i*2]);
+            }
+            if (!done)
+                in.copyTo(dst.rowRange(y0, y1));
+        }
+    }
+
+private:
+    const std::vector<Ptr<PipelineStage> >& stages;
+    const std::vector<int>& types;
+    const Mat& src;
+    Mat& dst;
+    int nstrips;
+    size_t bufSize;
+};
+
+} // namespace
+
+class FilterPipeline::Impl
+{
+public:
+    Impl() : stripRows(0) {}
+
+    std::vector<Ptr<PipelineStage> > stages;
+    int stripRows;
+};
+
+FilterPipeline::FilterPipeline() : p(makePtr<Impl>()) {}
+
+FilterPipeline::~FilterPipeline() {}
+
+FilterPipeline& FilterPipeline::cvtColor(int code, int dstCn)
+{
+    p->stages.push_back(makePtr<CvtColorStage>(code, dstCn));
+    return *this;
+}
+
+FilterPipeline& FilterPipeline::GaussianBlur(Size ksize, double sigmaX, double sigmaY, int borderType)
+{
+    p->stages.push_back(makePtr<GaussianBlurStage>(ksize, sigmaX, sigmaY, borderType));
+    return *this;
+}
+
+FilterPipeline& FilterPipeline::boxFilter(int ddepth, Size ksize, Point anchor, bool normalize, int borderType)
+{
+    p->stages.push_back(makePtr<BoxFilterStage>(ddepth, ksize, anchor, normalize, borderType));
+    return *this;
+}
+
+FilterPipeline& FilterPipeline::sepFilter2D(int ddepth, InputArray kernelX, InputArray kernelY,
+                                            Point anchor, double delta, int borderType)
+{
+    p->stages.push_back(makePtr<SepFilterStage>(ddepth, kernelX.getMat(), kernelY.getMat(), anchor, delta, borderType));
+    return *this;
+}
+
+FilterPipeline& FilterPipeline::Sobel(int ddepth, int dx, int dy, int ksize, double scale, double delta, int borderType)
+{
+    p->stages.push_back(makePtr<SobelStage>(ddepth, dx, dy, ksize, scale, delta, borderType));
+    return *this;
+}
+
+FilterPipeline& FilterPipeline::threshold(double thresh, double maxval, int type)
+{
+    p->stages.push_back(makePtr<ThresholdStage>(thresh, maxval, type));
+    return *this;
+}
+
+FilterPipeline& FilterPipeline::convertTo(int rtype, double alpha, double beta)
+{
+    p->stages.push_back(makePtr<ConvertStage>(rtype, alpha, beta, false));
+    return *this;
+}
+
+FilterPipeline& FilterPipeline::convertScaleAbs(double alpha, double beta)
+{
+    p->stages.push_back(makePtr<ConvertStage>(-1, alpha, beta, true));
+    return *this;
+}
+
+void FilterPipeline::setStripRows(int rows)
+{
+    CV_CheckGE(rows, 0, "");
+    p->stripRows = rows;
+}
+
+int FilterPipeline::getStripRows() const
+{
+    return p->stripRows;
+}
+
+size_t FilterPipeline::size() const
+{
+    return p->stages.size();
+}
+
+bool FilterPipeline::empty() const
+{
+    return p->stages.empty();
+}
+
+void FilterPipeline::clear()
+{
+    p->stages.clear();
+}
+
+void FilterPipeline::apply(InputArray _src, OutputArray _dst) const
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert(!_src.empty() && _src.dims() <= 2);
+    const std::vector<Ptr<PipelineStage> >& stages = p->stages;
+    if (stages.empty())
+    {
+        _src.copyTo(_dst);
+        return;
+    }
+
+    Mat src = _src.getMat();
+    const int n = (int)stages.size();
+
+    // run the chain on a tiny image to get the types of the intermediate images
+    std::vector<int> types(n);
+    size_t rowSize = 0;
+    int maxAperture = 1, halo = 0;
+    {
+        Mat probe = Mat::zeros(6, 6, src.type());
+        for (int i = 0; i < n; i++)
+        {
+            Mat out;
+            stages[i]->apply(probe, out);
+            CV_Assert(out.size() == probe.size() && "FilterPipeline: all stages must preserve the image size");
+            types[i] = out.type();
+            rowSize = std::max(rowSize, src.cols*out.elemSize());
+            maxAperture = std::max(maxAperture, stages[i]->top + stages[i]->bottom + 1);
+            halo += stages[i]->top + stages[i]->bottom;
+            probe = out;
+        }
+    }
+
+    if (_dst.getObj() == _src.getObj() || (!_dst.empty() && _dst.getMat().datastart == src.datastart))
+        src = src.clone();
+    _dst.create(src.size(), types[n - 1]);
+    Mat dst = _dst.getMat();
+
+    // strips must be taller than the apertures to get the same border extrapolation as for the whole image
+    int stripRows = p->stripRows;
+    if (stripRows <= 0)
+        stripRows = (int)(getFilterPipelineStripSize()/(rowSize*2)) - halo;
+    stripRows = std::max(stripRows, std::max(16, maxAperture*2));
+
+    int nstrips = (src.rows + stripRows - 1)/stripRows;
+    size_t bufSize = alignSize(rowSize*(src.rows/nstrips + 1 + halo), CV_MALLOC_ALIGN);
+    FilterPipelineInvoker invoker(stages, types, src, dst, nstrips, bufSize);
+    parallel_for_(Range(0, nstrips), invoker, std::min(nstrips, std::max(getNumThreads(), 1)*4));
+}
+
+} // namespace cv
@@ -0,0 +1,182 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "opencv2/core/hal/intrin.hpp"
+#include "filter.hpp"
+
+/*
+ Recursive (IIR) approximation of the Gaussian filter:
+ I.T. Young, L.J. van Vliet, "Recursive implementation of the Gaussian filter",
+ Signal Processing 44 (1995), 139-151.
+
+ Every 1D pass is a causal 3rd order filter followed by an anti-causal one, the cost does not
+ depend on sigma. The columns are filtered directly (the vector lanes go along the rows), the rows
+ are filtered as columns of the transposed image. The borders are extrapolated for 4*sigma pixels,
+ the same extent as the FIR kernel has, and the filter state is initialized with the
+ steady-state response to the first (last) extrapolated pixel.
+*/
+
+namespace cv
+{
+
+namespace
+{
+
+struct RecursiveGaussianCoeffs
+{
+    // y[n] = B*x[n] + b1*y[n-1] + b2*y[n-2] + b3*y[n-3]
+    double B, b1, b2, b3;
+
+    explicit RecursiveGaussianCoeffs(double sigma)
+    {
+        const double q = sigma >= 2.5 ? 0.98711*sigma - 0.96330
+                                      : 3.97156 - 4.14554*std::sqrt(1 - 0.26891*sigma);
+        const double q2 = q*q, q3 = q2*q;
+        const double b0 = 1.57825 + 2.44413*q + 1.4281*q2 + 0.422205*q3;
+        const double c1 = (2.44413*q + 2.85619*q2 + 1.26661*q3) / b0;
+        const double c2 = -(1.4281*q2 + 1.26661*q3) / b0;
+        const double c3 = 0.422205*q3 / b0;
+        b1 = c1;
+        b2 = c2;
+        b3 = c3;
+        B = 1 - (c1 + c2 + c3);
+    }
+};
+
+// filters the columns of a CV_32F image in place, the image is processed by blocks of columns
+class RecursiveGaussianColsInvoker : public ParallelLoopBody
+{
+public:
+    enum { BLOCK_SIZE = 64 };
+
+    RecursiveGaussianColsInvoker(Mat& img_, double sigma, int borderType_) :
+        img(img_), c(sigma), borderType(borderType_)
+    {
+        pad = cvCeil(sigma*4);
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        const int rows = img.rows, width = img.cols*img.channels();
+        // 3 rows of the initial state on both sides
+        const int total = rows + 2*pad + 6;
+        AutoBuffer<double> _buf((size_t)total*BLOCK_SIZE + BLOCK_SIZE);
+        double* buf = _buf.data();
+        double* row = buf + (size_t)total*BLOCK_SIZE;
+
+        for (int x0 = range.start*BLOCK_SIZE; x0 < std::min(range.end*BLOCK_SIZE, width); x0 += BLOCK_SIZE)
+        {
+            const int w = std::min(width - x0, (int)BLOCK_SIZE);
+
+            // causal pass, buf[i + 3] is the response for the extrapolated row i - pad
+            for (int i = -3; i < rows + 2*pad; i++)
+            {
+                const int y = borderInterpolate(std::max(i, 0) - pad, rows, borderType);
+                double* dst = buf + (size_t)(i + 3)*BLOCK_SIZE;
+                load(img.ptr<float>(y) + x0, row, w);
+                if (i < 0)
+                    memcpy(dst, row, w*sizeof(dst[0]));
+                else
+                    causal(row, dst, dst - BLOCK_SIZE, dst - 2*BLOCK_SIZE, dst - 3*BLOCK_SIZE, w);
+            }
+
+            // anti-causal pass, in place
+            double* last = buf + (size_t)(rows + 2*pad + 2)*BLOCK_SIZE;
+            for (int i = 1; i <= 3; i++)
+                memcpy(last + i*BLOCK_SIZE, last, w*sizeof(last[0]));
+            for (int i = rows + 2*pad + 2; i >= 3 + pad; i--)
+            {
+                double* dst = buf + (size_t)i*BLOCK_SIZE;
+                causal(dst, dst, dst + BLOCK_SIZE, dst + 2*BLOCK_SIZE, dst + 3*BLOCK_SIZE, w);
+                if (i < rows + pad + 3)
+                    store(dst, img.ptr<float>(i - 3 - pad) + x0, w);
+            }
+        }
+    }
+
+private:
+    // the filter state is kept in double, for large sigmas B is tiny and
+    // the float accumulation error is amplified by the poles close to 1
+    static void load(const float* src, double* dst, int w)
+    {
+        int x = 0;
+#if (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+        const int vlanes = VTraits<v_float32>::vlanes();
+        for (; x <= w - vlanes; x += vlanes)
+        {
+            v_float32 v = vx_load(src + x);
+            v_store(dst + x, v_cvt_f64(v));
+            v_store(dst + x + vlanes/2, v_cvt_f64_high(v));
+        }
+#endif
+        for (; x < w; x++)
+            dst[x] = src[x];
+    }
+
+    static void store(const double* src, float* dst, int w)
+    {
+        int x = 0;
+#if (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+        const int vlanes = VTraits<v_float32>::vlanes();
+        for (; x <= w - vlanes; x += vlanes)
+            v_store(dst + x, v_cvt_f32(vx_load(src + x), vx_load(src + x + vlanes/2)));
+#endif
+        for (; x < w; x++)
+            dst[x] = (float)src[x];
+    }
+
+    // dst = B*src + b1*y1 + b2*y2 + b3*y3, dst may be the same as src
+    void causal(const double* src, double* dst, const double* y1, const double* y2, const double* y3, int w) const
+    {
+        int x = 0;
+#if (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+        const int vlanes = VTraits<v_float64>::vlanes();
+        const v_float64 vB = vx_setall_f64(c.B), vb1 = vx_setall_f64(c.b1),
+                        vb2 = vx_setall_f64(c.b2), vb3 = vx_setall_f64(c.b3);
+        for (; x <= w - vlanes; x += vlanes)
+        {
+            v_float64 v = v_mul(vx_load(src + x), vB);
+            v = v_fma(vx_load(y1 + x), vb1, v);
+            v = v_fma(vx_load(y2 + x), vb2, v);
+            v = v_fma(vx_load(y3 + x), vb3, v);
+            v_store(dst + x, v);
+        }
+#endif
+        for (; x < w; x++)
+            dst[x] = c.B*src[x] + c.b1*y1[x] + c.b2*y2[x] + c.b3*y3[x];
+    }
+
+    Mat& img;
+    RecursiveGaussianCoeffs c;
+    int borderType;
+    int pad;
+};
+
+static void recursiveGaussianCols(Mat& img, double sigma, int borderType)
+{
+    const int width = img.cols*img.channels();
+    const int nblocks = (width + RecursiveGaussianColsInvoker::BLOCK_SIZE - 1) / RecursiveGaussianColsInvoker::BLOCK_SIZE;
+    parallel_for_(Range(0, nblocks), RecursiveGaussianColsInvoker(img, sigma, borderType));
+}
+
+}  // namespace
+
+void GaussianBlurRecursive(const Mat& src, Mat& dst, double sigmaX, double sigmaY, int borderType)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert(src.depth() != CV_64F);
+    borderType &= ~BORDER_ISOLATED;
+
+    Mat buf, bufT;
+    src.convertTo(buf, CV_32F);
+    recursiveGaussianCols(buf, sigmaY, borderType);
+    transpose(buf, bufT);
+    recursiveGaussianCols(bufT, sigmaX, borderType);
+    transpose(bufT, buf);
+    buf.convertTo(dst, src.depth());
+}
+
+}  // namespace cv
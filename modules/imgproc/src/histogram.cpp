@@ -1309,6 +1309,321 @@ void cv::calcHist( InputArrayOfArrays images, const std::vector<int>& channels,
 }
 
 
+//////////////////////////// S L I D I N G   A N D   I N T E G R A L   H I S T O G R A M S ////////////////////////////
+
+namespace cv
+{
+
+// Maps every pixel to the flat index of its bin in the dense histogram computed by calcHist()
+// (the last dimension is the fastest one). Pixels out of the ranges are mapped to negative values.
+template<typename T> static void
+calcHistBinIndexRow( const T* src, int cn, const int* channels, const int* const* tabs, int dims,
+                     int* dst, int width )
+{
+    int x;
+    if( dims == 1 )
+    {
+        const int* tab0 = tabs[0];
+        const T* p0 = src + channels[0];
+        for( x = 0; x < width; x++, p0 += cn )
+            dst[x] = tab0[*p0];
+    }
+    else if( dims == 2 )
+    {
+        const int *tab0 = tabs[0], *tab1 = tabs[1];
+        const T *p0 = src + channels[0], *p1 = src + channels[1];
+        for( x = 0; x < width; x++, p0 += cn, p1 += cn )
+            dst[x] = tab0[*p0] + tab1[*p1];
+    }
+    else
+    {
+        const int *tab0 = tabs[0], *tab1 = tabs[1], *tab2 = tabs[2];
+        const T *p0 = src + channels[0], *p1 = src + channels[1], *p2 = src + channels[2];
+        for( x = 0; x < width; x++, p0 += cn, p1 += cn, p2 += cn )
+            dst[x] = tab0[*p0] + tab1[*p1] + tab2[*p2];
+    }
+}
+
+class HistBinIndexInvoker : public ParallelLoopBody
+{
+public:
+    HistBinIndexInvoker( const Mat& _src, const int* _channels, const std::vector<int>& _tab, int _dims, Mat& _dst ) :
+        src(_src), channels(_channels), tab(_tab), dims(_dims), dst(_dst)
+    {
+    }
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        const int nvals = src.depth() == CV_8U ? 256 : 65536, cn = src.channels();
+        const int* tabs[3] = { &tab[0], dims > 1 ? &tab[nvals] : 0, dims > 2 ? &tab[nvals*2] : 0 };
+        for( int y = range.start; y < range.end; y++ )
+        {
+            if( src.depth() == CV_8U )
+                calcHistBinIndexRow(src.ptr<uchar>(y), cn, channels, tabs, dims, dst.ptr<int>(y), src.cols);
+            else
+                calcHistBinIndexRow(src.ptr<ushort>(y), cn, channels, tabs, dims, dst.ptr<int>(y), src.cols);
+        }
+    }
+
+private:
+    const Mat& src;
+    const int* channels;
+    const std::vector<int>& tab;
+    int dims;
+    Mat& dst;
+};
+
+static void calcHistBinIndices( const Mat& src, const std::vector<int>& channels,
+                                const std::vector<int>& histSize, const std::vector<float>& ranges,
+                                Mat& binIdx, int& nbins )
+{
+    const int dims = (int)histSize.size(), depth = src.depth(), cn = src.channels();
+    CV_Assert( src.dims <= 2 && (depth == CV_8U || depth == CV_16U) );
+    CV_Assert( dims >= 1 && dims <= 3 );
+    CV_Assert( channels.empty() ? cn == dims : (int)channels.size() == dims );
+    CV_Assert( ranges.size() == (size_t)dims*2 || (ranges.empty() && depth == CV_8U) );
+
+    // negative for any combination with an out of range value, see calcHistBinIndexRow()
+    const int outOfRange = INT_MIN/4;
+    const int nvals = depth == CV_8U ? 256 : 65536;
+    std::vector<int> tab((size_t)nvals*dims);
+    int ch[3];
+    double total = 1;
+    nbins = 1;
+    for( int i = dims - 1; i >= 0; i-- )
+    {
+        const int sz = histSize[i];
+        ch[i] = channels.empty() ? i : channels[i];
+        CV_Assert( sz > 0 && 0 <= ch[i] && ch[i] < cn );
+
+        // the same binning as the uniform calcHist()
+        double a = sz/256., b = 0, v_lo = 0, v_hi = 256;
+        if( !ranges.empty() )
+        {
+            v_lo = ranges[i*2];
+            v_hi = ranges[i*2+1];
+            CV_Assert( v_lo < v_hi );
+            a = sz/(v_hi - v_lo);
+            b = -a*v_lo;
+        }
+        int* t = &tab[(size_t)nvals*i];
+        for( int v = 0; v < nvals; v++ )
+        {
+            int idx = cvFloor(v*a + b);
+            t[v] = v >= v_lo && v < v_hi ? CV_CLAMP_INT(idx, 0, sz - 1)*nbins : outOfRange;
+        }
+        total *= sz;
+        CV_Assert( total < (1 << 28) );
+        nbins *= sz;
+    }
+
+    binIdx.create(src.size(), CV_32S);
+    HistBinIndexInvoker invoker(src, ch, tab, dims, binIdx);
+    parallel_for_(Range(0, src.rows), invoker, src.total()/(double)(1 << 16));
+}
+
+static inline void addHist( int* dst, const int* src, int n )
+{
+    int i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int vlanes = VTraits<v_int32>::vlanes();
+    for( ; i <= n - vlanes; i += vlanes )
+        v_store(dst + i, v_add(vx_load(dst + i), vx_load(src + i)));
+#endif
+    for( ; i < n; i++ )
+        dst[i] += src[i];
+}
+
+static inline void subHist( int* dst, const int* src, int n )
+{
+    int i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int vlanes = VTraits<v_int32>::vlanes();
+    for( ; i <= n - vlanes; i += vlanes )
+        v_store(dst + i, v_sub(vx_load(dst + i), vx_load(src + i)));
+#endif
+    for( ; i < n; i++ )
+        dst[i] -= src[i];
+}
+
+// Every stripe of window rows keeps the histograms of the image columns over the current window
+// rows. Moving the window down updates them with the entering and leaving pixels only, moving it
+// right updates the window histogram with the entering and leaving column histograms only.
+class SlidingHistInvoker : public ParallelLoopBody
+{
+public:
+    SlidingHistInvoker( const Mat& _binIdx, int _nbins, Size _winSize, Size _stride, int _nx, Mat& _hists ) :
+        binIdx(_binIdx), nbins(_nbins), winSize(_winSize), stride(_stride), nx(_nx), hists(_hists)
+    {
+    }
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        // only the columns covered by the windows
+        const int width = (nx - 1)*stride.width + winSize.width;
+        AutoBuffer<int> _colHist((size_t)width*nbins), _winHist(nbins);
+        int* colHist = _colHist.data();
+        int* winHist = _winHist.data();
+        int top = 0, bottom = 0;
+
+        for( int wy = range.start; wy < range.end; wy++ )
+        {
+            const int y0 = wy*stride.height, y1 = y0 + winSize.height;
+            if( wy == range.start || y0 >= bottom )
+            {
+                memset(colHist, 0, (size_t)width*nbins*sizeof(colHist[0]));
+                updateColumns(y0, y1, 1, colHist, width);
+            }
+            else
+            {
+                updateColumns(top, y0, -1, colHist, width);
+                updateColumns(bottom, y1, 1, colHist, width);
+            }
+            top = y0;
+            bottom = y1;
+
+            float* dst = hists.ptr<float>(wy*nx);
+            for( int wx = 0; wx < nx; wx++, dst += nbins )
+            {
+                const int x0 = wx*stride.width;
+                if( wx == 0 || stride.width >= winSize.width )
+                {
+                    memset(winHist, 0, nbins*sizeof(winHist[0]));
+                    for( int x = x0; x < x0 + winSize.width; x++ )
+                        addHist(winHist, colHist + (size_t)x*nbins, nbins);
+                }
+                else
+                {
+                    for( int x = x0 - stride.width; x < x0; x++ )
+                        subHist(winHist, colHist + (size_t)x*nbins, nbins);
+                    for( int x = x0 - stride.width + winSize.width; x < x0 + winSize.width; x++ )
+                        addHist(winHist, colHist + (size_t)x*nbins, nbins);
+                }
+                for( int b = 0; b < nbins; b++ )
+                    dst[b] = (float)winHist[b];
+            }
+        }
+    }
+
+private:
+    void updateColumns( int y0, int y1, int delta, int* colHist, int width ) const
+    {
+        for( int y = y0; y < y1; y++ )
+        {
+            const int* idx = binIdx.ptr<int>(y);
+            for( int x = 0; x < width; x++ )
+                if( idx[x] >= 0 )
+                    colHist[(size_t)x*nbins + idx[x]] += delta;
+        }
+    }
+
+    const Mat& binIdx;
+    int nbins;
+    Size winSize, stride;
+    int nx;
+    Mat& hists;
+};
+
+class IntegralHistRowsInvoker : public ParallelLoopBody
+{
+public:
+    IntegralHistRowsInvoker( const Mat& _binIdx, int _nbins, Mat& _ihist ) :
+        binIdx(_binIdx), nbins(_nbins), ihist(_ihist)
+    {
+    }
+
+    // horizontal prefix sums, the row y of the image goes to the plane y + 1
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        for( int y = range.start; y < range.end; y++ )
+        {
+            const int* idx = binIdx.ptr<int>(y);
+            int* dst = ihist.ptr<int>(y + 1);
+            memset(dst, 0, nbins*sizeof(dst[0]));
+            for( int x = 0; x < binIdx.cols; x++, dst += nbins )
+            {
+                memcpy(dst + nbins, dst, nbins*sizeof(dst[0]));
+                if( idx[x] >= 0 )
+                    dst[nbins + idx[x]]++;
+            }
+        }
+    }
+
+private:
+    const Mat& binIdx;
+    int nbins;
+    Mat& ihist;
+};
+
+class IntegralHistColsInvoker : public ParallelLoopBody
+{
+public:
+    IntegralHistColsInvoker( Mat& _ihist ) : ihist(_ihist) {}
+
+    // vertical prefix sums over the range of the elements of every plane
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        for( int y = 2; y < ihist.size[0]; y++ )
+            addHist(ihist.ptr<int>(y) + range.start, ihist.ptr<int>(y - 1) + range.start, range.size());
+    }
+
+private:
+    Mat& ihist;
+};
+
+}
+
+void cv::calcHistSliding( InputArray _src, const std::vector<int>& channels,
+                          const std::vector<int>& histSize, const std::vector<float>& ranges,
+                          Size winSize, Size stride, OutputArray _hists )
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat src = _src.getMat();
+    CV_Assert( !src.empty() );
+    CV_Assert( winSize.width > 0 && winSize.height > 0 && winSize.width <= src.cols && winSize.height <= src.rows );
+    CV_Assert( stride.width > 0 && stride.height > 0 );
+
+    Mat binIdx;
+    int nbins = 0;
+    calcHistBinIndices(src, channels, histSize, ranges, binIdx, nbins);
+
+    const int nx = (src.cols - winSize.width)/stride.width + 1;
+    const int ny = (src.rows - winSize.height)/stride.height + 1;
+    _hists.create(ny*nx, nbins, CV_32F);
+    Mat hists = _hists.getMat();
+
+    SlidingHistInvoker invoker(binIdx, nbins, winSize, stride, nx, hists);
+    parallel_for_(Range(0, ny), invoker, std::min(ny, std::max(getNumThreads(), 1)));
+}
+
+void cv::calcIntegralHist( InputArray _src, const std::vector<int>& channels,
+                           const std::vector<int>& histSize, const std::vector<float>& ranges,
+                           OutputArray _ihist )
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat src = _src.getMat();
+    CV_Assert( !src.empty() );
+
+    Mat binIdx;
+    int nbins = 0;
+    calcHistBinIndices(src, channels, histSize, ranges, binIdx, nbins);
+
+    const int sizes[] = { src.rows + 1, src.cols + 1, nbins };
+    _ihist.create(3, sizes, CV_32S);
+    Mat ihist = _ihist.getMat();
+    CV_Assert( ihist.isContinuous() );
+    memset(ihist.ptr<int>(0), 0, ihist.step[0]);
+
+    IntegralHistRowsInvoker rowsInvoker(binIdx, nbins, ihist);
+    parallel_for_(Range(0, src.rows), rowsInvoker, (double)src.total()*nbins/(1 << 16));
+
+    const int planeSize = (src.cols + 1)*nbins;
+    IntegralHistColsInvoker colsInvoker(ihist);
+    parallel_for_(Range(0, planeSize), colsInvoker, (double)planeSize/(1 << 12));
+}
+
 /////////////////////////////////////// B A C K   P R O J E C T ////////////////////////////////////
 
 namespace cv
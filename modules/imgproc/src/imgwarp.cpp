@@ -3466,6 +3466,245 @@ void cv::warpPerspective( InputArray _src, OutputArray _dst, InputArray _M0,
 }
 
 
+namespace cv
+{
+
+// Builds the fixed-point maps exactly as WarpAffineInvoker/WarpPerspectiveInvoker do for
+// each block, so remap with these maps produces the same result as warpAffine/warpPerspective
+class WarpPlanMapsInvoker :
+    public ParallelLoopBody
+{
+public:
+    WarpPlanMapsInvoker(Mat &_map1, Mat &_map2, const double *_M, bool _perspective,
+                        int _interpolation, const int *_adelta, const int *_bdelta) :
+        ParallelLoopBody(), map1(_map1), map2(_map2), M(_M), perspective(_perspective),
+        interpolation(_interpolation), adelta(_adelta), bdelta(_bdelta)
+    {
+    }
+
+    virtual void operator() (const Range& range) const CV_OVERRIDE
+    {
+        const int BLOCK_SZ = perspective ? 32 : 64;
+        const int AB_BITS = MAX(10, (int)INTER_BITS);
+        const int AB_SCALE = 1 << AB_BITS;
+        int round_delta = interpolation == INTER_NEAREST ? AB_SCALE/2 : AB_SCALE/INTER_TAB_SIZE/2;
+        int width = map1.cols, height = map1.rows;
+
+        int bh0 = std::min(BLOCK_SZ/2, height);
+        int bw0 = std::min(BLOCK_SZ*BLOCK_SZ/bh0, width);
+
+        for( int y = range.start; y < range.end; y++ )
+        {
+            short* xy_row = map1.ptr<short>(y);
+            short* alpha_row = interpolation == INTER_NEAREST ? 0 : map2.ptr<short>(y);
+
+            for( int x = 0; x < width; x += bw0 )
+            {
+                int bw = std::min( bw0, width - x);
+                short* xy = xy_row + x*2;
+
+                if( perspective )
+                {
+                    double X0 = M[0]*x + M[1]*y + M[2];
+                    double Y0 = M[3]*x + M[4]*y + M[5];
+                    double W0 = M[6]*x + M[7]*y + M[8];
+
+                    if( interpolation == INTER_NEAREST )
+                        hal::warpPerspectiveBlocklineNN(M, xy, X0, Y0, W0, bw);
+                    else
+                        hal::warpPerspectiveBlockline(M, xy, alpha_row + x, X0, Y0, W0, bw);
+                }
+                else
+                {
+                    int X0 = saturate_cast<int>((M[1]*y + M[2])*AB_SCALE) + round_delta;
+                    int Y0 = saturate_cast<int>((M[4]*y + M[5])*AB_SCALE) + round_delta;
+
+                    if( interpolation == INTER_NEAREST )
+                        hal::warpAffineBlocklineNN((int*)adelta + x, (int*)bdelta + x, xy, X0, Y0, bw);
+                    else
+                        hal::warpAffineBlockline((int*)adelta + x, (int*)bdelta + x, xy, alpha_row + x, X0, Y0, bw);
+                }
+            }
+        }
+    }
+
+private:
+    Mat &map1;
+    Mat &map2;
+    const double* M;
+    bool perspective;
+    int interpolation;
+    const int *adelta, *bdelta;
+};
+
+class WarpPlan::Impl
+{
+public:
+    Impl() : interpolation(INTER_LINEAR), borderType(BORDER_CONSTANT) {}
+
+    void setParams(int _interpolation, int _borderType, const Scalar& _borderValue)
+    {
+        int interp = _interpolation & INTER_MAX;
+        CV_Assert( interp == INTER_NEAREST || interp == INTER_LINEAR ||
+                   interp == INTER_CUBIC || interp == INTER_LANCZOS4 );
+        interpolation = _interpolation;
+        borderType = _borderType;
+        borderValue = _borderValue;
+    }
+
+    void createTransform(InputArray _M0, Size dsize, int flags, bool perspective)
+    {
+        CV_Assert( dsize.width > 0 && dsize.height > 0 );
+
+        Mat M0 = _M0.getMat();
+        int mrows = perspective ? 3 : 2;
+        CV_Assert( (M0.type() == CV_32F || M0.type() == CV_64F) && M0.rows == mrows && M0.cols == 3 );
+
+        double M[9] = {0};
+        Mat matM(mrows, 3, CV_64F, M);
+        M0.convertTo(matM, matM.type());
+
+        int interp = flags & INTER_MAX;
+        if( interp == INTER_AREA )
+            interp = INTER_LINEAR;
+        CV_Assert( interp == INTER_NEAREST || interp == INTER_LINEAR ||
+                   interp == INTER_CUBIC || interp == INTER_LANCZOS4 );
+
+        if( !(flags & WARP_INVERSE_MAP) )
+        {
+            if( perspective )
+                invert(matM, matM);
+            else
+            {
+                double D = M[0]*M[4] - M[1]*M[3];
+                D = D != 0 ? 1./D : 0;
+                double A11 = M[4]*D, A22=M[0]*D;
+                M[0] = A11; M[1] *= -D;
+                M[3] *= -D; M[4] = A22;
+                double b1 = -M[0]*M[2] - M[1]*M[5];
+                double b2 = -M[3]*M[2] - M[4]*M[5];
+                M[2] = b1; M[5] = b2;
+            }
+        }
+
+        map1.create(dsize, CV_16SC2);
+        if( interp == INTER_NEAREST )
+            map2.release();
+        else
+            map2.create(dsize, CV_16UC1);
+
+        AutoBuffer<int> _abdelta(perspective ? 0 : dsize.width*2);
+        int *adelta = _abdelta.data(), *bdelta = adelta + (perspective ? 0 : dsize.width);
+        if( !perspective )
+        {
+            const int AB_BITS = MAX(10, (int)INTER_BITS);
+            const int AB_SCALE = 1 << AB_BITS;
+            for( int x = 0; x < dsize.width; x++ )
+            {
+                adelta[x] = saturate_cast<int>(M[0]*x*AB_SCALE);
+                bdelta[x] = saturate_cast<int>(M[3]*x*AB_SCALE);
+            }
+        }
+
+        WarpPlanMapsInvoker invoker(map1, map2, M, perspective, interp, adelta, bdelta);
+        parallel_for_(Range(0, dsize.height), invoker, dsize.area()/(double)(1<<16));
+        interpolation = interp;
+    }
+
+    Mat map1, map2;
+    int interpolation, borderType;
+    Scalar borderValue;
+};
+
+WarpPlan::WarpPlan()
+{
+}
+
+WarpPlan::~WarpPlan()
+{
+}
+
+void WarpPlan::createAffine(InputArray M, Size dsize, int flags, int borderMode, const Scalar& borderValue)
+{
+    CV_INSTRUMENT_REGION();
+
+    Ptr<Impl> impl = makePtr<Impl>();
+    impl->createTransform(M, dsize, flags, false);
+    impl->borderType = borderMode;
+    impl->borderValue = borderValue;
+    p = impl;
+}
+
+void WarpPlan::createPerspective(InputArray M, Size dsize, int flags, int borderMode, const Scalar& borderValue)
+{
+    CV_INSTRUMENT_REGION();
+
+    Ptr<Impl> impl = makePtr<Impl>();
+    impl->createTransform(M, dsize, flags, true);
+    impl->borderType = borderMode;
+    impl->borderValue = borderValue;
+    p = impl;
+}
+
+void WarpPlan::createFromMaps(InputArray _map1, InputArray _map2, int interpolation,
+                              int borderMode, const Scalar& borderValue)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( !_map1.empty() );
+    Ptr<Impl> impl = makePtr<Impl>();
+    impl->setParams(interpolation, borderMode, borderValue);
+
+    bool nninterpolate = (interpolation & INTER_MAX) == INTER_NEAREST;
+    int type1 = _map1.type(), type2 = _map2.type();
+    if( type1 == CV_16SC2 && (nninterpolate ? _map2.empty() : type2 == CV_16UC1) )
+    {
+        _map1.copyTo(impl->map1);
+        _map2.copyTo(impl->map2);
+    }
+    else
+        convertMaps(_map1, _map2, impl->map1, impl->map2, CV_16SC2, nninterpolate);
+
+    if( nninterpolate )
+        impl->map2.release();
+    p = impl;
+}
+
+void WarpPlan::apply(InputArray _src, OutputArray _dst) const
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( !empty() );
+    CV_Assert( _src.channels() <= 4 || ((p->interpolation & INTER_MAX) != INTER_LANCZOS4 &&
+                                        (p->interpolation & INTER_MAX) != INTER_CUBIC) );
+
+    Mat src = _src.getMat();
+    CV_Assert( !src.empty() );
+    if( _dst.isMat() && _dst.getMat().data == src.data )
+        src = src.clone();
+
+    remap(src, _dst, p->map1, p->map2, p->interpolation, p->borderType, p->borderValue);
+}
+
+void WarpPlan::getMaps(OutputArray map1, OutputArray map2) const
+{
+    CV_Assert( !empty() );
+    p->map1.copyTo(map1);
+    p->map2.copyTo(map2);
+}
+
+Size WarpPlan::dstSize() const
+{
+    return empty() ? Size() : p->map1.size();
+}
+
+bool WarpPlan::empty() const
+{
+    return !p || p->map1.empty();
+}
+
+}
+
 cv::Matx23d cv::getRotationMatrix2D_(Point2f center, double angle, double scale)
 {
     CV_INSTRUMENT_REGION();
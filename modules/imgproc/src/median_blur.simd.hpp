@@ -81,7 +81,7 @@ void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize);
 #ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
 
 static void
-medianBlur_8u_O1( const Mat& _src, Mat& _dst, int ksize )
+medianBlur_8u_O1( const Mat& _src, Mat& _dst, int ksize, const Rect& roi )
 {
     CV_INSTRUMENT_REGION();
 
@@ -119,7 +119,7 @@ medianBlur_8u_O1( const Mat& _src, Mat& _dst, int ksize )
     CV_Assert(cn > 0 && cn <= 4);
     size_t sstep = _src.step, dstep = _dst.step;
 
-    int STRIPE_SIZE = std::min( _dst.cols, 512/cn );
+    int STRIPE_SIZE = std::min( roi.width, 512/cn );
 
 #if defined(CV_SIMD_WIDTH) && CV_SIMD_WIDTH >= 16
 # define CV_ALIGNMENT CV_SIMD_WIDTH
@@ -132,22 +132,28 @@ medianBlur_8u_O1( const Mat& _src, Mat& _dst, int ksize )
     HT* h_coarse = alignPtr(&_h_coarse[0], CV_ALIGNMENT);
     HT* h_fine = alignPtr(&_h_fine[0], CV_ALIGNMENT);
 
-    for( int x = 0; x < _dst.cols; x += STRIPE_SIZE )
+    for( int x = roi.x; x < roi.x + roi.width; x += STRIPE_SIZE )
     {
-        int i, j, k, c, n = std::min(_dst.cols - x, STRIPE_SIZE) + r*2;
+        int i, j, k, c, n = std::min(roi.x + roi.width - x, STRIPE_SIZE) + r*2;
         const uchar* src = _src.ptr() + x*cn;
         uchar* dst = _dst.ptr() + (x - r)*cn;
 
         memset( h_coarse, 0, 16*n*cn*sizeof(h_coarse[0]) );
         memset( h_fine, 0, 16*16*n*cn*sizeof(h_fine[0]) );
 
-        // First row initialization
+        // First row initialization: rows [roi.y - r - 1, roi.y + r - 1] with replicated borders,
+        // the first iteration below removes the top one and adds roi.y + r
         for( c = 0; c < cn; c++ )
         {
-            for( j = 0; j < n; j++ )
-                COP( c, j, src[cn*j+c], += (HT)(r+2) );
+            int i0 = roi.y - r - 1;
+            if( i0 < 1 )
+            {
+                for( j = 0; j < n; j++ )
+                    COP( c, j, src[cn*j+c], += (HT)(1 - i0) );
+                i0 = 1;
+            }
 
-            for( i = 1; i < r; i++ )
+            for( i = i0; i < roi.y + r; i++ )
             {
                 const uchar* p = src + sstep*std::min(i, m-1);
                 for ( j = 0; j < n; j++ )
@@ -155,7 +161,7 @@ medianBlur_8u_O1( const Mat& _src, Mat& _dst, int ksize )
             }
         }
 
-        for( i = 0; i < m; i++ )
+        for( i = roi.y; i < roi.y + roi.height; i++ )
         {
             const uchar* p0 = src + sstep * std::max( 0, i-r-1 );
             const uchar* p1 = src + sstep * std::min( m-1, i+r );
@@ -345,7 +351,7 @@ medianBlur_8u_O1( const Mat& _src, Mat& _dst, int ksize )
 }
 
 static void
-medianBlur_8u_Om( const Mat& _src, Mat& _dst, int m )
+medianBlur_8u_Om( const Mat& _src, Mat& _dst, int m, const Range& cols )
 {
     CV_INSTRUMENT_REGION();
 
@@ -370,7 +376,9 @@ medianBlur_8u_Om( const Mat& _src, Mat& _dst, int m )
     }
 
     //CV_Assert( size.height >= nx && size.width >= nx );
-    for( x = 0; x < size.width; x++, src += cn, dst += cn )
+    src += cols.start*cn;
+    dst += cols.start*cn;
+    for( x = cols.start; x < cols.end; x++, src += cn, dst += cn )
     {
         uchar* dst_cur = dst;
         const uchar* src_top = src;
@@ -491,6 +499,209 @@ medianBlur_8u_Om( const Mat& _src, Mat& _dst, int m )
 }
 
 
+static inline void medianHistAdd( ushort* h, const ushort* a, int len )
+{
+    int i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int vlanes = VTraits<v_uint16>::vlanes();
+    for( ; i <= len - vlanes; i += vlanes )
+        v_store(h + i, v_add_wrap(vx_load(h + i), vx_load(a + i)));
+#endif
+    for( ; i < len; i++ )
+        h[i] = (ushort)(h[i] + a[i]);
+}
+
+static inline void medianHistSub( ushort* h, const ushort* a, int len )
+{
+    int i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int vlanes = VTraits<v_uint16>::vlanes();
+    for( ; i <= len - vlanes; i += vlanes )
+        v_store(h + i, v_sub_wrap(vx_load(h + i), vx_load(a + i)));
+#endif
+    for( ; i < len; i++ )
+        h[i] = (ushort)(h[i] - a[i]);
+}
+
+static inline void medianHistAddSub( ushort* h, const ushort* a, const ushort* b, int len )
+{
+    int i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int vlanes = VTraits<v_uint16>::vlanes();
+    for( ; i <= len - vlanes; i += vlanes )
+        v_store(h + i, v_sub_wrap(v_add_wrap(vx_load(h + i), vx_load(a + i)), vx_load(b + i)));
+#endif
+    for( ; i < len; i++ )
+        h[i] = (ushort)(h[i] + a[i] - b[i]);
+}
+
+// returns the first bin where the running sum exceeds t, sum is increased by the preceding bins
+static inline int medianHistFind( const ushort* h, int len, int t, int& sum )
+{
+    int k = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int vlanes = VTraits<v_uint16>::vlanes();
+    for( ; k <= len - vlanes; k += vlanes )
+    {
+        int s = (int)v_reduce_sum(vx_load(h + k));
+        if( sum + s > t )
+            break;
+        sum += s;
+    }
+#endif
+    for( ; k < len && sum + h[k] <= t; k++ )
+        sum += h[k];
+    return k;
+}
+
+// adds (delta = 1) or subtracts (delta = -1) the pixels of the window column which belong to the coarse bin k
+static inline void
+medianHistUpdateColumn16u( ushort* segment, const ushort* const* rows, int nrows, size_t ofs,
+                           int minVal, int k, int fineBits, int delta )
+{
+    const int fineMask = (1 << fineBits) - 1;
+    for( int q = 0; q < nrows; q++ )
+    {
+        int v = rows[q][ofs] - minVal;
+        if( (v >> fineBits) == k )
+            segment[v & fineMask] = (ushort)(segment[v & fineMask] + delta);
+    }
+}
+
+/*
+ * Constant-time median filter for 16-bit images, the same algorithm as medianBlur_8u_O1.
+ * Pixel values are shifted by minVal and split into coarseBits + fineBits, so the column
+ * histograms only cover the value range of the image: up to 256 coarse bins and
+ * 256 fine bins per coarse bin. The source is expected to have a ksize/2 border on the left and right.
+ *
+ * Fine column histograms take (1 << (coarseBits + fineBits)) counters per column (128Kb for the full 16-bit range).
+ * If fineColumnHist is false, only coarse column histograms are kept and the fine histogram of the window
+ * is updated from the pixels of the window columns instead (ksize pixels per column instead of 1 << fineBits bins).
+ */
+static void
+medianBlur_16u_O1( const Mat& _src, Mat& _dst, int ksize, const Rect& roi,
+                   int minVal, int coarseBits, int fineBits, bool fineColumnHist, std::vector<ushort>& buf )
+{
+    CV_INSTRUMENT_REGION();
+
+    typedef ushort HT;
+
+    const int cn = _dst.channels(), m = _dst.rows, r = (ksize-1)/2;
+    const int CB = 1 << coarseBits, FB = 1 << fineBits, fineMask = FB - 1;
+    const int n = roi.width + 2*r, t = 2*r*r + 2*r;
+    const size_t sstep = _src.step1();
+    const size_t fineSize = fineColumnHist ? (size_t)CB*FB*n : 0;
+
+    buf.resize((size_t)CB*n + fineSize + CB + (size_t)CB*FB + CB);
+    HT* h_coarse = &buf[0];
+    HT* h_fine = h_coarse + (size_t)CB*n;
+    HT* H_coarse = h_fine + fineSize;
+    HT* H_fine = H_coarse + CB;
+    HT* luc = H_fine + (size_t)CB*FB;
+    std::vector<const ushort*> rows(fineColumnHist ? 0 : ksize);  // rows of the window
+
+#define COP16(j,x,op) \
+    { \
+        int v_ = (x) - minVal; \
+        h_coarse[CB*(j) + (v_ >> fineBits)] op; \
+        if( fineColumnHist ) \
+            h_fine[FB*((size_t)n*(v_ >> fineBits) + (j)) + (v_ & fineMask)] op; \
+    }
+
+    for( int c = 0; c < cn; c++ )
+    {
+        const ushort* src = _src.ptr<ushort>() + roi.x*cn + c;
+        int i, j, k, b;
+
+        memset( h_coarse, 0, (size_t)CB*n*sizeof(HT) );
+        if( fineColumnHist )
+            memset( h_fine, 0, fineSize*sizeof(HT) );
+
+        // rows [roi.y - r - 1, roi.y + r - 1] with replicated borders
+        for( i = roi.y - r - 1; i < roi.y + r; i++ )
+        {
+            const ushort* p = src + sstep*std::min(std::max(i, 0), m-1);
+            for( j = 0; j < n; j++ )
+                COP16( j, p[cn*j], ++ );
+        }
+
+        for( i = roi.y; i < roi.y + roi.height; i++ )
+        {
+            const ushort* p0 = src + sstep*std::max( 0, i-r-1 );
+            const ushort* p1 = src + sstep*std::min( m-1, i+r );
+            ushort* dst = _dst.ptr<ushort>(i) + (roi.x - r)*cn + c;
+
+            // Update column histograms for the entire row.
+            for( j = 0; j < n; j++ )
+            {
+                COP16( j, p0[cn*j], -- );
+                COP16( j, p1[cn*j], ++ );
+            }
+            for( size_t q = 0; q < rows.size(); q++ )
+                rows[q] = src + sstep*std::min(std::max(i - r + (int)q, 0), m-1);
+
+            memset( H_coarse, 0, CB*sizeof(HT) );
+            memset( luc, 0, CB*sizeof(HT) );
+            for( j = 0; j < 2*r; j++ )
+                medianHistAdd( H_coarse, h_coarse + CB*j, CB );
+
+            for( j = r; j < n-r; j++ )
+            {
+                int sum = 0;
+                medianHistAdd( H_coarse, h_coarse + CB*(j + r), CB );
+
+                // Find median at coarse level
+                k = medianHistFind( H_coarse, CB, t, sum );
+                CV_Assert( k < CB );
+
+                // Update corresponding histogram segment
+                HT* segment = H_fine + FB*k;
+                if( !fineColumnHist )
+                {
+                    if( luc[k] <= j-r )
+                    {
+                        memset( segment, 0, FB*sizeof(HT) );
+                        luc[k] = HT(j - r);
+                        for( ; luc[k] < j + r + 1; ++luc[k] )
+                            medianHistUpdateColumn16u( segment, &rows[0], ksize, (size_t)cn*luc[k], minVal, k, fineBits, 1 );
+                    }
+                    else
+                    {
+                        for( ; luc[k] < j + r + 1; ++luc[k] )
+                        {
+                            medianHistUpdateColumn16u( segment, &rows[0], ksize, (size_t)cn*luc[k], minVal, k, fineBits, 1 );
+                            medianHistUpdateColumn16u( segment, &rows[0], ksize, (size_t)cn*(luc[k] - 2*r - 1), minVal, k, fineBits, -1 );
+                        }
+                    }
+                }
+                else if( luc[k] <= j-r )
+                {
+                    const HT* px = h_fine + (size_t)FB*n*k;
+                    memset( segment, 0, FB*sizeof(HT) );
+                    for( luc[k] = HT(j - r); luc[k] < j + r + 1; ++luc[k] )
+                        medianHistAdd( segment, px + FB*luc[k], FB );
+                }
+                else
+                {
+                    const HT* px = h_fine + (size_t)FB*n*k;
+                    for( ; luc[k] < j + r + 1; ++luc[k] )
+                        medianHistAddSub( segment, px + FB*luc[k], px + FB*(luc[k] - 2*r - 1), FB );
+                }
+
+                medianHistSub( H_coarse, h_coarse + CB*(j - r), CB );
+
+                // Find median in segment
+                b = medianHistFind( segment, FB, t, sum );
+                CV_Assert( b < FB );
+                dst[cn*j] = (ushort)(minVal + (k << fineBits) + b);
+            }
+        }
+    }
+
+#undef COP16
+}
+
+
 namespace {
 
 struct MinMax8u
@@ -838,6 +1049,73 @@ medianBlur_SortNet( const Mat& _src, Mat& _dst, int m )
     }
 }
 
+class MedianBlurOmInvoker : public ParallelLoopBody
+{
+public:
+    MedianBlurOmInvoker(const Mat& src_, Mat& dst_, int ksize_) :
+        src(src_), dst(dst_), ksize(ksize_)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        medianBlur_8u_Om( src, dst, ksize, range );
+    }
+
+private:
+    const Mat& src;
+    Mat& dst;
+    int ksize;
+};
+
+// processes the image by tiles: vertical stripes split into horizontal bands
+class MedianBlurO1Invoker : public ParallelLoopBody
+{
+public:
+    MedianBlurO1Invoker(const Mat& src_, Mat& dst_, int ksize_, Size tile_,
+                        int minVal_ = 0, int coarseBits_ = 0, int fineBits_ = 0, bool fineColumnHist_ = true) :
+        src(src_), dst(dst_), ksize(ksize_), tile(tile_),
+        minVal(minVal_), coarseBits(coarseBits_), fineBits(fineBits_), fineColumnHist(fineColumnHist_)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        std::vector<ushort> buf;
+        const int nx = divUp(dst.cols, tile.width);
+        for( int idx = range.start; idx < range.end; idx++ )
+        {
+            Rect roi(Point((idx % nx)*tile.width, (idx / nx)*tile.height), tile);
+            roi &= Rect(0, 0, dst.cols, dst.rows);
+            if( dst.depth() == CV_8U )
+                medianBlur_8u_O1( src, dst, ksize, roi );
+            else
+                medianBlur_16u_O1( src, dst, ksize, roi, minVal, coarseBits, fineBits, fineColumnHist, buf );
+        }
+    }
+
+private:
+    const Mat& src;
+    Mat& dst;
+    int ksize;
+    Size tile;
+    int minVal, coarseBits, fineBits;
+    bool fineColumnHist;
+};
+
+static void medianBlur_O1_parallel( const Mat& src, Mat& dst, int ksize, int tileWidth,
+                                    int minVal = 0, int coarseBits = 0, int fineBits = 0, bool fineColumnHist = true )
+{
+    const int nx = divUp(dst.cols, tileWidth);
+    const int nThreads = getNumThreads();
+    // every band initializes the column histograms from ksize rows again
+    int ny = nThreads > 1 ? divUp(nThreads*4, nx) : 1;
+    ny = std::max(1, std::min(ny, dst.rows / (ksize*4)));
+    Size tile(tileWidth, divUp(dst.rows, ny));
+    ny = divUp(dst.rows, tile.height);
+    parallel_for_(Range(0, nx*ny), MedianBlurO1Invoker(src, dst, ksize, tile, minVal, coarseBits, fineBits, fineColumnHist));
+}
+
 } // namespace anon
 
 void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize)
@@ -877,14 +1155,37 @@ void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize)
         cv::copyMakeBorder( src0, src, 0, 0, ksize/2, ksize/2, BORDER_REPLICATE|BORDER_ISOLATED);
 
         int cn = src0.channels();
-        CV_Assert( src.depth() == CV_8U && (cn == 1 || cn == 3 || cn == 4) );
+        CV_Assert( (src.depth() == CV_8U || src.depth() == CV_16U) && (cn == 1 || cn == 3 || cn == 4) );
+
+        if( src.depth() == CV_16U )
+        {
+            // histogram counters are 16-bit
+            CV_CheckLE(ksize, 255, "medianBlur: aperture size of 16-bit images is limited to 255");
+            double minVal = 0, maxVal = 0;
+            minMaxIdx( src0.reshape(1), &minVal, &maxVal );
+            const int range = (int)(maxVal - minVal);
+            int bits = 8;
+            while( bits < 16 && (range >> bits) != 0 )
+                bits++;
+            const int coarseBits = bits / 2, fineBits = bits - coarseBits;
+            // column histograms of a tile take about 1Mb. A tile is never narrower than the aperture,
+            // so fine column histograms are not kept if they don't fit for the value range of the image
+            // (e.g. 128Kb per column for the full 16-bit range)
+            const size_t histLimit = (size_t)1 << 20;
+            const bool fineColumnHist = (((size_t)1 << bits)*sizeof(ushort))*(2*ksize - 1) <= histLimit;
+            const size_t colHistSize = ((fineColumnHist ? ((size_t)1 << bits) : 0) + ((size_t)1 << coarseBits))*sizeof(ushort);
+            int tileWidth = std::max(ksize, (int)(histLimit / colHistSize) - (ksize - 1));
+            tileWidth = std::min(tileWidth, std::min(dst.cols, 512/cn));
+            medianBlur_O1_parallel( src, dst, ksize, tileWidth, (int)minVal, coarseBits, fineBits, fineColumnHist );
+            return;
+        }
 
         double img_size_mp = (double)(src0.total())/(1 << 20);
         if( ksize <= 3 + (img_size_mp < 1 ? 12 : img_size_mp < 4 ? 6 : 2)*
             ((CV_SIMD || CV_SIMD_SCALABLE) ? 1 : 3))
-            medianBlur_8u_Om( src, dst, ksize );
+            parallel_for_( Range(0, dst.cols), MedianBlurOmInvoker(src, dst, ksize), getNumThreads()*4 );
         else
-            medianBlur_8u_O1( src, dst, ksize );
+            medianBlur_O1_parallel( src, dst, ksize, std::min(dst.cols, 512/cn) );
     }
 }
 
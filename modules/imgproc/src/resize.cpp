@@ -59,6 +59,9 @@
 #include "opencv2/core/softfloat.hpp"
 #include "fixedpoint.inl.hpp"
 
+#include <list>
+#include <unordered_map>
+
 using namespace cv;
 
 namespace
@@ -3821,31 +3824,153 @@ static bool ipp_resize(const uchar * src_data, size_t src_step, int src_width, i
 
 //==================================================================================================
 
-namespace hal {
+// Coordinate and coefficient tables of the separable resize (INTER_LINEAR, INTER_CUBIC, INTER_LANCZOS4
+// and INTER_AREA upscaling)
+struct ResizeTables
+{
+    AutoBuffer<uchar> buffer;
+    int* xofs;
+    int* yofs;
+    void* alpha;
+    void* beta;
+    int xmin, xmax, ksize;
+};
 
-void resize(int src_type,
-            const uchar * src_data, size_t src_step, int src_width, int src_height,
-            uchar * dst_data, size_t dst_step, int dst_width, int dst_height,
-            double inv_scale_x, double inv_scale_y, int interpolation)
+static void computeResizeTables(ResizeTables& tab, int depth, int cn, int src_width, Size dsize,
+                                double inv_scale_x, double inv_scale_y, int interpolation)
 {
-    CV_INSTRUMENT_REGION();
+    double scale_x = 1./inv_scale_x, scale_y = 1./inv_scale_y;
+    int k, sx, sy, dx, dy;
+    int xmin = 0, xmax = dsize.width, width = dsize.width*cn;
+    bool area_mode = interpolation == INTER_AREA;
+    bool fixpt = depth == CV_8U;
+    float fx, fy;
+    int ksize, ksize2;
+    if( interpolation == INTER_CUBIC )
+        ksize = 4;
+    else if( interpolation == INTER_LANCZOS4 )
+        ksize = 8;
+    else
+        ksize = 2;
+    ksize2 = ksize/2;
 
-    CV_Assert((dst_width > 0 && dst_height > 0) || (inv_scale_x > 0 && inv_scale_y > 0));
-    if (inv_scale_x < DBL_EPSILON || inv_scale_y < DBL_EPSILON)
+    tab.buffer.allocate((width + dsize.height)*(sizeof(int) + sizeof(float)*ksize));
+    int* xofs = (int*)tab.buffer.data();
+    int* yofs = xofs + width;
+    float* alpha = (float*)(yofs + dsize.height);
+    short* ialpha = (short*)alpha;
+    float* beta = alpha + width*ksize;
+    short* ibeta = ialpha + width*ksize;
+    float cbuf[MAX_ESIZE] = {0};
+
+    for( dx = 0; dx < dsize.width; dx++ )
     {
-        inv_scale_x = static_cast<double>(dst_width) / src_width;
-        inv_scale_y = static_cast<double>(dst_height) / src_height;
+        if( !area_mode )
+        {
+            fx = (float)((dx+0.5)*scale_x - 0.5);
+            sx = cvFloor(fx);
+            fx -= sx;
+        }
+        else
+        {
+            sx = cvFloor(dx*scale_x);
+            fx = (float)((dx+1) - (sx+1)*inv_scale_x);
+            fx = fx <= 0 ? 0.f : fx - cvFloor(fx);
+        }
+
+        if( sx < ksize2-1 )
+        {
+            xmin = dx+1;
+            if( sx < 0 && (interpolation != INTER_CUBIC && interpolation != INTER_LANCZOS4))
+                fx = 0, sx = 0;
+        }
+
+        if( sx + ksize2 >= src_width )
+        {
+            xmax = std::min( xmax, dx );
+            if( sx >= src_width-1 && (interpolation != INTER_CUBIC && interpolation != INTER_LANCZOS4))
+                fx = 0, sx = src_width-1;
+        }
+
+        for( k = 0, sx *= cn; k < cn; k++ )
+            xofs[dx*cn + k] = sx + k;
+
+        if( interpolation == INTER_CUBIC )
+            interpolateCubic( fx, cbuf );
+        else if( interpolation == INTER_LANCZOS4 )
+            interpolateLanczos4( fx, cbuf );
+        else
+        {
+            cbuf[0] = 1.f - fx;
+            cbuf[1] = fx;
+        }
+        if( fixpt )
+        {
+            for( k = 0; k < ksize; k++ )
+                ialpha[dx*cn*ksize + k] = saturate_cast<short>(cbuf[k]*INTER_RESIZE_COEF_SCALE);
+            for( ; k < cn*ksize; k++ )
+                ialpha[dx*cn*ksize + k] = ialpha[dx*cn*ksize + k - ksize];
+        }
+        else
+        {
+            for( k = 0; k < ksize; k++ )
+                alpha[dx*cn*ksize + k] = cbuf[k];
+            for( ; k < cn*ksize; k++ )
+                alpha[dx*cn*ksize + k] = alpha[dx*cn*ksize + k - ksize];
+        }
     }
 
-    CALL_HAL(resize, cv_hal_resize, src_type, src_data, src_step, src_width, src_height, dst_data, dst_step, dst_width, dst_height, inv_scale_x, inv_scale_y, interpolation);
+    for( dy = 0; dy < dsize.height; dy++ )
+    {
+        if( !area_mode )
+        {
+            fy = (float)((dy+0.5)*scale_y - 0.5);
+            sy = cvFloor(fy);
+            fy -= sy;
+        }
+        else
+        {
+            sy = cvFloor(dy*scale_y);
+            fy = (float)((dy+1) - (sy+1)*inv_scale_y);
+            fy = fy <= 0 ? 0.f : fy - cvFloor(fy);
+        }
 
-    int  depth = CV_MAT_DEPTH(src_type), cn = CV_MAT_CN(src_type);
-    Size dsize = Size(saturate_cast<int>(src_width*inv_scale_x),
-                        saturate_cast<int>(src_height*inv_scale_y));
-    CV_Assert( !dsize.empty() );
+        yofs[dy] = sy;
+        if( interpolation == INTER_CUBIC )
+            interpolateCubic( fy, cbuf );
+        else if( interpolation == INTER_LANCZOS4 )
+            interpolateLanczos4( fy, cbuf );
+        else
+        {
+            cbuf[0] = 1.f - fy;
+            cbuf[1] = fy;
+        }
+
+        if( fixpt )
+        {
+            for( k = 0; k < ksize; k++ )
+                ibeta[dy*ksize + k] = saturate_cast<short>(cbuf[k]*INTER_RESIZE_COEF_SCALE);
+        }
+        else
+        {
+            for( k = 0; k < ksize; k++ )
+                beta[dy*ksize + k] = cbuf[k];
+        }
+    }
 
-    CV_IPP_RUN_FAST(ipp_resize(src_data, src_step, src_width, src_height, dst_data, dst_step, dsize.width, dsize.height, inv_scale_x, inv_scale_y, depth, cn, interpolation))
 
+    tab.xofs = xofs;
+    tab.yofs = yofs;
+    tab.alpha = fixpt ? (void*)ialpha : (void*)alpha;
+    tab.beta = fixpt ? (void*)ibeta : (void*)beta;
+    tab.xmin = xmin;
+    tab.xmax = xmax;
+    tab.ksize = ksize;
+}
+
+// Separable resize implementation working on ResizeTables
+static ResizeFunc getResizeFunc(int depth, int interpolation)
+{
     static ResizeFunc linear_tab[] =
     {
         resizeGeneric_<
@@ -3931,6 +4056,125 @@ void resize(int src_type,
         0
     };
 
+    ResizeFunc func=0;
+    if( interpolation == INTER_CUBIC )
+        func = cubic_tab[depth];
+    else if( interpolation == INTER_LANCZOS4 )
+        func = lanczos4_tab[depth];
+    else if( interpolation == INTER_LINEAR || interpolation == INTER_AREA )
+        func = linear_tab[depth];
+    else
+        CV_Error( cv::Error::StsBadArg, "Unknown interpolation method" );
+    return func;
+}
+
+// Tables shared by the images of resizeBatch(). Batches usually contain few distinct geometries,
+// the number of kept tables is limited (least recently used tables are dropped).
+class ResizeTablesCache
+{
+public:
+    enum { MAX_ENTRIES = 64 };
+
+    Ptr<ResizeTables> get(int depth, int cn, int src_width, int src_height, Size dsize,
+                          double inv_scale_x, double inv_scale_y, int interpolation)
+    {
+        Key key;
+        key.fixpt = depth == CV_8U;
+        key.cn = cn;
+        key.ssize = Size(src_width, src_height);
+        key.dsize = dsize;
+        key.inv_scale_x = inv_scale_x;
+        key.inv_scale_y = inv_scale_y;
+        key.interpolation = interpolation;
+        {
+            AutoLock lock(mutex);
+            Ptr<ResizeTables> tables = find(key);
+            if (tables)
+                return tables;
+        }
+        // computed without lock, concurrent threads may compute the same tables
+        Ptr<ResizeTables> tables = makePtr<ResizeTables>();
+        computeResizeTables(*tables, depth, cn, src_width, dsize, inv_scale_x, inv_scale_y, interpolation);
+        AutoLock lock(mutex);
+        Ptr<ResizeTables> existing = find(key);
+        if (existing)
+            return existing;
+        lru.push_front(std::make_pair(key, tables));
+        index[key] = lru.begin();
+        if (lru.size() > MAX_ENTRIES)
+        {
+            index.erase(lru.back().first);
+            lru.pop_back();
+        }
+        return tables;
+    }
+
+private:
+    struct Key
+    {
+        bool fixpt;
+        int cn;
+        Size ssize, dsize;
+        double inv_scale_x, inv_scale_y;
+        int interpolation;
+
+        bool operator==(const Key& k) const
+        {
+            return fixpt == k.fixpt && cn == k.cn && ssize == k.ssize && dsize == k.dsize &&
+                   inv_scale_x == k.inv_scale_x && inv_scale_y == k.inv_scale_y && interpolation == k.interpolation;
+        }
+    };
+    struct KeyHash
+    {
+        size_t operator()(const Key& k) const
+        {
+            size_t h = (size_t)k.fixpt;
+            const int ivalues[] = { k.cn, k.ssize.width, k.ssize.height, k.dsize.width, k.dsize.height, k.interpolation };
+            for (size_t i = 0; i < sizeof(ivalues) / sizeof(ivalues[0]); i++)
+                h = h * 31 + (size_t)ivalues[i];
+            h = h * 31 + std::hash<double>()(k.inv_scale_x);
+            h = h * 31 + std::hash<double>()(k.inv_scale_y);
+            return h;
+        }
+    };
+    typedef std::list<std::pair<Key, Ptr<ResizeTables> > > LRUList;  // the most recently used tables are first
+
+    Ptr<ResizeTables> find(const Key& key)
+    {
+        std::unordered_map<Key, LRUList::iterator, KeyHash>::const_iterator it = index.find(key);
+        if (it == index.end())
+            return Ptr<ResizeTables>();
+        lru.splice(lru.begin(), lru, it->second);
+        return it->second->second;
+    }
+
+    Mutex mutex;
+    LRUList lru;
+    std::unordered_map<Key, LRUList::iterator, KeyHash> index;
+};
+
+static void resize_(int src_type,
+                    const uchar * src_data, size_t src_step, int src_width, int src_height,
+                    uchar * dst_data, size_t dst_step, int dst_width, int dst_height,
+                    double inv_scale_x, double inv_scale_y, int interpolation,
+                    ResizeTablesCache* cache)
+{
+    CV_Assert((dst_width > 0 && dst_height > 0) || (inv_scale_x > 0 && inv_scale_y > 0));
+    if (inv_scale_x < DBL_EPSILON || inv_scale_y < DBL_EPSILON)
+    {
+        inv_scale_x = static_cast<double>(dst_width) / src_width;
+        inv_scale_y = static_cast<double>(dst_height) / src_height;
+    }
+
+    CALL_HAL(resize, cv_hal_resize, src_type, src_data, src_step, src_width, src_height, dst_data, dst_step, dst_width, dst_height, inv_scale_x, inv_scale_y, interpolation);
+
+    int  depth = CV_MAT_DEPTH(src_type), cn = CV_MAT_CN(src_type);
+    Size dsize = Size(saturate_cast<int>(src_width*inv_scale_x),
+                        saturate_cast<int>(src_height*inv_scale_y));
+    CV_Assert( !dsize.empty() );
+
+    CV_IPP_RUN_FAST(ipp_resize(src_data, src_step, src_width, src_height, dst_data, dst_step, dsize.width, dsize.height, inv_scale_x, inv_scale_y, depth, cn, interpolation))
+
     static ResizeAreaFastFunc areafast_tab[] =
     {
         resizeAreaFast_<uchar, int, ResizeAreaFastVec<uchar, ResizeAreaFastVec_SIMD_8u> >,
@@ -4067,130 +4311,131 @@ void resize(int src_type,
         }
     }
 
-    int xmin = 0, xmax = dsize.width, width = dsize.width*cn;
-    bool area_mode = interpolation == INTER_AREA;
-    bool fixpt = depth == CV_8U;
-    float fx, fy;
-    ResizeFunc func=0;
-    int ksize=0, ksize2;
-    if( interpolation == INTER_CUBIC )
-        ksize = 4, func = cubic_tab[depth];
-    else if( interpolation == INTER_LANCZOS4 )
-        ksize = 8, func = lanczos4_tab[depth];
-    else if( interpolation == INTER_LINEAR || interpolation == INTER_AREA )
-        ksize = 2, func = linear_tab[depth];
-    else
-        CV_Error( cv::Error::StsBadArg, "Unknown interpolation method" );
-    ksize2 = ksize/2;
-
+    ResizeFunc func = getResizeFunc(depth, interpolation);
     CV_Assert( func != 0 );
 
-    AutoBuffer<uchar> _buffer((width + dsize.height)*(sizeof(int) + sizeof(float)*ksize));
-    int* xofs = (int*)_buffer.data();
-    int* yofs = xofs + width;
-    float* alpha = (float*)(yofs + dsize.height);
-    short* ialpha = (short*)alpha;
-    float* beta = alpha + width*ksize;
-    short* ibeta = ialpha + width*ksize;
-    float cbuf[MAX_ESIZE] = {0};
-
-    for( dx = 0; dx < dsize.width; dx++ )
+    ResizeTables localTab;
+    const ResizeTables* tab = &localTab;
+    Ptr<ResizeTables> cachedTab;  // keeps the tables alive if they are dropped from the cache by other threads
+    if( cache )
     {
-        if( !area_mode )
-        {
-            fx = (float)((dx+0.5)*scale_x - 0.5);
-            sx = cvFloor(fx);
-            fx -= sx;
-        }
-        else
-        {
-            sx = cvFloor(dx*scale_x);
-            fx = (float)((dx+1) - (sx+1)*inv_scale_x);
-            fx = fx <= 0 ? 0.f : fx - cvFloor(fx);
-        }
+        cachedTab = cache->get(depth, cn, src_width, src_height, dsize, inv_scale_x, inv_scale_y, interpolation);
+        tab = cachedTab.get();
+    }
+    else
+        computeResizeTables(localTab, depth, cn, src_width, dsize, inv_scale_x, inv_scale_y, interpolation);
 
-        if( sx < ksize2-1 )
-        {
-            xmin = dx+1;
-            if( sx < 0 && (interpolation != INTER_CUBIC && interpolation != INTER_LANCZOS4))
-                fx = 0, sx = 0;
-        }
+    func( src, dst, tab->xofs, tab->alpha, tab->yofs, tab->beta, tab->xmin, tab->xmax, tab->ksize );
+}
 
-        if( sx + ksize2 >= src_width )
-        {
-            xmax = std::min( xmax, dx );
-            if( sx >= src_width-1 && (interpolation != INTER_CUBIC && interpolation != INTER_LANCZOS4))
-                fx = 0, sx = src_width-1;
-        }
+//==================================================================================================
 
-        for( k = 0, sx *= cn; k < cn; k++ )
-            xofs[dx*cn + k] = sx + k;
+namespace {
 
-        if( interpolation == INTER_CUBIC )
-            interpolateCubic( fx, cbuf );
-        else if( interpolation == INTER_LANCZOS4 )
-            interpolateLanczos4( fx, cbuf );
-        else
-        {
-            cbuf[0] = 1.f - fx;
-            cbuf[1] = fx;
-        }
-        if( fixpt )
-        {
-            for( k = 0; k < ksize; k++ )
-                ialpha[dx*cn*ksize + k] = saturate_cast<short>(cbuf[k]*INTER_RESIZE_COEF_SCALE);
-            for( ; k < cn*ksize; k++ )
-                ialpha[dx*cn*ksize + k] = ialpha[dx*cn*ksize + k - ksize];
-        }
-        else
-        {
-            for( k = 0; k < ksize; k++ )
-                alpha[dx*cn*ksize + k] = cbuf[k];
-            for( ; k < cn*ksize; k++ )
-                alpha[dx*cn*ksize + k] = alpha[dx*cn*ksize + k - ksize];
-        }
+class ResizeBandsInvoker : public ParallelLoopBody
+{
+public:
+    ResizeBandsInvoker(const ResizeBandSource& _source, Size _ssize, int _type, Size _dsize,
+                       const ResizeTables& _tab, ResizeFunc _func, const ResizeBandSink& _sink, int _dstBandRows) :
+        source(_source), ssize(_ssize), type(_type), dsize(_dsize), tab(_tab), func(_func), sink(_sink),
+        dstBandRows(_dstBandRows)
+    {
     }
 
-    for( dy = 0; dy < dsize.height; dy++ )
+    void operator()(const Range& range) const CV_OVERRIDE
     {
-        if( !area_mode )
-        {
-            fy = (float)((dy+0.5)*scale_y - 0.5);
-            sy = cvFloor(fy);
-            fy -= sy;
-        }
-        else
-        {
-            sy = cvFloor(dy*scale_y);
-            fy = (float)((dy+1) - (sy+1)*inv_scale_y);
-            fy = fy <= 0 ? 0.f : fy - cvFloor(fy);
-        }
+        const int ksize = tab.ksize, ksize2 = ksize/2, align = source.rowAlignment();
+        const size_t betaStep = ksize*(CV_MAT_DEPTH(type) == CV_8U ? sizeof(short) : sizeof(float));
+        AutoBuffer<int> yofs(dstBandRows);
+        Mat srcBuf, dstBuf(dstBandRows, dsize.width, type);
 
-        yofs[dy] = sy;
-        if( interpolation == INTER_CUBIC )
-            interpolateCubic( fy, cbuf );
-        else if( interpolation == INTER_LANCZOS4 )
-            interpolateLanczos4( fy, cbuf );
-        else
+        for (int dy0 = range.start; dy0 < range.end; dy0 += dstBandRows)
         {
-            cbuf[0] = 1.f - fy;
-            cbuf[1] = fy;
+            const int dy1 = std::min(dy0 + dstBandRows, range.end);
+
+            // source rows used by the destination rows [dy0, dy1), see resizeGeneric_Invoker
+            int sy0 = std::min(std::max(tab.yofs[dy0] - ksize2 + 1, 0), ssize.height - 1);
+            int sy1 = std::min(std::max(tab.yofs[dy1 - 1] - ksize2 + ksize, 0), ssize.height - 1) + 1;
+            sy0 -= sy0 % align;
+            sy1 = std::min((int)alignSize(sy1, align), ssize.height);
+
+            if (srcBuf.rows < sy1 - sy0)
+                srcBuf.create(sy1 - sy0, ssize.width, type);
+            Mat srcBand = srcBuf.rowRange(0, sy1 - sy0), dstBand = dstBuf.rowRange(0, dy1 - dy0);
+            source.getBand(sy0, srcBand);
+
+            for (int dy = dy0; dy < dy1; dy++)
+                yofs[dy - dy0] = tab.yofs[dy] - sy0;
+            func(srcBand, dstBand, tab.xofs, tab.alpha, yofs.data(), (const uchar*)tab.beta + betaStep*dy0,
+                 tab.xmin, tab.xmax, ksize);
+            sink.putBand(dy0, dstBand);
         }
+    }
 
-        if( fixpt )
-        {
-            for( k = 0; k < ksize; k++ )
-                ibeta[dy*ksize + k] = saturate_cast<short>(cbuf[k]*INTER_RESIZE_COEF_SCALE);
-        }
-        else
-        {
-            for( k = 0; k < ksize; k++ )
-                beta[dy*ksize + k] = cbuf[k];
-        }
+private:
+    const ResizeBandSource& source;
+    Size ssize;
+    int type;
+    Size dsize;
+    const ResizeTables& tab;
+    ResizeFunc func;
+    const ResizeBandSink& sink;
+    int dstBandRows;
+};
+
+} // namespace
+
+bool resizeBands(const ResizeBandSource& source, Size ssize, int type, Size dsize, int interpolation,
+                 const ResizeBandSink& sink)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert(!ssize.empty() && !dsize.empty());
+    if (ssize == dsize)
+        return false;
+
+    const double inv_scale_x = (double)dsize.width/ssize.width, inv_scale_y = (double)dsize.height/ssize.height;
+    const double scale_x = 1./inv_scale_x, scale_y = 1./inv_scale_y;
+    const int iscale_x = saturate_cast<int>(scale_x), iscale_y = saturate_cast<int>(scale_y);
+    const bool is_area_fast = std::abs(scale_x - iscale_x) < DBL_EPSILON &&
+                              std::abs(scale_y - iscale_y) < DBL_EPSILON;
+
+    // only the modes resize_() handles with the separable resizeGeneric_()
+    if (interpolation == INTER_LINEAR)
+    {
+        if (is_area_fast && iscale_x == 2 && iscale_y == 2)
+            return false;
     }
+    else if (interpolation != INTER_CUBIC && interpolation != INTER_LANCZOS4)
+        return false;
 
-    func( src, dst, xofs, fixpt ? (void*)ialpha : (void*)alpha, yofs,
-          fixpt ? (void*)ibeta : (void*)beta, xmin, xmax, ksize );
+    const int depth = CV_MAT_DEPTH(type), cn = CV_MAT_CN(type);
+    ResizeFunc func = getResizeFunc(depth, interpolation);
+    if (!func)
+        return false;
+
+    ResizeTables tab;
+    computeResizeTables(tab, depth, cn, ssize.width, dsize, inv_scale_x, inv_scale_y, interpolation);
+
+    // destination rows per band: the source band should stay in L2 cache
+    const int srcBandRows = std::max(32, tab.ksize*4);
+    const int dstBandRows = std::max(cvFloor(srcBandRows*inv_scale_y), 1);
+    ResizeBandsInvoker invoker(source, ssize, type, dsize, tab, func, sink, dstBandRows);
+    parallel_for_(Range(0, dsize.height), invoker, (double)dsize.height/dstBandRows);
+    return true;
+}
+
+namespace hal {
+
+void resize(int src_type,
+            const uchar * src_data, size_t src_step, int src_width, int src_height,
+            uchar * dst_data, size_t dst_step, int dst_width, int dst_height,
+            double inv_scale_x, double inv_scale_y, int interpolation)
+{
+    CV_INSTRUMENT_REGION();
+
+    resize_(src_type, src_data, src_step, src_width, src_height, dst_data, dst_step, dst_width, dst_height,
+            inv_scale_x, inv_scale_y, interpolation, NULL);
 }
 
 } // cv::hal::
@@ -4245,6 +4490,78 @@ void cv::resize( InputArray _src, OutputArray _dst, Size dsize,
     hal::resize(src.type(), src.data, src.step, src.cols, src.rows, dst.data, dst.step, dst.cols, dst.rows, inv_scale_x, inv_scale_y, interpolation);
 }
 
+namespace cv
+{
+
+class ResizeBatchInvoker :
+    public ParallelLoopBody
+{
+public:
+    ResizeBatchInvoker(const std::vector<Mat>& _src, const std::vector<Mat>& _dst,
+                       int _interpolation, ResizeTablesCache& _cache) :
+        ParallelLoopBody(), src(_src), dst(_dst), interpolation(_interpolation), cache(_cache)
+    {
+    }
+
+    virtual void operator() (const Range& range) const CV_OVERRIDE
+    {
+        for( int i = range.start; i < range.end; i++ )
+        {
+            const Mat& s = src[i];
+            const Mat& d = dst[i];
+            if( s.size() == d.size() )
+            {
+                s.copyTo(d);
+                continue;
+            }
+            int method = interpolation;
+            if( method == INTER_LINEAR_EXACT && (s.depth() == CV_32F || s.depth() == CV_64F) )
+                method = INTER_LINEAR;
+            resize_(s.type(), s.data, s.step, s.cols, s.rows, d.data, d.step, d.cols, d.rows,
+                    (double)d.cols/s.cols, (double)d.rows/s.rows, method, &cache);
+        }
+    }
+
+private:
+    const std::vector<Mat>& src;
+    const std::vector<Mat>& dst;
+    int interpolation;
+    ResizeTablesCache& cache;
+
+    ResizeBatchInvoker& operator = (const ResizeBatchInvoker&);
+};
+
+} // cv::
+
+void cv::resizeBatch( InputArrayOfArrays _src, OutputArrayOfArrays _dst,
+                      const std::vector<Size>& dsize, int interpolation )
+{
+    CV_INSTRUMENT_REGION();
+
+    std::vector<Mat> src;
+    _src.getMatVector(src);
+    int i, n = (int)src.size();
+    CV_Assert( dsize.size() == 1 || dsize.size() == src.size() );
+
+    _dst.create(n, 1, 0);
+    std::vector<Mat> dst(n);
+    for( i = 0; i < n; i++ )
+    {
+        Size sz = dsize[dsize.size() == 1 ? 0 : i];
+        CV_Assert( !src[i].empty() && src[i].dims <= 2 && !sz.empty() );
+        _dst.create(sz, src[i].type(), i);
+        dst[i] = _dst.getMat(i);
+    }
+
+    // Small images are resized in parallel, each of them by a single thread
+    ResizeTablesCache cache;
+    ResizeBatchInvoker invoker(src, dst, interpolation, cache);
+    if( n >= getNumThreads() )
+        parallel_for_(Range(0, n), invoker);
+    else
+        invoker(Range(0, n));
+}
+
 
 CV_IMPL void
 cvResize( const CvArr* srcarr, CvArr* dstarr, int method )
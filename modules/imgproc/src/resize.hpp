@@ -53,6 +53,31 @@
 
 namespace cv
 {
+// Source image of resizeBands(): the rows are produced on demand, so the whole image is never stored
+class ResizeBandSource
+{
+public:
+    virtual ~ResizeBandSource() {}
+    // fills band with the source rows [y, y + band.rows)
+    virtual void getBand(int y, Mat& band) const = 0;
+    // y and the band height are multiples of it, unless the band ends at the last row
+    virtual int rowAlignment() const { return 1; }
+};
+
+// Destination of resizeBands(), receives the resized rows [y, y + band.rows)
+class ResizeBandSink
+{
+public:
+    virtual ~ResizeBandSink() {}
+    virtual void putBand(int y, const Mat& band) const = 0;
+};
+
+// Resizes the image of the given size and type band by band, the bands are processed in parallel.
+// Produces the same result as cv::resize(). Returns false if the interpolation is not separable
+// (or is handled by another code path in cv::resize()), the caller is expected to fall back then.
+bool resizeBands(const ResizeBandSource& source, Size ssize, int type, Size dsize, int interpolation,
+                 const ResizeBandSink& sink);
+
 namespace opt_AVX2
 {
 #if CV_TRY_AVX2
@@ -606,6 +606,20 @@ static bool validateGaussianBlurKernel(std::vector<T>& kernel)
     return isValid;
 }
 
+// The recursive filter cost does not depend on sigma, it replaces the separable one
+// for large sigmas, when the kernel is not truncated below its default size.
+static bool useRecursiveGaussian(Size ksize, double& sigma1, double& sigma2)
+{
+    const double minSigma = 10;
+    if (sigma1 <= 0)
+        sigma1 = ksize.width > 0 ? 0.3*((ksize.width - 1)*0.5 - 1) + 0.8 : 0;
+    if (sigma2 <= 0)
+        sigma2 = ksize.height > 0 ? 0.3*((ksize.height - 1)*0.5 - 1) + 0.8 : 0;
+    return sigma1 >= minSigma && sigma2 >= minSigma &&
+        (ksize.width <= 0 || ksize.width >= cvRound(sigma1*3)*2 + 1) &&
+        (ksize.height <= 0 || ksize.height >= cvRound(sigma2*3)*2 + 1);
+}
+
 void GaussianBlur(InputArray _src, OutputArray _dst, Size ksize,
                   double sigma1, double sigma2,
                   int borderType, AlgorithmHint hint)
@@ -646,6 +660,19 @@ void GaussianBlur(InputArray _src, OutputArray _dst, Size ksize,
 
     int sdepth = CV_MAT_DEPTH(type), cn = CV_MAT_CN(type);
 
+    if (hint == ALGO_HINT_APPROX && sdepth != CV_64F && _src.dims() <= 2 &&
+        (borderType & ~BORDER_ISOLATED) != BORDER_WRAP && (borderType & ~BORDER_ISOLATED) != BORDER_CONSTANT &&
+        ((borderType & BORDER_ISOLATED) || !_src.isSubmatrix()))
+    {
+        double rsigma1 = sigma1, rsigma2 = sigma2;
+        if (useRecursiveGaussian(ksize, rsigma1, rsigma2))
+        {
+            Mat src = _src.getMat(), dst = _dst.getMat();
+            GaussianBlurRecursive(src, dst, rsigma1, rsigma2, borderType);
+            return;
+        }
+    }
+
     Mat kx, ky;
     createGaussianKernels(kx, ky, type, ksize, sigma1, sigma2);
 
@@ -903,7 +903,7 @@ static void matchTemplateMask( InputArray _img, InputArray _templ, OutputArray _
     }
 }
 
-static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method, int cn )
+static void common_matchTemplate( const Mat& sum, const Mat& sqsum, const Mat& templ, Mat& result, int method, int cn )
 {
     if( method == cv::TM_CCORR )
         return;
@@ -916,19 +916,16 @@ static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method,
 
     double invArea = 1./((double)templ.rows * templ.cols);
 
-    Mat sum, sqsum;
     Scalar templMean, templSdv;
-    double *q0 = 0, *q1 = 0, *q2 = 0, *q3 = 0;
+    const double *q0 = 0, *q1 = 0, *q2 = 0, *q3 = 0;
     double templNorm = 0, templSum2 = 0;
 
     if( method == cv::TM_CCOEFF )
     {
-        integral(img, sum, CV_64F);
         templMean = mean(templ);
     }
     else
     {
-        integral(img, sum, sqsum, CV_64F);
         meanStdDev( templ, templMean, templSdv );
 
         templNorm = templSdv[0]*templSdv[0] + templSdv[1]*templSdv[1] + templSdv[2]*templSdv[2] + templSdv[3]*templSdv[3];
@@ -952,17 +949,17 @@ static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method,
         templNorm /= std::sqrt(invArea); // care of accuracy here
 
         CV_Assert(sqsum.data != NULL);
-        q0 = (double*)sqsum.data;
+        q0 = sqsum.ptr<double>();
         q1 = q0 + templ.cols*cn;
-        q2 = (double*)(sqsum.data + templ.rows*sqsum.step);
+        q2 = sqsum.ptr<double>(templ.rows);
         q3 = q2 + templ.cols*cn;
     }
 
     CV_Assert(sum.data != NULL);
-    double* p0 = (double*)sum.data;
-    double* p1 = p0 + templ.cols*cn;
-    double* p2 = (double*)(sum.data + templ.rows*sum.step);
-    double* p3 = p2 + templ.cols*cn;
+    const double* p0 = sum.ptr<double>();
+    const double* p1 = p0 + templ.cols*cn;
+    const double* p2 = sum.ptr<double>(templ.rows);
+    const double* p3 = p2 + templ.cols*cn;
 
     int sumstep = sum.data ? (int)(sum.step / sizeof(double)) : 0;
     int sqstep = sqsum.data ? (int)(sqsum.step / sizeof(double)) : 0;
@@ -1027,6 +1024,20 @@ static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method,
         }
     }
 }
+
+static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method, int cn )
+{
+    if( method == cv::TM_CCORR )
+        return;
+
+    Mat sum, sqsum;
+    if( method == cv::TM_CCOEFF )
+        integral(img, sum, CV_64F);
+    else
+        integral(img, sum, sqsum, CV_64F);
+
+    common_matchTemplate(sum, sqsum, templ, result, method, cn);
+}
 }
 
 
@@ -1193,6 +1204,255 @@ void cv::matchTemplate( InputArray _img, InputArray _templ, OutputArray _result,
     common_matchTemplate(img, templ, result, method, cn);
 }
 
+namespace cv
+{
+
+// Correlation of one image with many templates. The image is split into tiles sized for the largest
+// template, the spectra of all the tiles are computed once and shared by all the templates.
+struct MatchTemplateBatchTiles
+{
+    MatchTemplateBatchTiles(const Mat& img, Size maxTemplSize, Size minTemplSize, int depth_) :
+        depth(depth_), cn(img.channels())
+    {
+        const double blockScale = 4.5;
+        const int minBlockSize = 256;
+        Size corrSize(img.cols - minTemplSize.width + 1, img.rows - minTemplSize.height + 1);
+
+        blocksize.width = cvRound(maxTemplSize.width*blockScale);
+        blocksize.width = std::max( blocksize.width, minBlockSize - maxTemplSize.width + 1 );
+        blocksize.width = std::min( blocksize.width, corrSize.width );
+        blocksize.height = cvRound(maxTemplSize.height*blockScale);
+        blocksize.height = std::max( blocksize.height, minBlockSize - maxTemplSize.height + 1 );
+        blocksize.height = std::min( blocksize.height, corrSize.height );
+
+        dftsize.width = std::max(getOptimalDFTSize(blocksize.width + maxTemplSize.width - 1), 2);
+        dftsize.height = getOptimalDFTSize(blocksize.height + maxTemplSize.height - 1);
+        if( dftsize.width <= 0 || dftsize.height <= 0 )
+            CV_Error( cv::Error::StsOutOfRange, "the input arrays are too big" );
+
+        // every tile gives blocksize correlation values for any of the templates
+        blocksize.width = std::min(dftsize.width - maxTemplSize.width + 1, corrSize.width);
+        blocksize.height = std::min(dftsize.height - maxTemplSize.height + 1, corrSize.height);
+        tileCountX = (corrSize.width + blocksize.width - 1)/blocksize.width;
+        tileCountY = (corrSize.height + blocksize.height - 1)/blocksize.height;
+        spectra.resize((size_t)tileCountX*tileCountY*cn);
+    }
+
+    Rect tileRect(int tile, Size imgSize) const
+    {
+        int x = (tile % tileCountX)*blocksize.width, y = (tile / tileCountX)*blocksize.height;
+        return Rect(x, y, std::min(dftsize.width, imgSize.width - x), std::min(dftsize.height, imgSize.height - y));
+    }
+
+    Size dftsize, blocksize;
+    int tileCountX, tileCountY;
+    int depth, cn;
+    std::vector<Mat> spectra; // tile-major, one spectrum per channel
+};
+
+static void matchTemplateBatch_plane( const Mat& src, Mat& plane, int k, Mat& buf )
+{
+    plane = Scalar::all(0);
+    Mat dst(plane, Rect(0, 0, src.cols, src.rows));
+    if( src.channels() == 1 )
+        src.convertTo(dst, plane.depth());
+    else
+    {
+        extractChannel(src, buf, k);
+        buf.convertTo(dst, plane.depth());
+    }
+}
+
+class MatchTemplateBatchTilesInvoker : public ParallelLoopBody
+{
+public:
+    MatchTemplateBatchTilesInvoker(const Mat& img_, MatchTemplateBatchTiles& tiles_) :
+        img(img_), tiles(tiles_)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        Ptr<hal::DFT2D> c;
+        int cRows = 0;
+        Mat buf;
+        for( int i = range.start; i < range.end; i++ )
+        {
+            int tile = i / tiles.cn, k = i % tiles.cn;
+            Rect r = tiles.tileRect(tile, img.size());
+            Mat& spectrum = tiles.spectra[i];
+            spectrum.create(tiles.dftsize, tiles.depth);
+            matchTemplateBatch_plane(img(r), spectrum, k, buf);
+            if( !c || cRows != r.height )
+            {
+                cRows = r.height;
+                c = hal::DFT2D::create(tiles.dftsize.width, tiles.dftsize.height, tiles.depth, 1, 1, CV_HAL_DFT_IS_INPLACE, cRows);
+            }
+            c->apply(spectrum.data, (int)spectrum.step, spectrum.data, (int)spectrum.step);
+        }
+    }
+
+private:
+    const Mat& img;
+    MatchTemplateBatchTiles& tiles;
+};
+
+class MatchTemplateBatchInvoker : public ParallelLoopBody
+{
+public:
+    MatchTemplateBatchInvoker(const Mat& img_, const std::vector<Mat>& templs_, const std::vector<Mat>& masks_,
+                              std::vector<Mat>& results_, int method_, const MatchTemplateBatchTiles& tiles_,
+                              const Mat& sum_, const Mat& sqsum_) :
+        img(img_), templs(templs_), masks(masks_), results(results_), method(method_), tiles(tiles_),
+        sum(sum_), sqsum(sqsum_)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        const int cn = tiles.cn;
+        std::vector<Mat> templSpectra(cn);
+        Mat acc(tiles.dftsize, tiles.depth), prod(tiles.dftsize, tiles.depth), buf;
+        Ptr<hal::DFT2D> cR = hal::DFT2D::create(tiles.dftsize.width, tiles.dftsize.height, tiles.depth, 1, 1,
+                                                CV_HAL_DFT_IS_INPLACE | CV_HAL_DFT_INVERSE | CV_HAL_DFT_SCALE,
+                                                tiles.blocksize.height);
+
+        for( int t = range.start; t < range.end; t++ )
+        {
+            const Mat& templ = templs[t];
+            Mat& result = results[t];
+
+            if( !masks.empty() && !masks[t].empty() )
+            {
+                matchTemplate(img, templ, result, method, masks[t]);
+                continue;
+            }
+            if( templ.rows > img.rows || templ.cols > img.cols )
+            {
+                // the roles of the image and the template are swapped like in matchTemplate()
+                matchTemplate(img, templ, result, method);
+                continue;
+            }
+
+            Ptr<hal::DFT2D> cF = hal::DFT2D::create(tiles.dftsize.width, tiles.dftsize.height, tiles.depth, 1, 1,
+                                                    CV_HAL_DFT_IS_INPLACE, templ.rows);
+            for( int k = 0; k < cn; k++ )
+            {
+                templSpectra[k].create(tiles.dftsize, tiles.depth);
+                matchTemplateBatch_plane(templ, templSpectra[k], k, buf);
+                cF->apply(templSpectra[k].data, (int)templSpectra[k].step, templSpectra[k].data, (int)templSpectra[k].step);
+            }
+
+            for( int tile = 0; tile < tiles.tileCountX*tiles.tileCountY; tile++ )
+            {
+                int x = (tile % tiles.tileCountX)*tiles.blocksize.width;
+                int y = (tile / tiles.tileCountX)*tiles.blocksize.height;
+                if( x >= result.cols || y >= result.rows )
+                    continue;
+
+                // the channels are summed in the frequency domain, one inverse transform per tile
+                for( int k = 0; k < cn; k++ )
+                {
+                    const Mat& spectrum = tiles.spectra[(size_t)tile*cn + k];
+                    if( k == 0 )
+                        mulSpectrums(spectrum, templSpectra[k], acc, 0, true);
+                    else
+                    {
+                        mulSpectrums(spectrum, templSpectra[k], prod, 0, true);
+                        add(acc, prod, acc);
+                    }
+                }
+                cR->apply(acc.data, (int)acc.step, acc.data, (int)acc.step);
+
+                Rect block(x, y, std::min(tiles.blocksize.width, result.cols - x),
+                           std::min(tiles.blocksize.height, result.rows - y));
+                acc(Rect(0, 0, block.width, block.height)).convertTo(result(block), CV_32F);
+            }
+
+            common_matchTemplate(sum, sqsum, templ, result, method, cn);
+        }
+    }
+
+private:
+    const Mat& img;
+    const std::vector<Mat>& templs;
+    const std::vector<Mat>& masks;
+    std::vector<Mat>& results;
+    int method;
+    const MatchTemplateBatchTiles& tiles;
+    const Mat& sum;
+    const Mat& sqsum;
+};
+
+}
+
+void cv::matchTemplateBatch( InputArray _img, InputArrayOfArrays _templs, OutputArrayOfArrays _results,
+                             int method, InputArrayOfArrays _masks )
+{
+    CV_INSTRUMENT_REGION();
+
+    int type = _img.type(), depth = CV_MAT_DEPTH(type);
+    CV_Assert( cv::TM_SQDIFF <= method && method <= cv::TM_CCOEFF_NORMED );
+    CV_Assert( (depth == CV_8U || depth == CV_32F) && _img.dims() <= 2 );
+
+    Mat img = _img.getMat();
+    std::vector<Mat> templs, masks;
+    _templs.getMatVector(templs);
+    if( !_masks.empty() )
+    {
+        _masks.getMatVector(masks);
+        CV_Assert( masks.size() == templs.size() );
+    }
+
+    int ntempls = (int)templs.size();
+    _results.create(ntempls, 1, CV_32F, -1, true);
+    if( ntempls == 0 )
+        return;
+
+    std::vector<Mat> results(ntempls);
+    Size maxTemplSize, minTemplSize = img.size();
+    for( int t = 0; t < ntempls; t++ )
+    {
+        const Mat& templ = templs[t];
+        CV_Assert( templ.type() == type && templ.dims <= 2 && !templ.empty() );
+        // a template larger than the image is processed like in matchTemplate(): the roles are swapped
+        const bool swapped = templ.rows > img.rows || templ.cols > img.cols;
+        if( swapped )
+            CV_Assert( templ.rows >= img.rows && templ.cols >= img.cols );
+        if( !masks.empty() && !masks[t].empty() )
+            CV_Assert( masks[t].size() == templ.size() );
+        else if( !swapped )
+        {
+            maxTemplSize.width = std::max(maxTemplSize.width, templ.cols);
+            maxTemplSize.height = std::max(maxTemplSize.height, templ.rows);
+            minTemplSize.width = std::min(minTemplSize.width, templ.cols);
+            minTemplSize.height = std::min(minTemplSize.height, templ.rows);
+        }
+
+        _results.create(std::abs(img.rows - templ.rows) + 1, std::abs(img.cols - templ.cols) + 1, CV_32F, t);
+        results[t] = _results.getMat(t);
+    }
+
+    const bool unmasked = maxTemplSize.area() > 0;
+    if( !unmasked )
+        maxTemplSize = minTemplSize = Size(1, 1);
+
+    // the spectra of all the tiles are kept during the call, so they are single-precision even for
+    // floating-point images (matchTemplate uses CV_64F there, the results differ within float accuracy)
+    MatchTemplateBatchTiles tiles(img, maxTemplSize, minTemplSize, CV_32F);
+    if( unmasked )
+        parallel_for_(Range(0, (int)tiles.spectra.size()), MatchTemplateBatchTilesInvoker(img, tiles));
+
+    // the integral images are shared by all the templates
+    Mat sum, sqsum;
+    if( method == cv::TM_CCOEFF )
+        integral(img, sum, CV_64F);
+    else if( method != cv::TM_CCORR )
+        integral(img, sum, sqsum, CV_64F);
+
+    parallel_for_(Range(0, ntempls), MatchTemplateBatchInvoker(img, templs, masks, results, method, tiles, sum, sqsum));
+}
+
 CV_IMPL void
 cvMatchTemplate( const CvArr* _img, const CvArr* _templ, CvArr* _result, int method )
 {
@@ -789,6 +789,95 @@ TEST(Imgproc_ConnectedComponents, single_column)
 }
 
 
+static Mat makeNoisyBlobs(Size size, double threshold, uint64 seed)
+{
+    Mat noise(size, CV_8UC1), img;
+    RNG rng(seed);
+    rng.fill(noise, RNG::UNIFORM, 0, 256);
+    blur(noise, noise, Size(5, 5));
+    cv::threshold(noise, img, threshold, 1, THRESH_BINARY);
+    return img;
+}
+
+static void checkStatsOnly(const Mat& img, int connectivity, int ccltype)
+{
+    Mat labels, stats, centroids, stats2, centroids2, stats3, centroids3;
+    int nLabels = connectedComponentsWithStats(img, labels, stats, centroids, connectivity, CV_32S, ccltype);
+    int nLabels2 = connectedComponentsStats(img, stats2, centroids2, connectivity, ccltype);
+    int nLabels3 = connectedComponentsWithStats(img, noArray(), stats3, centroids3, connectivity, CV_32S, ccltype);
+    ASSERT_EQ(nLabels, nLabels2);
+    ASSERT_EQ(nLabels, nLabels3);
+    EXPECT_EQ(0, cvtest::norm(stats, stats2, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(centroids, centroids2, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(stats, stats3, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(centroids, centroids3, NORM_INF));
+}
+
+TEST(Imgproc_ConnectedComponents, stats_only)
+{
+    const int ccltype[] = { cv::CCL_DEFAULT, cv::CCL_WU, cv::CCL_GRANA, cv::CCL_BOLELLI, cv::CCL_SAUF, cv::CCL_BBDT, cv::CCL_SPAGHETTI };
+    const Size sizes[] = { Size(1, 1), Size(17, 1), Size(1, 23), Size(64, 48), Size(131, 97), Size(320, 241) };
+    const int threads = getNumThreads();
+    for (int nThreads = 1; nThreads <= 4; nThreads += 3)
+    {
+        setNumThreads(nThreads);
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+        {
+            for (int t = 100; t <= 150; t += 25)
+            {
+                Mat img = makeNoisyBlobs(sizes[i], t, i * 1000 + t);
+                for (size_t cclt = 0; cclt < sizeof(ccltype) / sizeof(ccltype[0]); ++cclt)
+                {
+                    SCOPED_TRACE(cv::format("size=%dx%d threshold=%d threads=%d ccltype=%d",
+                                            sizes[i].width, sizes[i].height, t, nThreads, ccltype[cclt]));
+                    checkStatsOnly(img, 8, ccltype[cclt]);
+                    checkStatsOnly(img, 4, ccltype[cclt]);
+                }
+            }
+        }
+    }
+    setNumThreads(threads);
+}
+
+TEST(Imgproc_ConnectedComponents, stats_only_missing_background)
+{
+    Mat m = Mat::ones(10, 10, CV_8U);
+    Mat stats, centroids;
+    EXPECT_EQ(2, cv::connectedComponentsStats(m, stats, centroids));
+    EXPECT_EQ(stats.at<int32_t>(0, cv::CC_STAT_WIDTH), 0);
+    EXPECT_EQ(stats.at<int32_t>(0, cv::CC_STAT_HEIGHT), 0);
+    EXPECT_EQ(stats.at<int32_t>(0, cv::CC_STAT_LEFT), -1);
+    EXPECT_TRUE(std::isnan(centroids.at<double>(0, 0)));
+    EXPECT_TRUE(std::isnan(centroids.at<double>(0, 1)));
+    EXPECT_EQ(stats.at<int32_t>(1, cv::CC_STAT_AREA), 100);
+    EXPECT_EQ(centroids.at<double>(1, 0), 4.5);
+}
+
+TEST(Imgproc_ConnectedComponents, parallel_16u_labels)
+{
+    const int ccltype[] = { cv::CCL_DEFAULT, cv::CCL_WU, cv::CCL_GRANA, cv::CCL_BOLELLI, cv::CCL_SAUF, cv::CCL_BBDT, cv::CCL_SPAGHETTI };
+    Mat img = makeNoisyBlobs(Size(333, 240), 128, 12345);
+    const int threads = getNumThreads();
+    setNumThreads(4);
+    for (size_t cclt = 0; cclt < sizeof(ccltype) / sizeof(ccltype[0]); ++cclt)
+    {
+        for (int connectivity = 4; connectivity <= 8; connectivity += 4)
+        {
+            SCOPED_TRACE(cv::format("ccltype=%d connectivity=%d", ccltype[cclt], connectivity));
+            Mat labels32, labels16, stats32, stats16, centroids32, centroids16;
+            int n32 = connectedComponentsWithStats(img, labels32, stats32, centroids32, connectivity, CV_32S, ccltype[cclt]);
+            int n16 = connectedComponentsWithStats(img, labels16, stats16, centroids16, connectivity, CV_16U, ccltype[cclt]);
+            ASSERT_EQ(n32, n16);
+            ASSERT_EQ(CV_16UC1, labels16.type());
+            Mat labels16to32;
+            labels16.convertTo(labels16to32, CV_32S);
+            EXPECT_EQ(0, cvtest::norm(labels32, labels16to32, NORM_INF));
+            EXPECT_EQ(0, cvtest::norm(stats32, stats16, NORM_INF));
+        }
+    }
+    setNumThreads(threads);
+}
+
 TEST(Imgproc_ConnectedComponents, 4conn_regression_21366)
 {
     Mat src = Mat::zeros(Size(10, 10), CV_8UC1);
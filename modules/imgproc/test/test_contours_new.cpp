@@ -561,6 +561,68 @@ INSTANTIATE_TEST_CASE_P(
                                      CHAIN_APPROX_TC89_L1,
                                      CHAIN_APPROX_TC89_KCOS)));
 
+// Large noisy masks exercise the parallel parts (preprocessing, TC89 approximation),
+// results must not depend on the number of threads
+TEST(Imgproc_FindContours, large_mask_threads)
+{
+    RNG& rng = TS::ptr()->get_rng();
+    Mat noise(Size(1280, 960), CV_8UC1), fimg, img;
+    cvtest::randUni(rng, noise, 0, 255);
+    boxFilter(noise, fimg, CV_8U, Size(7, 7));
+    cv::threshold(fimg, img, 128, 200, THRESH_BINARY);
+
+    Mat labels;
+    connectedComponents(img, labels, 8, CV_32S);
+
+    const int modes[] = { RETR_EXTERNAL, RETR_LIST, RETR_CCOMP, RETR_TREE, RETR_FLOODFILL };
+    const int methods[] = { 0, CHAIN_APPROX_NONE, CHAIN_APPROX_SIMPLE,
+                            CHAIN_APPROX_TC89_L1, CHAIN_APPROX_TC89_KCOS };
+    const int nthreads = getNumThreads();
+    for (int mode : modes)
+    {
+        for (int method : methods)
+        {
+            SCOPED_TRACE(format("mode = %d, method = %d", mode, method));
+            const Mat& src = mode == RETR_FLOODFILL ? labels : img;
+            const int res_type = method == 0 ? CV_8SC1 : CV_32SC2;
+
+            vector<Mat> contours, contours1;
+            vector<Vec4i> hierarchy, hierarchy1;
+            findContours(src, contours, hierarchy, mode, method, Point(3, -2));
+            setNumThreads(1);
+            findContours(src, contours1, hierarchy1, mode, method, Point(3, -2));
+            setNumThreads(nthreads);
+
+            ASSERT_GT(contours.size(), 10u);
+            ASSERT_EQ(contours1.size(), contours.size());
+            for (size_t i = 0; i < contours.size(); ++i)
+            {
+                SCOPED_TRACE(format("contour = %zu", i));
+                ASSERT_EQ(res_type, contours[i].type());
+                EXPECT_MAT_NEAR(contours1[i], contours[i], 0);
+            }
+            EXPECT_MAT_NEAR(Mat(hierarchy1), Mat(hierarchy), 0);
+
+#if CHECK_OLD
+            if (mode != RETR_FLOODFILL &&
+                (method == CHAIN_APPROX_NONE || method == CHAIN_APPROX_SIMPLE))
+            {
+                vector<vector<Point>> contours_o;
+                vector<Vec4i> hierarchy_o;
+                findContours_legacy(src, contours_o, hierarchy_o, mode, method, Point(3, -2));
+                ASSERT_EQ(contours_o.size(), contours.size());
+                for (size_t i = 0; i < contours_o.size(); ++i)
+                {
+                    SCOPED_TRACE(format("contour = %zu", i));
+                    EXPECT_MAT_NEAR(Mat(contours_o[i]), contours[i], 0);
+                }
+                EXPECT_MAT_NEAR(Mat(hierarchy_o), Mat(hierarchy), 0);
+            }
+#endif
+        }
+    }
+}
+
 TEST(Imgproc_FindContours, link_runs)
 {
     const Size sz {500, 500};
@@ -884,4 +884,67 @@ TEST(cvtColorUYVY, size_issue_21035)
     EXPECT_THROW(cv::cvtColor(input, output, cv::COLOR_YUV2BGR_UYVY), cv::Exception);
 }
 
+
+CV_ENUM(YUV420toBGRCodes, COLOR_YUV2BGR_NV12, COLOR_YUV2RGBA_NV21, COLOR_YUV2BGR_YV12, COLOR_YUV2RGBA_IYUV)
+CV_ENUM(CvtResizeInterpolation, INTER_LINEAR, INTER_CUBIC, INTER_LANCZOS4, INTER_AREA, INTER_NEAREST)
+
+typedef ::testing::TestWithParam< tuple<YUV420toBGRCodes, CvtResizeInterpolation> > Imgproc_cvtColorResize;
+
+TEST_P(Imgproc_cvtColorResize, accuracy)
+{
+    const int code = get<0>(GetParam());
+    const int interpolation = get<1>(GetParam());
+    const bool twoPlanes = code == COLOR_YUV2BGR_NV12 || code == COLOR_YUV2RGBA_NV21;
+    const Scalar mean(104, 117, 123, 0);
+    const double scale = 1./255;
+
+    RNG& rng = theRNG();
+    for (int iter = 0; iter < 10; iter++)
+    {
+        Size ssize(rng.uniform(1, 321)*2, rng.uniform(1, 241)*2);
+        Size dsize(rng.uniform(1, 641), rng.uniform(1, 481));
+        if (iter == 0)
+            ssize = Size(1920, 1080), dsize = Size(640, 640);
+        else if (iter == 1)
+            dsize = Size(ssize.width/2, ssize.height/2);
+
+        Mat src(ssize.height*3/2, ssize.width, CV_8UC1);
+        rng.fill(src, RNG::UNIFORM, 0, 256);
+
+        Mat converted, ref, ref32f, dst;
+        cvtColor(src, converted, code);
+        resize(converted, ref, dsize, 0, 0, interpolation);
+        ref.convertTo(ref32f, CV_32F);
+        subtract(ref32f, mean, ref32f);
+        ref32f.convertTo(ref32f, CV_32F, scale);
+
+        cvtColorResize(src, dst, code, dsize, interpolation);
+        ASSERT_EQ(ref.type(), dst.type());
+        EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), 1) << ssize << " -> " << dsize;
+
+        cvtColorResize(src, dst, code, dsize, interpolation, CV_32F, scale, mean);
+        ASSERT_EQ(ref32f.type(), dst.type());
+        EXPECT_LE(cvtest::norm(ref32f, dst, NORM_INF), scale + 1e-5) << ssize << " -> " << dsize;
+
+        if (twoPlanes)
+        {
+            // padded chroma plane
+            Mat ysrc = src.rowRange(0, ssize.height);
+            Mat uvsrc_full(ssize.height/2, ssize.width/2 + 3, CV_8UC2);
+            Mat uvsrc = uvsrc_full.colRange(1, ssize.width/2 + 1);
+            Mat(ssize.height/2, ssize.width/2, CV_8UC2, src.ptr(ssize.height), src.step).copyTo(uvsrc);
+
+            cvtColorTwoPlaneResize(ysrc, uvsrc, dst, code, dsize, interpolation);
+            EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), 1) << ssize << " -> " << dsize;
+        }
+
+        // in-place
+        Mat inplace = src.clone();
+        cvtColorResize(inplace, inplace, code, dsize, interpolation);
+        EXPECT_LE(cvtest::norm(ref, inplace, NORM_INF), 1) << ssize << " -> " << dsize;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_cvtColorResize, testing::Combine(YUV420toBGRCodes::all(), CvtResizeInterpolation::all()));
+
 } // namespace
@@ -2249,6 +2249,75 @@ TEST(Imgproc_MedianBlur, hires_regression_13409)
     ASSERT_EQ(0.0, cvtest::norm(dst_hires(Rect(516, 516, 1016, 1016)), dst_ref(Rect(4, 4, 1016, 1016)), NORM_INF));
 }
 
+template <typename T>
+static Mat medianBlurReference(const Mat& src, int ksize)
+{
+    const int r = ksize / 2, cn = src.channels();
+    Mat border, dst(src.size(), src.type());
+    cv::copyMakeBorder(src, border, r, r, r, r, BORDER_REPLICATE);
+    std::vector<T> window(ksize * ksize);
+    for (int y = 0; y < src.rows; y++)
+        for (int x = 0; x < src.cols; x++)
+            for (int c = 0; c < cn; c++)
+            {
+                size_t k = 0;
+                for (int dy = 0; dy < ksize; dy++)
+                    for (int dx = 0; dx < ksize; dx++)
+                        window[k++] = border.ptr<T>(y + dy)[(x + dx) * cn + c];
+                std::nth_element(window.begin(), window.begin() + window.size() / 2, window.end());
+                dst.ptr<T>(y)[x * cn + c] = window[window.size() / 2];
+            }
+    return dst;
+}
+
+typedef testing::TestWithParam<tuple<int, int> > Imgproc_MedianBlur_16u;
+
+TEST_P(Imgproc_MedianBlur_16u, accuracy)
+{
+    const int cn = get<0>(GetParam());
+    const int ksize = get<1>(GetParam());
+    const int ranges[] = { 200, 4000, 65536 };
+    RNG& rng = theRNG();
+    const int threads = getNumThreads();
+    for (size_t i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++)
+    {
+        Mat src(rng.uniform(ksize, 120), rng.uniform(ksize, 150), CV_MAKETYPE(CV_16U, cn));
+        const int lo = rng.uniform(0, 65536 - ranges[i] + 1);
+        randu(src, lo, lo + ranges[i]);
+        Mat ref = medianBlurReference<ushort>(src, ksize);
+        for (int nThreads = 1; nThreads <= 4; nThreads += 3)
+        {
+            SCOPED_TRACE(cv::format("range=%d threads=%d", ranges[i], nThreads));
+            setNumThreads(nThreads);
+            Mat dst;
+            medianBlur(src, dst, ksize);
+            EXPECT_EQ(0, cvtest::norm(dst, ref, NORM_INF));
+        }
+    }
+    setNumThreads(threads);
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_MedianBlur_16u,
+    testing::Combine(testing::Values(1, 3, 4), testing::Values(7, 15, 31)));
+
+TEST(Imgproc_MedianBlur, tiles_8u)
+{
+    Mat src(120, 400, CV_8UC3), ref, dst;
+    randu(src, 0, 256);
+    const int threads = getNumThreads();
+    for (int ksize = 7; ksize <= 31; ksize += 8)
+    {
+        SCOPED_TRACE(cv::format("ksize=%d", ksize));
+        setNumThreads(1);
+        medianBlur(src, ref, ksize);
+        setNumThreads(4);
+        medianBlur(src, dst, ksize);
+        EXPECT_EQ(0, cvtest::norm(dst, ref, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(dst, medianBlurReference<uchar>(src, ksize), NORM_INF));
+    }
+    setNumThreads(threads);
+}
+
 TEST(Imgproc_Sobel, s16_regression_13506)
 {
     Mat src = (Mat_<short>(8, 16) << 127, 138, 130, 102, 118,  97,  76,  84, 124,  90, 146,  63, 130,  87, 212,  85,
@@ -2509,4 +2578,120 @@ INSTANTIATE_TEST_CASE_P(/**/, Imgproc_sepFilter2D_types,
     testing::Values(CV_16S, CV_32F, CV_64F),
 );
 
+static void filterPipelineReference(const Mat& src, Mat& dst, int chain)
+{
+    Mat t0, t1;
+    if (chain == 0)
+    {
+        cvtColor(src, t0, COLOR_BGR2GRAY);
+        GaussianBlur(t0, t1, Size(5, 5), 0);
+        Sobel(t1, t0, CV_16S, 1, 0);
+        convertScaleAbs(t0, t1);
+        cv::threshold(t1, dst, 64, 255, THRESH_BINARY);
+    }
+    else if (chain == 1)
+    {
+        GaussianBlur(src, t0, Size(0, 0), 3.0);
+        boxFilter(t0, t1, CV_32F, Size(7, 3), Point(-1, -1), true, BORDER_REFLECT);
+        Mat kx = (Mat_<float>(1, 3) << -1, 0, 1), ky = (Mat_<float>(4, 1) << 0.1f, 0.2f, 0.3f, 0.4f);
+        sepFilter2D(t1, t0, -1, kx, ky, Point(1, 3), 1.5, BORDER_CONSTANT);
+        t0.convertTo(dst, CV_16S, 10, -3);
+    }
+    else
+    {
+        GaussianBlur(src, t0, Size(7, 7), 0, 0, BORDER_REPLICATE);
+        Sobel(t0, dst, CV_32F, 0, 1, FILTER_SCHARR, 0.5);
+    }
+}
+
+static void filterPipelineCreate(FilterPipeline& pipeline, int chain)
+{
+    if (chain == 0)
+    {
+        pipeline.cvtColor(COLOR_BGR2GRAY)
+                .GaussianBlur(Size(5, 5), 0)
+                .Sobel(CV_16S, 1, 0)
+                .convertScaleAbs()
+                .threshold(64, 255, THRESH_BINARY);
+    }
+    else if (chain == 1)
+    {
+        Mat kx = (Mat_<float>(1, 3) << -1, 0, 1), ky = (Mat_<float>(4, 1) << 0.1f, 0.2f, 0.3f, 0.4f);
+        pipeline.GaussianBlur(Size(0, 0), 3.0)
+                .boxFilter(CV_32F, Size(7, 3), Point(-1, -1), true, BORDER_REFLECT)
+                .sepFilter2D(-1, kx, ky, Point(1, 3), 1.5, BORDER_CONSTANT)
+                .convertTo(CV_16S, 10, -3);
+    }
+    else
+    {
+        pipeline.GaussianBlur(Size(7, 7), 0, 0, BORDER_REPLICATE)
+                .Sobel(CV_32F, 0, 1, FILTER_SCHARR, 0.5);
+    }
+}
+
+TEST(Imgproc_FilterPipeline, accuracy)
+{
+    const Size sizes[] = { Size(320, 240), Size(67, 301), Size(33, 5), Size(1, 40), Size(640, 1) };
+    const int types[] = { CV_8UC3, CV_8UC3, CV_16UC1 };
+    const int stripRows[] = { 0, 1, 23, 100 };
+    RNG& rng = theRNG();
+    for (int chain = 0; chain < 3; chain++)
+    {
+        FilterPipeline pipeline;
+        filterPipelineCreate(pipeline, chain);
+        for (size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++)
+        {
+            Mat src(sizes[i], types[chain]), ref;
+            rng.fill(src, RNG::UNIFORM, 0, CV_MAT_DEPTH(types[chain]) == CV_8U ? 256 : 65536);
+            filterPipelineReference(src, ref, chain);
+            for (size_t j = 0; j < sizeof(stripRows)/sizeof(stripRows[0]); j++)
+            {
+                SCOPED_TRACE(cv::format("chain=%d size=%dx%d stripRows=%d", chain, src.cols, src.rows, stripRows[j]));
+                pipeline.setStripRows(stripRows[j]);
+                Mat dst;
+                pipeline.apply(src, dst);
+                ASSERT_EQ(ref.type(), dst.type());
+                ASSERT_EQ(ref.size(), dst.size());
+                EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+            }
+        }
+    }
+}
+
+TEST(Imgproc_FilterPipeline, inplace_and_empty)
+{
+    Mat src(100, 80, CV_8UC1), ref;
+    randu(src, 0, 256);
+    GaussianBlur(src, ref, Size(3, 3), 0);
+    cv::threshold(ref, ref, 100, 200, THRESH_TRUNC);
+
+    FilterPipeline pipeline;
+    EXPECT_TRUE(pipeline.empty());
+    Mat dst;
+    pipeline.apply(src, dst);
+    EXPECT_EQ(0, cvtest::norm(src, dst, NORM_INF));
+
+    pipeline.GaussianBlur(Size(3, 3), 0).threshold(100, 200, THRESH_TRUNC);
+    EXPECT_EQ(2u, pipeline.size());
+    pipeline.setStripRows(16);
+    pipeline.apply(src, src);
+    EXPECT_EQ(0, cvtest::norm(ref, src, NORM_INF));
+
+    pipeline.clear();
+    EXPECT_TRUE(pipeline.empty());
+}
+
+TEST(Imgproc_FilterPipeline, unsupported)
+{
+    FilterPipeline pipeline;
+    EXPECT_THROW(pipeline.cvtColor(COLOR_BayerBG2BGR), cv::Exception);
+    EXPECT_THROW(pipeline.threshold(0, 255, THRESH_BINARY | THRESH_OTSU), cv::Exception);
+    EXPECT_THROW(pipeline.GaussianBlur(Size(3, 3), 0, 0, BORDER_WRAP), cv::Exception);
+    EXPECT_TRUE(pipeline.empty());
+
+    Mat src(120, 64, CV_8UC1, Scalar::all(0)), dst;
+    pipeline.cvtColor(COLOR_YUV2BGR_NV12);
+    EXPECT_THROW(pipeline.apply(src, dst), cv::Exception);
+}
+
 }} // namespace
@@ -2096,5 +2096,124 @@ INSTANTIATE_TEST_CASE_P(Imgproc_Hist, Imgproc_Equalize_Hist, ::testing::Combine(
                         ::testing::Values(cv::Size(123, 321), cv::Size(256, 256), cv::Size(1024, 768)),
                         ::testing::Range(0, 10)));
 
+typedef ::testing::TestWithParam<std::tuple<int, int>> Imgproc_Hist_Sliding;
+
+static void makeSlidingHistParams(RNG& rng, int depth, int cn, std::vector<int>& channels,
+                                  std::vector<int>& histSize, std::vector<float>& ranges)
+{
+    channels.clear(); histSize.clear(); ranges.clear();
+    for (int c = 0; c < cn; c++)
+    {
+        channels.push_back(cn - 1 - c);
+        histSize.push_back(rng.uniform(2, 9));
+        // some of the values are out of the ranges
+        ranges.push_back(depth == CV_8U ? 10.f : 100.f);
+        ranges.push_back(depth == CV_8U ? 250.f : 4000.f);
+    }
+}
+
+static Mat flatHist(const Mat& src, const Rect& r, const std::vector<int>& channels,
+                    const std::vector<int>& histSize, const std::vector<float>& ranges)
+{
+    Mat hist;
+    std::vector<Mat> images(1, src(r));
+    calcHist(images, channels, noArray(), hist, histSize, ranges);
+    return Mat(1, (int)hist.total(), CV_32F, hist.ptr()).clone();
+}
+
+TEST_P(Imgproc_Hist_Sliding, accuracy)
+{
+    const int depth = std::get<0>(GetParam()), cn = std::get<1>(GetParam());
+    RNG& rng = theRNG();
+    for (int iter = 0; iter < 5; iter++)
+    {
+        Size sz(rng.uniform(1, 80), rng.uniform(1, 80));
+        Mat src(sz, CV_MAKETYPE(depth, cn));
+        rng.fill(src, RNG::UNIFORM, 0, depth == CV_8U ? 256 : 4096);
+
+        std::vector<int> channels, histSize;
+        std::vector<float> ranges;
+        makeSlidingHistParams(rng, depth, cn, channels, histSize, ranges);
+        Size winSize(rng.uniform(1, sz.width + 1), rng.uniform(1, sz.height + 1));
+        Size stride(rng.uniform(1, 8), rng.uniform(1, 8));
+
+        Mat hists;
+        calcHistSliding(src, channels, histSize, ranges, winSize, stride, hists);
+
+        const int nx = (sz.width - winSize.width)/stride.width + 1;
+        const int ny = (sz.height - winSize.height)/stride.height + 1;
+        ASSERT_EQ(CV_32FC1, hists.type());
+        ASSERT_EQ(ny*nx, hists.rows);
+        for (int wy = 0; wy < ny; wy++)
+            for (int wx = 0; wx < nx; wx++)
+            {
+                Rect r(wx*stride.width, wy*stride.height, winSize.width, winSize.height);
+                Mat ref = flatHist(src, r, channels, histSize, ranges);
+                ASSERT_EQ(0, cvtest::norm(ref, hists.row(wy*nx + wx), NORM_INF)) << r;
+            }
+    }
+}
+
+TEST_P(Imgproc_Hist_Sliding, integral)
+{
+    const int depth = std::get<0>(GetParam()), cn = std::get<1>(GetParam());
+    RNG& rng = theRNG();
+    for (int iter = 0; iter < 5; iter++)
+    {
+        Size sz(rng.uniform(1, 200), rng.uniform(1, 200));
+        Mat src(sz, CV_MAKETYPE(depth, cn));
+        rng.fill(src, RNG::UNIFORM, 0, depth == CV_8U ? 256 : 4096);
+
+        std::vector<int> channels, histSize;
+        std::vector<float> ranges;
+        makeSlidingHistParams(rng, depth, cn, channels, histSize, ranges);
+
+        Mat ihist;
+        calcIntegralHist(src, channels, histSize, ranges, ihist);
+        ASSERT_EQ(CV_32SC1, ihist.type());
+        ASSERT_EQ(3, ihist.dims);
+        ASSERT_EQ(sz.height + 1, ihist.size[0]);
+        ASSERT_EQ(sz.width + 1, ihist.size[1]);
+
+        const int nbins = ihist.size[2];
+        for (int k = 0; k < 20; k++)
+        {
+            int x0 = rng.uniform(0, sz.width), y0 = rng.uniform(0, sz.height);
+            Rect r(x0, y0, rng.uniform(1, sz.width - x0 + 1), rng.uniform(1, sz.height - y0 + 1));
+            Mat hist = Mat(1, nbins, CV_32S, ihist.ptr<int>(r.y + r.height, r.x + r.width)) -
+                       Mat(1, nbins, CV_32S, ihist.ptr<int>(r.y, r.x + r.width)) -
+                       Mat(1, nbins, CV_32S, ihist.ptr<int>(r.y + r.height, r.x)) +
+                       Mat(1, nbins, CV_32S, ihist.ptr<int>(r.y, r.x));
+            Mat ref = flatHist(src, r, channels, histSize, ranges), ref32s;
+            ref.convertTo(ref32s, CV_32S);
+            ASSERT_EQ(0, cvtest::norm(ref32s, hist, NORM_INF)) << r;
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Imgproc_Hist, Imgproc_Hist_Sliding, ::testing::Combine(
+                        ::testing::Values(CV_8U, CV_16U),
+                        ::testing::Values(1, 2, 3)));
+
+TEST(Imgproc_Hist_Calc, sliding_implicit_8u_ranges)
+{
+    Mat src(64, 48, CV_8UC1), hists;
+    randu(src, 0, 256);
+    std::vector<int> channels, histSize(1, 16);
+    std::vector<float> ranges;
+    calcHistSliding(src, channels, histSize, ranges, Size(16, 16), Size(16, 16), hists);
+    ASSERT_EQ(12, hists.rows);
+
+    std::vector<float> fullRange;
+    fullRange.push_back(0.f);
+    fullRange.push_back(256.f);
+    for (int i = 0; i < hists.rows; i++)
+    {
+        Mat ref = flatHist(src, Rect((i % 3)*16, (i / 3)*16, 16, 16), channels, histSize, fullRange);
+        EXPECT_EQ(0, cvtest::norm(ref, hists.row(i), NORM_INF));
+        EXPECT_EQ(256, cvtest::norm(hists.row(i), NORM_L1));
+    }
+}
+
 }} // namespace
 /* End Of File */
@@ -1765,5 +1765,198 @@ TEST(Imgproc_Remap, issue_23562)
     }
 }
 
+TEST(Imgproc_ResizeBatch, accuracy)
+{
+    const int interpolations[] = { INTER_NEAREST, INTER_LINEAR, INTER_CUBIC, INTER_AREA,
+                                   INTER_LANCZOS4, INTER_LINEAR_EXACT, INTER_NEAREST_EXACT };
+    const int types[] = { CV_8UC1, CV_8UC3, CV_16UC4, CV_32FC3, CV_64FC1 };
+    RNG& rng = theRNG();
+    for (size_t ti = 0; ti < sizeof(types)/sizeof(types[0]); ti++)
+    {
+        std::vector<Mat> src(40);
+        std::vector<Size> dsize(src.size());
+        for (size_t i = 0; i < src.size(); i++)
+        {
+            // a few distinct geometries, so the interpolation tables are shared
+            Size ssize = i % 3 == 0 ? Size(64, 64) : Size(rng.uniform(1, 100), rng.uniform(1, 100));
+            src[i].create(ssize, types[ti]);
+            rng.fill(src[i], RNG::UNIFORM, 0, 256);
+            dsize[i] = i % 4 == 0 ? Size(224, 224) :
+                       i % 4 == 1 ? Size(32, 32) :
+                       i % 4 == 2 ? ssize : Size(rng.uniform(1, 300), rng.uniform(1, 300));
+        }
+        for (size_t k = 0; k < sizeof(interpolations)/sizeof(interpolations[0]); k++)
+        {
+            const int interpolation = interpolations[k];
+            SCOPED_TRACE(cv::format("type=%d interpolation=%d", types[ti], interpolation));
+            std::vector<Mat> dst;
+            resizeBatch(src, dst, dsize, interpolation);
+            ASSERT_EQ(src.size(), dst.size());
+            for (size_t i = 0; i < src.size(); i++)
+            {
+                Mat ref;
+                resize(src[i], ref, dsize[i], 0, 0, interpolation);
+                ASSERT_EQ(ref.size(), dst[i].size());
+                ASSERT_EQ(ref.type(), dst[i].type());
+                EXPECT_EQ(0, cvtest::norm(ref, dst[i], NORM_INF)) << "image " << i << ": " << src[i].size() << " -> " << dsize[i];
+            }
+        }
+    }
+}
+
+TEST(Imgproc_ResizeBatch, common_size)
+{
+    std::vector<Mat> src(3);
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        src[i].create(10 + (int)i, 20, CV_8UC3);
+        randu(src[i], 0, 256);
+    }
+    std::vector<Mat> dst;
+    resizeBatch(src, dst, std::vector<Size>(1, Size(16, 8)), INTER_AREA);
+    ASSERT_EQ(src.size(), dst.size());
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        Mat ref;
+        resize(src[i], ref, Size(16, 8), 0, 0, INTER_AREA);
+        EXPECT_EQ(0, cvtest::norm(ref, dst[i], NORM_INF));
+    }
+
+    std::vector<Size> wrongSizes(2, Size(16, 8));
+    EXPECT_THROW(resizeBatch(src, dst, wrongSizes, INTER_LINEAR), cv::Exception);
+}
+
+TEST(Imgproc_ResizeBatch, many_geometries)
+{
+    // more distinct geometries than the tables cache keeps, repeated in the second half of the batch
+    RNG& rng = theRNG();
+    std::vector<Mat> src(300);
+    std::vector<Size> dsize(src.size());
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        const int k = (int)(i % 150);
+        src[i].create(20 + k % 13, 30 + k, CV_8UC3);
+        rng.fill(src[i], RNG::UNIFORM, 0, 256);
+        dsize[i] = Size(17 + k, 11 + k % 7);
+    }
+    std::vector<Mat> dst;
+    resizeBatch(src, dst, dsize, INTER_LINEAR);
+    ASSERT_EQ(src.size(), dst.size());
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        Mat ref;
+        resize(src[i], ref, dsize[i], 0, 0, INTER_LINEAR);
+        EXPECT_EQ(0, cvtest::norm(ref, dst[i], NORM_INF)) << "image " << i;
+    }
+}
+
+TEST(Imgproc_WarpPlan, accuracy)
+{
+    RNG& rng = theRNG();
+    const int types[] = { CV_8UC1, CV_8UC3, CV_8UC4, CV_16UC1, CV_16SC3, CV_32FC1, CV_32FC4 };
+    const int interpolations[] = { INTER_NEAREST, INTER_LINEAR, INTER_CUBIC, INTER_LANCZOS4, INTER_AREA };
+    const int borders[] = { BORDER_CONSTANT, BORDER_REPLICATE, BORDER_REFLECT_101 };
+    for (int iter = 0; iter < 60; iter++)
+    {
+        int type = types[rng.uniform(0, (int)(sizeof(types)/sizeof(types[0])))];
+        int interpolation = interpolations[rng.uniform(0, (int)(sizeof(interpolations)/sizeof(interpolations[0])))];
+        int border = borders[rng.uniform(0, (int)(sizeof(borders)/sizeof(borders[0])))];
+        int flags = interpolation | (rng.uniform(0, 2) ? WARP_INVERSE_MAP : 0);
+        Size ssize(rng.uniform(1, 300), rng.uniform(1, 200));
+        Size dsize(rng.uniform(1, 400), rng.uniform(1, 150));
+        Scalar borderValue(rng.uniform(0, 100), rng.uniform(0, 100), rng.uniform(0, 100), rng.uniform(0, 100));
+        SCOPED_TRACE(cv::format("type=%d flags=%d border=%d src=%dx%d dst=%dx%d",
+                                type, flags, border, ssize.width, ssize.height, dsize.width, dsize.height));
+
+        Mat src(ssize, type);
+        randu(src, 0, 256);
+
+        Mat A = getRotationMatrix2D(Point2f(ssize.width*0.5f, ssize.height*0.5f),
+                                    rng.uniform(-180., 180.), rng.uniform(0.3, 2.));
+        Mat H = Mat::eye(3, 3, CV_64F);
+        A.copyTo(H.rowRange(0, 2));
+        H.at<double>(2, 0) = rng.uniform(-1e-3, 1e-3);
+        H.at<double>(2, 1) = rng.uniform(-1e-3, 1e-3);
+
+        WarpPlan affinePlan, perspectivePlan;
+        affinePlan.createAffine(A, dsize, flags, border, borderValue);
+        perspectivePlan.createPerspective(H, dsize, flags, border, borderValue);
+        ASSERT_EQ(dsize, affinePlan.dstSize());
+
+        Mat ref, dst;
+        warpAffine(src, ref, A, dsize, flags, border, borderValue);
+        affinePlan.apply(src, dst);
+        EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF)) << "affine";
+
+        warpPerspective(src, ref, H, dsize, flags, border, borderValue);
+        perspectivePlan.apply(src, dst);
+        EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF)) << "perspective";
+    }
+}
+
+TEST(Imgproc_WarpPlan, fromMaps)
+{
+    Size size(320, 240);
+    Mat src(size, CV_8UC3);
+    randu(src, 0, 256);
+
+    // radial distortion-like maps
+    Mat mapx(size, CV_32FC1), mapy(size, CV_32FC1);
+    for (int y = 0; y < size.height; y++)
+        for (int x = 0; x < size.width; x++)
+        {
+            float dx = x - size.width*0.5f, dy = y - size.height*0.5f;
+            float k = 1.f + 2e-6f*(dx*dx + dy*dy);
+            mapx.at<float>(y, x) = size.width*0.5f + dx*k;
+            mapy.at<float>(y, x) = size.height*0.5f + dy*k;
+        }
+
+    const int interpolations[] = { INTER_NEAREST, INTER_LINEAR, INTER_CUBIC };
+    for (size_t i = 0; i < sizeof(interpolations)/sizeof(interpolations[0]); i++)
+    {
+        int interpolation = interpolations[i];
+        SCOPED_TRACE(interpolation);
+        Mat map1, map2, ref, dst;
+        convertMaps(mapx, mapy, map1, map2, CV_16SC2, interpolation == INTER_NEAREST);
+        remap(src, ref, map1, map2, interpolation, BORDER_CONSTANT, Scalar(1, 2, 3));
+
+        WarpPlan plan;
+        EXPECT_TRUE(plan.empty());
+        plan.createFromMaps(mapx, mapy, interpolation, BORDER_CONSTANT, Scalar(1, 2, 3));
+        EXPECT_FALSE(plan.empty());
+        plan.apply(src, dst);
+        EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+
+        Mat pmap1, pmap2;
+        plan.getMaps(pmap1, pmap2);
+        EXPECT_EQ(0, cvtest::norm(map1, pmap1, NORM_INF));
+        EXPECT_EQ(interpolation == INTER_NEAREST, pmap2.empty());
+
+        // fixed-point maps are used as is
+        WarpPlan plan2;
+        plan2.createFromMaps(map1, map2, interpolation, BORDER_CONSTANT, Scalar(1, 2, 3));
+        plan2.apply(src, dst);
+        EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+    }
+}
+
+TEST(Imgproc_WarpPlan, inplace)
+{
+    Mat src(100, 120, CV_8UC1);
+    randu(src, 0, 256);
+    Mat M = getRotationMatrix2D(Point2f(60, 50), 15, 1.1);
+
+    Mat ref;
+    warpAffine(src, ref, M, src.size());
+
+    WarpPlan plan;
+    plan.createAffine(M, src.size());
+    plan.apply(src, src);
+    EXPECT_EQ(0, cvtest::norm(ref, src, NORM_INF));
+
+    EXPECT_THROW(plan.createAffine(M, Size()), cv::Exception);
+    EXPECT_THROW(plan.createPerspective(M, src.size()), cv::Exception);
+}
+
 }} // namespace
 /* End of file. */
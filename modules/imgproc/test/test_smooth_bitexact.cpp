@@ -306,4 +306,55 @@ INSTANTIATE_TEST_CASE_P(/*nothing*/, GaussianBlurVsBitexact,
     )
 );
 
+CV_ENUM(GaussRecursiveBorder, BORDER_REPLICATE, BORDER_REFLECT, BORDER_REFLECT_101);
+
+typedef testing::TestWithParam<tuple<MatType, double, GaussRecursiveBorder> > GaussianBlurRecursive;
+
+TEST_P(GaussianBlurRecursive, accuracy)
+{
+    int type = get<0>(GetParam());
+    double sigma = get<1>(GetParam());
+    int border = get<2>(GetParam());
+
+    Mat noise(480, 640, type), src;
+    RNG& rng = theRNG();
+    rng.fill(noise, RNG::UNIFORM, 0, 256);
+    GaussianBlur(noise, src, Size(), 2);
+
+    Mat gt, dst;
+    GaussianBlur(src, gt, Size(), sigma, sigma, border, ALGO_HINT_ACCURATE);
+    GaussianBlur(src, dst, Size(), sigma, sigma, border, ALGO_HINT_APPROX);
+
+    // the recursive filter extends the kernel to 4*sigma
+    EXPECT_LE(cvtest::norm(dst, gt, NORM_INF), 1);
+    EXPECT_LE(cvtest::norm(dst, gt, NORM_L1) / dst.total() / dst.channels(), 0.2);
+
+    GaussianBlur(src, src, Size(), sigma, sigma, border, ALGO_HINT_APPROX);
+    EXPECT_EQ(0, cvtest::norm(src, dst, NORM_INF));
+}
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/, GaussianBlurRecursive,
+    testing::Combine(
+        testing::Values(CV_8UC1, CV_8UC3, CV_16UC1, CV_32FC1, CV_32FC4),
+        testing::Values(10, 30, 100),
+        GaussRecursiveBorder::all()
+    )
+);
+
+TEST(GaussianBlur_Recursive, truncated_kernel)
+{
+    Mat src(100, 100, CV_8UC1), gt, dst;
+    theRNG().fill(src, RNG::UNIFORM, 0, 256);
+
+    // explicit aperture is smaller than 3*sigma, the separable filter is used
+    GaussianBlur(src, gt, Size(21, 21), 30, 30, BORDER_DEFAULT, ALGO_HINT_ACCURATE);
+    GaussianBlur(src, dst, Size(21, 21), 30, 30, BORDER_DEFAULT, ALGO_HINT_APPROX);
+    EXPECT_EQ(0, cvtest::norm(dst, gt, NORM_INF));
+
+    // constant border is not handled by the recursive filter
+    GaussianBlur(src, gt, Size(), 30, 30, BORDER_CONSTANT, ALGO_HINT_ACCURATE);
+    GaussianBlur(src, dst, Size(), 30, 30, BORDER_CONSTANT, ALGO_HINT_APPROX);
+    EXPECT_EQ(0, cvtest::norm(dst, gt, NORM_INF));
+}
+
 }} // namespace
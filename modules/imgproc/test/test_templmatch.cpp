@@ -341,5 +341,94 @@ INSTANTIATE_TEST_CASE_P(/**/,
             testing::Values(1, 3),
             testing::Values(TM_SQDIFF, TM_SQDIFF_NORMED, TM_CCORR, TM_CCORR_NORMED, TM_CCOEFF, TM_CCOEFF_NORMED)));
 
+typedef testing::TestWithParam<testing::tuple<perf::MatDepth, int, MatchModes>> matchTemplateBatch_Modes;
+
+TEST_P(matchTemplateBatch_Modes, accuracy)
+{
+    const int data_type = CV_MAKE_TYPE(get<0>(GetParam()), get<1>(GetParam()));
+    const int method = get<2>(GetParam());
+    RNG & rng = TS::ptr()->get_rng();
+
+    const Size imgSize(rng.uniform(300, 640), rng.uniform(200, 480));
+    Mat img(imgSize, data_type);
+    cvtest::randUni(rng, img, Scalar::all(0), Scalar::all(255));
+
+    std::vector<Mat> templs, masks;
+    for (int i = 0; i < 12; i++)
+    {
+        const Size templSize(rng.uniform(1, 60), rng.uniform(1, 60));
+        Rect r(rng.uniform(0, imgSize.width - templSize.width), rng.uniform(0, imgSize.height - templSize.height),
+               templSize.width, templSize.height);
+        Mat templ = img(r).clone();
+        if (i % 2)
+            cvtest::randUni(rng, templ, Scalar::all(0), Scalar::all(255));
+        templs.push_back(templ);
+
+        Mat mask;
+        if (i % 4 == 3)
+        {
+            mask.create(templSize, CV_8UC1);
+            cvtest::randUni(rng, mask, Scalar::all(0), Scalar::all(2));
+        }
+        masks.push_back(mask);
+    }
+
+    std::vector<Mat> results, maskedResults;
+    cv::matchTemplateBatch(img, templs, results, method);
+    cv::matchTemplateBatch(img, templs, maskedResults, method, masks);
+    ASSERT_EQ(templs.size(), results.size());
+    ASSERT_EQ(templs.size(), maskedResults.size());
+
+    for (size_t i = 0; i < templs.size(); i++)
+    {
+        SCOPED_TRACE(cv::format("template %d, size %dx%d", (int)i, templs[i].cols, templs[i].rows));
+
+        Mat reference;
+        cv::matchTemplate(img, templs[i], reference, method);
+        ASSERT_EQ(reference.size(), results[i].size());
+        EXPECT_MAT_NEAR_RELATIVE(results[i], reference, 1e-3);
+
+        cv::matchTemplate(img, templs[i], reference, method, masks[i]);
+        if (masks[i].empty())
+            EXPECT_MAT_NEAR_RELATIVE(maskedResults[i], reference, 1e-3);
+        else
+            EXPECT_EQ(0, cvtest::norm(maskedResults[i], reference, NORM_INF));
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/,
+    matchTemplateBatch_Modes,
+        testing::Combine(
+            testing::Values(CV_8U, CV_32F),
+            testing::Values(1, 3),
+            testing::Values(TM_SQDIFF, TM_SQDIFF_NORMED, TM_CCORR, TM_CCORR_NORMED, TM_CCOEFF, TM_CCOEFF_NORMED)));
+
+TEST(matchTemplateBatch, swapped_template)
+{
+    RNG& rng = TS::ptr()->get_rng();
+    Mat img(40, 50, CV_32FC1);
+    cvtest::randUni(rng, img, Scalar::all(0), Scalar::all(255));
+    std::vector<Mat> templs(3);
+    templs[0].create(60, 70, CV_32FC1);  // larger than the image
+    templs[1].create(10, 12, CV_32FC1);
+    templs[2].create(40, 50, CV_32FC1);
+    for (size_t i = 0; i < templs.size(); i++)
+        cvtest::randUni(rng, templs[i], Scalar::all(0), Scalar::all(255));
+
+    std::vector<Mat> results;
+    cv::matchTemplateBatch(img, templs, results, TM_CCORR_NORMED);
+    ASSERT_EQ(templs.size(), results.size());
+    for (size_t i = 0; i < templs.size(); i++)
+    {
+        SCOPED_TRACE(cv::format("template %d", (int)i));
+        Mat reference;
+        cv::matchTemplate(img, templs[i], reference, TM_CCORR_NORMED);
+        ASSERT_EQ(reference.size(), results[i].size());
+        EXPECT_MAT_NEAR_RELATIVE(results[i], reference, 1e-3);
+    }
+
+    templs.push_back(Mat(60, 20, CV_32FC1, Scalar::all(1)));  // larger in one dimension only
+    EXPECT_THROW(cv::matchTemplateBatch(img, templs, results, TM_CCORR_NORMED), cv::Exception);
+}
 
 }} // namespace